@@ -17,6 +17,7 @@
 
 package org.apache.hugegraph.pd.client;
 
+import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.concurrent.ConcurrentHashMap;
@@ -31,6 +32,7 @@ import org.apache.hugegraph.pd.common.GraphCache;
 import org.apache.hugegraph.pd.common.KVPair;
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.common.PartitionUtils;
+import org.apache.hugegraph.pd.common.RouteSnapshot;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.Metapb.Graph;
 import org.apache.hugegraph.pd.grpc.Metapb.Graph.Builder;
@@ -153,6 +155,35 @@ public class ClientCache {
         }
     }
 
+    /**
+     * Route a batch of codes against one snapshot of the ranges, codes out of the snapshot
+     * fall back to {@link #getPartitionByCode}, which reloads the graph from pd.
+     *
+     * @return partition and leader of each code, in the order of the codes
+     */
+    public KVPair<Partition, Shard>[] getPartitionsByCodes(String graphName, int[] codes) {
+        try {
+            GraphCache graph = initGraph(graphName);
+            RouteSnapshot snapshot = graph.getRouteSnapshot();
+            KVPair<Partition, Shard>[] pairs = new KVPair[codes.length];
+            Map<Integer, KVPair<Partition, Shard>> routed = new HashMap<>();
+            for (int i = 0; i < codes.length; i++) {
+                int partId = snapshot.getPartitionId(codes[i]);
+                KVPair<Partition, Shard> pair = null;
+                if (partId >= 0) {
+                    pair = routed.get(partId);
+                    if (pair == null && (pair = getPair(partId, graph)) != null) {
+                        routed.put(partId, pair);
+                    }
+                }
+                pairs[i] = pair != null ? pair : getPartitionByCode(graphName, codes[i]);
+            }
+            return pairs;
+        } catch (PDException e) {
+            throw new RuntimeException(e);
+        }
+    }
+
     private GraphCache initGraph(String graphName) throws PDException {
         initCache();
         GraphCache graph = getGraphCache(graphName);
@@ -375,6 +406,22 @@ public class ClientCache {
                           .collect(Collectors.toList());
     }
 
+    /**
+     * Addresses of the stores holding learner replicas, used by scans served from learners
+     */
+    public List<String> getLearnerStoreAddresses() throws PDException {
+        initCache();
+        var storeIds = this.groups.values().stream()
+                                  .flatMap(pair -> pair.getKey().getShardsList().stream())
+                                  .filter(shard -> shard.getRole() == Metapb.ShardRole.Learner)
+                                  .map(Shard::getStoreId)
+                                  .collect(Collectors.toSet());
+        return this.stores.values().stream()
+                          .filter(store -> storeIds.contains(store.getId()))
+                          .map(Metapb.Store::getAddress)
+                          .collect(Collectors.toList());
+    }
+
     public Map<Integer, String> getLeaderPartitionStoreAddress(String graphName) throws
                                                                                  PDException {
         initCache();
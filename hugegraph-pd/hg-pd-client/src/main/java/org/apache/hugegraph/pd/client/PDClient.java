@@ -161,7 +161,13 @@ public class PDClient {
             public void onNext(PartitionEvent response) {
                 // log.info("PDClient receive partition event {}-{} {}",
                 //        response.getGraph(), response.getPartitionId(), response.getChangeType());
-                invalidPartitionCache(response.getGraph(), response.getPartitionId());
+                if (response.getPartition() != null &&
+                    response.getChangeType() != ChangeType.DEL) {
+                    // pd pushes the versioned partition, apply it without a round trip
+                    updatePartitionCache(response.getPartition(), null);
+                } else {
+                    invalidPartitionCache(response.getGraph(), response.getPartitionId());
+                }
                 if (response.getChangeType() == ChangeType.DEL) {
                     cache.removeAll(response.getGraph());
                 }
@@ -584,6 +590,25 @@ public class PDClient {
         return partShard;
     }
 
+    /**
+     * Route a batch of hash codes in one pass against one snapshot of the cached routes, only
+     * the codes missing from the cache cost a request to pd
+     *
+     * @return partition and leader of each code, in the order of the codes
+     */
+    public KVPair<Metapb.Partition, Metapb.Shard>[] getPartitionsByCodes(String graphName,
+                                                                        int[] codes)
+            throws PDException {
+        KVPair<Metapb.Partition, Metapb.Shard>[] partShards =
+                cache.getPartitionsByCodes(graphName, codes);
+        for (int i = 0; i < codes.length; i++) {
+            if (partShards[i] == null || partShards[i].getValue() == null) {
+                partShards[i] = getPartitionByCode(graphName, codes[i]);
+            }
+        }
+        return partShards;
+    }
+
     /**
      * Obtain the hash value of the key
      */
@@ -138,7 +138,9 @@ final class PDWatchImpl implements PDWatch {
             WatchPartitionResponse res = watchResponse.getPartitionResponse();
             PartitionEvent event = new PartitionEvent(res.getGraph(), res.getPartitionId(),
                                                       PartitionEvent.ChangeType.grpcTypeOf(
-                                                              res.getChangeType()));
+                                                              res.getChangeType()),
+                                                      res.hasPartition() ? res.getPartition() :
+                                                      null);
             this.listener.onNext(event);
         }
     }
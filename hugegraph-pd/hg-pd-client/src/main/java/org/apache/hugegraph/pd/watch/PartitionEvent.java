@@ -19,6 +19,7 @@ package org.apache.hugegraph.pd.watch;
 
 import java.util.Objects;
 
+import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.watch.WatchChangeType;
 
 public class PartitionEvent {
@@ -26,11 +27,18 @@ public class PartitionEvent {
     private String graph;
     private int partitionId;
     private ChangeType changeType;
+    private Metapb.Partition partition;
 
     public PartitionEvent(String graph, int partitionId, ChangeType changeType) {
+        this(graph, partitionId, changeType, null);
+    }
+
+    public PartitionEvent(String graph, int partitionId, ChangeType changeType,
+                          Metapb.Partition partition) {
         this.graph = graph;
         this.partitionId = partitionId;
         this.changeType = changeType;
+        this.partition = partition;
     }
 
     public String getGraph() {
@@ -45,6 +53,13 @@ public class PartitionEvent {
         return this.changeType;
     }
 
+    /**
+     * @return the partition after the change, null if pd did not push it
+     */
+    public Metapb.Partition getPartition() {
+        return this.partition;
+    }
+
     @Override
     public boolean equals(Object o) {
         if (this == o) {
@@ -69,6 +84,7 @@ public class PartitionEvent {
                "graph='" + graph + '\'' +
                ", partitionId=" + partitionId +
                ", changeType=" + changeType +
+               ", version=" + (partition == null ? "" : partition.getVersion()) +
                '}';
     }
 
@@ -23,6 +23,7 @@ import java.util.Objects;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
+import java.util.concurrent.locks.ReentrantReadWriteLock.ReadLock;
 import java.util.concurrent.locks.ReentrantReadWriteLock.WriteLock;
 
 import org.apache.commons.collections4.CollectionUtils;
@@ -47,6 +48,8 @@ public class GraphCache {
     private Map<Integer, AtomicBoolean> state = new ConcurrentHashMap<>();
     private Map<Integer, Partition> partitions = new ConcurrentHashMap<>();
     private volatile RangeMap<Long, Integer> range = TreeRangeMap.create();
+    // Rebuilt lazily after the range is changed, cleared under the write lock
+    private volatile RouteSnapshot routeSnapshot;
 
     public GraphCache(Graph graph) {
         this.graph = graph;
@@ -62,6 +65,7 @@ public class GraphCache {
                     gps.put(p.getId(), p);
                     range.put(Range.closedOpen(p.getStartKey(), p.getEndKey()), p.getId());
                 }
+                routeSnapshot = null;
             } catch (Exception e) {
                 log.warn("init graph with error:", e);
             } finally {
@@ -90,6 +94,7 @@ public class GraphCache {
                 lock.lock();
                 try {
                     range.remove(range.getEntry(p.getStartKey()).getKey());
+                    routeSnapshot = null;
                 } catch (Exception e) {
                     log.warn("remove partition with error:", e);
                 } finally {
@@ -109,6 +114,7 @@ public class GraphCache {
             if (range != null) {
                 range.clear();
             }
+            routeSnapshot = null;
         } catch (Exception e) {
             log.warn("remove partition with error:", e);
         } finally {
@@ -128,17 +134,46 @@ public class GraphCache {
         } catch (Exception e) {
 
         }
+        routeSnapshot = null;
     }
 
+    /**
+     * Immutable view of the current ranges, used to route a batch of codes without locking
+     */
+    public RouteSnapshot getRouteSnapshot() {
+        RouteSnapshot snapshot = routeSnapshot;
+        if (snapshot == null) {
+            ReadLock lock = getLock().readLock();
+            lock.lock();
+            try {
+                snapshot = RouteSnapshot.of(getRange());
+                routeSnapshot = snapshot;
+            } finally {
+                lock.unlock();
+            }
+        }
+        return snapshot;
+    }
+
+    /**
+     * Update the route of the partition, a partition older than the cached one is ignored,
+     * as pushed changes and routes carried by store errors may arrive out of order
+     *
+     * @return false if the partition is stale or unchanged
+     */
     public boolean updatePartition(Partition partition) {
         int partId = partition.getId();
         Partition p = getPartition(partId);
-        if (p != null && p.equals(partition)) {
+        if (isStale(p, partition)) {
             return false;
         }
         WriteLock lock = getLock().writeLock();
         try {
             lock.lock();
+            p = getPartition(partId);
+            if (isStale(p, partition)) {
+                return false;
+            }
             RangeMap<Long, Integer> range = getRange();
             addPartition(partId, partition);
             try {
@@ -156,6 +191,7 @@ public class GraphCache {
             } catch (Exception e) {
                 log.warn("update partition with error:", e);
             }
+            routeSnapshot = null;
         } catch (Exception e) {
             throw new RuntimeException(e);
         } finally {
@@ -164,4 +200,9 @@ public class GraphCache {
         return true;
     }
 
+    private static boolean isStale(Partition cached, Partition partition) {
+        return cached != null &&
+               (cached.getVersion() > partition.getVersion() || cached.equals(partition));
+    }
+
 }
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.pd.common;
+
+import java.util.Arrays;
+import java.util.Map;
+
+import com.google.common.collect.Range;
+import com.google.common.collect.RangeMap;
+
+/**
+ * Immutable copy of the key code ranges of a graph, sorted by start key. Lookups need no
+ * lock, so a batch of codes can be routed against one consistent view of the routes.
+ */
+public final class RouteSnapshot {
+
+    private final long[] starts;
+    private final long[] ends;
+    private final int[] ids;
+
+    private RouteSnapshot(long[] starts, long[] ends, int[] ids) {
+        this.starts = starts;
+        this.ends = ends;
+        this.ids = ids;
+    }
+
+    /**
+     * Requires external read lock of the range
+     */
+    public static RouteSnapshot of(RangeMap<Long, Integer> range) {
+        Map<Range<Long>, Integer> ranges = range.asMapOfRanges();
+        long[] starts = new long[ranges.size()];
+        long[] ends = new long[ranges.size()];
+        int[] ids = new int[ranges.size()];
+        int i = 0;
+        // The ranges of a TreeRangeMap are iterated in ascending order
+        for (Map.Entry<Range<Long>, Integer> entry : ranges.entrySet()) {
+            starts[i] = entry.getKey().lowerEndpoint();
+            ends[i] = entry.getKey().upperEndpoint();
+            ids[i] = entry.getValue();
+            i++;
+        }
+        return new RouteSnapshot(starts, ends, ids);
+    }
+
+    /**
+     * @return id of the partition holding the code, -1 if no partition holds it
+     */
+    public int getPartitionId(long code) {
+        int i = Arrays.binarySearch(this.starts, code);
+        if (i < 0) {
+            i = -i - 2;
+            if (i < 0) {
+                return -1;
+            }
+        }
+        return code < this.ends[i] ? this.ids[i] : -1;
+    }
+
+    public int size() {
+        return this.ids.length;
+    }
+}
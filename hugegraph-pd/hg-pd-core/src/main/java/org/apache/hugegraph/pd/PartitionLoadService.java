@@ -0,0 +1,112 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.pd;
+
+import java.util.HashMap;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+
+import lombok.Data;
+
+/**
+ * Keeps the read/write load reported by partition heartbeats in memory, smoothed over
+ * heartbeats, for the load-aware scheduling in TaskScheduleService
+ */
+public class PartitionLoadService {
+
+    // One 4KB I/O is scored as one operation
+    private static final double BYTES_PER_OPERATION = 4096.0;
+    private static final double SMOOTH_FACTOR = 0.5;
+
+    private final Map<Integer, Load> loads = new ConcurrentHashMap<>();
+    private final long expireMillis;
+
+    public PartitionLoadService(long expireMillis) {
+        this.expireMillis = expireMillis;
+    }
+
+    public void update(Metapb.PartitionStats stats) {
+        if (!stats.hasLoad()) {
+            return;
+        }
+        Metapb.PartitionLoad reported = stats.getLoad();
+        this.loads.compute(stats.getId(), (id, load) -> {
+            if (load == null) {
+                load = new Load();
+                load.setPartitionId(id);
+                load.setReadScore(readScore(reported));
+                load.setWriteScore(writeScore(reported));
+                load.setCpuUsage(reported.getCpuUsage());
+            } else {
+                load.setReadScore(smooth(load.getReadScore(), readScore(reported)));
+                load.setWriteScore(smooth(load.getWriteScore(), writeScore(reported)));
+                load.setCpuUsage(smooth(load.getCpuUsage(), reported.getCpuUsage()));
+            }
+            load.setLatest(reported);
+            load.setTimestamp(System.currentTimeMillis());
+            return load;
+        });
+    }
+
+    /**
+     * Loads of the partitions that reported recently
+     */
+    public Map<Integer, Load> getLoads() {
+        long now = System.currentTimeMillis();
+        this.loads.values().removeIf(load -> now - load.getTimestamp() > this.expireMillis);
+        return new HashMap<>(this.loads);
+    }
+
+    public Load getLoad(int partitionId) {
+        return this.loads.get(partitionId);
+    }
+
+    public void remove(int partitionId) {
+        this.loads.remove(partitionId);
+    }
+
+    private static double readScore(Metapb.PartitionLoad load) {
+        return load.getReadQps() + load.getReadBytes() / BYTES_PER_OPERATION;
+    }
+
+    private static double writeScore(Metapb.PartitionLoad load) {
+        return load.getWriteQps() + load.getWriteBytes() / BYTES_PER_OPERATION;
+    }
+
+    private static double smooth(double old, double current) {
+        return old * (1 - SMOOTH_FACTOR) + current * SMOOTH_FACTOR;
+    }
+
+    @Data
+    public static class Load {
+
+        private int partitionId;
+        // Reads are served by the leader only, writes are applied on every replica
+        private double readScore;
+        private double writeScore;
+        private double cpuUsage;
+        private Metapb.PartitionLoad latest;
+        private long timestamp;
+
+        public double getScore() {
+            return readScore + writeScore;
+        }
+    }
+}
@@ -25,6 +25,7 @@ import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
 import java.util.Optional;
+import java.util.concurrent.locks.Lock;
 import java.util.stream.Collectors;
 
 import org.apache.commons.collections4.SetUtils;
@@ -50,6 +51,8 @@ import org.apache.hugegraph.pd.meta.PartitionMeta;
 import org.apache.hugegraph.pd.meta.TaskInfoMeta;
 import org.apache.hugegraph.pd.raft.RaftStateListener;
 
+import com.google.common.util.concurrent.Striped;
+
 import lombok.extern.slf4j.Slf4j;
 
 /**
@@ -62,16 +65,23 @@ public class PartitionService implements RaftStateListener {
     private final StoreNodeService storeService;
     private PartitionMeta partitionMeta;
     private PDConfig pdConfig;
+    private final PartitionLoadService loadService;
     // Partition command listening
     private List<PartitionInstructionListener> instructionListeners;
 
     // Partition status listeners
     private List<PartitionStatusListener> statusListeners;
+    // Partition updates from the heartbeats are only serialized per partition id, structural
+    // operations (split, move, combine and remove) lock the partitions they change as well
+    private final Striped<Lock> partitionLocks = Striped.lock(64);
 
     public PartitionService(PDConfig config, StoreNodeService storeService) {
         this.pdConfig = config;
         this.storeService = storeService;
         partitionMeta = MetadataFactory.newPartitionMeta(config);
+        // Loads missing three balance rounds are stale
+        loadService = new PartitionLoadService(
+                config.getPartition().getLoadBalanceInterval() * 3 * 1000L);
         instructionListeners =
                 Collections.synchronizedList(new ArrayList<PartitionInstructionListener>());
         statusListeners = Collections.synchronizedList(new ArrayList<PartitionStatusListener>());
@@ -308,11 +318,19 @@ public class PartitionService implements RaftStateListener {
         return partShards;
     }
 
-    public synchronized long updatePartition(List<Metapb.Partition> partitions) throws PDException {
+    public long updatePartition(List<Metapb.Partition> partitions) throws PDException {
         for (Metapb.Partition pt : partitions) {
-            Metapb.Partition oldPt = getPartitionById(pt.getGraphName(), pt.getId());
-            partitionMeta.updatePartition(pt);
-            onPartitionChanged(oldPt, pt);
+            Metapb.Partition oldPt;
+            Metapb.Partition newPt;
+            Lock lock = partitionLocks.get(pt.getId());
+            lock.lock();
+            try {
+                oldPt = getPartitionById(pt.getGraphName(), pt.getId());
+                newPt = partitionMeta.updatePartition(pt);
+            } finally {
+                lock.unlock();
+            }
+            onPartitionChanged(oldPt, newPt);
         }
         return partitions.size();
     }
@@ -325,17 +343,24 @@ public class PartitionService implements RaftStateListener {
      * @param state
      * @throws PDException
      */
-    public synchronized void updatePartitionState(String graph, int partId,
-                                                  Metapb.PartitionState state) throws PDException {
-        Metapb.Partition partition = getPartitionById(graph, partId);
-
-        if (partition.getState() != state) {
-            Metapb.Partition newPartition = partitionMeta.updatePartition(partition.toBuilder()
-                                                                                   .setState(state)
-                                                                                   .build());
-
-            onPartitionChanged(partition, newPartition);
+    public void updatePartitionState(String graph, int partId,
+                                     Metapb.PartitionState state) throws PDException {
+        Metapb.Partition partition;
+        Metapb.Partition newPartition;
+        Lock lock = partitionLocks.get(partId);
+        lock.lock();
+        try {
+            partition = getPartitionById(graph, partId);
+            if (partition.getState() == state) {
+                return;
+            }
+            newPartition = partitionMeta.updatePartition(partition.toBuilder()
+                                                                  .setState(state)
+                                                                  .build());
+        } finally {
+            lock.unlock();
         }
+        onPartitionChanged(partition, newPartition);
     }
 
     public synchronized void updateGraphState(String graphName, Metapb.PartitionState state) throws
@@ -348,34 +373,41 @@ public class PartitionService implements RaftStateListener {
     }
 
     public synchronized long removePartition(String graphName, int partId) throws PDException {
-        log.info("Partition {}-{} removePartition", graphName, partId);
-        Metapb.Partition partition = partitionMeta.getPartitionById(graphName, partId);
-        var ret = partitionMeta.removePartition(graphName, partId);
-        partitionMeta.reload();
-        onPartitionRemoved(partition);
-
+        // Hold the partition lock against the heartbeat updates of the removed partition
+        Lock lock = partitionLocks.get(partId);
+        lock.lock();
         try {
-            Metapb.PartitionState state = Metapb.PartitionState.PState_Normal;
-            for (Metapb.Partition pt : partitionMeta.getPartitions(partition.getGraphName())) {
-                if (pt.getState().getNumber() > state.getNumber()) {
-                    state = pt.getState();
+            log.info("Partition {}-{} removePartition", graphName, partId);
+            Metapb.Partition partition = partitionMeta.getPartitionById(graphName, partId);
+            var ret = partitionMeta.removePartition(graphName, partId);
+            partitionMeta.reload();
+            onPartitionRemoved(partition);
+
+            try {
+                Metapb.PartitionState state = Metapb.PartitionState.PState_Normal;
+                for (Metapb.Partition pt : partitionMeta.getPartitions(partition.getGraphName())) {
+                    if (pt.getState().getNumber() > state.getNumber()) {
+                        state = pt.getState();
+                    }
                 }
-            }
-            updateGraphState(partition.getGraphName(), state);
+                updateGraphState(partition.getGraphName(), state);
 
-            state = Metapb.PartitionState.PState_Normal;
-            for (Metapb.ShardGroup group : storeService.getShardGroups()) {
-                if (group.getState().getNumber() > state.getNumber()) {
-                    state = group.getState();
+                state = Metapb.PartitionState.PState_Normal;
+                for (Metapb.ShardGroup group : storeService.getShardGroups()) {
+                    if (group.getState().getNumber() > state.getNumber()) {
+                        state = group.getState();
+                    }
                 }
+                storeService.updateClusterStatus(state);
+
+            } catch (PDException e) {
+                log.error("onPartitionChanged", e);
             }
-            storeService.updateClusterStatus(state);
 
-        } catch (PDException e) {
-            log.error("onPartitionChanged", e);
+            return ret;
+        } finally {
+            lock.unlock();
         }
-
-        return ret;
     }
 
     public Metapb.PartitionStats getPartitionStats(String graphName, int partitionId) throws
@@ -580,6 +612,8 @@ public class PartitionService implements RaftStateListener {
      */
     public synchronized void movePartitionsShard(Integer partitionId, long fromStore,
                                                  long toStore) {
+        Lock lock = partitionLocks.get(partitionId);
+        lock.lock();
         try {
             log.info("movePartitionsShard partitionId {} from store {} to store {}", partitionId,
                      fromStore, toStore);
@@ -609,6 +643,8 @@ public class PartitionService implements RaftStateListener {
             }
         } catch (PDException e) {
             log.error("Partition {} movePartitionsShard exception {}", partitionId, e);
+        } finally {
+            lock.unlock();
         }
     }
 
@@ -673,6 +709,27 @@ public class PartitionService implements RaftStateListener {
     private synchronized void splitPartition(Metapb.Graph graph,
                                              List<KVPair<Integer, Integer>> splits)
             throws PDException {
+        // Lock the source partitions and the ids of the new ones, which are allocated after
+        // the current partitions
+        List<Integer> partIds = getPartitions(graph.getGraphName()).stream()
+                                                                   .map(Metapb.Partition::getId)
+                                                                   .collect(Collectors.toList());
+        int nextId = partIds.size();
+        for (var pair : splits) {
+            for (int i = 1; i < pair.getValue(); i++) {
+                partIds.add(nextId++);
+            }
+        }
+        List<Lock> locks = lockPartitions(partIds);
+        try {
+            doSplitPartition(graph, splits);
+        } finally {
+            unlockPartitions(locks);
+        }
+    }
+
+    private void doSplitPartition(Metapb.Graph graph, List<KVPair<Integer, Integer>> splits)
+            throws PDException {
         var taskInfoMeta = storeService.getTaskInfoMeta();
         if (!taskInfoMeta.scanSplitTask(graph.getGraphName()).isEmpty()) {
             return;
@@ -721,13 +778,11 @@ public class PartitionService implements RaftStateListener {
                                            .build());
                 i += 1;
 
-                // try to save new partitions, and repair shard group
+                // Repair shard group. The new partitions are saved, and so routed to, only when
+                // the task succeeds, the source keeps serving their ranges until then
                 for (int j = 0; j < newPartitions.size(); j++) {
                     var newPartition = newPartitions.get(j);
 
-                    if (j != 0) {
-                        partitionMeta.updatePartition(newPartition);
-                    }
                     // Create a shard group, if it is empty, create it according to the shard
                     // group of the partition, and ensure that it is on one machine
                     // If it exists, the number of partitions in each graph is not the same, and
@@ -742,7 +797,7 @@ public class PartitionService implements RaftStateListener {
                     }
 
                     // check shard list
-                    if (shardGroup.getShardsCount() != pdConfig.getPartition().getShardCount()) {
+                    if (storeService.isShardCountChanged(shardGroup)) {
                         storeService.reallocShards(shardGroup);
                     }
                 }
@@ -752,10 +807,6 @@ public class PartitionService implements RaftStateListener {
                                                               .build();
 
                 fireSplitPartition(partition, splitPartition);
-                // Change the partition status to Offline, and resume the partition status to
-                // Offline after the task is completed
-                updatePartitionState(partition.getGraphName(), partition.getId(),
-                                     Metapb.PartitionState.PState_Offline);
 
                 // Record transactions
                 var task = MetaTask.Task.newBuilder().setPartition(partition)
@@ -829,6 +880,20 @@ public class PartitionService implements RaftStateListener {
      */
     private synchronized void combineGraphPartition(Metapb.Graph graph, int toCount, int shardCount)
             throws PDException {
+        List<Integer> partIds = graph == null ? Collections.emptyList() :
+                                getPartitions(graph.getGraphName()).stream()
+                                                                   .map(Metapb.Partition::getId)
+                                                                   .collect(Collectors.toList());
+        List<Lock> locks = lockPartitions(partIds);
+        try {
+            doCombineGraphPartition(graph, toCount, shardCount);
+        } finally {
+            unlockPartitions(locks);
+        }
+    }
+
+    private void doCombineGraphPartition(Metapb.Graph graph, int toCount, int shardCount)
+            throws PDException {
         if (graph == null) {
             throw new PDException(1,
                                   "Graph not exists, try to use full graph name, like " +
@@ -908,6 +973,25 @@ public class PartitionService implements RaftStateListener {
         storeService.updateClusterStatus(Metapb.ClusterState.Cluster_Offline);
     }
 
+    /**
+     * Lock the partitions against the heartbeat updates, the stripes are locked in a fixed
+     * order so that structural operations can't deadlock each other
+     */
+    private List<Lock> lockPartitions(List<Integer> partIds) {
+        List<Lock> locks = new ArrayList<>();
+        for (Lock lock : partitionLocks.bulkGet(partIds)) {
+            lock.lock();
+            locks.add(lock);
+        }
+        return locks;
+    }
+
+    private void unlockPartitions(List<Lock> locks) {
+        for (int i = locks.size() - 1; i >= 0; i--) {
+            locks.get(i).unlock();
+        }
+    }
+
     /**
      * get raft group count from storeService
      *
@@ -964,11 +1048,27 @@ public class PartitionService implements RaftStateListener {
         // partitionMeta.getAndCreateGraph(partition.getGraphName());
         checkShardState(shardGroup, stats);
         // }
-        // statistics
+        loadService.update(stats);
+        // statistics, kept in memory and flushed in batches by flushPartitionStats()
         partitionMeta.updatePartitionStats(stats.toBuilder()
                                                 .setTimestamp(System.currentTimeMillis()).build());
     }
 
+    /**
+     * Persist the partition stats changed since the last flush, called periodically on
+     * the leader
+     */
+    public void flushPartitionStats() throws PDException {
+        int count = partitionMeta.flushPartitionStats();
+        if (count > 0) {
+            log.debug("flush {} partition stats", count);
+        }
+    }
+
+    public PartitionLoadService getLoadService() {
+        return loadService;
+    }
+
     private boolean isShardEquals(List<Metapb.Shard> list1, List<Metapb.Shard> list2) {
         return SetUtils.isEqualSet(list1, list2);
     }
@@ -1307,6 +1407,15 @@ public class PartitionService implements RaftStateListener {
             // Set source to upline
             updatePartitionState(source.getGraphName(), source.getId(),
                                  Metapb.PartitionState.PState_Normal);
+            // Resend the source range, which lifts the write fence of the migration on store
+            fireChangePartitionKeyRange(source.toBuilder()
+                                              .setState(Metapb.PartitionState.PState_Normal)
+                                              .build(),
+                                        PartitionKeyRange.newBuilder()
+                                                         .setPartitionId(source.getId())
+                                                         .setKeyStart(source.getStartKey())
+                                                         .setKeyEnd(source.getEndKey())
+                                                         .build());
             var movedPartition = metaTask.getMovePartition().getTargetPartition();
 
             if (targetPartitionIds.contains(movedPartition.getId())) {
@@ -1561,6 +1670,7 @@ public class PartitionService implements RaftStateListener {
         } catch (PDException e) {
             log.error("Partition meta reload exception {}", e);
         }
+        partitionMeta.clearPartitionStats();
     }
 
     public void onPartitionStateChanged(String graph, int partId,
@@ -25,7 +25,10 @@ import java.util.List;
 import java.util.Map;
 import java.util.Objects;
 import java.util.Random;
+import java.util.Set;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.locks.Lock;
+import java.util.stream.Collectors;
 
 import org.apache.commons.lang3.StringUtils;
 import org.apache.hugegraph.pd.common.KVPair;
@@ -42,7 +45,9 @@ import org.apache.hugegraph.pd.meta.MetadataFactory;
 import org.apache.hugegraph.pd.meta.MetadataKeyHelper;
 import org.apache.hugegraph.pd.meta.StoreInfoMeta;
 import org.apache.hugegraph.pd.meta.TaskInfoMeta;
+import org.apache.hugegraph.pd.raft.RaftStateListener;
 
+import com.google.common.util.concurrent.Striped;
 import com.google.gson.Gson;
 
 import lombok.extern.slf4j.Slf4j;
@@ -51,9 +56,12 @@ import lombok.extern.slf4j.Slf4j;
  * Hg Store registration and keep-alive management
  */
 @Slf4j
-public class StoreNodeService {
+public class StoreNodeService implements RaftStateListener {
 
     private static final Long STORE_HEART_BEAT_INTERVAL = 30000L;
+    // Label of the stores started with raft.learner, they host learner replicas only
+    private static final String REPLICA_ROLE_LABEL = "replica-role";
+    private static final String LEARNER_ROLE = "learner";
     private static String graphSpaceConfPrefix = "HUGEGRAPH/hg/GRAPHSPACE/CONF/";
     private List<StoreStatusListener> statusListeners;
     private List<ShardGroupStatusListener> shardGroupStatusListeners;
@@ -74,6 +82,8 @@ public class StoreNodeService {
         }
     };
     private volatile Metapb.ClusterStats clusterStats;
+    // Heartbeats update the shard groups concurrently, they are only serialized per group
+    private final Striped<Lock> shardGroupLocks = Striped.lock(64);
 
     public StoreNodeService(PDConfig config) {
         this.pdConfig = config;
@@ -401,6 +411,51 @@ public class StoreNodeService {
         return storeInfoMeta.getActiveStores();
     }
 
+    public static boolean isLearnerStore(Metapb.Store store) {
+        return store.getLabelsList().stream()
+                    .anyMatch(label -> REPLICA_ROLE_LABEL.equals(label.getKey()) &&
+                                       LEARNER_ROLE.equals(label.getValue()));
+    }
+
+    /**
+     * Returns the active stores that host the voting replicas
+     */
+    public List<Metapb.Store> getActiveVoterStores() throws PDException {
+        return getActiveStores().stream()
+                                .filter(store -> !isLearnerStore(store))
+                                .collect(Collectors.toList());
+    }
+
+    public List<Metapb.Store> getActiveLearnerStores() throws PDException {
+        return getActiveStores().stream()
+                                .filter(StoreNodeService::isLearnerStore)
+                                .collect(Collectors.toList());
+    }
+
+    /**
+     * Returns the ids of all learner stores, including the ones not active
+     */
+    public Set<Long> getLearnerStoreIds() throws PDException {
+        return getStores().stream()
+                          .filter(StoreNodeService::isLearnerStore)
+                          .map(Metapb.Store::getId)
+                          .collect(Collectors.toSet());
+    }
+
+    /**
+     * Whether the voters or the learners of the shard group differ from the configured counts
+     */
+    public boolean isShardCountChanged(Metapb.ShardGroup group) throws PDException {
+        Set<Long> learnerStoreIds = getLearnerStoreIds();
+        long learners = group.getShardsList().stream()
+                             .filter(shard -> learnerStoreIds.contains(shard.getStoreId()))
+                             .count();
+        int learnerCount = Math.min(pdConfig.getPartition().getLearnerCount(),
+                                    getActiveLearnerStores().size());
+        return group.getShardsCount() - learners != pdConfig.getPartition().getShardCount() ||
+               learners != learnerCount;
+    }
+
     public List<Metapb.Store> getTombStores() throws PDException {
         List<Metapb.Store> stores = new ArrayList<>();
         for (Metapb.Store store : this.getStores()) {
@@ -428,8 +483,8 @@ public class StoreNodeService {
         // The number of partitions can be set based on the size of the data, but the total
         // number cannot exceed the number of raft groups
         if (storeInfoMeta.getShardGroup(partId) == null) {
-            // Get active store key
-            List<Metapb.Store> stores = storeInfoMeta.getActiveStores();
+            // Get active store key, learner stores only take the learner replicas
+            List<Metapb.Store> stores = getActiveVoterStores();
 
             if (stores.size() == 0) {
                 throw new PDException(Pdpb.ErrorType.NO_ACTIVE_STORE_VALUE,
@@ -451,6 +506,10 @@ public class StoreNodeService {
                 shardCount = 1;
             }
 
+            List<Metapb.Store> learnerStores = getActiveLearnerStores();
+            int learnerCount = Math.min(pdConfig.getPartition().getLearnerCount(),
+                                        learnerStores.size());
+
             // All ShardGroups are created at one time to ensure that the initial groupIDs are
             // orderly and easy for humans to read
             for (int groupId = 0; groupId < pdConfig.getConfigService().getPartitionCount();
@@ -466,6 +525,13 @@ public class StoreNodeService {
                     shards.add(shard);
                     storeIdx = (storeIdx + 1) >= stores.size() ? 0 : ++storeIdx; // Sequential
                 }
+                for (int i = 0; i < learnerCount; i++) {
+                    int learnerIdx = (groupId + i) % learnerStores.size();
+                    shards.add(Metapb.Shard.newBuilder()
+                                           .setStoreId(learnerStores.get(learnerIdx).getId())
+                                           .setRole(Metapb.ShardRole.Learner)
+                                           .build());
+                }
 
                 Metapb.ShardGroup group = Metapb.ShardGroup.newBuilder()
                                                            .setId(groupId)
@@ -489,7 +555,7 @@ public class StoreNodeService {
      */
     public synchronized List<Metapb.Shard> reallocShards(Metapb.ShardGroup shardGroup) throws
                                                                                        PDException {
-        List<Metapb.Store> stores = storeInfoMeta.getActiveStores();
+        List<Metapb.Store> stores = getActiveVoterStores();
 
         if (stores.size() == 0) {
             throw new PDException(Pdpb.ErrorType.NO_ACTIVE_STORE_VALUE,
@@ -510,39 +576,32 @@ public class StoreNodeService {
             shardCount = 1;
         }
 
-        List<Metapb.Shard> shards = new ArrayList<>();
-        shards.addAll(shardGroup.getShardsList());
-
-        if (shardCount > shards.size()) {
-            // Need to add shards
-            log.info("reallocShards ShardGroup {}, add shards from {} to {}",
-                     shardGroup.getId(), shards.size(), shardCount);
-            int storeIdx = (int) shardGroup.getId() % stores.size();
-            for (int addCount = shardCount - shards.size(); addCount > 0; ) {
-                // Check if it already exists
-                if (!isStoreInShards(shards, stores.get(storeIdx).getId())) {
-                    Metapb.Shard shard = Metapb.Shard.newBuilder()
-                                                     .setStoreId(stores.get(storeIdx).getId())
-                                                     .build();
-                    shards.add(shard);
-                    addCount--;
-                }
-                storeIdx = (storeIdx + 1) >= stores.size() ? 0 : ++storeIdx;
+        List<Metapb.Store> learnerStores = getActiveLearnerStores();
+        int learnerCount = Math.min(pdConfig.getPartition().getLearnerCount(),
+                                    learnerStores.size());
+
+        // The voters and the learners are adjusted separately
+        Set<Long> learnerStoreIds = getLearnerStoreIds();
+        List<Metapb.Shard> voters = new ArrayList<>();
+        List<Metapb.Shard> learners = new ArrayList<>();
+        shardGroup.getShardsList().forEach(shard -> {
+            if (learnerStoreIds.contains(shard.getStoreId())) {
+                learners.add(shard.toBuilder().setRole(Metapb.ShardRole.Learner).build());
+            } else if (shard.getRole() == Metapb.ShardRole.Learner) {
+                // A voter still catching up, it must not be kept as a learner
+                voters.add(shard.toBuilder().setRole(Metapb.ShardRole.Follower).build());
+            } else {
+                voters.add(shard);
             }
-        } else if (shardCount < shards.size()) {
-            // Need to reduce shard
-            log.info("reallocShards ShardGroup {}, remove shards from {} to {}",
-                     shardGroup.getId(), shards.size(), shardCount);
+        });
 
-            int subCount = shards.size() - shardCount;
-            Iterator<Metapb.Shard> iterator = shards.iterator();
-            while (iterator.hasNext() && subCount > 0) {
-                if (iterator.next().getRole() != Metapb.ShardRole.Leader) {
-                    iterator.remove();
-                    subCount--;
-                }
-            }
-        } else {
+        boolean changed = adjustShards(shardGroup, voters, stores, shardCount, null);
+        changed |= adjustShards(shardGroup, learners, learnerStores, learnerCount,
+                                Metapb.ShardRole.Learner);
+
+        List<Metapb.Shard> shards = new ArrayList<>(voters);
+        shards.addAll(learners);
+        if (!changed) {
             return shards;
         }
 
@@ -585,6 +644,52 @@ public class StoreNodeService {
         return sum;
     }
 
+    /**
+     * Add shards on the stores or remove the non-leader shards, until there are count shards
+     *
+     * @param role role of the added shards, null for voters whose role is decided by raft
+     * @return whether the shards are changed
+     */
+    private boolean adjustShards(Metapb.ShardGroup shardGroup, List<Metapb.Shard> shards,
+                                 List<Metapb.Store> stores, int count, Metapb.ShardRole role) {
+        if (count > shards.size()) {
+            // Need to add shards
+            log.info("reallocShards ShardGroup {}, add shards from {} to {}",
+                     shardGroup.getId(), shards.size(), count);
+            int storeIdx = (int) shardGroup.getId() % stores.size();
+            for (int addCount = count - shards.size(); addCount > 0; ) {
+                // Check if it already exists
+                if (!isStoreInShards(shards, stores.get(storeIdx).getId())) {
+                    Metapb.Shard.Builder shard = Metapb.Shard.newBuilder()
+                                                             .setStoreId(
+                                                                     stores.get(storeIdx).getId());
+                    if (role != null) {
+                        shard.setRole(role);
+                    }
+                    shards.add(shard.build());
+                    addCount--;
+                }
+                storeIdx = (storeIdx + 1) >= stores.size() ? 0 : ++storeIdx;
+            }
+        } else if (count < shards.size()) {
+            // Need to reduce shard
+            log.info("reallocShards ShardGroup {}, remove shards from {} to {}",
+                     shardGroup.getId(), shards.size(), count);
+
+            int subCount = shards.size() - count;
+            Iterator<Metapb.Shard> iterator = shards.iterator();
+            while (iterator.hasNext() && subCount > 0) {
+                if (iterator.next().getRole() != Metapb.ShardRole.Leader) {
+                    iterator.remove();
+                    subCount--;
+                }
+            }
+        } else {
+            return false;
+        }
+        return true;
+    }
+
     /**
      * Alloc shard group, prepare for the split
      *
@@ -612,9 +717,20 @@ public class StoreNodeService {
      * @param confVersion : conf version, ignored if less than 0
      * @return
      */
-    public synchronized Metapb.ShardGroup updateShardGroup(int groupId, List<Metapb.Shard> shards,
-                                                           long version, long confVersion) throws
-                                                                                           PDException {
+    public Metapb.ShardGroup updateShardGroup(int groupId, List<Metapb.Shard> shards,
+                                              long version, long confVersion) throws PDException {
+        Lock lock = shardGroupLocks.get(groupId);
+        lock.lock();
+        try {
+            return doUpdateShardGroup(groupId, shards, version, confVersion);
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    private Metapb.ShardGroup doUpdateShardGroup(int groupId, List<Metapb.Shard> shards,
+                                                 long version, long confVersion) throws
+                                                                                 PDException {
         Metapb.ShardGroup group = this.storeInfoMeta.getShardGroup(groupId);
 
         if (group == null) {
@@ -690,27 +806,33 @@ public class StoreNodeService {
         }
     }
 
-    public synchronized void updateShardGroupState(int groupId, Metapb.PartitionState state) throws
-                                                                                             PDException {
-        Metapb.ShardGroup shardGroup = storeInfoMeta.getShardGroup(groupId);
-
-        if (state != shardGroup.getState()) {
+    public void updateShardGroupState(int groupId, Metapb.PartitionState state) throws
+                                                                                PDException {
+        Lock lock = shardGroupLocks.get(groupId);
+        lock.lock();
+        try {
+            Metapb.ShardGroup shardGroup = storeInfoMeta.getShardGroup(groupId);
+            if (state == shardGroup.getState()) {
+                return;
+            }
             var newShardGroup = shardGroup.toBuilder().setState(state).build();
             storeInfoMeta.updateShardGroup(newShardGroup);
             partitionService.updateShardGroupCache(newShardGroup);
+        } finally {
+            lock.unlock();
+        }
 
-            log.debug("update shard group {} state: {}", groupId, state);
+        log.debug("update shard group {} state: {}", groupId, state);
 
-            // Check the status of the cluster
-            // todo : A clearer definition of cluster status
-            Metapb.PartitionState clusterState = state;
-            for (Metapb.ShardGroup group : getShardGroups()) {
-                if (group.getState().getNumber() > state.getNumber()) {
-                    clusterState = group.getState();
-                }
+        // Check the status of the cluster
+        // todo : A clearer definition of cluster status
+        Metapb.PartitionState clusterState = state;
+        for (Metapb.ShardGroup group : getShardGroups()) {
+            if (group.getState().getNumber() > state.getNumber()) {
+                clusterState = group.getState();
             }
-            updateClusterStatus(clusterState);
         }
+        updateClusterStatus(clusterState);
     }
 
     /**
@@ -720,7 +842,6 @@ public class StoreNodeService {
      * @throws PDException
      */
     public Metapb.ClusterStats heartBeat(Metapb.StoreStats storeStats) throws PDException {
-        this.storeInfoMeta.updateStoreStats(storeStats);
         Metapb.Store lastStore = this.getStore(storeStats.getStoreId());
         if (lastStore == null) {
             // store does not exist
@@ -751,7 +872,7 @@ public class StoreNodeService {
                                        .setStats(storeStats)
                                        .setLastHeartbeat(System.currentTimeMillis())
                                        .setState(Metapb.StoreState.Exiting).build();
-                this.storeInfoMeta.updateStore(nowStore);
+                this.storeInfoMeta.updateStoreHeartbeat(nowStore);
                 return this.clusterStats;
             } else {
                 nowStore = Metapb.Store.newBuilder(lastStore)
@@ -759,6 +880,7 @@ public class StoreNodeService {
                                        .setLastHeartbeat(System.currentTimeMillis())
                                        .setState(Metapb.StoreState.Tombstone).build();
                 this.storeInfoMeta.updateStore(nowStore);
+                this.storeInfoMeta.updateStoreStats(storeStats);
                 storeInfoMeta.removeActiveStore(nowStore);
                 return this.clusterStats;
             }
@@ -769,7 +891,7 @@ public class StoreNodeService {
                                    .setStats(storeStats)
                                    .setLastHeartbeat(System.currentTimeMillis())
                                    .setState(Metapb.StoreState.Pending).build();
-            this.storeInfoMeta.updateStore(nowStore);
+            this.storeInfoMeta.updateStoreHeartbeat(nowStore);
             return this.clusterStats;
         } else {
             if (lastStore.getState() == Metapb.StoreState.Offline) {
@@ -780,13 +902,37 @@ public class StoreNodeService {
                                    .setState(Metapb.StoreState.Up)
                                    .setStats(storeStats)
                                    .setLastHeartbeat(System.currentTimeMillis()).build();
-            this.storeInfoMeta.updateStore(nowStore);
+            if (lastStore.getState() != Metapb.StoreState.Up) {
+                this.storeInfoMeta.updateStore(nowStore);
+            } else {
+                // Nothing but the stats changed, they are flushed in batches
+                this.storeInfoMeta.updateStoreHeartbeat(nowStore);
+            }
             this.storeInfoMeta.keepStoreAlive(nowStore);
             this.checkStoreStatus();
             return this.clusterStats;
         }
     }
 
+    /**
+     * Persist the store heartbeats changed since the last flush, called periodically on
+     * the leader
+     */
+    public void flushHeartbeats() throws PDException {
+        int count = storeInfoMeta.flushHeartbeats();
+        if (count > 0) {
+            log.debug("flush {} store heartbeats", count);
+        }
+    }
+
+    /**
+     * The heartbeats kept in memory may be stale once the leader has changed
+     */
+    @Override
+    public void onRaftLeaderChanged() {
+        storeInfoMeta.clearHeartbeats();
+    }
+
     public synchronized Metapb.ClusterStats updateClusterStatus(Metapb.ClusterState state) {
         if (this.clusterStats.getState() != state) {
             log.info("update cluster state: {}", state);
@@ -26,6 +26,7 @@ import java.util.List;
 import java.util.Map;
 import java.util.Objects;
 import java.util.PriorityQueue;
+import java.util.Set;
 import java.util.concurrent.ScheduledExecutorService;
 import java.util.concurrent.ScheduledThreadPoolExecutor;
 import java.util.concurrent.TimeUnit;
@@ -55,6 +56,7 @@ import lombok.extern.slf4j.Slf4j;
 public class TaskScheduleService {
 
     private static final String BALANCE_SHARD_KEY = "BALANCE_SHARD_KEY";
+    private static final String SPLIT_OPERATION = "split";
     private static final String KEY_ENABLE_AUTO_BALANCE = "key/ENABLE_AUTO_BALANCE";
     // The dynamic balancing can only be carried out after the machine is offline for 30 minutes
     private final long TurnOffAndBalanceInterval = 30 * 60 * 1000;
@@ -71,6 +73,8 @@ public class TaskScheduleService {
     private LogService logService;
     private long lastStoreTurnoffTime = 0;
     private long lastBalanceLeaderTime = 0;
+    // partition id -> the last time it was scheduled by load
+    private final Map<Integer, Long> loadBalanceTimes = new HashMap<>();
 
 
     /**
@@ -143,6 +147,36 @@ public class TaskScheduleService {
                     }
                 }, 2, 30,
                 TimeUnit.SECONDS);
+        int flushInterval = pdConfig.getStore().getHeartbeatFlushInterval();
+        executor.scheduleWithFixedDelay(() -> {
+            try {
+                if (isLeader()) {
+                    storeService.flushHeartbeats();
+                    partitionService.flushPartitionStats();
+                }
+            } catch (Throwable e) {
+                log.error("flush heartbeats exception: ", e);
+            }
+        }, flushInterval, flushInterval, TimeUnit.SECONDS);
+        int loadBalanceInterval = pdConfig.getPartition().getLoadBalanceInterval();
+        executor.scheduleWithFixedDelay(() -> {
+            try {
+                if (isLeader() && pdConfig.getPartition().isLoadBalanceEnabled()) {
+                    balancePartitionLoad();
+                }
+            } catch (Throwable e) {
+                log.error("balancePartitionLoad exception: ", e);
+            }
+        }, loadBalanceInterval, loadBalanceInterval, TimeUnit.SECONDS);
+        executor.scheduleWithFixedDelay(() -> {
+            try {
+                if (isLeader()) {
+                    splitNextPartition();
+                }
+            } catch (Throwable e) {
+                log.error("splitNextPartition exception: ", e);
+            }
+        }, 10, 10, TimeUnit.SECONDS);
         // clean expired monitor data each 10 minutes, delay 3min.
         if (isLeader() && this.pdConfig.getStore().isMonitorDataEnabled()) {
             executor.scheduleAtFixedRate(() -> {
@@ -239,7 +273,7 @@ public class TaskScheduleService {
 
         // If the number of replicas is inconsistent, reallocate replicas
         for (Metapb.ShardGroup group : storeService.getShardGroups()) {
-            if (group.getShardsCount() != pdConfig.getPartition().getShardCount()) {
+            if (storeService.isShardCountChanged(group)) {
                 storeService.reallocShards(group);
                 kvService.put(BALANCE_SHARD_KEY, "DOING", 180 * 1000);
             }
@@ -282,7 +316,8 @@ public class TaskScheduleService {
             return null;
         }
 
-        int activeStores = storeService.getActiveStores().size();
+        // Learner stores only host the learner replicas, they take no part in the balance
+        int activeStores = storeService.getActiveVoterStores().size();
         if (activeStores == 0) {
             log.warn("balancePartitionShard non active stores, skip to balancePartitionShard");
             return null;
@@ -302,11 +337,13 @@ public class TaskScheduleService {
 
         // Count the partitions on each store, StoreId -> PartitionID, ShardRole
         Map<Long, Map<Integer, Metapb.ShardRole>> partitionMap = new HashMap<>();
-        storeService.getActiveStores().forEach(store -> {
+        storeService.getActiveVoterStores().forEach(store -> {
             partitionMap.put(store.getId(), new HashMap<>());
         });
+        Set<Long> learnerStoreIds = storeService.getLearnerStoreIds();
 
         // If it says “leaner,” it means the migration is in progress. Don't submit the task again.
+        // The learners on the learner stores are permanent and do not count.
         AtomicReference<Boolean> isLeaner = new AtomicReference<>(false);
         partitionService.getPartitions().forEach(partition -> {
 
@@ -314,7 +351,8 @@ public class TaskScheduleService {
                 storeService.getShardList(partition.getId()).forEach(shard -> {
                     Long storeId = shard.getStoreId();
                     // Determine whether each shard is leaner or in an abnormal state.
-                    if (shard.getRole() == Metapb.ShardRole.Learner
+                    if ((shard.getRole() == Metapb.ShardRole.Learner &&
+                         !learnerStoreIds.contains(storeId))
                         || partition.getState() != Metapb.PartitionState.PState_Normal) {
                         isLeaner.set(true);
                     }
@@ -484,11 +522,14 @@ public class TaskScheduleService {
 
         Map<Long, Integer> storeShardCount = new HashMap<>();
 
+        // Learners could not be the leader
         shardGroups.forEach(group -> {
-            group.getShardsList().forEach(shard -> {
-                storeShardCount.put(shard.getStoreId(),
-                                    storeShardCount.getOrDefault(shard.getStoreId(), 0) + 1);
-            });
+            group.getShardsList().stream()
+                 .filter(shard -> shard.getRole() != Metapb.ShardRole.Learner)
+                 .forEach(shard -> {
+                     storeShardCount.put(shard.getStoreId(),
+                                         storeShardCount.getOrDefault(shard.getStoreId(), 0) + 1);
+                 });
         });
 
         log.info("balancePartitionLeader, shard group size: {}, by store: {}", shardGroups.size(),
@@ -566,6 +607,190 @@ public class TaskScheduleService {
         return results;
     }
 
+    /**
+     * Balance the read/write load reported by partition heartbeats instead of the counts.
+     * For each hot store, its hottest leader partitions are handled in turn:
+     * 1. a partition that is hot on its own is queued to split, and the round stops there
+     * 2. the leader is transferred to the coolest replica, which moves the reads
+     * 3. otherwise the shard is moved to the coolest store without a replica
+     * At most load-balance-max-operations per round, and a partition is not scheduled
+     * again within load-balance-cooldown.
+     *
+     * @return partition id -> the operation
+     */
+    public synchronized Map<Integer, String> balancePartitionLoad() throws PDException {
+        Map<Integer, String> results = new HashMap<>();
+        if (!isLeader()) {
+            return results;
+        }
+
+        var taskMeta = storeService.getTaskInfoMeta();
+        if (taskMeta.hasSplitTaskDoing() || taskMeta.hasMoveTaskDoing() ||
+            !taskMeta.getPendingSplits().isEmpty() ||
+            Objects.equals(kvService.get(BALANCE_SHARD_KEY), "DOING")) {
+            log.info("balancePartitionLoad, split, move or balance task is processing, skip");
+            return results;
+        }
+
+        var loads = partitionService.getLoadService().getLoads();
+        List<Metapb.Store> stores = storeService.getActiveVoterStores();
+        if (loads.isEmpty() || stores.size() < 2) {
+            return results;
+        }
+
+        // Reads go to the leader, writes are applied on every replica
+        Map<Long, Double> storeLoads = new HashMap<>();
+        stores.forEach(store -> storeLoads.put(store.getId(), 0.0));
+        Map<Integer, Metapb.ShardGroup> groups = new HashMap<>();
+        for (Metapb.ShardGroup group : storeService.getShardGroups()) {
+            groups.put(group.getId(), group);
+            var load = loads.get(group.getId());
+            if (load == null) {
+                continue;
+            }
+            for (Metapb.Shard shard : group.getShardsList()) {
+                double score = shard.getRole() == Metapb.ShardRole.Leader ?
+                               load.getScore() : load.getWriteScore();
+                storeLoads.computeIfPresent(shard.getStoreId(), (id, v) -> v + score);
+            }
+        }
+
+        var config = pdConfig.getPartition();
+        double average = storeLoads.values().stream().mapToDouble(Double::doubleValue).sum() /
+                         storeLoads.size();
+        double hotThreshold = average * (1 + config.getLoadBalanceTolerance());
+        double averagePartition = loads.values().stream()
+                                       .mapToDouble(PartitionLoadService.Load::getScore)
+                                       .average().orElse(0);
+        if (average <= 0) {
+            return results;
+        }
+        log.info("balancePartitionLoad, store loads: {}, hot threshold: {}", storeLoads,
+                 hotThreshold);
+
+        long now = System.currentTimeMillis();
+        long cooldown = config.getLoadBalanceCooldown() * 1000L;
+        loadBalanceTimes.values().removeIf(time -> now - time > cooldown);
+
+        List<Long> hotStores = storeLoads.entrySet().stream()
+                                         .filter(e -> e.getValue() > hotThreshold)
+                                         .sorted(Map.Entry.<Long, Double>comparingByValue()
+                                                          .reversed())
+                                         .map(Map.Entry::getKey)
+                                         .collect(Collectors.toList());
+
+        hotStores:
+        for (Long hotStore : hotStores) {
+            // The leader partitions of the hot store, hottest first
+            List<PartitionLoadService.Load> candidates =
+                    loads.values().stream()
+                         .filter(load -> !loadBalanceTimes.containsKey(load.getPartitionId()))
+                         .filter(load -> groups.containsKey(load.getPartitionId()) &&
+                                         hotStore.equals(getLeaderStore(
+                                                 groups.get(load.getPartitionId()))))
+                         .sorted(Comparator.comparingDouble(PartitionLoadService.Load::getScore)
+                                           .reversed())
+                         .collect(Collectors.toList());
+
+            for (var load : candidates) {
+                if (results.size() >= config.getLoadBalanceMaxOperations() ||
+                    storeLoads.get(hotStore) <= hotThreshold) {
+                    break;
+                }
+                var group = groups.get(load.getPartitionId());
+                String operation = balanceHotPartition(group, load, hotStore, storeLoads,
+                                                       hotThreshold, averagePartition);
+                if (operation != null) {
+                    results.put(group.getId(), operation);
+                    loadBalanceTimes.put(group.getId(), now);
+                }
+                // The partitions change with the split, the loads are stale until reported again
+                if (SPLIT_OPERATION.equals(operation)) {
+                    break hotStores;
+                }
+            }
+        }
+
+        if (!results.isEmpty()) {
+            log.info("balancePartitionLoad, operations: {}", results);
+        }
+        return results;
+    }
+
+    private String balanceHotPartition(Metapb.ShardGroup group, PartitionLoadService.Load load,
+                                       long hotStore, Map<Long, Double> storeLoads,
+                                       double hotThreshold, double averagePartition) {
+        int splitFactor = pdConfig.getPartition().getHotSplitFactor();
+        if (splitFactor > 0 && load.getScore() >= averagePartition * splitFactor &&
+            queueHotSplit(group.getId())) {
+            return SPLIT_OPERATION;
+        }
+
+        // Moving the leader moves the reads of the partition
+        Metapb.Shard follower = null;
+        for (Metapb.Shard shard : group.getShardsList()) {
+            if (shard.getRole() != Metapb.ShardRole.Leader &&
+                storeLoads.containsKey(shard.getStoreId()) &&
+                (follower == null ||
+                 storeLoads.get(shard.getStoreId()) < storeLoads.get(follower.getStoreId()))) {
+                follower = shard;
+            }
+        }
+        if (follower != null &&
+            storeLoads.get(follower.getStoreId()) + load.getReadScore() <= hotThreshold) {
+            partitionService.transferLeader(group.getId(), follower);
+            storeLoads.merge(hotStore, -load.getReadScore(), Double::sum);
+            storeLoads.merge(follower.getStoreId(), load.getReadScore(), Double::sum);
+            return "transfer leader to " + follower.getStoreId();
+        }
+
+        // Moving the shard moves the reads and the writes
+        var shardStores = group.getShardsList().stream().map(Metapb.Shard::getStoreId)
+                               .collect(Collectors.toSet());
+        Long coolStore = storeLoads.entrySet().stream()
+                                   .filter(e -> !shardStores.contains(e.getKey()))
+                                   .min(Map.Entry.comparingByValue())
+                                   .map(Map.Entry::getKey).orElse(null);
+        if (coolStore != null && storeLoads.get(coolStore) + load.getScore() <= hotThreshold) {
+            partitionService.movePartitionsShard(group.getId(), hotStore, coolStore);
+            storeLoads.merge(hotStore, -load.getScore(), Double::sum);
+            storeLoads.merge(coolStore, load.getScore(), Double::sum);
+            return "move shard to " + coolStore;
+        }
+        return null;
+    }
+
+    /**
+     * Queue the split of a hot partition like the auto splits, so it never runs along with
+     * another split, and a new leader goes on with it
+     */
+    private boolean queueHotSplit(int groupId) {
+        try {
+            taskInfoMeta.addPendingSplit(groupId, 2);
+        } catch (PDException e) {
+            log.warn("balancePartitionLoad, split hot partition {} failed: {}",
+                     groupId, e.getMessage());
+            return false;
+        }
+        try {
+            splitNextPartition();
+        } catch (PDException e) {
+            // Started by the next schedule of the pending splits
+            log.warn("balancePartitionLoad, start split of partition {} failed: {}",
+                     groupId, e.getMessage());
+        }
+        return true;
+    }
+
+    private Long getLeaderStore(Metapb.ShardGroup group) {
+        for (Metapb.Shard shard : group.getShardsList()) {
+            if (shard.getRole() == Metapb.ShardRole.Leader) {
+                return shard.getStoreId();
+            }
+        }
+        return null;
+    }
+
     private long getMaxIndexGap(Map<Integer, Map<Long, Long>> committedIndexMap, int partitionId) {
         long maxGap = Long.MAX_VALUE;
         if (committedIndexMap == null || !committedIndexMap.containsKey(partitionId)) {
@@ -611,6 +836,7 @@ public class TaskScheduleService {
      * execution conditions
      * The number of partitions per machine after the split is less than partition
      * .max-partitions-per-store
+     * The shard groups are split online one after another, see {@link #splitNextPartition()}
      *
      * @throws PDException
      */
@@ -629,13 +855,18 @@ public class TaskScheduleService {
             }
         }
 
+        if (!taskInfoMeta.getPendingSplits().isEmpty() || isSplitting()) {
+            throw new PDException(Pdpb.ErrorType.Split_Partition_Doing_VALUE,
+                                  "The data is splitting");
+        }
+
         //For TEST
         //   pdConfig.getPartition().setMaxShardsPerStore(pdConfig.getPartition()
         //   .getMaxShardsPerStore()*2);
 
         // The maximum split count that a compute cluster can support
         int splitCount = pdConfig.getPartition().getMaxShardsPerStore() *
-                         storeService.getActiveStores().size() /
+                         storeService.getActiveVoterStores().size() /
                          (storeService.getShardGroups().size() *
                           pdConfig.getPartition().getShardCount());
 
@@ -649,20 +880,51 @@ public class TaskScheduleService {
         // If the maximum number of partitions per store is not reached, it will be split
         log.info("Start to split partitions..., split count = {}", splitCount);
 
-        // Set the cluster status to Offline
-        storeService.updateClusterStatus(Metapb.ClusterState.Cluster_Offline);
+        // Split online group by group, the cluster keeps serving
         // Modify the default number of partitions
         // pdConfig.getConfigService().setPartitionCount(storeService.getShardGroups().size() *
         // splitCount);
 
-        var list = storeService.getShardGroups().stream()
-                               .map(shardGroup -> new KVPair<>(shardGroup.getId(), splitCount))
-                               .collect(Collectors.toList());
-        storeService.splitShardGroups(list);
+        // Queued in the raft backed meta, so a new leader goes on with them
+        for (var shardGroup : storeService.getShardGroups()) {
+            taskInfoMeta.addPendingSplit(shardGroup.getId(), splitCount);
+        }
+        splitNextPartition();
 
         return null;
     }
 
+    /**
+     * Start the split of the next pending shard group once no split task is running. Only the
+     * partitions of that group hand off data, the others are not affected.
+     *
+     * @throws PDException
+     */
+    public synchronized void splitNextPartition() throws PDException {
+        if (!isLeader()) {
+            return;
+        }
+        var pendingSplits = taskInfoMeta.getPendingSplits();
+        if (pendingSplits.isEmpty() || isSplitting()) {
+            return;
+        }
+        var split = pendingSplits.get(0);
+        // Dequeue first, a split that was started is never started again
+        taskInfoMeta.removePendingSplit(split.getKey());
+        log.info("split shard group {} into {}, {} groups pending", split.getKey(),
+                 split.getValue(), pendingSplits.size() - 1);
+        storeService.splitShardGroups(List.of(split));
+    }
+
+    private boolean isSplitting() throws PDException {
+        for (Metapb.Graph graph : partitionService.getGraphs()) {
+            if (!storeService.getTaskInfoMeta().scanSplitTask(graph.getGraphName()).isEmpty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * Store reports the status of the task
      * The state of the partition changes, and the state of the ShardGroup, graph, and the entire
@@ -675,6 +937,7 @@ public class TaskScheduleService {
             switch (task.getType()) {
                 case Split_Partition:
                     partitionService.handleSplitTask(task);
+                    splitNextPartition();
                     break;
                 case Move_Partition:
                     partitionService.handleMoveTask(task);
@@ -734,7 +997,12 @@ public class TaskScheduleService {
         // Record the amount of data in the partition to be migrated
         Map<Integer, Long> partitionDataSize = new HashMap<>();
 
+        // The replicas of a learner store only move to other learner stores, and vice versa
+        boolean learnerSource = StoreNodeService.isLearnerStore(sourceStore);
         storeService.getActiveStores().forEach(store -> {
+            if (StoreNodeService.isLearnerStore(store) != learnerSource) {
+                return;
+            }
             if (store.getId() != sourceStore.getId()) {
                 otherPartitionMap.put(store.getId(), new HashMap<>());
                 // Records the remaining disk space of other stores, in bytes
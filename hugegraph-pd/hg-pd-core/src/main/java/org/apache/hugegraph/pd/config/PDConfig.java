@@ -172,6 +172,9 @@ public class PDConfig {
         private long keepAliveTimeout = 300;
         @Value("${store.max-down-time:1800}")
         private long maxDownTime = 1800;
+        // Interval of persisting the heartbeat stats of stores and partitions, in seconds
+        @Value("${store.heartbeat-flush-interval:10}")
+        private int heartbeatFlushInterval = 10;
 
         @Value("${store.monitor_data_enabled:false}")
         private boolean monitorDataEnabled = false;
@@ -266,6 +269,35 @@ public class PDConfig {
         @Value("${partition.default-shard-count:3}")
         private int shardCount = 3;
 
+        // Learner replicas per partition, placed on the stores labeled as learner stores
+        @Value("${partition.learner-count:0}")
+        private int learnerCount = 0;
+
+        // Load-aware scheduling of the partitions reporting hot reads/writes
+        @Value("${partition.load-balance-enabled:false}")
+        private boolean loadBalanceEnabled = false;
+
+        // Interval of load balancing, in seconds
+        @Value("${partition.load-balance-interval:60}")
+        private int loadBalanceInterval = 60;
+
+        // A store whose load exceeds the average by this ratio is hot
+        @Value("${partition.load-balance-tolerance:0.3}")
+        private double loadBalanceTolerance = 0.3;
+
+        // Maximum leader transfers, shard moves and splits per round
+        @Value("${partition.load-balance-max-operations:2}")
+        private int loadBalanceMaxOperations = 2;
+
+        // A partition is not scheduled again within this period, in seconds
+        @Value("${partition.load-balance-cooldown:600}")
+        private int loadBalanceCooldown = 600;
+
+        // A partition whose load reaches this times the average partition load is split,
+        // 0 means never
+        @Value("${partition.hot-split-factor:8}")
+        private int hotSplitFactor = 8;
+
         public int getTotalCount() {
             if (totalCount == 0) {
                 totalCount = getInitialPartitionCount();
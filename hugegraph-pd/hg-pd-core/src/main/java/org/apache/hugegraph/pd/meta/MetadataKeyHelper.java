@@ -39,6 +39,7 @@ public class MetadataKeyHelper {
     private static final String GRAPH_SPACE = "GRAPH_SPACE";
     private static final String PD_CONFIG = "PD_CONFIG";
     private static final String TASK_SPLIT = "TASK_SPLIT";
+    private static final String TASK_SPLIT_PENDING = "TASK_SPLIT_PENDING";
     private static final String TASK_MOVE = "TASK_MOVE";
     private static final String TASK_BUILD_INDEX = "TASK_BI";
     private static final String LOG_RECORD = "LOG_RECORD";
@@ -256,6 +257,21 @@ public class MetadataKeyHelper {
         return builder.toString().getBytes(Charset.defaultCharset());
     }
 
+    public static byte[] getPendingSplitKey(int groupId) {
+        // TASK_SPLIT_PENDING/{groupId}
+        StringBuilder builder = StringBuilderHelper.get()
+                                                   .append(TASK_SPLIT_PENDING).append(DELIMITER)
+                                                   .append(groupId);
+        return builder.toString().getBytes(Charset.defaultCharset());
+    }
+
+    public static byte[] getPendingSplitPrefix() {
+        // TASK_SPLIT_PENDING/
+        StringBuilder builder = StringBuilderHelper.get()
+                                                   .append(TASK_SPLIT_PENDING).append(DELIMITER);
+        return builder.toString().getBytes(Charset.defaultCharset());
+    }
+
     public static byte[] getMoveTaskKey(String graphName, int targetGroupId, int groupId) {
         // TASK_MOVE/{GraphName}/to PartitionID/{source partitionID}
         StringBuilder builder = StringBuilderHelper.get()
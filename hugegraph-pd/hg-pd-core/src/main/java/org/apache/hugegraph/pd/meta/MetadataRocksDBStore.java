@@ -80,6 +80,15 @@ public class MetadataRocksDBStore extends MetadataStoreBase {
         }
     }
 
+    @Override
+    public void putBatch(List<byte[]> keys, List<byte[]> values) throws PDException {
+        try {
+            getStore().putBatch(keys, values);
+        } catch (Exception e) {
+            throw new PDException(Pdpb.ErrorType.ROCKSDB_WRITE_ERROR_VALUE, e);
+        }
+    }
+
     @Override
     public void putWithTTL(byte[] key, byte[] value, long ttl) throws PDException {
         this.store.putWithTTL(key, value, ttl);
@@ -38,6 +38,11 @@ public abstract class MetadataStoreBase {
 
     public abstract void put(byte[] key, byte[] value) throws PDException;
 
+    /**
+     * Put all the keys in one write, replicated as a single raft log entry
+     */
+    public abstract void putBatch(List<byte[]> keys, List<byte[]> values) throws PDException;
+
     /**
      * A put with an expiration time
      */
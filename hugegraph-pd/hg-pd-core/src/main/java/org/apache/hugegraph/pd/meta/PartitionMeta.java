@@ -19,8 +19,13 @@ package org.apache.hugegraph.pd.meta;
 
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+import java.util.concurrent.ConcurrentHashMap;
 
 import org.apache.commons.collections4.CollectionUtils;
+import org.apache.commons.lang3.StringUtils;
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.common.PDRuntimeException;
 import org.apache.hugegraph.pd.common.PartitionCache;
@@ -39,6 +44,9 @@ public class PartitionMeta extends MetadataRocksDBStore {
     public static final int CID_GRAPH_ID_MAX = 0xFFFE;
     private PDConfig pdConfig;
     private PartitionCache cache;
+    // Latest partition stats from the heartbeats, only the dirty ones get persisted
+    private final Map<Integer, Metapb.PartitionStats> partitionStats = new ConcurrentHashMap<>();
+    private final Set<Integer> dirtyStats = ConcurrentHashMap.newKeySet();
 
     public PartitionMeta(PDConfig pdConfig) {
         super(pdConfig);
@@ -164,16 +172,28 @@ public class PartitionMeta extends MetadataRocksDBStore {
     }
 
     /**
-     * Save the partition information
+     * Save the partition information, the version is bumped whenever the range or state
+     * changes, so that clients can tell stale routes from new ones
      *
      * @param partition
-     * @return
+     * @return the partition saved, with its new version
      * @throws PDException
      */
     public Metapb.Partition updatePartition(Metapb.Partition partition) throws PDException {
         if (!cache.hasGraph(partition.getGraphName())) {
             getAndCreateGraph(partition.getGraphName());
         }
+        var pair = cache.getPartitionById(partition.getGraphName(), partition.getId());
+        if (pair != null) {
+            Metapb.Partition old = pair.getKey();
+            long version = Math.max(old.getVersion(), partition.getVersion());
+            if (old.getStartKey() != partition.getStartKey() ||
+                old.getEndKey() != partition.getEndKey() ||
+                old.getState() != partition.getState()) {
+                version++;
+            }
+            partition = partition.toBuilder().setVersion(version).build();
+        }
         byte[] key = MetadataKeyHelper.getPartitionKey(partition.getGraphName(), partition.getId());
         put(key, partition.toByteString().toByteArray());
         cache.updatePartition(partition);
@@ -220,17 +240,63 @@ public class PartitionMeta extends MetadataRocksDBStore {
         return remove(key);
     }
 
-    public void updatePartitionStats(Metapb.PartitionStats stats) throws PDException {
-        // for (String graphName : stats.getGraphNameList()) {
-        byte[] prefix = MetadataKeyHelper.getPartitionStatusKey("", stats.getId());
-        put(prefix, stats.toByteArray());
-        // }
+    /**
+     * Keep the stats in memory, they are persisted by flushPartitionStats() when anything
+     * but the timestamp has changed
+     */
+    public void updatePartitionStats(Metapb.PartitionStats stats) {
+        Metapb.PartitionStats last = partitionStats.put(stats.getId(), stats);
+        if (last == null || !last.toBuilder().setTimestamp(stats.getTimestamp()).build()
+                                 .equals(stats)) {
+            dirtyStats.add(stats.getId());
+        }
+    }
+
+    /**
+     * Persist the changed partition stats in one batch
+     *
+     * @return the number of stats persisted
+     */
+    public int flushPartitionStats() throws PDException {
+        if (dirtyStats.isEmpty()) {
+            return 0;
+        }
+        List<Integer> ids = new ArrayList<>(dirtyStats);
+        List<byte[]> keys = new ArrayList<>(ids.size());
+        List<byte[]> values = new ArrayList<>(ids.size());
+        for (Integer id : ids) {
+            dirtyStats.remove(id);
+            Metapb.PartitionStats stats = partitionStats.get(id);
+            if (stats != null) {
+                keys.add(MetadataKeyHelper.getPartitionStatusKey("", id));
+                values.add(stats.toByteArray());
+            }
+        }
+        try {
+            putBatch(keys, values);
+        } catch (PDException e) {
+            dirtyStats.addAll(ids);
+            throw e;
+        }
+        return keys.size();
+    }
+
+    /**
+     * Drop the stats kept in memory, they may be stale after a leader change
+     */
+    public void clearPartitionStats() {
+        partitionStats.clear();
+        dirtyStats.clear();
     }
 
     /**
      * Get the partition status
      */
     public Metapb.PartitionStats getPartitionStats(String graphName, int id) throws PDException {
+        Metapb.PartitionStats stats = partitionStats.get(id);
+        if (stats != null) {
+            return stats;
+        }
         byte[] prefix = MetadataKeyHelper.getPartitionStatusKey(graphName, id);
         return getOne(Metapb.PartitionStats.parser(), prefix);
     }
@@ -240,7 +306,14 @@ public class PartitionMeta extends MetadataRocksDBStore {
      */
     public List<Metapb.PartitionStats> getPartitionStats(String graphName) throws PDException {
         byte[] prefix = MetadataKeyHelper.getPartitionStatusPrefixKey(graphName);
-        return scanPrefix(Metapb.PartitionStats.parser(), prefix);
+        List<Metapb.PartitionStats> stored = scanPrefix(Metapb.PartitionStats.parser(), prefix);
+        if (!StringUtils.isEmpty(graphName)) {
+            return stored;
+        }
+        Map<Integer, Metapb.PartitionStats> merged = new TreeMap<>();
+        stored.forEach(stats -> merged.put(stats.getId(), stats));
+        merged.putAll(partitionStats);
+        return new ArrayList<>(merged.values());
     }
 
     /**
@@ -297,6 +370,10 @@ public class PartitionMeta extends MetadataRocksDBStore {
     }
 
     public long removePartitionStats(String graphName) throws PDException {
+        if (StringUtils.isEmpty(graphName)) {
+            partitionStats.clear();
+            dirtyStats.clear();
+        }
         byte[] prefix = MetadataKeyHelper.getPartitionStatusPrefixKey(graphName);
         return removeByPrefix(prefix);
     }
@@ -17,9 +17,13 @@
 
 package org.apache.hugegraph.pd.meta;
 
+import java.util.ArrayList;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.ListIterator;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
 
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.config.PDConfig;
@@ -34,6 +38,11 @@ import lombok.extern.slf4j.Slf4j;
 public class StoreInfoMeta extends MetadataRocksDBStore {
 
     private PDConfig pdConfig;
+    // Latest store state from the heartbeats, only the dirty ones get persisted
+    private final Map<Long, Metapb.Store> liveStores = new ConcurrentHashMap<>();
+    private final Set<Long> dirtyStores = ConcurrentHashMap.newKeySet();
+    // store id -> the last time the keep-alive ttl was renewed
+    private final Map<Long, Long> aliveTimes = new ConcurrentHashMap<>();
 
     public StoreInfoMeta(PDConfig pdConfig) {
         super(pdConfig);
@@ -63,27 +72,105 @@ public class StoreInfoMeta extends MetadataRocksDBStore {
     public void updateStore(Metapb.Store store) throws PDException {
         byte[] storeInfoKey = MetadataKeyHelper.getStoreInfoKey(store.getId());
         put(storeInfoKey, store.toByteArray());
+        liveStores.remove(store.getId());
     }
 
     /**
-     * Update the survivability status of the store
+     * Keep the heartbeat of the store in memory, it is persisted by flushHeartbeats() when
+     * anything but the heartbeat time has changed
+     *
+     * @param store
+     */
+    public void updateStoreHeartbeat(Metapb.Store store) {
+        Metapb.Store last = liveStores.put(store.getId(), store);
+        if (last == null ||
+            !last.toBuilder().setLastHeartbeat(store.getLastHeartbeat()).build().equals(store)) {
+            dirtyStores.add(store.getId());
+        }
+    }
+
+    /**
+     * Persist the changed heartbeats, the store and its stats, in one batch
+     *
+     * @return the number of stores persisted
+     */
+    public int flushHeartbeats() throws PDException {
+        if (dirtyStores.isEmpty()) {
+            return 0;
+        }
+        List<Long> ids = new ArrayList<>(dirtyStores);
+        List<byte[]> keys = new ArrayList<>(ids.size() * 2);
+        List<byte[]> values = new ArrayList<>(ids.size() * 2);
+        for (Long id : ids) {
+            dirtyStores.remove(id);
+            Metapb.Store store = liveStores.get(id);
+            if (store != null) {
+                keys.add(MetadataKeyHelper.getStoreInfoKey(id));
+                values.add(store.toByteArray());
+                keys.add(MetadataKeyHelper.getStoreStatusKey(id));
+                values.add(store.getStats().toByteArray());
+            }
+        }
+        try {
+            putBatch(keys, values);
+        } catch (PDException e) {
+            dirtyStores.addAll(ids);
+            throw e;
+        }
+        return keys.size() / 2;
+    }
+
+    /**
+     * Drop the heartbeats kept in memory, they may be stale after a leader change
+     */
+    public void clearHeartbeats() {
+        liveStores.clear();
+        dirtyStores.clear();
+        aliveTimes.clear();
+    }
+
+    /**
+     * Update the survivability status of the store. The ttl is renewed once a third of the
+     * keep-alive timeout, the heartbeats in between stay in memory
      *
      * @param store
      */
     public void keepStoreAlive(Metapb.Store store) throws PDException {
+        long timeout = pdConfig.getStore().getKeepAliveTimeout();
+        long now = System.currentTimeMillis();
+        Long last = aliveTimes.get(store.getId());
+        if (last != null && now - last < timeout * 1000 / 3) {
+            return;
+        }
         byte[] activeStoreKey = MetadataKeyHelper.getActiveStoreKey(store.getId());
-        putWithTTL(activeStoreKey, store.toByteArray(), pdConfig.getStore().getKeepAliveTimeout());
+        putWithTTL(activeStoreKey, store.toByteArray(), timeout);
+        aliveTimes.put(store.getId(), now);
     }
 
     public void removeActiveStore(Metapb.Store store) throws PDException {
         byte[] activeStoreKey = MetadataKeyHelper.getActiveStoreKey(store.getId());
         removeWithTTL(activeStoreKey);
+        aliveTimes.remove(store.getId());
     }
 
     public Metapb.Store getStore(Long storeId) throws PDException {
+        Metapb.Store store = liveStores.get(storeId);
+        if (store != null) {
+            return store;
+        }
         byte[] storeInfoKey = MetadataKeyHelper.getStoreInfoKey(storeId);
-        Metapb.Store store = getOne(Metapb.Store.parser(), storeInfoKey);
-        return store;
+        return getOne(Metapb.Store.parser(), storeInfoKey);
+    }
+
+    private List<Metapb.Store> withHeartbeats(List<Metapb.Store> stores) {
+        if (liveStores.isEmpty()) {
+            return stores;
+        }
+        List<Metapb.Store> list = new ArrayList<>(stores.size());
+        for (Metapb.Store store : stores) {
+            list.add(liveStores.getOrDefault(store.getId(), store));
+        }
+        return list;
     }
 
     /**
@@ -95,7 +182,7 @@ public class StoreInfoMeta extends MetadataRocksDBStore {
      */
     public List<Metapb.Store> getStores(String graphName) throws PDException {
         byte[] storePrefix = MetadataKeyHelper.getStorePrefix();
-        return scanPrefix(Metapb.Store.parser(), storePrefix);
+        return withHeartbeats(scanPrefix(Metapb.Store.parser(), storePrefix));
     }
 
     /**
@@ -107,16 +194,16 @@ public class StoreInfoMeta extends MetadataRocksDBStore {
      */
     public List<Metapb.Store> getActiveStores(String graphName) throws PDException {
         byte[] activePrefix = MetadataKeyHelper.getActiveStorePrefix();
-        List listWithTTL = getInstanceListWithTTL(Metapb.Store.parser(),
-                                                  activePrefix);
-        return listWithTTL;
+        List<Metapb.Store> listWithTTL = getInstanceListWithTTL(Metapb.Store.parser(),
+                                                                activePrefix);
+        return withHeartbeats(listWithTTL);
     }
 
     public List<Metapb.Store> getActiveStores() throws PDException {
         byte[] activePrefix = MetadataKeyHelper.getActiveStorePrefix();
-        List listWithTTL = getInstanceListWithTTL(Metapb.Store.parser(),
-                                                  activePrefix);
-        return listWithTTL;
+        List<Metapb.Store> listWithTTL = getInstanceListWithTTL(Metapb.Store.parser(),
+                                                                activePrefix);
+        return withHeartbeats(listWithTTL);
     }
 
     /**
@@ -143,11 +230,14 @@ public class StoreInfoMeta extends MetadataRocksDBStore {
     }
 
     public long removeStore(long storeId) throws PDException {
+        liveStores.remove(storeId);
+        dirtyStores.remove(storeId);
         byte[] storeInfoKey = MetadataKeyHelper.getStoreInfoKey(storeId);
         return remove(storeInfoKey);
     }
 
     public long removeAll() throws PDException {
+        clearHeartbeats();
         byte[] storePrefix = MetadataKeyHelper.getStorePrefix();
         return this.removeByPrefix(storePrefix);
     }
@@ -178,6 +268,10 @@ public class StoreInfoMeta extends MetadataRocksDBStore {
     }
 
     public Metapb.StoreStats getStoreStats(long storeId) throws PDException {
+        Metapb.Store store = liveStores.get(storeId);
+        if (store != null && store.hasStats()) {
+            return store.getStats();
+        }
         byte[] storeStatusKey = MetadataKeyHelper.getStoreStatusKey(storeId);
         Metapb.StoreStats stats = getOne(Metapb.StoreStats.parser(),
                                          storeStatusKey);
@@ -17,14 +17,18 @@
 
 package org.apache.hugegraph.pd.meta;
 
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
 import java.util.List;
 
+import org.apache.hugegraph.pd.common.KVPair;
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.config.PDConfig;
 import org.apache.hugegraph.pd.grpc.MetaTask;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.pulse.MovePartition;
 import org.apache.hugegraph.pd.grpc.pulse.SplitPartition;
+import org.apache.hugegraph.pd.store.KV;
 
 /**
  * Task management
@@ -77,6 +81,32 @@ public class TaskInfoMeta extends MetadataRocksDBStore {
         return scanPrefix(key).size() > 0;
     }
 
+    /**
+     * Queue a shard group to be split into splitCount partitions, the auto split runs the
+     * queued groups one at a time
+     */
+    public void addPendingSplit(int groupId, int splitCount) throws PDException {
+        byte[] value = ByteBuffer.allocate(Integer.BYTES * 2)
+                                 .putInt(groupId).putInt(splitCount).array();
+        put(MetadataKeyHelper.getPendingSplitKey(groupId), value);
+    }
+
+    /**
+     * @return shard group id -> split count
+     */
+    public List<KVPair<Integer, Integer>> getPendingSplits() throws PDException {
+        List<KVPair<Integer, Integer>> splits = new ArrayList<>();
+        for (KV kv : scanPrefix(MetadataKeyHelper.getPendingSplitPrefix())) {
+            ByteBuffer buf = ByteBuffer.wrap(kv.getValue());
+            splits.add(new KVPair<>(buf.getInt(), buf.getInt()));
+        }
+        return splits;
+    }
+
+    public void removePendingSplit(int groupId) throws PDException {
+        remove(MetadataKeyHelper.getPendingSplitKey(groupId));
+    }
+
     public void addMovePartitionTask(Metapb.Partition partition, MovePartition movePartition)
             throws PDException {
         byte[] key = MetadataKeyHelper.getMoveTaskKey(partition.getGraphName(),
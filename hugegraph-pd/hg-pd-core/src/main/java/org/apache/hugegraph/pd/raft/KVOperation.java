@@ -20,6 +20,9 @@ package org.apache.hugegraph.pd.raft;
 import java.io.ByteArrayInputStream;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
+import java.io.Serializable;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.TimeUnit;
 
 import com.alipay.sofa.jraft.util.BytesUtil;
@@ -49,6 +52,10 @@ public class KVOperation {
     public static final byte CLEAR = 0x07;
     public static final byte PUT_WITH_TTL_UNIT = 0x08;
     public static final byte REMOVE_WITH_TTL = 0x09;
+    /**
+     * Put several keys in one write batch
+     */
+    public static final byte PUT_BATCH = 0x0A;
     /**
      * Snapshot operation
      */
@@ -103,6 +110,17 @@ public class KVOperation {
         return new KVOperation(key, value, null, PUT);
     }
 
+    /**
+     * Keys and values are carried in arg as a PutBatch, so the whole batch is one raft log
+     * entry
+     */
+    public static KVOperation createPutBatch(final List<byte[]> keys, final List<byte[]> values) {
+        Requires.requireNonNull(keys, "keys");
+        Requires.requireNonNull(values, "values");
+        Requires.requireTrue(keys.size() == values.size(), "keys and values size mismatch");
+        return new KVOperation(null, null, null, PUT_BATCH, new PutBatch(keys, values));
+    }
+
     public static KVOperation createGet(final byte[] key) {
         Requires.requireNonNull(key, "key");
         return new KVOperation(key, BytesUtil.EMPTY_BYTES, null, GET);
@@ -163,4 +181,23 @@ public class KVOperation {
             return bos.toByteArray();
         }
     }
+
+    /**
+     * The arg of PUT_BATCH, it must be allowed by HugegraphHessianSerializerFactory
+     */
+    @Data
+    public static class PutBatch implements Serializable {
+
+        private List<byte[]> keys;
+        private List<byte[]> values;
+
+        public PutBatch() {
+
+        }
+
+        public PutBatch(List<byte[]> keys, List<byte[]> values) {
+            this.keys = new ArrayList<>(keys);
+            this.values = new ArrayList<>(values);
+        }
+    }
 }
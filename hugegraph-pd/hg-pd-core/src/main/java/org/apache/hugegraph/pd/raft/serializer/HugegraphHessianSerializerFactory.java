@@ -114,6 +114,7 @@ public class HugegraphHessianSerializerFactory extends SerializerFactory {
     private void allowBusinessClasses() {
         addToWhitelist(
                 org.apache.hugegraph.pd.raft.KVOperation.class,
+                org.apache.hugegraph.pd.raft.KVOperation.PutBatch.class,
                 byte[].class
         );
     }
@@ -29,6 +29,8 @@ public interface HgKVStore {
 
     void put(byte[] key, byte[] value) throws PDException;
 
+    void putBatch(List<byte[]> keys, List<byte[]> values) throws PDException;
+
     byte[] get(byte[] key) throws PDException;
 
     List<KV> scanPrefix(byte[] prefix);
@@ -43,6 +43,8 @@ import org.rocksdb.RocksDB;
 import org.rocksdb.RocksDBException;
 import org.rocksdb.RocksIterator;
 import org.rocksdb.Slice;
+import org.rocksdb.WriteBatch;
+import org.rocksdb.WriteOptions;
 
 import com.alipay.sofa.jraft.util.Utils;
 import com.google.common.cache.CacheBuilder;
@@ -97,6 +99,23 @@ public class HgKVStoreImpl implements HgKVStore {
         }
     }
 
+    @Override
+    public void putBatch(List<byte[]> keys, List<byte[]> values) throws PDException {
+        final Lock readLock = this.readWriteLock.readLock();
+        readLock.lock();
+        try (WriteBatch batch = new WriteBatch();
+             WriteOptions options = new WriteOptions()) {
+            for (int i = 0; i < keys.size(); i++) {
+                batch.put(keys.get(i), values.get(i));
+            }
+            db.write(options, batch);
+        } catch (RocksDBException e) {
+            throw new PDException(Pdpb.ErrorType.ROCKSDB_WRITE_ERROR_VALUE, e);
+        } finally {
+            readLock.unlock();
+        }
+    }
+
     @Override
     public byte[] get(byte[] key) throws PDException {
         final Lock readLock = this.readWriteLock.readLock();
@@ -78,6 +78,19 @@ public class RaftKVStore implements HgKVStore, RaftTaskHandler {
         }
     }
 
+    @Override
+    public void putBatch(List<byte[]> keys, List<byte[]> values) throws PDException {
+        if (keys.isEmpty()) {
+            return;
+        }
+        KVOperation operation = KVOperation.createPutBatch(keys, values);
+        try {
+            applyOperation(operation).get();
+        } catch (Exception e) {
+            throw new PDException(Pdpb.ErrorType.UNKNOWN_VALUE, e.getMessage());
+        }
+    }
+
     /**
      * Queries can be read without rafting
      */
@@ -187,6 +200,10 @@ public class RaftKVStore implements HgKVStore, RaftTaskHandler {
         store.put(key, value);
     }
 
+    private void doPutBatch(List<byte[]> keys, List<byte[]> values) throws PDException {
+        this.store.putBatch(keys, values);
+    }
+
     public long doRemove(byte[] bytes) throws PDException {
         return this.store.remove(bytes);
     }
@@ -289,6 +306,10 @@ public class RaftKVStore implements HgKVStore, RaftTaskHandler {
             case KVOperation.PUT:
                 doPut(op.getKey(), op.getValue());
                 break;
+            case KVOperation.PUT_BATCH:
+                KVOperation.PutBatch batch = (KVOperation.PutBatch) op.getArg();
+                doPutBatch(batch.getKeys(), batch.getValues());
+                break;
             case KVOperation.REMOVE:
                 doRemove(op.getKey());
                 break;
@@ -94,6 +94,11 @@ public class TaskAPI extends API {
         return pdRestService.balancePartitionLeader();
     }
 
+    @GetMapping(value = "/balanceLoad")
+    public Map<Integer, String> balanceLoad() throws PDException {
+        return pdRestService.balancePartitionLoad();
+    }
+
     @GetMapping(value = "/compact")
     public String dbCompaction() throws PDException {
         pdRestService.dbCompaction();
@@ -265,6 +265,10 @@ public class PDRestService implements InitializingBean {
         return monitorService.balancePartitionLeader(true);
     }
 
+    public Map<Integer, String> balancePartitionLoad() throws PDException {
+        return monitorService.balancePartitionLoad();
+    }
+
     public void dbCompaction() throws PDException {
         monitorService.dbCompaction("");
     }
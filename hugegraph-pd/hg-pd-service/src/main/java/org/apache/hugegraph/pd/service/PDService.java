@@ -191,6 +191,7 @@ public class PDService extends PDGrpc.PDImplBase implements RaftStateListener {
         if (licenseVerifierService == null) {
             licenseVerifierService = new LicenseVerifierService(pdConfig);
         }
+        RaftEngine.getInstance().addStateListener(storeNodeService);
         RaftEngine.getInstance().addStateListener(partitionService);
         pdConfig.setIdService(idService);
 
@@ -280,8 +281,7 @@ public class PDService extends PDGrpc.PDImplBase implements RaftStateListener {
         partitionService.addStatusListener(new PartitionStatusListener() {
             @Override
             public void onPartitionChanged(Metapb.Partition old, Metapb.Partition partition) {
-                PDWatchSubject.notifyPartitionChange(ChangeType.ALTER,
-                                                     partition.getGraphName(), partition.getId());
+                PDWatchSubject.notifyPartitionChange(ChangeType.ALTER, partition);
             }
 
             @Override
@@ -78,6 +78,12 @@ public class PDWatchSubject implements StreamObserver<WatchRequest> {
 
     }
 
+    public static void notifyPartitionChange(ChangeType changeType, Metapb.Partition partition) {
+        ((PartitionChangeSubject) subjectHolder.get(WatchType.WATCH_TYPE_PARTITION_CHANGE.name()))
+                .notifyWatcher(changeType.getGrpcType(), partition.getGraphName(),
+                               partition.getId(), partition);
+    }
+
     public static void notifyShardGroupChange(ChangeType changeType, int groupId,
                                               Metapb.ShardGroup group) {
         ((ShardGroupChangeSubject) subjectHolder.get(
@@ -22,7 +22,9 @@ import static org.apache.hugegraph.pd.common.HgAssert.isArgumentValid;
 
 import javax.annotation.concurrent.ThreadSafe;
 
+import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.watch.WatchChangeType;
+import org.apache.hugegraph.pd.grpc.watch.WatchPartitionResponse;
 import org.apache.hugegraph.pd.grpc.watch.WatchResponse;
 import org.apache.hugegraph.pd.grpc.watch.WatchType;
 
@@ -42,22 +44,35 @@ final class PartitionChangeSubject extends AbstractWatchSubject {
         return sb.append("graph:").append(res.getPartitionResponse().getGraph())
                  .append(",")
                  .append("partitionId:").append(res.getPartitionResponse().getPartitionId())
+                 .append(",")
+                 .append("version:")
+                 .append(res.getPartitionResponse().getPartition().getVersion())
                  .toString();
     }
 
     public void notifyWatcher(WatchChangeType changeType, String graph, int partitionId) {
+        notifyWatcher(changeType, graph, partitionId, null);
+    }
+
+    /**
+     * Notify the change with the new partition, so that watchers can apply the delta to
+     * their route table directly rather than reloading it from pd.
+     */
+    public void notifyWatcher(WatchChangeType changeType, String graph, int partitionId,
+                              Metapb.Partition partition) {
         isArgumentNotNull(changeType, "changeType");
         isArgumentValid(graph, "graph");
 
         super.notifyWatcher(builder -> {
-            builder.setPartitionResponse(
+            WatchPartitionResponse.Builder response =
                     builder.getPartitionResponseBuilder().clear()
                            .setGraph(graph)
                            .setPartitionId(partitionId)
-                           .setChangeType(changeType)
-                           .build()
-            );
-
+                           .setChangeType(changeType);
+            if (partition != null) {
+                response.setPartition(partition);
+            }
+            builder.setPartitionResponse(response.build());
         });
     }
 
@@ -30,6 +30,7 @@ import lombok.extern.slf4j.Slf4j;
 @Suite.SuiteClasses({
         PartitionUtilsTest.class,
         PartitionCacheTest.class,
+        GraphCacheTest.class,
         MetadataKeyHelperTest.class,
         KvServiceTest.class,
         HgAssertTest.class,
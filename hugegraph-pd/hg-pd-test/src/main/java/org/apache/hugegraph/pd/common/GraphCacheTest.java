@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.pd.common;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.junit.Before;
+import org.junit.Test;
+
+public class GraphCacheTest {
+
+    private GraphCache cache;
+
+    private static Metapb.Partition createPartition(int pid, long start, long end,
+                                                    long version) {
+        return Metapb.Partition.newBuilder()
+                               .setId(pid)
+                               .setGraphName("graph0")
+                               .setStartKey(start)
+                               .setEndKey(end)
+                               .setState(Metapb.PartitionState.PState_Normal)
+                               .setVersion(version)
+                               .build();
+    }
+
+    @Before
+    public void setup() {
+        cache = new GraphCache(Metapb.Graph.newBuilder().setGraphName("graph0").build());
+    }
+
+    @Test
+    public void testUpdatePartitionByVersion() {
+        assertTrue(cache.updatePartition(createPartition(1, 0, 100, 1)));
+        // unchanged
+        assertFalse(cache.updatePartition(createPartition(1, 0, 100, 1)));
+
+        // split, the new half arrives first
+        assertTrue(cache.updatePartition(createPartition(1, 0, 50, 2)));
+        assertTrue(cache.updatePartition(createPartition(2, 50, 100, 1)));
+        assertEquals(2, (int) cache.getRange().get(60L));
+
+        // the stale route is ignored
+        assertFalse(cache.updatePartition(createPartition(1, 0, 100, 1)));
+        assertEquals(50, cache.getPartition(1).getEndKey());
+        assertEquals(1, (int) cache.getRange().get(10L));
+        assertEquals(2, (int) cache.getRange().get(60L));
+    }
+
+    @Test
+    public void testRouteSnapshot() {
+        cache.updatePartition(createPartition(1, 0, 50, 1));
+        cache.updatePartition(createPartition(2, 50, 100, 1));
+        RouteSnapshot snapshot = cache.getRouteSnapshot();
+        assertEquals(2, snapshot.size());
+        assertEquals(1, snapshot.getPartitionId(0));
+        assertEquals(1, snapshot.getPartitionId(49));
+        assertEquals(2, snapshot.getPartitionId(50));
+        assertEquals(-1, snapshot.getPartitionId(100));
+
+        // the snapshot is immutable, a change builds a new one
+        cache.updatePartition(createPartition(1, 0, 20, 2));
+        assertEquals(1, snapshot.getPartitionId(30));
+        assertEquals(-1, cache.getRouteSnapshot().getPartitionId(30));
+    }
+}
@@ -18,6 +18,7 @@
 package org.apache.hugegraph.pd.core;
 
 import org.apache.hugegraph.pd.core.meta.MetadataKeyHelperTest;
+import org.apache.hugegraph.pd.core.raft.KVOperationTest;
 import org.apache.hugegraph.pd.core.store.HgKVStoreImplTest;
 import org.junit.runner.RunWith;
 import org.junit.runners.Suite;
@@ -28,11 +29,13 @@ import lombok.extern.slf4j.Slf4j;
 @Suite.SuiteClasses({
         MetadataKeyHelperTest.class,
         HgKVStoreImplTest.class,
+        KVOperationTest.class,
         ConfigServiceTest.class,
         IdServiceTest.class,
         KvServiceTest.class,
         LogServiceTest.class,
         PartitionServiceTest.class,
+        PartitionLoadServiceTest.class,
         StoreMonitorDataServiceTest.class,
         StoreServiceTest.class,
         TaskScheduleServiceTest.class,
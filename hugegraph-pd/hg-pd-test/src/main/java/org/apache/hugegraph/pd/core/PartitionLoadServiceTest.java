@@ -0,0 +1,62 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.pd.core;
+
+import org.apache.hugegraph.pd.PartitionLoadService;
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.junit.Assert;
+import org.junit.Test;
+
+public class PartitionLoadServiceTest {
+
+    private static Metapb.PartitionStats stats(int id, long readQps, long writeQps) {
+        return Metapb.PartitionStats.newBuilder()
+                                    .setId(id)
+                                    .setLoad(Metapb.PartitionLoad.newBuilder()
+                                                                 .setReadQps(readQps)
+                                                                 .setWriteQps(writeQps)
+                                                                 .build())
+                                    .build();
+    }
+
+    @Test
+    public void testUpdate() {
+        PartitionLoadService service = new PartitionLoadService(60 * 1000L);
+        service.update(stats(1, 1000, 200));
+        service.update(Metapb.PartitionStats.newBuilder().setId(2).build());
+
+        PartitionLoadService.Load load = service.getLoad(1);
+        Assert.assertEquals(1000.0, load.getReadScore(), 0.01);
+        Assert.assertEquals(200.0, load.getWriteScore(), 0.01);
+        // No load is reported
+        Assert.assertNull(service.getLoad(2));
+
+        // Smoothed with the previous heartbeat
+        service.update(stats(1, 0, 0));
+        Assert.assertEquals(600.0, service.getLoad(1).getScore(), 0.01);
+    }
+
+    @Test
+    public void testExpire() throws InterruptedException {
+        PartitionLoadService service = new PartitionLoadService(10L);
+        service.update(stats(1, 100, 100));
+        Assert.assertEquals(1, service.getLoads().size());
+        Thread.sleep(50);
+        Assert.assertTrue(service.getLoads().isEmpty());
+    }
+}
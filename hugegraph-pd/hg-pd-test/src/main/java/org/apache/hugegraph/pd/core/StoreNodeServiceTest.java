@@ -113,4 +113,24 @@ public class StoreNodeServiceTest extends BaseCoreTest {
 
     }
 
+    @Test
+    public void testIsLearnerStore() {
+        Metapb.Store store = Metapb.Store.newBuilder()
+                                         .setAddress("127.0.0.1:8500")
+                                         .addLabels(Metapb.StoreLabel.newBuilder()
+                                                                     .setKey("rest.port")
+                                                                     .setValue("8520")
+                                                                     .build())
+                                         .build();
+        Assert.assertFalse(StoreNodeService.isLearnerStore(store));
+
+        store = store.toBuilder()
+                     .addLabels(Metapb.StoreLabel.newBuilder()
+                                                 .setKey("replica-role")
+                                                 .setValue("learner")
+                                                 .build())
+                     .build();
+        Assert.assertTrue(StoreNodeService.isLearnerStore(store));
+    }
+
 }
@@ -17,7 +17,9 @@
 
 package org.apache.hugegraph.pd.core;
 
+import static org.junit.Assert.assertEquals;
 import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
 
 import java.util.ArrayList;
 import java.util.List;
@@ -75,6 +77,24 @@ public class TaskScheduleServiceTest extends PDCoreTestBase {
         getStoreNodeService().getStoreInfoMeta().removeAll();
     }
 
+    @Test
+    public void testPendingSplits() throws PDException {
+        var taskInfoMeta = getStoreNodeService().getTaskInfoMeta();
+        taskInfoMeta.addPendingSplit(1, 2);
+        taskInfoMeta.addPendingSplit(2, 2);
+
+        // Kept in the meta store, so a new leader sees them
+        var splits = taskInfoMeta.getPendingSplits();
+        assertEquals(2, splits.size());
+        assertEquals(2, (int) splits.get(0).getValue());
+        // Not taken for split tasks
+        assertFalse(taskInfoMeta.hasSplitTaskDoing());
+
+        taskInfoMeta.removePendingSplit(1);
+        taskInfoMeta.removePendingSplit(2);
+        assertTrue(taskInfoMeta.getPendingSplits().isEmpty());
+    }
+
     // TODO
     public void testSplitPartition() {
 
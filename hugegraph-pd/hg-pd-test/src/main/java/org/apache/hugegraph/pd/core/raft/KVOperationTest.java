@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.pd.core.raft;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.List;
+
+import org.apache.commons.io.FileUtils;
+import org.apache.hugegraph.pd.common.PDException;
+import org.apache.hugegraph.pd.config.PDConfig;
+import org.apache.hugegraph.pd.raft.KVOperation;
+import org.apache.hugegraph.pd.store.HgKVStore;
+import org.apache.hugegraph.pd.store.HgKVStoreImpl;
+import org.apache.hugegraph.pd.store.RaftKVStore;
+import org.junit.Assert;
+import org.junit.BeforeClass;
+import org.junit.Test;
+
+public class KVOperationTest {
+
+    private static final String testPath = "tmp/kv_operation_test";
+    private static PDConfig pdConfig;
+
+    @BeforeClass
+    public static void init() throws IOException {
+        File testFile = new File(testPath);
+        if (testFile.exists()) {
+            FileUtils.deleteDirectory(testFile);
+        }
+        FileUtils.forceMkdir(testFile);
+        pdConfig = new PDConfig() {{
+            setDataPath(testPath);
+        }};
+    }
+
+    @Test
+    public void testPutBatchRoundTrip() throws IOException {
+        List<byte[]> keys = Arrays.asList("k1".getBytes(), "k2".getBytes());
+        List<byte[]> values = Arrays.asList("v1".getBytes(), "v2".getBytes());
+        KVOperation op = KVOperation.createPutBatch(keys, values);
+
+        // Followers decode the raft log with the whitelisted hessian factory
+        KVOperation decoded = KVOperation.fromByteArray(op.toByteArray());
+        Assert.assertEquals(KVOperation.PUT_BATCH, decoded.getOp());
+        Assert.assertTrue(decoded.getArg() instanceof KVOperation.PutBatch);
+        KVOperation.PutBatch batch = (KVOperation.PutBatch) decoded.getArg();
+        Assert.assertEquals(2, batch.getKeys().size());
+        Assert.assertArrayEquals("k1".getBytes(), batch.getKeys().get(0));
+        Assert.assertArrayEquals("k2".getBytes(), batch.getKeys().get(1));
+        Assert.assertArrayEquals("v1".getBytes(), batch.getValues().get(0));
+        Assert.assertArrayEquals("v2".getBytes(), batch.getValues().get(1));
+    }
+
+    @Test
+    public void testApplyDecodedPutBatch() throws IOException, PDException {
+        HgKVStore store = new HgKVStoreImpl();
+        store.init(pdConfig);
+        RaftKVStore raftStore = new RaftKVStore(null, store);
+
+        List<byte[]> keys = Arrays.asList("batch1".getBytes(), "batch2".getBytes());
+        List<byte[]> values = Arrays.asList("a".getBytes(), "b".getBytes());
+        byte[] log = KVOperation.createPutBatch(keys, values).toByteArray();
+        raftStore.invoke(KVOperation.fromByteArray(log), null);
+
+        Assert.assertArrayEquals("a".getBytes(), store.get("batch1".getBytes()));
+        Assert.assertArrayEquals("b".getBytes(), store.get("batch2".getBytes()));
+        store.close();
+    }
+}
@@ -20,6 +20,8 @@ package org.apache.hugegraph.pd.core.store;
 import java.io.File;
 import java.io.IOException;
 import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
 
 import org.apache.commons.io.FileUtils;
 import org.apache.hugegraph.pd.common.PDException;
@@ -71,6 +73,25 @@ public class HgKVStoreImplTest {
         kvStore.close();
     }
 
+    @Test
+    public void TestPutBatch() throws PDException {
+        HgKVStore kvStore = new HgKVStoreImpl();
+        kvStore.init(pdConfig);
+
+        List<byte[]> keys = new ArrayList<>();
+        List<byte[]> values = new ArrayList<>();
+        for (int i = 0; i < 100; i++) {
+            keys.add(String.format("b%03d", i).getBytes());
+            values.add(("value" + i).getBytes());
+        }
+        kvStore.putBatch(keys, values);
+        Assert.assertEquals(100, kvStore.scanPrefix("b".getBytes()).size());
+        Assert.assertArrayEquals("value7".getBytes(), kvStore.get("b007".getBytes()));
+
+        kvStore.removeByPrefix("b".getBytes());
+        kvStore.close();
+    }
+
     @Test
     public void TestSnapshot() throws PDException {
         HgKVStore kvStore = new HgKVStoreImpl();
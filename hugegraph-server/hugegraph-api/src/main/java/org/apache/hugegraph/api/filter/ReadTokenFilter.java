@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.apache.hugegraph.api.filter;
+
+import org.apache.hugegraph.backend.store.raft.RaftReadSession;
+
+import jakarta.inject.Singleton;
+import jakarta.ws.rs.container.ContainerRequestContext;
+import jakarta.ws.rs.container.ContainerRequestFilter;
+import jakarta.ws.rs.container.ContainerResponseContext;
+import jakarta.ws.rs.container.ContainerResponseFilter;
+import jakarta.ws.rs.ext.Provider;
+
+/**
+ * Pass the raft read tokens of a client session through the requests, the
+ * client echoes the tokens returned by the last response, then the bounded
+ * reads on any server observe the writes of the session
+ */
+@Provider
+@Singleton
+public class ReadTokenFilter implements ContainerRequestFilter,
+                                        ContainerResponseFilter {
+
+    public static final String X_HG_READ_TOKEN = "x-hg-read-token";
+
+    @Override
+    public void filter(ContainerRequestContext context) {
+        // Always begin a new session, the thread may serve another client
+        RaftReadSession.begin(context.getHeaderString(X_HG_READ_TOKEN));
+    }
+
+    @Override
+    public void filter(ContainerRequestContext requestContext,
+                       ContainerResponseContext responseContext) {
+        String tokens = RaftReadSession.end();
+        if (tokens != null) {
+            responseContext.getHeaders().putSingle(X_HG_READ_TOKEN, tokens);
+        }
+    }
+}
@@ -50,13 +50,24 @@ public class RaftBackendStore implements BackendStore {
     private final BackendStore store;
     private final RaftContext context;
     private final ThreadLocal<MutationBatch> mutationBatch;
-    private final boolean isSafeRead;
+    private final ReadMode readMode;
+    private final int readMaxLag;
 
     public RaftBackendStore(BackendStore store, RaftContext context) {
         this.store = store;
         this.context = context;
         this.mutationBatch = new ThreadLocal<>();
-        this.isSafeRead = this.context.safeRead();
+        this.readMode = this.context.readMode();
+        this.readMaxLag = this.context.readMaxLag();
+    }
+
+    /**
+     * The raft log index the reads of current thread must observe, it's
+     * updated by committing and by the tokens of the client session
+     */
+    public long readToken() {
+        long session = RaftReadSession.token(this.context.group());
+        return Math.max(this.getOrNewBatch().readToken, session);
     }
 
     public BackendStore originStore() {
@@ -176,7 +187,16 @@ public class RaftBackendStore implements BackendStore {
         MutationBatch batch = this.getOrNewBatch();
         try {
             byte[] bytes = StoreSerializer.writeMutations(batch.mutations);
-            this.submitAndWait(StoreAction.COMMIT_TX, bytes);
+            StoreType type = this.context.storeType(this.store());
+            StoreCommand command = new StoreCommand(type, StoreAction.COMMIT_TX,
+                                                    bytes);
+            RaftStoreClosure closure = new RaftStoreClosure(command);
+            this.node().submitAndWait(command, closure);
+            // Read your writes on any replica in bounded read mode
+            if (this.readMode == ReadMode.BOUNDED) {
+                batch.readToken = Math.max(batch.readToken, closure.index());
+                RaftReadSession.observe(this.context.group(), closure.index());
+            }
         } finally {
             batch.clear();
         }
@@ -222,7 +242,38 @@ public class RaftBackendStore implements BackendStore {
     }
 
     private Object queryByRaft(Object query, Function<Object, Object> func) {
-        return this.queryByRaft(query, this.isSafeRead, func);
+        switch (this.readMode) {
+            case LOCAL:
+                return func.apply(query);
+            case LEASE:
+                // Read locally if the leadership is confirmed recently
+                boolean local = this.node().leaderLeaseValid();
+                return this.queryByRaft(query, !local, func);
+            case BOUNDED:
+                return this.queryByRaft(query, !this.withinStaleBound(), func);
+            case READ_INDEX:
+            default:
+                return this.queryByRaft(query, true, func);
+        }
+    }
+
+    private boolean withinStaleBound() {
+        RaftNode node = this.node();
+        return withinStaleBound(this.readToken(), node.appliedIndex(),
+                                node.leaderIndex(), this.readMaxLag);
+    }
+
+    /**
+     * Whether a local read observes the read token and lags behind the
+     * leader's commit index (confirmed within the lease, -1 if unknown)
+     * by at most maxLag entries
+     */
+    public static boolean withinStaleBound(long token, long appliedIndex,
+                                           long leaderIndex, long maxLag) {
+        if (leaderIndex < 0L || appliedIndex < token) {
+            return false;
+        }
+        return leaderIndex - appliedIndex <= maxLag;
     }
 
     private Object queryByRaft(Object query, boolean safeRead,
@@ -232,10 +283,13 @@ public class RaftBackendStore implements BackendStore {
         }
 
         RaftClosure<Object> future = new RaftClosure<>();
+        long startTime = System.nanoTime();
         ReadIndexClosure readIndexClosure = new ReadIndexClosure() {
             @Override
             public void run(Status status, long index, byte[] reqCtx) {
                 if (status.isOk()) {
+                    node().renewLeaderLease(startTime);
+                    node().confirmLeaderIndex(index, startTime);
                     future.complete(status, () -> func.apply(query));
                 } else {
                     future.failure(status, new BackendException(
@@ -267,9 +321,12 @@ public class RaftBackendStore implements BackendStore {
 
         // This object will stay in memory for a long time
         private final List<BackendMutation> mutations;
+        // Survives clear() to keep read-your-writes across transactions
+        private long readToken;
 
         public MutationBatch() {
             this.mutations = new ArrayList<>((int) Query.COMMIT_BATCH);
+            this.readToken = 0L;
         }
 
         public void add(BackendMutation mutation) {
@@ -281,6 +338,14 @@ public class RaftBackendStore implements BackendStore {
         }
     }
 
+    public enum ReadMode {
+
+        LOCAL,
+        READ_INDEX,
+        LEASE,
+        BOUNDED
+    }
+
     protected static final class IncrCounter {
 
         private HugeType type;
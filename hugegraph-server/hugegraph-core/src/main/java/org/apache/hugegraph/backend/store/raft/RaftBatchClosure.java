@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.backend.store.raft;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreAction;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreType;
+import org.apache.hugegraph.util.E;
+
+import com.alipay.sofa.jraft.Status;
+
+/**
+ * The closure of a raft task coalesced from multiple store commands, each
+ * command keeps its own closure which will be completed separately
+ */
+public class RaftBatchClosure extends RaftStoreClosure {
+
+    private final List<RaftStoreClosure> closures;
+
+    public RaftBatchClosure(List<RaftStoreClosure> closures) {
+        super(batchCommand(closures));
+        this.closures = closures;
+        // The batch is applied when all of the commands are applied
+        AtomicInteger remaining = new AtomicInteger(closures.size());
+        for (RaftStoreClosure closure : closures) {
+            closure.whenApplied(() -> {
+                if (remaining.decrementAndGet() == 0) {
+                    this.applied();
+                }
+            });
+        }
+    }
+
+    public List<RaftStoreClosure> closures() {
+        return this.closures;
+    }
+
+    @Override
+    public void failure(Status status, Throwable exception) {
+        for (RaftStoreClosure closure : this.closures) {
+            closure.failure(status, exception);
+        }
+        super.failure(status, exception);
+    }
+
+    private static StoreCommand batchCommand(List<RaftStoreClosure> closures) {
+        E.checkArgument(!closures.isEmpty(), "The batch closures can't be empty");
+        List<StoreCommand> commands = new ArrayList<>(closures.size());
+        for (RaftStoreClosure closure : closures) {
+            commands.add(closure.command());
+        }
+        byte[] data = StoreSerializer.writeCommands(commands);
+        return new StoreCommand(StoreType.ALL, StoreAction.BATCH, data);
+    }
+}
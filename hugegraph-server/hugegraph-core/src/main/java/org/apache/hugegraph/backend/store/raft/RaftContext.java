@@ -79,13 +79,15 @@ public final class RaftContext {
     public static final int POLL_INTERVAL = 5000;
     public static final int WAIT_RAFTLOG_TIMEOUT = 30 * 60 * 1000;
     public static final int WAIT_LEADER_TIMEOUT = 10 * 60 * 1000;
-    public static final int BUSY_MIN_SLEEP_FACTOR = 3 * 1000;
-    public static final int BUSY_MAX_SLEEP_FACTOR = 5 * 1000;
     public static final int WAIT_RPC_TIMEOUT = 30 * 60 * 1000;
     public static final int LOG_WARN_INTERVAL = 60 * 1000;
 
     // compress block size
     public static final int BLOCK_SIZE = (int) (Bytes.KB * 8);
+    // The max bytes of commands coalesced into one raft task
+    public static final int MAX_BATCH_BYTES = (int) (Bytes.MB * 4);
+    // The max coalesced raft tasks in flight, the others queue up meanwhile
+    public static final int MAX_INFLIGHT_BATCHES = 2;
 
     // work queue size
     public static final int QUEUE_SIZE = CoreOptions.CPUS;
@@ -247,6 +249,8 @@ public final class RaftContext {
 
         int snapshotInterval = config.get(CoreOptions.RAFT_SNAPSHOT_INTERVAL);
         nodeOptions.setSnapshotIntervalSecs(snapshotInterval);
+        // Reuse the files of last snapshot which have the same checksum
+        nodeOptions.setFilterBeforeCopyRemote(this.snapshotIncremental());
         nodeOptions.setInitialConf(this.groupPeers);
 
         String raftPath = config.get(CoreOptions.RAFT_PATH);
@@ -350,6 +354,39 @@ public final class RaftContext {
         return this.config().get(CoreOptions.RAFT_SAFE_READ);
     }
 
+    public RaftBackendStore.ReadMode readMode() {
+        if (this.safeRead()) {
+            return RaftBackendStore.ReadMode.READ_INDEX;
+        }
+        String mode = this.config().get(CoreOptions.RAFT_READ_MODE);
+        return RaftBackendStore.ReadMode.valueOf(mode.toUpperCase());
+    }
+
+    public int readMaxLag() {
+        return this.config().get(CoreOptions.RAFT_READ_MAX_LAG);
+    }
+
+    public long leaderLeaseMillis() {
+        // Same as the default leader lease ratio(90%) of jraft
+        return this.config().get(CoreOptions.RAFT_ELECTION_TIMEOUT) * 9L / 10L;
+    }
+
+    public int submitBatchSize() {
+        return this.config().get(CoreOptions.RAFT_SUBMIT_BATCH_SIZE);
+    }
+
+    public int queueSize() {
+        return this.config().get(CoreOptions.RAFT_QUEUE_SIZE);
+    }
+
+    public int queuePublishTimeout() {
+        return this.config().get(CoreOptions.RAFT_QUEUE_PUBLISH_TIMEOUT);
+    }
+
+    public boolean snapshotIncremental() {
+        return this.config().get(CoreOptions.RAFT_SNAPSHOT_INCREMENTAL);
+    }
+
     public ExecutorService snapshotExecutor() {
         return this.snapshotExecutor;
     }
@@ -19,12 +19,18 @@ package org.apache.hugegraph.backend.store.raft;
 
 import java.io.IOException;
 import java.nio.ByteBuffer;
-import java.util.Random;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Queue;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
 
 import org.apache.hugegraph.backend.BackendException;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreAction;
 import org.apache.hugegraph.util.LZ4Util;
 import org.apache.hugegraph.util.Log;
 import org.slf4j.Logger;
@@ -51,7 +57,13 @@ public final class RaftNode {
     private final StoreStateMachine stateMachine;
     private final AtomicReference<LeaderInfo> leaderInfo;
     private final AtomicBoolean started;
-    private final AtomicInteger busyCounter;
+    private final int batchSize;
+    private final Queue<RaftStoreClosure> pendingCommands;
+    private final AtomicBoolean flushing;
+    private final AtomicInteger inflightBatches;
+    private final Semaphore inflightTasks;
+    private volatile long leaseExpireTime;
+    private volatile LeaderIndex leaderIndex;
 
     public RaftNode(RaftContext context) {
         this.context = context;
@@ -66,7 +78,14 @@ public final class RaftNode {
         this.node.addReplicatorStateListener(new RaftStateListener());
         this.leaderInfo = new AtomicReference<>(LeaderInfo.NO_LEADER);
         this.started = new AtomicBoolean(false);
-        this.busyCounter = new AtomicInteger();
+        this.batchSize = context.submitBatchSize();
+        this.pendingCommands = new ConcurrentLinkedQueue<>();
+        this.flushing = new AtomicBoolean(false);
+        this.inflightBatches = new AtomicInteger(0);
+        // Limit in-flight tasks to the capacity of the disruptor queue
+        this.inflightTasks = new Semaphore(context.queueSize());
+        this.leaseExpireTime = 0L;
+        this.leaderIndex = LeaderIndex.UNKNOWN;
     }
 
     private RaftContext context() {
@@ -93,6 +112,64 @@ public final class RaftNode {
     public void onLeaderInfoChange(PeerId leaderId, boolean selfIsLeader) {
         leaderId = leaderId != null ? leaderId.copy() : null;
         this.leaderInfo.set(new LeaderInfo(leaderId, selfIsLeader));
+        this.leaseExpireTime = 0L;
+        this.leaderIndex = LeaderIndex.UNKNOWN;
+    }
+
+    public long appliedIndex() {
+        return this.node.getLastAppliedLogIndex();
+    }
+
+    public long committedIndex() {
+        return this.node.getLastCommittedIndex();
+    }
+
+    /**
+     * Whether the leadership confirmed by the last read-index is still valid,
+     * the followers won't elect a new leader before the election timeout
+     */
+    public boolean leaderLeaseValid() {
+        return this.selfIsLeader() && System.nanoTime() < this.leaseExpireTime;
+    }
+
+    /**
+     * Extend the leader lease after the leadership has been confirmed by
+     * a quorum at the specified time (read-index started at)
+     */
+    public void renewLeaderLease(long confirmedNanos) {
+        if (!this.selfIsLeader()) {
+            return;
+        }
+        long lease = TimeUnit.MILLISECONDS.toNanos(this.context.leaderLeaseMillis());
+        long expireTime = confirmedNanos + lease;
+        if (expireTime - this.leaseExpireTime > 0L) {
+            this.leaseExpireTime = expireTime;
+        }
+    }
+
+    /**
+     * Record the leader's commit index returned by a read-index which was
+     * started at the specified time, it works on both leader and followers
+     */
+    public void confirmLeaderIndex(long index, long confirmedNanos) {
+        long lease = TimeUnit.MILLISECONDS.toNanos(this.context.leaderLeaseMillis());
+        LeaderIndex current = this.leaderIndex;
+        if (index >= current.index) {
+            this.leaderIndex = new LeaderIndex(index, confirmedNanos + lease);
+        }
+    }
+
+    /**
+     * The leader's commit index confirmed by a read-index within the leader
+     * lease, or -1 if no such confirmation, callers should do a read-index
+     */
+    public long leaderIndex() {
+        LeaderIndex current = this.leaderIndex;
+        if (current == LeaderIndex.UNKNOWN ||
+            System.nanoTime() - current.expireTime >= 0L) {
+            return -1L;
+        }
+        return current.index;
     }
 
     public void shutdown() {
@@ -126,7 +203,7 @@ public final class RaftNode {
 
     public <T> T submitAndWait(StoreCommand command, RaftStoreClosure future) {
         // Submit command to raft node
-        this.submitCommand(command, future);
+        this.submit(command, future);
 
         try {
             /*
@@ -144,7 +221,13 @@ public final class RaftNode {
         }
     }
 
-    private void submitCommand(StoreCommand command, RaftStoreClosure future) {
+    /**
+     * Submit command to raft node without waiting for it committed.
+     * NOTE: the command on the leader is applied by the waiting thread, so
+     * the caller must call future.waitFinished() later, the commit commands
+     * may be submitted later by other threads
+     */
+    public void submit(StoreCommand command, RaftStoreClosure future) {
         // Wait leader elected
         LeaderInfo leaderInfo = this.waitLeaderElected(
                 RaftContext.WAIT_LEADER_TIMEOUT);
@@ -155,22 +238,131 @@ public final class RaftNode {
             return;
         }
 
-        // Sleep a while when raft node is busy
-        this.waitIfBusy();
+        if (this.batchSize <= 1 || command.action() != StoreAction.COMMIT_TX) {
+            // Back pressure when too many tasks are in flight
+            this.acquireInflight();
+            this.submitTask(command, future);
+            return;
+        }
+
+        // Coalesce concurrent commit commands into one raft task
+        this.pendingCommands.add(future);
+        this.flushPendingCommands();
+    }
+
+    private void flushPendingCommands() {
+        /*
+         * Only one thread drains the pending commands at a time, the others
+         * just return and wait for their commands being submitted by it.
+         * The commands queue up while MAX_INFLIGHT_BATCHES raft tasks of them
+         * are in flight, and are submitted together when one is applied.
+         */
+        while (!this.pendingCommands.isEmpty() &&
+               this.inflightBatches.get() < RaftContext.MAX_INFLIGHT_BATCHES &&
+               this.inflightTasks.availablePermits() > 0 &&
+               this.flushing.compareAndSet(false, true)) {
+            List<RaftStoreClosure> batch = new ArrayList<>();
+            boolean acquired = false;
+            try {
+                /*
+                 * Check again with the flushing flag held, if it fails, the
+                 * commands are submitted by the thread which applies a task
+                 */
+                if (this.inflightBatches.get() >= RaftContext.MAX_INFLIGHT_BATCHES ||
+                    !this.inflightTasks.tryAcquire()) {
+                    continue;
+                }
+                acquired = true;
+
+                long bytes = 0L;
+                RaftStoreClosure closure;
+                while (batch.size() < this.batchSize &&
+                       bytes < RaftContext.MAX_BATCH_BYTES &&
+                       (closure = this.pendingCommands.poll()) != null) {
+                    batch.add(closure);
+                    bytes += closure.command().data().length;
+                }
+
+                if (batch.isEmpty()) {
+                    this.inflightTasks.release();
+                    continue;
+                }
+                RaftStoreClosure future = batch.size() == 1 ? batch.get(0) :
+                                          new RaftBatchClosure(batch);
+                this.inflightBatches.incrementAndGet();
+                future.whenApplied(() -> {
+                    this.inflightBatches.decrementAndGet();
+                    this.flushPendingCommands();
+                });
+                // The permit is released once applied from now on
+                acquired = false;
+                this.submitTask(future.command(), future);
+            } catch (Throwable e) {
+                if (acquired) {
+                    this.inflightTasks.release();
+                }
+                // Notify the waiting threads, they may be not the current one
+                Status status = new Status(RaftError.EINTERNAL,
+                                           "Failed to submit commands: %s",
+                                           e.getMessage());
+                for (RaftStoreClosure closure : batch) {
+                    closure.failure(status, e);
+                }
+            } finally {
+                this.flushing.set(false);
+            }
+        }
+    }
+
+    /**
+     * Submit the task with a permit of in-flight tasks acquired, the permit
+     * is released once the command is applied rather than committed, so the
+     * permits bound the commands waiting to be applied on the leader
+     */
+    private void submitTask(StoreCommand command, RaftStoreClosure future) {
+        future.whenApplied(() -> {
+            this.inflightTasks.release();
+            // The pending commands may wait for the permit
+            this.flushPendingCommands();
+        });
 
         Task task = new Task();
-        // Compress data, note compress() will return a BytesBuffer
-        ByteBuffer buffer = LZ4Util.compress(command.data(),
-                                             RaftContext.BLOCK_SIZE)
-                                   .forReadWritten()
-                                   .asByteBuffer();
-        LOG.debug("Submit to raft node '{}', the compressed bytes of command " +
-                  "{} is {}", this.node, command.action(), buffer.limit());
-        task.setData(buffer);
+        try {
+            // Compress data, note compress() will return a BytesBuffer
+            ByteBuffer buffer = LZ4Util.compress(command.data(),
+                                                 RaftContext.BLOCK_SIZE)
+                                       .forReadWritten()
+                                       .asByteBuffer();
+            LOG.debug("Submit to raft node '{}', the compressed bytes of " +
+                      "command {} is {}", this.node, command.action(),
+                      buffer.limit());
+            task.setData(buffer);
+        } catch (Throwable e) {
+            future.failure(new Status(RaftError.EINTERNAL,
+                                      "Failed to submit command: %s",
+                                      e.getMessage()), e);
+            return;
+        }
         task.setDone(future);
         this.node.apply(task);
     }
 
+    private void acquireInflight() {
+        int timeout = this.context.queuePublishTimeout();
+        boolean acquired;
+        try {
+            acquired = this.inflightTasks.tryAcquire(timeout, TimeUnit.SECONDS);
+        } catch (InterruptedException e) {
+            throw new BackendException("Interrupted while waiting for " +
+                                       "raft node '%s' idle", this, e);
+        }
+        if (!acquired) {
+            throw new BackendException("The raft backend store is busy, " +
+                                       "there are %s tasks in flight",
+                                       this.context.queueSize());
+        }
+    }
+
     LeaderInfo waitLeaderElected(int timeout) {
         String group = this.context.group();
         LeaderInfo leaderInfo = this.leaderInfo.get();
@@ -226,35 +418,6 @@ public final class RaftNode {
         LOG.info("Waited for raft group '{}' log synced successfully", group);
     }
 
-    private void waitIfBusy() {
-        int counter = this.busyCounter.get();
-        if (counter <= 0) {
-            return;
-        }
-        // It may lead many thread sleep, but this is exactly what I want
-        int delta = RaftContext.BUSY_MAX_SLEEP_FACTOR -
-                    RaftContext.BUSY_MIN_SLEEP_FACTOR;
-        Random random = new Random();
-        int timeout = random.nextInt(delta) +
-                      RaftContext.BUSY_MIN_SLEEP_FACTOR;
-        int time = counter * timeout;
-        try {
-            Thread.sleep(time);
-        } catch (InterruptedException e) {
-            // Throw busy exception if the request is timeout
-            throw new BackendException("The raft backend store is busy", e);
-        } finally {
-            if (this.busyCounter.get() > 0) {
-                synchronized (this) {
-                    if (this.busyCounter.get() > 0) {
-                        counter = this.busyCounter.decrementAndGet();
-                        LOG.info("Decrease busy counter: [{}]", counter);
-                    }
-                }
-            }
-        }
-    }
-
     private Node initRaftNode() throws IOException {
         NodeOptions nodeOptions = this.context.nodeOptions();
         nodeOptions.setFsm(this.stateMachine);
@@ -311,20 +474,18 @@ public final class RaftNode {
                 this.lastPrintTime = now;
             }
             if (this.isWriteBufferOverflow(status)) {
-                // Increment busy counter
-                int count = RaftNode.this.busyCounter.incrementAndGet();
-                LOG.info("Increase busy counter due to overflow: [{}]", count);
+                LOG.info("Replicator '{}' write buffer overflow, in-flight " +
+                         "tasks will be limited by raft queue", peer);
             }
         }
 
         // NOTE: Jraft itself doesn't have this callback, it's added by us
         public void onBusy(PeerId peer, Status status) {
             /*
-             * If follower is busy then increase busy counter,
-             * it will lead to submit thread wait more time
+             * If follower is busy, the submit threads will be blocked by
+             * the limit of in-flight tasks instead of sleeping
              */
-            int count = RaftNode.this.busyCounter.incrementAndGet();
-            LOG.info("Increase busy counter: [{}]", count);
+            LOG.info("Replicator '{}' is busy: {}", peer, status);
         }
 
         private boolean isWriteBufferOverflow(Status status) {
@@ -362,4 +523,17 @@ public final class RaftNode {
             this.selfIsLeader = selfIsLeader;
         }
     }
+
+    private static class LeaderIndex {
+
+        private static final LeaderIndex UNKNOWN = new LeaderIndex(-1L, 0L);
+
+        private final long index;
+        private final long expireTime;
+
+        public LeaderIndex(long index, long expireTime) {
+            this.index = index;
+            this.expireTime = expireTime;
+        }
+    }
 }
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.apache.hugegraph.backend.store.raft;
+
+import java.util.HashMap;
+import java.util.Map;
+
+import org.apache.commons.lang3.StringUtils;
+import org.apache.hugegraph.util.E;
+
+/**
+ * The read tokens of the client session served by current thread, a token
+ * is the raft log index of the latest write seen by the session for each
+ * raft group. The session passes the tokens from request to request, so the
+ * bounded reads of a session observe its writes on any server.
+ * The tokens are formatted as "group1=index1,group2=index2".
+ */
+public final class RaftReadSession {
+
+    private static final String GROUP_DELIMITER = ",";
+    private static final String INDEX_DELIMITER = "=";
+
+    private static final ThreadLocal<Map<String, Long>> TOKENS =
+            new ThreadLocal<>();
+
+    private RaftReadSession() {
+    }
+
+    /**
+     * Begin the session of a request with the tokens given by the client,
+     * nullable if the client has no token yet
+     */
+    public static void begin(String tokens) {
+        TOKENS.set(parse(tokens));
+    }
+
+    /**
+     * End the session of current request
+     * @return the tokens to be passed to the next request of the session,
+     *         null if no session or no token
+     */
+    public static String end() {
+        Map<String, Long> tokens = TOKENS.get();
+        TOKENS.remove();
+        if (tokens == null || tokens.isEmpty()) {
+            return null;
+        }
+        return format(tokens);
+    }
+
+    /**
+     * The log index the reads of the group must observe, 0 if no session
+     */
+    public static long token(String group) {
+        Map<String, Long> tokens = TOKENS.get();
+        if (tokens == null) {
+            return 0L;
+        }
+        return tokens.getOrDefault(group, 0L);
+    }
+
+    /**
+     * Record the log index of a write committed by the session
+     */
+    public static void observe(String group, long index) {
+        Map<String, Long> tokens = TOKENS.get();
+        if (tokens != null) {
+            tokens.merge(group, index, Math::max);
+        }
+    }
+
+    public static Map<String, Long> parse(String tokens) {
+        Map<String, Long> results = new HashMap<>();
+        if (StringUtils.isBlank(tokens)) {
+            return results;
+        }
+        for (String token : StringUtils.split(tokens, GROUP_DELIMITER)) {
+            String[] parts = StringUtils.split(token.trim(), INDEX_DELIMITER);
+            E.checkArgument(parts.length == 2,
+                            "Invalid raft read token '%s'", token);
+            long index;
+            try {
+                index = Long.parseLong(parts[1]);
+            } catch (NumberFormatException e) {
+                throw new IllegalArgumentException(String.format(
+                          "Invalid raft read token '%s'", token));
+            }
+            E.checkArgument(index >= 0L,
+                            "Invalid raft read token '%s'", token);
+            results.merge(parts[0], index, Math::max);
+        }
+        return results;
+    }
+
+    public static String format(Map<String, Long> tokens) {
+        StringBuilder sb = new StringBuilder();
+        for (Map.Entry<String, Long> e : tokens.entrySet()) {
+            if (sb.length() > 0) {
+                sb.append(GROUP_DELIMITER);
+            }
+            sb.append(e.getKey()).append(INDEX_DELIMITER).append(e.getValue());
+        }
+        return sb.toString();
+    }
+}
@@ -17,18 +17,55 @@
 
 package org.apache.hugegraph.backend.store.raft;
 
+import java.util.concurrent.CompletableFuture;
+
 import org.apache.hugegraph.util.E;
 
+import com.alipay.sofa.jraft.Status;
+
 public class RaftStoreClosure extends RaftClosure<Object> {
 
     private final StoreCommand command;
+    // The raft log index of the entry which carries the command
+    private volatile long index;
+    // Completed once the command is applied to the store or failed
+    private final CompletableFuture<Void> applied;
 
     public RaftStoreClosure(StoreCommand command) {
         E.checkNotNull(command, "store command");
         this.command = command;
+        this.index = 0L;
+        this.applied = new CompletableFuture<>();
     }
 
     public StoreCommand command() {
         return this.command;
     }
+
+    public long index() {
+        return this.index;
+    }
+
+    public void index(long index) {
+        this.index = index;
+    }
+
+    /**
+     * Run the action after the command is applied, on the leader it's
+     * applied by the waiting thread after the closure completed
+     */
+    public void whenApplied(Runnable action) {
+        this.applied.whenComplete((result, error) -> action.run());
+    }
+
+    public void applied() {
+        this.applied.complete(null);
+    }
+
+    @Override
+    public void failure(Status status, Throwable exception) {
+        super.failure(status, exception);
+        // Never to be applied
+        this.applied();
+    }
 }
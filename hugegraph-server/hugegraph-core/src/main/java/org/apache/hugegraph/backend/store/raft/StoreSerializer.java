@@ -129,6 +129,32 @@ public final class StoreSerializer {
         return mutation;
     }
 
+    public static byte[] writeCommands(List<StoreCommand> commands) {
+        int estimateSize = 0;
+        for (StoreCommand command : commands) {
+            estimateSize += command.data().length + BytesBuffer.INT_LEN;
+        }
+        // The first two bytes are reserved for StoreType and StoreAction
+        BytesBuffer buffer = BytesBuffer.allocate(StoreCommand.HEADER_SIZE +
+                                                  4 + estimateSize);
+        StoreCommand.writeHeader(buffer);
+
+        buffer.writeVInt(commands.size());
+        for (StoreCommand command : commands) {
+            buffer.writeBigBytes(command.data());
+        }
+        return buffer.bytes();
+    }
+
+    public static List<StoreCommand> readCommands(BytesBuffer buffer) {
+        int size = buffer.readVInt();
+        List<StoreCommand> commands = new ArrayList<>(size);
+        for (int i = 0; i < size; i++) {
+            commands.add(StoreCommand.fromBytes(buffer.readBigBytes()));
+        }
+        return commands;
+    }
+
     public static byte[] writeIncrCounter(IncrCounter incrCounter) {
         // The first two bytes are reserved for StoreType and StoreAction
         BytesBuffer buffer = BytesBuffer.allocate(StoreCommand.HEADER_SIZE +
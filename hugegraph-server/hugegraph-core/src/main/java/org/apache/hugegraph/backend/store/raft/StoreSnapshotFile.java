@@ -19,13 +19,19 @@ package org.apache.hugegraph.backend.store.raft;
 
 import java.io.File;
 import java.io.IOException;
+import java.io.InputStream;
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
+import java.util.Collection;
 import java.util.HashMap;
 import java.util.HashSet;
 import java.util.Map;
 import java.util.Set;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.zip.CheckedInputStream;
 import java.util.zip.Checksum;
 
 import org.apache.commons.io.FileUtils;
@@ -52,13 +58,23 @@ public class StoreSnapshotFile {
 
     public static final String SNAPSHOT_DIR = "snapshot";
     private static final String TAR = ".zip";
+    private static final String SST = ".sst";
 
     private final RaftBackendStore[] stores;
     private final Map<String, String> dataDisks;
     private final AtomicBoolean compressing;
+    private final boolean incremental;
+    /*
+     * The checksums of sst files in last saved snapshot, the key is
+     * "file@size@mtime", sst files are immutable so a linked file
+     * with the same key doesn't need to be read again
+     */
+    private volatile Map<String, String> sstChecksums;
 
-    public StoreSnapshotFile(RaftBackendStore[] stores) {
+    public StoreSnapshotFile(RaftBackendStore[] stores, boolean incremental) {
         this.stores = stores;
+        this.incremental = incremental;
+        this.sstChecksums = new HashMap<>();
         this.dataDisks = new HashMap<>();
         for (RaftBackendStore raftStore : stores) {
             // Call RocksDBStore method reportDiskMapping()
@@ -88,7 +104,11 @@ public class StoreSnapshotFile {
                 }
 
                 try {
-                    this.compressSnapshotDir(writer, snapshotDirMaps);
+                    if (this.incremental) {
+                        this.linkSnapshotDir(writer, snapshotDirMaps);
+                    } else {
+                        this.compressSnapshotDir(writer, snapshotDirMaps);
+                    }
                     this.deleteSnapshotDirs(snapshotDirMaps.keySet());
                     done.run(Status.OK());
                 } catch (Throwable e) {
@@ -118,8 +138,13 @@ public class StoreSnapshotFile {
 
         try {
             for (String snapshotDirTar : snapshotDirTars) {
-                String snapshotDir = this.decompressSnapshot(reader, snapshotDirTar);
-                snapshotDirs.add(snapshotDir);
+                if (snapshotDirTar.endsWith(TAR)) {
+                    String snapshotDir = this.decompressSnapshot(reader, snapshotDirTar);
+                    snapshotDirs.add(snapshotDir);
+                } else {
+                    // Snapshot file saved by incremental mode
+                    this.restoreSnapshotFile(reader, snapshotDirTar, snapshotDirs);
+                }
             }
         } catch (Throwable e) {
             LOG.error("Failed to decompress snapshot tar", e);
@@ -131,6 +156,8 @@ public class StoreSnapshotFile {
         try {
             this.doSnapshotLoad();
             this.deleteSnapshotDirs(snapshotDirs);
+            // The data files have been replaced, the cached checksums are stale
+            this.sstChecksums = new HashMap<>();
         } catch (Throwable e) {
             LOG.error("Failed to load snapshot", e);
             return false;
@@ -189,6 +216,120 @@ public class StoreSnapshotFile {
         }
     }
 
+    private void linkSnapshotDir(SnapshotWriter writer, Map<String, String> snapshotDirMaps) {
+        String writerPath = writer.getPath();
+        Map<String, String> checksums = new HashMap<>();
+        int reused = 0;
+        long begin = System.currentTimeMillis();
+        for (Map.Entry<String, String> entry : snapshotDirMaps.entrySet()) {
+            Path snapshotDir = Paths.get(entry.getKey()).toAbsolutePath();
+            String diskTableKey = entry.getValue();
+            Path rootDir = snapshotDir.getParent();
+            Collection<File> files = FileUtils.listFiles(snapshotDir.toFile(), null, true);
+            for (File file : files) {
+                /*
+                 * snapshot_rocksdb-data/g/000012.sst -> general
+                 * snapshot_rocksdb-vertex/g/000034.sst -> g/VERTEX
+                 */
+                String fileName = rootDir.relativize(file.toPath()).toString();
+                String checksum;
+                try {
+                    linkOrCopy(file.toPath(), Paths.get(writerPath, fileName));
+                    String key = String.join("@", fileName, String.valueOf(file.length()),
+                                             String.valueOf(file.lastModified()));
+                    checksum = this.sstChecksums.get(key);
+                    if (checksum != null) {
+                        reused++;
+                    } else {
+                        checksum = fileChecksum(file);
+                    }
+                    if (fileName.endsWith(SST)) {
+                        checksums.put(key, checksum);
+                    }
+                } catch (IOException e) {
+                    throw new RaftException("Failed to link snapshot file '%s' to '%s'",
+                                            e, file, writerPath);
+                }
+
+                LocalFileMeta.Builder metaBuilder = LocalFileMeta.newBuilder();
+                metaBuilder.setChecksum(checksum);
+                metaBuilder.setUserMeta(ByteString.copyFromUtf8(diskTableKey));
+                if (!writer.addFile(fileName, metaBuilder.build())) {
+                    throw new RaftException("Failed to add snapshot file: '%s'", fileName);
+                }
+            }
+        }
+        this.sstChecksums = checksums;
+        long end = System.currentTimeMillis();
+        LOG.info("Linked snapshot dirs {} to '{}' with {} sst files ({} reused), " +
+                 "took {} seconds", snapshotDirMaps.keySet(), writerPath,
+                 checksums.size(), reused, (end - begin) / 1000.0F);
+    }
+
+    private void restoreSnapshotFile(SnapshotReader reader, String fileName,
+                                     Set<String> snapshotDirs) throws IOException {
+        LocalFileMeta meta = (LocalFileMeta) reader.getFileMeta(fileName);
+        if (meta == null) {
+            throw new IOException("Can't find snapshot file, path=" + fileName);
+        }
+
+        String diskTableKey = meta.getUserMeta().toStringUtf8();
+        E.checkArgument(this.dataDisks.containsKey(diskTableKey),
+                        "The data path for '%s' should be exist", diskTableKey);
+        String dataPath = this.dataDisks.get(diskTableKey);
+        Path parentPath = Paths.get(dataPath).toAbsolutePath().getParent();
+        String snapshotDir = parentPath.resolve(Paths.get(fileName).getName(0)).toString();
+        if (snapshotDirs.add(snapshotDir)) {
+            FileUtils.deleteDirectory(new File(snapshotDir));
+            LOG.info("Delete stale snapshot dir {}", snapshotDir);
+        }
+
+        /*
+         * Verify the file before linking it, rocksdb only checks the block
+         * checksums of sst files while reading, and a corrupted MANIFEST or
+         * a truncated file copied from leader would break the whole store
+         */
+        Path source = Paths.get(reader.getPath(), fileName);
+        if (meta.hasChecksum()) {
+            String expected = meta.getChecksum();
+            String actual = fileChecksum(source.toFile());
+            E.checkArgument(expected.equals(actual),
+                            "Snapshot file '%s' checksum error: '%s' != '%s'",
+                            fileName, actual, expected);
+        }
+        linkOrCopy(source, parentPath.resolve(fileName));
+    }
+
+    private static void linkOrCopy(Path source, Path target) throws IOException {
+        Files.createDirectories(target.getParent());
+        Files.deleteIfExists(target);
+        /*
+         * Only sst files are immutable, others like MANIFEST may be appended
+         * by rocksdb after being loaded, so they must be copied
+         */
+        if (source.toString().endsWith(SST)) {
+            try {
+                Files.createLink(target, source);
+                return;
+            } catch (IOException | UnsupportedOperationException e) {
+                LOG.debug("Can't link '{}' to '{}', fallback to copy", source, target, e);
+            }
+        }
+        Files.copy(source, target, StandardCopyOption.REPLACE_EXISTING);
+    }
+
+    private static String fileChecksum(File file) throws IOException {
+        Checksum checksum = new CRC64();
+        byte[] buffer = new byte[64 * 1024];
+        try (InputStream is = new CheckedInputStream(Files.newInputStream(file.toPath()),
+                                                     checksum)) {
+            while (is.read(buffer) != -1) {
+                // Read the whole file to update the checksum
+            }
+        }
+        return Long.toHexString(checksum.getValue());
+    }
+
     private String decompressSnapshot(SnapshotReader reader,
                                       String snapshotDirTar) throws IOException {
         LocalFileMeta meta = (LocalFileMeta) reader.getFileMeta(snapshotDirTar);
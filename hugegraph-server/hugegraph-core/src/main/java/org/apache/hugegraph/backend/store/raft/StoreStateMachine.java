@@ -55,7 +55,8 @@ public final class StoreStateMachine extends StateMachineAdapter {
 
     public StoreStateMachine(RaftContext context) {
         this.context = context;
-        this.snapshotFile = new StoreSnapshotFile(context.stores());
+        this.snapshotFile = new StoreSnapshotFile(context.stores(),
+                                                  context.snapshotIncremental());
     }
 
     private BackendStore store(StoreType type) {
@@ -75,7 +76,15 @@ public final class StoreStateMachine extends StateMachineAdapter {
             // Apply all the logs
             while (iter.hasNext()) {
                 RaftStoreClosure closure = (RaftStoreClosure) iter.done();
-                if (closure != null) {
+                if (closure instanceof RaftBatchClosure) {
+                    RaftBatchClosure batch = (RaftBatchClosure) closure;
+                    for (RaftStoreClosure sub : batch.closures()) {
+                        sub.index(iter.getIndex());
+                        futures.add(this.onApplyLeader(sub));
+                    }
+                    batch.complete(Status.OK());
+                } else if (closure != null) {
+                    closure.index(iter.getIndex());
                     futures.add(this.onApplyLeader(closure));
                 } else {
                     futures.add(this.onApplyFollower(iter.getData()));
@@ -115,6 +124,8 @@ public final class StoreStateMachine extends StateMachineAdapter {
             } catch (Throwable e) {
                 future.completeExceptionally(e);
                 throw e;
+            } finally {
+                closure.applied();
             }
             future.complete(result);
             return result;
@@ -127,21 +138,40 @@ public final class StoreStateMachine extends StateMachineAdapter {
         byte[] bytes = data.array();
         // Let the backend thread do it directly
         return this.context.backendExecutor().submit(() -> {
-            BytesBuffer buffer = LZ4Util.decompress(bytes,
-                                                    RaftContext.BLOCK_SIZE);
-            buffer.forReadWritten();
-            StoreType type = StoreType.valueOf(buffer.read());
-            StoreAction action = StoreAction.valueOf(buffer.read());
-            try {
-                return this.applyCommand(type, action, buffer, false);
-            } catch (Throwable e) {
-                String title = "Failed to execute backend command";
-                LOG.error("{}: {}", title, action, e);
-                throw new BackendException(title, e);
-            }
+            return applyLogData(bytes, (type, action, buffer) -> {
+                try {
+                    return this.applyCommand(type, action, buffer, false);
+                } catch (Throwable e) {
+                    String title = "Failed to execute backend command";
+                    LOG.error("{}: {}", title, action, e);
+                    throw new BackendException(title, e);
+                }
+            });
         });
     }
 
+    /**
+     * Apply the compressed data of a raft log entry, the commands coalesced
+     * into a BATCH entry are applied in the submitted order
+     */
+    public static Object applyLogData(byte[] bytes, CommandApplier applier) {
+        BytesBuffer buffer = LZ4Util.decompress(bytes, RaftContext.BLOCK_SIZE);
+        buffer.forReadWritten();
+        StoreType type = StoreType.valueOf(buffer.read());
+        StoreAction action = StoreAction.valueOf(buffer.read());
+        if (action != StoreAction.BATCH) {
+            return applier.apply(type, action, buffer);
+        }
+        for (StoreCommand command : StoreSerializer.readCommands(buffer)) {
+            BytesBuffer buf = BytesBuffer.wrap(command.data());
+            // Skip the StoreType and StoreAction header
+            buf.read();
+            buf.read();
+            applier.apply(command.type(), command.action(), buf);
+        }
+        return null;
+    }
+
     private Object applyCommand(StoreType type, StoreAction action,
                                 BytesBuffer buffer, boolean forwarded) {
         E.checkState(type != StoreType.ALL,
@@ -246,4 +276,10 @@ public final class StoreStateMachine extends StateMachineAdapter {
     public void onError(final RaftException e) {
         LOG.error("Raft error: {}", e.getMessage(), e);
     }
+
+    @FunctionalInterface
+    public interface CommandApplier {
+
+        Object apply(StoreType type, StoreAction action, BytesBuffer buffer);
+    }
 }
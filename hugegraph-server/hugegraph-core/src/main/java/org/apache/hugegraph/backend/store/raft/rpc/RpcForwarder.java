@@ -87,6 +87,7 @@ public class RpcForwarder {
                     // via RaftClosure. Therefore, the result is returned as a RaftClosure here.
                     RaftClosure<Status> supplierFuture = new RaftClosure<>();
                     supplierFuture.complete(Status.OK());
+                    future.index(response.getIndex());
                     future.complete(Status.OK(), () -> supplierFuture);
                 } else {
                     LOG.debug("StoreCommandResponse status error");
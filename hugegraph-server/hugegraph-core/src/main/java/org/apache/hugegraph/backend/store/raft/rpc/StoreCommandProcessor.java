@@ -55,7 +55,8 @@ public class StoreCommandProcessor
             RaftStoreClosure closure = new RaftStoreClosure(command);
             node.submitAndWait(command, closure);
             // TODO: return the submitAndWait() result to rpc client
-            return StoreCommandResponse.newBuilder().setStatus(true).build();
+            return StoreCommandResponse.newBuilder().setStatus(true)
+                                       .setIndex(closure.index()).build();
         } catch (Throwable e) {
             LOG.warn("Failed to process StoreCommandRequest: {}",
                      request.getAction(), e);
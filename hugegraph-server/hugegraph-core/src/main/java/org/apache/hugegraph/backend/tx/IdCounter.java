@@ -18,25 +18,44 @@
 package org.apache.hugegraph.backend.tx;
 
 import java.util.Map;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
 import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicReference;
 
 import org.apache.hugegraph.backend.BackendException;
 import org.apache.hugegraph.backend.id.Id;
 import org.apache.hugegraph.backend.id.IdGenerator;
 import org.apache.hugegraph.pd.client.PDClient;
 import org.apache.hugegraph.pd.grpc.Pdpb;
-import org.apache.hugegraph.store.term.HgPair;
 import org.apache.hugegraph.type.HugeType;
 import org.apache.hugegraph.util.E;
+import org.apache.hugegraph.util.Log;
+import org.slf4j.Logger;
 
+/**
+ * Allocates ids from segments leased from pd. The current segment is consumed by a CAS
+ * without locking, the next one is prefetched asynchronously once half of the current one
+ * is used, and the segment size follows the allocation rate of each type.
+ */
 public class IdCounter {
 
+    private static final Logger LOG = Log.logger(IdCounter.class);
+
     private static final int TIMES = 10000;
     private static final int DELTA = 10000;
+    private static final int MAX_DELTA = DELTA << 9;
+    // A segment is expected to last about this long, or its size is doubled or halved
+    private static final long SEGMENT_LIFE_MS = 10_000L;
     private static final String DELIMITER = "/";
-    private static final Map<String, HgPair<AtomicLong, AtomicLong>> ids =
-        new ConcurrentHashMap<>();
+    private static final Map<String, Segments> ids = new ConcurrentHashMap<>();
+    private static final ExecutorService prefetcher = Executors.newCachedThreadPool(r -> {
+        Thread t = new Thread(r, "id-prefetch");
+        t.setDaemon(true);
+        return t;
+    });
     private final PDClient pdClient;
     private final String graphName;
 
@@ -65,27 +84,8 @@ public class IdCounter {
         return this.getCounterFromPd(type);
     }
 
-    public synchronized void increaseCounter(HugeType type, long lowest) {
-        String key = toKey(this.graphName, type);
-        getCounterFromPd(type);
-        HgPair<AtomicLong, AtomicLong> idPair = ids.get(key);
-        AtomicLong currentId = idPair.getKey();
-        AtomicLong maxId = idPair.getValue();
-        if (currentId.longValue() >= lowest) {
-            return;
-        }
-        if (maxId.longValue() >= lowest) {
-            currentId.set(lowest);
-            return;
-        }
-        synchronized (ids) {
-            try {
-                this.pdClient.getIdByKey(key, (int) (lowest - maxId.longValue()));
-                ids.remove(key);
-            } catch (Exception e) {
-                throw new BackendException(e);
-            }
-        }
+    public void increaseCounter(HugeType type, long lowest) {
+        this.segments(type).increase(lowest);
     }
 
     protected String toKey(String graphName, HugeType type) {
@@ -95,48 +95,153 @@ public class IdCounter {
     }
 
     public long getCounterFromPd(HugeType type) {
-        AtomicLong currentId;
-        AtomicLong maxId;
-        HgPair<AtomicLong, AtomicLong> idPair;
+        long id = this.segments(type).nextId();
+        E.checkArgument(id != 0L,
+                        "Having made too many attempts to get the" +
+                        " ID for type '%s'", type.name());
+        return id;
+    }
+
+    private Segments segments(HugeType type) {
         String key = toKey(this.graphName, type);
-        if ((idPair = ids.get(key)) == null) {
-            synchronized (ids) {
-                if ((idPair = ids.get(key)) == null) {
-                    try {
-                        currentId = new AtomicLong(0);
-                        maxId = new AtomicLong(0);
-                        idPair = new HgPair<>(currentId, maxId);
-                        ids.put(key, idPair);
-                    } catch (Exception e) {
-                        throw new BackendException(String.format(
-                                "Failed to get the ID from pd,%s", e));
+        return ids.computeIfAbsent(key, k -> new Segments(this.pdClient, k));
+    }
+
+    private static final class Segment {
+
+        private final AtomicLong current;
+        private final long max;
+        private final long prefetchAt;
+        // Zero for the empty segments standing in before the first lease
+        private long activatedAt;
+
+        private Segment(long start, long delta) {
+            this.current = new AtomicLong(start);
+            this.max = start + delta;
+            this.prefetchAt = start + delta / 2;
+        }
+    }
+
+    /**
+     * The ids of a key, ids in (current, max] of the segment are not handed out yet
+     */
+    private static final class Segments {
+
+        private final PDClient pdClient;
+        private final String key;
+        private final AtomicReference<CompletableFuture<Segment>> next;
+        private volatile Segment segment;
+        private volatile int delta;
+
+        private Segments(PDClient pdClient, String key) {
+            this.pdClient = pdClient;
+            this.key = key;
+            this.next = new AtomicReference<>();
+            this.segment = new Segment(0L, 0L);
+            this.delta = DELTA;
+        }
+
+        private long nextId() {
+            for (int i = 0; i < TIMES; i++) {
+                Segment segment = this.segment;
+                long id = segment.current.incrementAndGet();
+                if (id <= segment.max) {
+                    if (id == segment.prefetchAt) {
+                        this.prefetch();
                     }
+                    return id;
                 }
+                this.renew(segment);
             }
+            return 0L;
         }
-        currentId = idPair.getKey();
-        maxId = idPair.getValue();
-        for (int i = 0; i < TIMES; i++) {
-            synchronized (currentId) {
-                if ((currentId.incrementAndGet()) <= maxId.longValue()) {
-                    return currentId.longValue();
+
+        private synchronized void renew(Segment exhausted) {
+            if (this.segment != exhausted) {
+                // Renewed by another thread
+                return;
+            }
+            if (exhausted.activatedAt != 0L) {
+                this.adapt(System.currentTimeMillis() - exhausted.activatedAt);
+            }
+            Segment segment = null;
+            CompletableFuture<Segment> future = this.next.getAndSet(null);
+            if (future != null) {
+                try {
+                    segment = future.join();
+                } catch (Exception e) {
+                    LOG.warn("Failed to prefetch the ids of '{}'", this.key, e);
                 }
-                if (currentId.longValue() > maxId.longValue()) {
-                    try {
-                        Pdpb.GetIdResponse idByKey = pdClient.getIdByKey(key, DELTA);
-                        idPair.getValue().getAndSet(idByKey.getId() +
-                                                    idByKey.getDelta());
-                        idPair.getKey().getAndSet(idByKey.getId());
-                    } catch (Exception e) {
-                        throw new BackendException(String.format(
-                                "Failed to get the ID from pd,%s", e));
-                    }
+            }
+            if (segment == null) {
+                segment = this.fetch(this.delta);
+            }
+            segment.activatedAt = System.currentTimeMillis();
+            this.segment = segment;
+        }
+
+        private synchronized void increase(long lowest) {
+            Segment segment = this.segment;
+            if (segment.current.get() >= lowest) {
+                return;
+            }
+            if (segment.max >= lowest) {
+                segment.current.accumulateAndGet(lowest, Math::max);
+                return;
+            }
+            // Drop the rest of the ids, including the prefetched ones
+            long max = segment.max;
+            segment.current.accumulateAndGet(max, Math::max);
+            CompletableFuture<Segment> future = this.next.getAndSet(null);
+            if (future != null) {
+                try {
+                    max = Math.max(max, future.join().max);
+                } catch (Exception e) {
+                    LOG.warn("Failed to prefetch the ids of '{}'", this.key, e);
                 }
             }
+            if (max < lowest) {
+                try {
+                    this.pdClient.getIdByKey(this.key, (int) (lowest - max));
+                } catch (Exception e) {
+                    throw new BackendException(e);
+                }
+            }
+            this.segment = new Segment(lowest, 0L);
+        }
+
+        private void prefetch() {
+            CompletableFuture<Segment> future = new CompletableFuture<>();
+            if (!this.next.compareAndSet(null, future)) {
+                return;
+            }
+            int delta = this.delta;
+            prefetcher.execute(() -> {
+                try {
+                    future.complete(this.fetch(delta));
+                } catch (Throwable e) {
+                    future.completeExceptionally(e);
+                }
+            });
+        }
+
+        private void adapt(long elapsed) {
+            int delta = this.delta;
+            if (elapsed < SEGMENT_LIFE_MS / 2 && delta < MAX_DELTA) {
+                this.delta = delta << 1;
+            } else if (elapsed > SEGMENT_LIFE_MS * 2 && delta > DELTA) {
+                this.delta = delta >> 1;
+            }
+        }
+
+        private Segment fetch(int delta) {
+            try {
+                Pdpb.GetIdResponse response = this.pdClient.getIdByKey(this.key, delta);
+                return new Segment(response.getId(), response.getDelta());
+            } catch (Exception e) {
+                throw new BackendException(String.format(
+                        "Failed to get the ID from pd,%s", e));
+            }
         }
-        E.checkArgument(false,
-                        "Having made too many attempts to get the" +
-                        " ID for type '%s'", type.name());
-        return 0L;
     }
 }
@@ -93,6 +93,30 @@ public class CoreOptions extends OptionHolder {
                     disallowEmpty(),
                     false
             );
+    public static final ConfigOption<String> RAFT_READ_MODE =
+            new ConfigOption<>(
+                    "raft.read_mode",
+                    "The read mode when raft.safe_read is false, 'local' reads " +
+                    "local data directly, 'read_index' does read-index for each " +
+                    "read, 'lease' reads locally on the leader during its lease " +
+                    "and 'bounded' reads locally on any replica once the applied " +
+                    "index reaches the read token of the thread or of the " +
+                    "client session passed by the 'x-hg-read-token' header and lags " +
+                    "behind the leader's commit index confirmed by a read-index " +
+                    "within the leader lease by at most raft.read_max_lag, " +
+                    "otherwise does read-index.",
+                    allowValues("local", "read_index", "lease", "bounded"),
+                    "local"
+            );
+    public static final ConfigOption<Integer> RAFT_READ_MAX_LAG =
+            new ConfigOption<>(
+                    "raft.read_max_lag",
+                    "The max number of raft logs the local applied index may lag " +
+                    "behind the leader's commit index for a local read in " +
+                    "'bounded' read mode.",
+                    rangeInt(0, Integer.MAX_VALUE),
+                    100
+            );
     public static final ConfigOption<String> RAFT_PATH =
             new ConfigOption<>(
                     "raft.path",
@@ -138,6 +162,15 @@ public class CoreOptions extends OptionHolder {
                     disallowEmpty(),
                     false
             );
+    public static final ConfigOption<Boolean> RAFT_SNAPSHOT_INCREMENTAL =
+            new ConfigOption<>(
+                    "raft.snapshot_incremental",
+                    "Whether to save snapshot as individual checkpoint files " +
+                    "instead of zip archives, sst files are hard-linked and " +
+                    "followers only fetch the files they don't have.",
+                    disallowEmpty(),
+                    false
+            );
     public static final ConfigOption<Integer> RAFT_SNAPSHOT_COMPRESS_THREADS =
             new ConfigOption<>(
                     "raft.snapshot_compress_threads",
@@ -198,6 +231,14 @@ public class CoreOptions extends OptionHolder {
                     // jraft default value is 10(sec)
                     60
             );
+    public static final ConfigOption<Integer> RAFT_SUBMIT_BATCH_SIZE =
+            new ConfigOption<>(
+                    "raft.submit_batch_size",
+                    "The max number of concurrent commit commands coalesced " +
+                    "into one raft task on the leader, 1 means no coalescing.",
+                    positiveInt(),
+                    32
+            );
     public static final ConfigOption<Integer> RAFT_RPC_THREADS =
             new ConfigOption<>(
                     "raft.rpc_threads",
@@ -42,13 +42,9 @@ public class RocksDBIngester {
     private static final Logger LOG = Log.logger(RocksDBIngester.class);
 
     private final RocksDB rocksdb;
-    private final IngestExternalFileOptions options;
 
     public RocksDBIngester(RocksDB rocksdb) {
         this.rocksdb = rocksdb;
-
-        this.options = new IngestExternalFileOptions();
-        this.options.setMoveFiles(true);
     }
 
     public List<String> ingest(Path path, ColumnFamilyHandle cf) throws RocksDBException {
@@ -74,8 +70,13 @@ public class RocksDBIngester {
 
     public void ingest(ColumnFamilyHandle cf, List<String> ssts) throws RocksDBException {
         LOG.info("Ingest sst files to CF '{}': {}", RocksDBStdSessions.decode(cf.getName()), ssts);
-        if (!ssts.isEmpty()) {
-            this.rocksdb.ingestExternalFile(cf, ssts, this.options);
+        if (ssts.isEmpty()) {
+            return;
+        }
+        // Release the native options after ingesting
+        try (IngestExternalFileOptions options = new IngestExternalFileOptions()) {
+            options.setMoveFiles(true);
+            this.rocksdb.ingestExternalFile(cf, ssts, options);
         }
     }
 
@@ -78,6 +78,49 @@ public class RocksDBOptions extends OptionHolder {
                     ImmutableList.of()
             );
 
+    public static final ConfigOption<String> COLD_PATH =
+            new ConfigOption<>(
+                    "rocksdb.cold_path",
+                    "The path on large and cheap disk for storing cold data, " +
+                    "SST files of the lower levels will be placed here once " +
+                    "data_path exceeds hot_path_target_size, empty means disabled. " +
+                    "It can't be used with raft mode or snapshots, since the " +
+                    "rocksdb checkpoint only covers a single db path.",
+                    null,
+                    ""
+            );
+
+    public static final ConfigOption<Long> HOT_PATH_TARGET_SIZE =
+            new ConfigOption<>(
+                    "rocksdb.hot_path_target_size",
+                    "The target size in bytes of data_path when cold_path is set, " +
+                    "levels that don't fit in it will be placed on cold_path.",
+                    rangeInt(1L, Long.MAX_VALUE),
+                    100L * Bytes.GB
+            );
+
+    public static final ConfigListOption<String> HOT_TABLES =
+            new ConfigListOption<>(
+                    "rocksdb.hot_tables",
+                    false,
+                    "The tables whose all levels are kept on data_path even if " +
+                    "cold_path is set, like [vertex, edge_out, edge_in].",
+                    null,
+                    String.class,
+                    ImmutableList.of()
+            );
+
+    public static final ConfigListOption<String> COLD_TABLES =
+            new ConfigListOption<>(
+                    "rocksdb.cold_tables",
+                    false,
+                    "The tables whose all levels are placed on cold_path, " +
+                    "like [search_index, shard_index].",
+                    null,
+                    String.class,
+                    ImmutableList.of()
+            );
+
     public static final ConfigOption<String> WAL_PATH =
             new ConfigOption<>(
                     "rocksdb.wal_path",
@@ -94,6 +137,16 @@ public class RocksDBOptions extends OptionHolder {
                     ""
             );
 
+    public static final ConfigOption<String> BULKLOAD_STAGING_PATH =
+            new ConfigOption<>(
+                    "rocksdb.bulkload_staging_path",
+                    "The path for staging SST files generated by online bulkload, " +
+                    "it should be on the same disk as data_path so that files can " +
+                    "be moved into RocksDB, empty means a sibling of data_path.",
+                    null,
+                    ""
+            );
+
     // TODO: support ConfigOption<InfoLogLevel>
     public static final ConfigOption<String> LOG_LEVEL =
             new ConfigOption<>(
@@ -59,6 +59,12 @@ public abstract class RocksDBSessions extends BackendSessionPool {
 
     public abstract void forceCloseRocksDB();
 
+    /**
+     * Create a session which collects puts and commits them by generating
+     * sorted SST files and ingesting them, the DB keeps serving meanwhile
+     */
+    public abstract Session bulkloadSession();
+
     @Override
     public abstract Session session();
 
@@ -18,10 +18,13 @@
 package org.apache.hugegraph.backend.store.rocksdb;
 
 import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.HashMap;
 import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
@@ -40,6 +43,8 @@ import org.apache.hugegraph.backend.store.BackendEntryIterator;
 import org.apache.hugegraph.backend.store.rocksdb.RocksDBIteratorPool.ReusedRocksIterator;
 import org.apache.hugegraph.config.CoreOptions;
 import org.apache.hugegraph.config.HugeConfig;
+import org.apache.hugegraph.exception.NotSupportException;
+import org.apache.hugegraph.type.HugeType;
 import org.apache.hugegraph.util.Bytes;
 import org.apache.hugegraph.util.E;
 import org.apache.hugegraph.util.Log;
@@ -53,7 +58,9 @@ import org.rocksdb.ColumnFamilyOptionsInterface;
 import org.rocksdb.CompressionType;
 import org.rocksdb.DBOptions;
 import org.rocksdb.DBOptionsInterface;
+import org.rocksdb.DbPath;
 import org.rocksdb.Env;
+import org.rocksdb.EnvOptions;
 import org.rocksdb.IndexType;
 import org.rocksdb.InfoLogLevel;
 import org.rocksdb.LRUCache;
@@ -64,6 +71,7 @@ import org.rocksdb.RocksDB;
 import org.rocksdb.RocksDBException;
 import org.rocksdb.RocksIterator;
 import org.rocksdb.SstFileManager;
+import org.rocksdb.SstFileWriter;
 import org.rocksdb.TableFormatConfig;
 import org.rocksdb.WriteBatch;
 import org.rocksdb.WriteOptions;
@@ -145,6 +153,7 @@ public class RocksDBStdSessions extends RocksDBSessions {
                     encode(table));
             ColumnFamilyOptions options = cfd.getOptions();
             initOptions(this.config(), null, null, options, options);
+            initTieredPaths(this.config(), this.dataPath, table, options);
             cfds.add(cfd);
         }
 
@@ -215,6 +224,12 @@ public class RocksDBStdSessions extends RocksDBSessions {
         this.rocksdb().close();
     }
 
+    @Override
+    public Session bulkloadSession() {
+        this.checkValid();
+        return new BulkloadSession();
+    }
+
     @Override
     public List<String> property(String property) {
         try {
@@ -252,11 +267,13 @@ public class RocksDBStdSessions extends RocksDBSessions {
 
     @Override
     public void createSnapshot(String snapshotPath) {
+        this.checkSnapshotSupported();
         this.rocksdb.createCheckpoint(snapshotPath);
     }
 
     @Override
     public void resumeSnapshot(String snapshotPath) {
+        this.checkSnapshotSupported();
         File originDataDir = new File(this.dataPath);
         File snapshotDir = new File(snapshotPath);
         try {
@@ -299,6 +316,7 @@ public class RocksDBStdSessions extends RocksDBSessions {
 
     @Override
     public String hardLinkSnapshot(String snapshotPath) throws RocksDBException {
+        this.checkSnapshotSupported();
         String snapshotLinkPath = this.dataPath + "_temp";
         try (OpenedRocksDB rocksdb = openRocksDB(this.config, ImmutableList.of(),
                                                  snapshotPath, null)) {
@@ -308,6 +326,17 @@ public class RocksDBStdSessions extends RocksDBSessions {
         return snapshotLinkPath;
     }
 
+    private void checkSnapshotSupported() {
+        /*
+         * The checkpoint of RocksDB only covers a single db path, and the
+         * resumed data path would refer to the files left on the cold path
+         */
+        if (coldPath(this.config, this.dataPath) != null) {
+            throw new NotSupportException("snapshot of rocksdb with cold_path '%s'",
+                                          this.config.get(RocksDBOptions.COLD_PATH));
+        }
+    }
+
     @Override
     public final Session session() {
         return (Session) super.getOrNewSession();
@@ -365,11 +394,21 @@ public class RocksDBStdSessions extends RocksDBSessions {
         }
     }
 
+    private Path bulkloadPath() {
+        String path = this.config().get(RocksDBOptions.BULKLOAD_STAGING_PATH);
+        if (path == null || path.isEmpty()) {
+            // Keep staging files on the same disk to ingest them by moving
+            return Paths.get(this.dataPath + "_bulkload");
+        }
+        return Paths.get(path, Paths.get(this.dataPath).getFileName().toString());
+    }
+
     private static OpenedRocksDB openRocksDB(HugeConfig config, String dataPath,
                                              String walPath) throws RocksDBException {
         // Init options
         Options options = new Options();
         RocksDBStdSessions.initOptions(config, options, options, options, options);
+        RocksDBStdSessions.initTieredPaths(config, dataPath, options);
         options.setWalDir(walPath);
         SstFileManager sstFileManager = new SstFileManager(Env.getDefault());
         options.setSstFileManager(sstFileManager);
@@ -396,12 +435,14 @@ public class RocksDBStdSessions extends RocksDBSessions {
             ColumnFamilyDescriptor cfd = new ColumnFamilyDescriptor(encode(cf));
             ColumnFamilyOptions options = cfd.getOptions();
             RocksDBStdSessions.initOptions(config, null, null, options, options);
+            RocksDBStdSessions.initTieredPaths(config, dataPath, cf, options);
             cfds.add(cfd);
         }
 
         // Init DB options
         DBOptions options = new DBOptions();
         RocksDBStdSessions.initOptions(config, options, options, null, null);
+        RocksDBStdSessions.initTieredPaths(config, dataPath, options);
         if (walPath != null) {
             options.setWalDir(walPath);
         }
@@ -626,6 +667,68 @@ public class RocksDBStdSessions extends RocksDBSessions {
         }
     }
 
+    /**
+     * Place SST files of the lower levels on the cold path once the data path
+     * exceeds its target size, see the `db_paths` option of RocksDB
+     */
+    private static void initTieredPaths(HugeConfig conf, String dataPath,
+                                        DBOptionsInterface<?> db) {
+        Path cold = coldPath(conf, dataPath);
+        if (cold == null) {
+            return;
+        }
+        // Raft mode needs snapshots, which don't support multiple db paths
+        E.checkArgument(!conf.get(CoreOptions.RAFT_MODE),
+                        "The rocksdb.cold_path can't be set in raft mode");
+        long hotSize = conf.get(RocksDBOptions.HOT_PATH_TARGET_SIZE);
+        db.setDbPaths(ImmutableList.of(new DbPath(hotPath(dataPath), hotSize),
+                                       new DbPath(cold, Long.MAX_VALUE)));
+    }
+
+    private static void initTieredPaths(HugeConfig conf, String dataPath,
+                                        String cf, ColumnFamilyOptions options) {
+        Path cold = coldPath(conf, dataPath);
+        if (cold == null) {
+            return;
+        }
+        // Pin all levels of the hinted tables to the hot or the cold path
+        if (matchTables(conf.get(RocksDBOptions.HOT_TABLES), cf)) {
+            options.setCfPaths(ImmutableList.of(new DbPath(hotPath(dataPath),
+                                                           Long.MAX_VALUE)));
+        } else if (matchTables(conf.get(RocksDBOptions.COLD_TABLES), cf)) {
+            options.setCfPaths(ImmutableList.of(new DbPath(cold, Long.MAX_VALUE)));
+        }
+    }
+
+    private static Path hotPath(String dataPath) {
+        return Paths.get(dataPath).toAbsolutePath();
+    }
+
+    private static Path coldPath(HugeConfig conf, String dataPath) {
+        String coldPath = conf.get(RocksDBOptions.COLD_PATH);
+        if (coldPath == null || coldPath.isEmpty()) {
+            return null;
+        }
+        // Like: cold_path/rocksdb-data/g for parent_path/rocksdb-data/g
+        Path hot = hotPath(dataPath);
+        Path cold = Paths.get(coldPath, hot.getParent().getFileName().toString(),
+                              hot.getFileName().toString()).toAbsolutePath();
+        E.checkArgument(!cold.startsWith(hot) && !hot.startsWith(cold),
+                        "Invalid cold path (can't be nested with data path): '%s'",
+                        coldPath);
+        return cold;
+    }
+
+    private static boolean matchTables(List<String> types, String cf) {
+        for (String type : types) {
+            HugeType table = HugeType.valueOf(type.trim().toUpperCase());
+            if (cf.endsWith("+" + RocksDBTables.tableName(table))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     public static TableFormatConfig initTableConfig(HugeConfig conf) {
         BlockBasedTableConfig tableConfig = new BlockBasedTableConfig();
 
@@ -1023,6 +1126,236 @@ public class RocksDBStdSessions extends RocksDBSessions {
         }
     }
 
+    /**
+     * BulkloadSession implement for RocksDB, puts are buffered in memory and
+     * written into one sorted SST file per table at commit time, then the
+     * files are ingested into the opened DB (per CF atomically)
+     */
+    private final class BulkloadSession extends RocksDBSessions.Session {
+
+        private final Map<String, List<Pair<byte[], byte[]>>> batch;
+
+        public BulkloadSession() {
+            this.batch = new HashMap<>();
+        }
+
+        @Override
+        public void open() {
+            this.opened = true;
+        }
+
+        @Override
+        public void close() {
+            assert this.closeable();
+            this.opened = false;
+        }
+
+        /**
+         * Any change in the session
+         */
+        @Override
+        public boolean hasChanges() {
+            return !this.batch.isEmpty();
+        }
+
+        /**
+         * Commit all puts to DB by generating and ingesting SST files
+         */
+        @Override
+        public Integer commit() {
+            if (this.batch.isEmpty()) {
+                return 0;
+            }
+
+            // The number of distinct keys written
+            int count = 0;
+            Path staging = null;
+            try {
+                Path root = bulkloadPath();
+                FileUtils.forceMkdir(root.toFile());
+                staging = Files.createTempDirectory(root, "bulkload-");
+
+                Map<String, String> ssts = new HashMap<>();
+                for (Map.Entry<String, List<Pair<byte[], byte[]>>> e :
+                        this.batch.entrySet()) {
+                    String table = e.getKey();
+                    Path sst = staging.resolve(table + RocksDBIngester.SST);
+                    List<Pair<byte[], byte[]>> changes = distinct(e.getValue());
+                    count += changes.size();
+                    if (this.writeSst(sst, changes)) {
+                        ssts.put(table, sst.toString());
+                    }
+                }
+
+                RocksDBIngester ingester = new RocksDBIngester(rocksdb());
+                for (Map.Entry<String, String> e : ssts.entrySet()) {
+                    try (OpenedRocksDB.CFHandle cf = cf(e.getKey())) {
+                        ingester.ingest(cf.get(), ImmutableList.of(e.getValue()));
+                    }
+                }
+            } catch (IOException | RocksDBException e) {
+                throw new BackendException("Failed to bulkload into '%s'",
+                                           e, RocksDBStdSessions.this.dataPath);
+            } finally {
+                if (staging != null) {
+                    FileUtils.deleteQuietly(staging.toFile());
+                }
+            }
+
+            // Clear batch if ingest successfully (retained if failed)
+            this.batch.clear();
+
+            return count;
+        }
+
+        /**
+         * Sort the puts by key, only the last put of the same key is kept
+         */
+        private List<Pair<byte[], byte[]>> distinct(List<Pair<byte[], byte[]>> changes) {
+            // Stable sort, so the later put of the same key follows the former
+            changes.sort((a, b) -> Bytes.compare(a.getKey(), b.getKey()));
+
+            int size = changes.size();
+            List<Pair<byte[], byte[]>> results = new ArrayList<>(size);
+            for (int i = 0; i < size; i++) {
+                Pair<byte[], byte[]> change = changes.get(i);
+                if (i + 1 < size &&
+                    Bytes.equals(change.getKey(), changes.get(i + 1).getKey())) {
+                    // Overwritten by the later one
+                    continue;
+                }
+                results.add(change);
+            }
+            return results;
+        }
+
+        /**
+         * Write the sorted distinct puts into a SST file
+         * @return whether any entries were written
+         */
+        private boolean writeSst(Path file, List<Pair<byte[], byte[]>> changes)
+                                 throws RocksDBException {
+            if (changes.isEmpty()) {
+                // SstFileWriter can't finish a file without entries
+                return false;
+            }
+
+            try (EnvOptions env = new EnvOptions();
+                 Options options = new Options()) {
+                initOptions(config(), options, options, options, options);
+                // NOTE: unset merge op due to SIGSEGV when cf.setMergeOperatorName()
+                options.setMergeOperatorName("not-exist-merge-op");
+                try (SstFileWriter sst = new SstFileWriter(env, options)) {
+                    sst.open(file.toString());
+                    for (Pair<byte[], byte[]> change : changes) {
+                        sst.put(change.getKey(), change.getValue());
+                    }
+                    sst.finish();
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Rollback all puts not committed
+         */
+        @Override
+        public void rollback() {
+            this.batch.clear();
+        }
+
+        @Override
+        public String dataPath() {
+            return RocksDBStdSessions.this.dataPath;
+        }
+
+        @Override
+        public String walPath() {
+            return RocksDBStdSessions.this.walPath;
+        }
+
+        @Override
+        public String property(String table, String property) {
+            throw new NotSupportException("RocksDB bulkload property()");
+        }
+
+        @Override
+        public Pair<byte[], byte[]> keyRange(String table) {
+            throw new NotSupportException("RocksDB bulkload keyRange()");
+        }
+
+        @Override
+        public void compactRange(String table) {
+            throw new NotSupportException("RocksDB bulkload compactRange()");
+        }
+
+        /**
+         * Add a KV record to a table
+         */
+        @Override
+        public void put(String table, byte[] key, byte[] value) {
+            E.checkState(existsTable(table), "Table '%s' is not opened", table);
+            this.batch.computeIfAbsent(table, k -> new ArrayList<>())
+                      .add(Pair.of(key, value));
+        }
+
+        @Override
+        public void merge(String table, byte[] key, byte[] value) {
+            throw new NotSupportException("RocksDB bulkload merge()");
+        }
+
+        @Override
+        public void increase(String table, byte[] key, byte[] value) {
+            throw new NotSupportException("RocksDB bulkload increase()");
+        }
+
+        @Override
+        public void delete(String table, byte[] key) {
+            throw new NotSupportException("RocksDB bulkload delete()");
+        }
+
+        @Override
+        public void deleteSingle(String table, byte[] key) {
+            throw new NotSupportException("RocksDB bulkload deleteSingle()");
+        }
+
+        @Override
+        public void deletePrefix(String table, byte[] key) {
+            throw new NotSupportException("RocksDB bulkload deletePrefix()");
+        }
+
+        @Override
+        public void deleteRange(String table, byte[] keyFrom, byte[] keyTo) {
+            throw new NotSupportException("RocksDB bulkload deleteRange()");
+        }
+
+        @Override
+        public byte[] get(String table, byte[] key) {
+            throw new NotSupportException("RocksDB bulkload get()");
+        }
+
+        @Override
+        public BackendColumnIterator get(String table, List<byte[]> keys) {
+            throw new NotSupportException("RocksDB bulkload get()");
+        }
+
+        @Override
+        public BackendColumnIterator scan(String table) {
+            throw new NotSupportException("RocksDB bulkload scan()");
+        }
+
+        @Override
+        public BackendColumnIterator scan(String table, byte[] prefix) {
+            throw new NotSupportException("RocksDB bulkload scan()");
+        }
+
+        @Override
+        public BackendColumnIterator scan(String table, byte[] keyFrom,
+                                          byte[] keyTo, int scanType) {
+            throw new NotSupportException("RocksDB bulkload scan()");
+        }
+    }
+
     /**
      * A wrapper for RocksIterator that convert RocksDB results to std Iterator
      */
@@ -61,6 +61,7 @@ import org.apache.hugegraph.config.CoreOptions;
 import org.apache.hugegraph.config.HugeConfig;
 import org.apache.hugegraph.exception.ConnectionException;
 import org.apache.hugegraph.type.HugeType;
+import org.apache.hugegraph.type.define.Action;
 import org.apache.hugegraph.util.Consumers;
 import org.apache.hugegraph.util.E;
 import org.apache.hugegraph.util.ExecutorUtil;
@@ -136,6 +137,12 @@ public abstract class RocksDBStore extends AbstractBackendStore<RocksDBSessions.
             RocksDBMetrics metrics = new RocksDBMetrics(dbsGet.get(), session);
             return metrics.compact();
         });
+
+        this.registerMetaHandler("bulkload", (session, meta, args) -> {
+            E.checkArgument(args.length == 1 && args[0] instanceof BackendMutation,
+                            "The args of %s must be a BackendMutation", meta);
+            return this.bulkload((BackendMutation) args[0]);
+        });
     }
 
     protected void registerTableManager(HugeType type, RocksDBTable table) {
@@ -440,6 +447,49 @@ public abstract class RocksDBStore extends AbstractBackendStore<RocksDBSessions.
         }
     }
 
+    /**
+     * Write the mutation by ingesting SST files instead of writing to
+     * memtable and WAL, the store keeps serving queries during ingesting.
+     * NOTE: only INSERT/APPEND actions of OLTP entries are supported
+     */
+    public int bulkload(BackendMutation mutation) {
+        Lock readLock = this.storeLock.readLock();
+        readLock.lock();
+        try {
+            this.checkOpened();
+            // Check all the actions before writing, a bulkload session only supports puts
+            for (HugeType type : mutation.types()) {
+                for (Iterator<BackendAction> it = mutation.mutation(type); it.hasNext(); ) {
+                    BackendAction item = it.next();
+                    E.checkArgument(!item.entry().olap(),
+                                    "Can't bulkload olap entry: %s", item.entry());
+                    E.checkArgument(item.action() == Action.INSERT ||
+                                    item.action() == Action.APPEND,
+                                    "Can't bulkload %s action of entry: %s",
+                                    item.action(), item.entry());
+                }
+            }
+
+            Map<RocksDBSessions, RocksDBSessions.Session> sessions = new HashMap<>();
+            for (HugeType type : mutation.types()) {
+                RocksDBSessions.Session session = sessions.computeIfAbsent(
+                        this.db(type), RocksDBSessions::bulkloadSession);
+                for (Iterator<BackendAction> it = mutation.mutation(type); it.hasNext(); ) {
+                    this.mutate(session, it.next());
+                }
+            }
+
+            int count = 0;
+            for (RocksDBSessions.Session session : sessions.values()) {
+                count += (Integer) session.commit();
+            }
+            LOG.debug("Store {} bulkloaded {} items", this.store, count);
+            return count;
+        } finally {
+            readLock.unlock();
+        }
+    }
+
     private void mutate(RocksDBSessions.Session session, BackendAction item) {
         BackendEntry entry = item.entry();
         RocksDBTable table;
@@ -36,6 +36,20 @@ import org.apache.hugegraph.util.StringEncoding;
 
 public class RocksDBTables {
 
+    /**
+     * Get the table name (without the database prefix) of the specified type
+     */
+    public static String tableName(HugeType type) {
+        switch (type) {
+            case EDGE_OUT:
+                return 'o' + Edge.TABLE_SUFFIX;
+            case EDGE_IN:
+                return 'i' + Edge.TABLE_SUFFIX;
+            default:
+                return type.string();
+        }
+    }
+
     public static class Meta extends RocksDBTable {
 
         private static final String TABLE = HugeType.META.string();
@@ -183,6 +183,11 @@ public class RocksDBSstSessions extends RocksDBSessions {
         throw new UnsupportedOperationException("forceCloseRocksDB");
     }
 
+    @Override
+    public Session bulkloadSession() {
+        throw new NotSupportException("RocksDBSstStore bulkloadSession()");
+    }
+
     private SstFileWriter table(String table) {
         SstFileWriter sst = this.tables.get(table);
         if (sst == null) {
@@ -60,7 +60,10 @@ import org.apache.hugegraph.unit.serializer.SerializerFactoryTest;
 import org.apache.hugegraph.unit.serializer.StoreSerializerTest;
 import org.apache.hugegraph.unit.serializer.TableBackendEntryTest;
 import org.apache.hugegraph.unit.serializer.TextBackendEntryTest;
+import org.apache.hugegraph.unit.store.RaftBatchTest;
+import org.apache.hugegraph.unit.store.RaftReadBoundTest;
 import org.apache.hugegraph.unit.store.RamIntObjectMapTest;
+import org.apache.hugegraph.unit.store.StoreSnapshotFileTest;
 import org.apache.hugegraph.unit.util.CompressUtilTest;
 import org.apache.hugegraph.unit.util.JsonUtilTest;
 import org.apache.hugegraph.unit.util.RateLimiterTest;
@@ -157,7 +160,10 @@ import org.junit.runners.Suite;
         IntSetTest.class,
 
         /* store */
-        RamIntObjectMapTest.class
+        RamIntObjectMapTest.class,
+        RaftReadBoundTest.class,
+        RaftBatchTest.class,
+        StoreSnapshotFileTest.class
 })
 public class UnitTestSuite {
 
@@ -26,7 +26,9 @@ import org.apache.hugegraph.backend.store.rocksdb.RocksDBOptions;
 import org.apache.hugegraph.backend.store.rocksdb.RocksDBSessions;
 import org.apache.hugegraph.backend.store.rocksdb.RocksDBStdSessions;
 import org.apache.hugegraph.backend.store.rocksdbsst.RocksDBSstSessions;
+import org.apache.hugegraph.config.CoreOptions;
 import org.apache.hugegraph.config.HugeConfig;
+import org.apache.hugegraph.exception.NotSupportException;
 import org.apache.hugegraph.testutil.Assert;
 import org.apache.hugegraph.unit.FakeObjects;
 import org.junit.Test;
@@ -157,6 +159,85 @@ public class RocksDBSessionsTest extends BaseRocksDBUnitTest {
         Assert.assertFalse(this.rocks.closed());
     }
 
+    @Test
+    public void testTieredPaths() throws RocksDBException {
+        HugeConfig config = FakeObjects.newConfig();
+        String dataPath = DB_PATH + "/tiered/data";
+        String coldPath = DB_PATH + "/cold";
+        config.addProperty(RocksDBOptions.COLD_PATH.name(), coldPath);
+        config.addProperty(RocksDBOptions.HOT_PATH_TARGET_SIZE.name(), "1");
+
+        RocksDBSessions rocks = new RocksDBStdSessions(config, "db", "store",
+                                                       dataPath, dataPath);
+        rocks.createTable(TABLE);
+        for (int i = 0; i < 1000; i++) {
+            String k = String.format("%03d", i);
+            rocks.session().put(TABLE, getBytes("person:" + k), getBytes("James" + i));
+        }
+        rocks.session().commit();
+        // Move data to the last level which doesn't fit in the hot path
+        rocks.compactRange();
+
+        File cold = new File(coldPath + "/tiered/data");
+        String[] ssts = cold.list((dir, name) -> name.endsWith(".sst"));
+        Assert.assertNotNull(ssts);
+        Assert.assertTrue(ssts.length > 0);
+
+        String value = getString(rocks.session().get(TABLE, getBytes("person:001")));
+        Assert.assertEquals("James1", value);
+        rocks.close();
+    }
+
+    @Test
+    public void testTieredPathsSnapshot() throws RocksDBException {
+        HugeConfig config = FakeObjects.newConfig();
+        String dataPath = DB_PATH + "/tiered_snapshot/data";
+        String coldPath = DB_PATH + "/cold_snapshot";
+        config.addProperty(RocksDBOptions.COLD_PATH.name(), coldPath);
+        config.addProperty(RocksDBOptions.HOT_PATH_TARGET_SIZE.name(), "1");
+
+        RocksDBSessions rocks = new RocksDBStdSessions(config, "db", "store",
+                                                       dataPath, dataPath);
+        rocks.createTable(TABLE);
+        rocks.session().put(TABLE, getBytes("person:1gname"), getBytes("James"));
+        rocks.session().commit();
+        rocks.compactRange();
+
+        // The checkpoint can't cover the cold path, snapshots are refused
+        String snapshotPath = DB_PATH + "/tiered_snapshot/snapshot";
+        Assert.assertThrows(NotSupportException.class, () -> {
+            rocks.createSnapshot(snapshotPath);
+        }, e -> {
+            Assert.assertContains("cold_path", e.getMessage());
+        });
+        Assert.assertFalse(new File(snapshotPath).exists());
+
+        // Resuming must not delete the data path before failing
+        Assert.assertThrows(NotSupportException.class, () -> {
+            rocks.resumeSnapshot(snapshotPath);
+        });
+        Assert.assertThrows(NotSupportException.class, () -> {
+            rocks.hardLinkSnapshot(snapshotPath);
+        });
+        String value = getString(rocks.session().get(TABLE, getBytes("person:1gname")));
+        Assert.assertEquals("James", value);
+        rocks.close();
+    }
+
+    @Test
+    public void testTieredPathsWithRaftMode() {
+        HugeConfig config = FakeObjects.newConfig();
+        String dataPath = DB_PATH + "/tiered_raft/data";
+        config.addProperty(RocksDBOptions.COLD_PATH.name(), DB_PATH + "/cold_raft");
+        config.setProperty(CoreOptions.RAFT_MODE.name(), true);
+
+        Assert.assertThrows(IllegalArgumentException.class, () -> {
+            new RocksDBStdSessions(config, "db", "store", dataPath, dataPath);
+        }, e -> {
+            Assert.assertContains("raft mode", e.getMessage());
+        });
+    }
+
     @Test
     public void testIngestSst() throws RocksDBException {
         HugeConfig config = FakeObjects.newConfig();
@@ -215,4 +296,37 @@ public class RocksDBSessionsTest extends BaseRocksDBUnitTest {
         value = getString(rocks.session().get(TABLE2, getBytes("book:1999")));
         Assert.assertEquals("Java1999", value);
     }
+
+    @Test
+    public void testBulkload() throws RocksDBException {
+        this.put("person:1gname", "James");
+
+        RocksDBSessions.Session session = this.rocks.bulkloadSession();
+        // Unsorted and duplicated keys, the last put wins
+        session.put(TABLE, getBytes("person:3gname"), getBytes("Tom"));
+        session.put(TABLE, getBytes("person:2gname"), getBytes("Lisa"));
+        session.put(TABLE, getBytes("person:1gname"), getBytes("Jame"));
+        session.put(TABLE, getBytes("person:1gname"), getBytes("James2"));
+        Assert.assertTrue(session.hasChanges());
+
+        // Not visible before commit
+        Assert.assertNull(this.get("person:2gname"));
+        // Count the distinct keys
+        Assert.assertEquals(3, session.commit());
+        Assert.assertFalse(session.hasChanges());
+        // Nothing to commit
+        Assert.assertEquals(0, session.commit());
+
+        Assert.assertEquals("James2", this.get("person:1gname"));
+        Assert.assertEquals("Lisa", this.get("person:2gname"));
+        Assert.assertEquals("Tom", this.get("person:3gname"));
+
+        // Keep serving normal writes after ingesting
+        this.put("person:2gname", "Lisa2");
+        Assert.assertEquals("Lisa2", this.get("person:2gname"));
+
+        Assert.assertThrows(NotSupportException.class, () -> {
+            session.delete(TABLE, getBytes("person:1gname"));
+        });
+    }
 }
@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.unit.store;
+
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.apache.hugegraph.backend.serializer.BinaryBackendEntry;
+import org.apache.hugegraph.backend.store.BackendAction;
+import org.apache.hugegraph.backend.store.BackendEntry;
+import org.apache.hugegraph.backend.store.BackendMutation;
+import org.apache.hugegraph.backend.store.raft.RaftBatchClosure;
+import org.apache.hugegraph.backend.store.raft.RaftContext;
+import org.apache.hugegraph.backend.store.raft.RaftStoreClosure;
+import org.apache.hugegraph.backend.store.raft.StoreCommand;
+import org.apache.hugegraph.backend.store.raft.StoreSerializer;
+import org.apache.hugegraph.backend.store.raft.StoreStateMachine;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreAction;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreType;
+import org.apache.hugegraph.testutil.Assert;
+import org.apache.hugegraph.type.HugeType;
+import org.apache.hugegraph.type.define.Action;
+import org.apache.hugegraph.util.LZ4Util;
+import org.junit.Test;
+
+import com.alipay.sofa.jraft.Status;
+import com.alipay.sofa.jraft.error.RaftError;
+
+public class RaftBatchTest {
+
+    private static RaftStoreClosure commitTx(StoreType type, byte id) {
+        BinaryBackendEntry entry = new BinaryBackendEntry(HugeType.VERTEX,
+                                                          new byte[]{1, 2});
+        entry.column(new byte[]{id}, new byte[]{id});
+        BackendMutation mutation = new BackendMutation();
+        mutation.add(entry, Action.INSERT);
+        byte[] data = StoreSerializer.writeMutations(List.of(mutation));
+        return new RaftStoreClosure(new StoreCommand(type, StoreAction.COMMIT_TX,
+                                                     data));
+    }
+
+    private static byte[] logData(StoreCommand command) {
+        // The same as the data of the raft task submitted by the leader
+        return LZ4Util.compress(command.data(), RaftContext.BLOCK_SIZE).bytes();
+    }
+
+    @Test
+    public void testApplyBatchOnFollower() {
+        List<RaftStoreClosure> closures = new ArrayList<>();
+        closures.add(commitTx(StoreType.GRAPH, (byte) 1));
+        closures.add(commitTx(StoreType.SCHEMA, (byte) 2));
+        closures.add(commitTx(StoreType.GRAPH, (byte) 3));
+        RaftBatchClosure batch = new RaftBatchClosure(closures);
+        Assert.assertEquals(StoreAction.BATCH, batch.command().action());
+
+        List<StoreType> types = new ArrayList<>();
+        List<Byte> ids = new ArrayList<>();
+        Object result = StoreStateMachine.applyLogData(
+                logData(batch.command()), (type, action, buffer) -> {
+                    Assert.assertEquals(StoreAction.COMMIT_TX, action);
+                    types.add(type);
+                    for (BackendMutation mutation :
+                            StoreSerializer.readMutations(buffer)) {
+                        Iterator<BackendAction> iter = mutation.mutation();
+                        while (iter.hasNext()) {
+                            BackendEntry entry = iter.next().entry();
+                            ids.add(entry.columns().iterator().next().name[0]);
+                        }
+                    }
+                    return null;
+                });
+
+        Assert.assertNull(result);
+        // Applied in the submitted order
+        Assert.assertEquals(List.of(StoreType.GRAPH, StoreType.SCHEMA,
+                                    StoreType.GRAPH), types);
+        Assert.assertEquals(List.of((byte) 1, (byte) 2, (byte) 3), ids);
+    }
+
+    @Test
+    public void testApplySingleOnFollower() {
+        RaftStoreClosure closure = commitTx(StoreType.GRAPH, (byte) 1);
+        AtomicInteger applied = new AtomicInteger();
+        Object result = StoreStateMachine.applyLogData(
+                logData(closure.command()), (type, action, buffer) -> {
+                    Assert.assertEquals(StoreType.GRAPH, type);
+                    Assert.assertEquals(StoreAction.COMMIT_TX, action);
+                    return applied.incrementAndGet();
+                });
+        Assert.assertEquals(1, result);
+    }
+
+    @Test
+    public void testBatchAppliedAfterAllCommands() {
+        List<RaftStoreClosure> closures = new ArrayList<>();
+        closures.add(commitTx(StoreType.GRAPH, (byte) 1));
+        closures.add(commitTx(StoreType.GRAPH, (byte) 2));
+        RaftBatchClosure batch = new RaftBatchClosure(closures);
+        AtomicInteger released = new AtomicInteger();
+        batch.whenApplied(released::incrementAndGet);
+
+        // Committed but not applied yet, the permit is still held
+        batch.complete(Status.OK());
+        closures.get(0).applied();
+        Assert.assertEquals(0, released.get());
+
+        closures.get(1).applied();
+        Assert.assertEquals(1, released.get());
+    }
+
+    @Test
+    public void testBatchAppliedAfterFailure() {
+        List<RaftStoreClosure> closures = new ArrayList<>();
+        closures.add(commitTx(StoreType.GRAPH, (byte) 1));
+        closures.add(commitTx(StoreType.GRAPH, (byte) 2));
+        RaftBatchClosure batch = new RaftBatchClosure(closures);
+        AtomicInteger released = new AtomicInteger();
+        batch.whenApplied(released::incrementAndGet);
+
+        // The failed commands are never applied, release the permit
+        batch.failure(new Status(RaftError.EPERM, "Not leader"),
+                      new IllegalStateException("Not leader"));
+        Assert.assertEquals(1, released.get());
+        for (RaftStoreClosure closure : closures) {
+            Assert.assertThrows(IllegalStateException.class,
+                                closure::waitFinished);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.unit.store;
+
+import java.util.Map;
+
+import org.apache.hugegraph.backend.store.raft.RaftBackendStore;
+import org.apache.hugegraph.backend.store.raft.RaftReadSession;
+import org.apache.hugegraph.backend.store.raft.RaftStoreClosure;
+import org.apache.hugegraph.backend.store.raft.StoreCommand;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreAction;
+import org.apache.hugegraph.backend.store.raft.rpc.RaftRequests.StoreType;
+import org.apache.hugegraph.testutil.Assert;
+import org.junit.Test;
+
+import com.alipay.sofa.jraft.Status;
+
+public class RaftReadBoundTest {
+
+    @Test
+    public void testWithinStaleBound() {
+        // Caught up with the leader
+        Assert.assertTrue(RaftBackendStore.withinStaleBound(10L, 20L, 20L, 0L));
+        // Lag behind the leader within the bound
+        Assert.assertTrue(RaftBackendStore.withinStaleBound(10L, 15L, 20L, 5L));
+        // Lag behind the leader beyond the bound
+        Assert.assertFalse(RaftBackendStore.withinStaleBound(10L, 14L, 20L, 5L));
+    }
+
+    @Test
+    public void testWithinStaleBoundWithReadToken() {
+        // The local replica hasn't applied the writes of the transaction
+        Assert.assertFalse(RaftBackendStore.withinStaleBound(21L, 20L, 20L, 100L));
+        Assert.assertTrue(RaftBackendStore.withinStaleBound(20L, 20L, 20L, 100L));
+    }
+
+    @Test
+    public void testWithinStaleBoundWithoutLeaderIndex() {
+        /*
+         * The local committed index can't bound the staleness of a follower
+         * partitioned from the leader, never read locally without the
+         * leader's commit index confirmed within the lease
+         */
+        Assert.assertFalse(RaftBackendStore.withinStaleBound(0L, 20L, -1L, 100L));
+        Assert.assertFalse(RaftBackendStore.withinStaleBound(0L, 0L, -1L,
+                                                             Long.MAX_VALUE));
+    }
+
+    @Test
+    public void testReadSession() {
+        // No session, the writes are not recorded
+        RaftReadSession.observe("g1", 10L);
+        Assert.assertEquals(0L, RaftReadSession.token("g1"));
+        Assert.assertNull(RaftReadSession.end());
+
+        // The tokens given by the client
+        RaftReadSession.begin("g1=10, g2=20");
+        Assert.assertEquals(10L, RaftReadSession.token("g1"));
+        Assert.assertEquals(20L, RaftReadSession.token("g2"));
+        Assert.assertEquals(0L, RaftReadSession.token("g3"));
+
+        // Committed by the request, never go back
+        RaftReadSession.observe("g1", 15L);
+        RaftReadSession.observe("g2", 5L);
+        RaftReadSession.observe("g3", 1L);
+        Map<String, Long> tokens = RaftReadSession.parse(RaftReadSession.end());
+        Assert.assertEquals(Map.of("g1", 15L, "g2", 20L, "g3", 1L), tokens);
+        Assert.assertEquals(0L, RaftReadSession.token("g1"));
+
+        // A request without token
+        RaftReadSession.begin(null);
+        Assert.assertEquals(0L, RaftReadSession.token("g1"));
+        Assert.assertNull(RaftReadSession.end());
+
+        Assert.assertThrows(IllegalArgumentException.class, () -> {
+            RaftReadSession.parse("g1");
+        });
+        Assert.assertThrows(IllegalArgumentException.class, () -> {
+            RaftReadSession.parse("g1=x");
+        });
+        Assert.assertThrows(IllegalArgumentException.class, () -> {
+            RaftReadSession.parse("g1=-1");
+        });
+    }
+
+    @Test
+    public void testStoreClosureIndex() {
+        StoreCommand command = new StoreCommand(StoreType.GRAPH,
+                                                StoreAction.COMMIT_TX,
+                                                new byte[]{1});
+        RaftStoreClosure closure = new RaftStoreClosure(command);
+        Assert.assertEquals(0L, closure.index());
+
+        // The state machine records the log index before completing
+        closure.index(35L);
+        closure.complete(Status.OK(), () -> null);
+        Assert.assertEquals(35L, closure.index());
+        Assert.assertTrue(closure.status().isOk());
+    }
+}
@@ -0,0 +1,274 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.unit.store;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Set;
+
+import org.apache.commons.io.FileUtils;
+import org.apache.hugegraph.backend.store.raft.RaftBackendStore;
+import org.apache.hugegraph.backend.store.raft.StoreSnapshotFile;
+import org.apache.hugegraph.testutil.Assert;
+import org.apache.hugegraph.testutil.Whitebox;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.alipay.sofa.jraft.entity.LocalFileMetaOutter.LocalFileMeta;
+import com.alipay.sofa.jraft.entity.RaftOutter;
+import com.alipay.sofa.jraft.storage.snapshot.SnapshotReader;
+import com.alipay.sofa.jraft.storage.snapshot.SnapshotWriter;
+import com.google.protobuf.Message;
+
+public class StoreSnapshotFileTest {
+
+    private static final String SST = "snapshot_rocksdb-data/g/000001.sst";
+    private static final String MANIFEST = "snapshot_rocksdb-data/g/MANIFEST-000001";
+
+    private Path root;
+    private Path dataPath;
+    private StoreSnapshotFile snapshotFile;
+
+    @Before
+    public void setup() throws IOException {
+        this.root = Files.createTempDirectory("hg-snapshot");
+        this.dataPath = this.root.resolve("data");
+        this.snapshotFile = new StoreSnapshotFile(new RaftBackendStore[0], true);
+        Map<String, String> dataDisks = Whitebox.getInternalState(
+                                        this.snapshotFile, "dataDisks");
+        dataDisks.put("general",
+                      this.dataPath.resolve("rocksdb-data").toString());
+    }
+
+    @After
+    public void teardown() {
+        FileUtils.deleteQuietly(this.root.toFile());
+    }
+
+    @Test
+    public void testLinkAndLoadIncrementalSnapshot() throws IOException {
+        this.writeCheckpoint("sst data", "manifest");
+        DirSnapshot snapshot = this.linkSnapshot("raft-1");
+        Assert.assertEquals(Set.of(SST, MANIFEST), snapshot.listFiles());
+        Assert.assertEquals(checksum(this.dataPath.resolve(SST)),
+                            snapshot.metas.get(SST).getChecksum());
+        Assert.assertEquals("general",
+                            snapshot.metas.get(SST).getUserMeta().toStringUtf8());
+
+        this.deleteCheckpoint();
+        Assert.assertTrue(this.snapshotFile.load(snapshot.reader()));
+    }
+
+    @Test
+    public void testLoadCorruptedIncrementalSnapshot() throws IOException {
+        this.writeCheckpoint("sst data", "manifest");
+        DirSnapshot snapshot = this.linkSnapshot("raft-1");
+
+        // Break the link with the checkpoint and truncate the copied file
+        Path copied = Path.of(snapshot.getPath(), SST);
+        Files.delete(copied);
+        Files.write(copied, "sst".getBytes(StandardCharsets.UTF_8));
+
+        this.deleteCheckpoint();
+        Assert.assertFalse(this.snapshotFile.load(snapshot.reader()));
+        // The corrupted file is never linked into the data path
+        Assert.assertFalse(Files.exists(this.dataPath.resolve(SST)));
+    }
+
+    @Test
+    public void testLoadSnapshotFileWithoutChecksum() throws IOException {
+        this.writeCheckpoint("sst data", "manifest");
+        DirSnapshot snapshot = this.linkSnapshot("raft-1");
+        // Accept the files saved without checksum
+        snapshot.metas.replaceAll((name, meta) -> {
+            return meta.toBuilder().clearChecksum().build();
+        });
+        Files.write(Path.of(snapshot.getPath(), MANIFEST),
+                    "changed".getBytes(StandardCharsets.UTF_8));
+
+        this.deleteCheckpoint();
+        Assert.assertTrue(this.snapshotFile.load(snapshot.reader()));
+    }
+
+    @Test
+    public void testReuseChecksumOfLinkedSstFile() throws IOException {
+        this.writeCheckpoint("sst data", "manifest");
+        this.linkSnapshot("raft-1");
+        Map<String, String> checksums = Whitebox.getInternalState(
+                                        this.snapshotFile, "sstChecksums");
+        Assert.assertEquals(1, checksums.size());
+        // Mark the cached checksum to see whether it's reused
+        checksums.replaceAll((key, value) -> "cached");
+
+        this.writeCheckpoint("sst data", "manifest2");
+        DirSnapshot snapshot = this.linkSnapshot("raft-2");
+        Assert.assertEquals("cached", snapshot.metas.get(SST).getChecksum());
+        // The metadata files are always read again
+        Assert.assertEquals(checksum(this.dataPath.resolve(MANIFEST)),
+                            snapshot.metas.get(MANIFEST).getChecksum());
+    }
+
+    private void writeCheckpoint(String sst, String manifest) throws IOException {
+        Path sstFile = this.dataPath.resolve(SST);
+        Files.createDirectories(sstFile.getParent());
+        if (!Files.exists(sstFile)) {
+            // The sst files are immutable
+            Files.write(sstFile, sst.getBytes(StandardCharsets.UTF_8));
+        }
+        Files.write(this.dataPath.resolve(MANIFEST),
+                    manifest.getBytes(StandardCharsets.UTF_8));
+    }
+
+    private void deleteCheckpoint() throws IOException {
+        // The checkpoint dir is deleted after saved into the raft snapshot
+        FileUtils.deleteDirectory(this.dataPath.resolve("snapshot_rocksdb-data")
+                                               .toFile());
+    }
+
+    private DirSnapshot linkSnapshot(String name) {
+        DirSnapshot snapshot = new DirSnapshot(this.root.resolve(name));
+        Map<String, String> snapshotDirs = new HashMap<>();
+        snapshotDirs.put(this.dataPath.resolve("snapshot_rocksdb-data").toString(),
+                         "general");
+        Whitebox.invoke(StoreSnapshotFile.class,
+                        new Class<?>[]{SnapshotWriter.class, Map.class},
+                        "linkSnapshotDir", this.snapshotFile,
+                        snapshot, snapshotDirs);
+        return snapshot;
+    }
+
+    private static String checksum(Path file) {
+        return Whitebox.invokeStatic(StoreSnapshotFile.class, "fileChecksum",
+                                     file.toFile());
+    }
+
+    private static class DirSnapshot extends SnapshotWriter {
+
+        private final String path;
+        private final Map<String, LocalFileMeta> metas;
+
+        public DirSnapshot(Path path) {
+            this.path = path.toString();
+            this.metas = new HashMap<>();
+        }
+
+        public SnapshotReader reader() {
+            DirSnapshot snapshot = this;
+            return new SnapshotReader() {
+
+                @Override
+                public RaftOutter.SnapshotMeta load() {
+                    return null;
+                }
+
+                @Override
+                public String generateURIForCopy() {
+                    return null;
+                }
+
+                @Override
+                public boolean init(Void opts) {
+                    return true;
+                }
+
+                @Override
+                public void shutdown() {
+                    // pass
+                }
+
+                @Override
+                public String getPath() {
+                    return snapshot.getPath();
+                }
+
+                @Override
+                public Set<String> listFiles() {
+                    return snapshot.listFiles();
+                }
+
+                @Override
+                public Message getFileMeta(String fileName) {
+                    return snapshot.getFileMeta(fileName);
+                }
+
+                @Override
+                public void close() {
+                    // pass
+                }
+            };
+        }
+
+        @Override
+        public boolean saveMeta(RaftOutter.SnapshotMeta meta) {
+            return true;
+        }
+
+        @Override
+        public boolean addFile(String fileName, Message fileMeta) {
+            Assert.assertTrue(new File(this.path, fileName).exists());
+            this.metas.put(fileName, (LocalFileMeta) fileMeta);
+            return true;
+        }
+
+        @Override
+        public boolean removeFile(String fileName) {
+            return this.metas.remove(fileName) != null;
+        }
+
+        @Override
+        public void close(boolean keepDataOnError) {
+            // pass
+        }
+
+        @Override
+        public boolean init(Void opts) {
+            return true;
+        }
+
+        @Override
+        public void shutdown() {
+            // pass
+        }
+
+        @Override
+        public String getPath() {
+            return this.path;
+        }
+
+        @Override
+        public Set<String> listFiles() {
+            return this.metas.keySet();
+        }
+
+        @Override
+        public Message getFileMeta(String fileName) {
+            return this.metas.get(fileName);
+        }
+
+        @Override
+        public void close() {
+            // pass
+        }
+    }
+}
@@ -67,6 +67,18 @@ public interface HgStoreNodePartitioner {
                 , HgStoreClientConst.ALL_PARTITION_OWNER);
     }
 
+    /**
+     * Route the owner keys in one pass against one snapshot of the partition routes.
+     *
+     * @param graphName
+     * @param ownerKeys
+     * @return the leader partition of each key, in the order of the keys; null if the
+     * partitioner can not route in batch, then the keys are routed one by one.
+     */
+    default HgNodePartition[] partition(String graphName, List<byte[]> ownerKeys) {
+        return null;
+    }
+
     default String partition(String graphName, byte[] startKey) throws PDException {
         return null;
     }
@@ -79,4 +91,12 @@ public interface HgStoreNodePartitioner {
         return null;
     }
 
+    /**
+     * @param graphName
+     * @return the addresses of the stores holding learner replicas of the graph
+     */
+    default List<String> getLearnerStores(String graphName) throws PDException {
+        return List.of();
+    }
+
 }
@@ -20,6 +20,7 @@ package org.apache.hugegraph.store.client;
 import java.util.Arrays;
 import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
 import java.util.stream.Collectors;
 
 import org.apache.hugegraph.pd.client.PDClient;
@@ -29,6 +30,7 @@ import org.apache.hugegraph.pd.common.PartitionUtils;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.store.client.type.HgNodeStatus;
 import org.apache.hugegraph.store.client.util.HgStoreClientConst;
+import org.apache.hugegraph.store.grpc.session.PartitionRoute;
 
 import lombok.extern.slf4j.Slf4j;
 
@@ -141,6 +143,29 @@ public class HgStoreNodePartitionerImpl implements HgStoreNodePartitioner,
         return 0;
     }
 
+    @Override
+    public HgNodePartition[] partition(String graphName, List<byte[]> ownerKeys) {
+        try {
+            int[] codes = new int[ownerKeys.size()];
+            for (int i = 0; i < codes.length; i++) {
+                codes[i] = pdClient.keyToCode(graphName, ownerKeys.get(i));
+            }
+            KVPair<Metapb.Partition, Metapb.Shard>[] partShards =
+                    pdClient.getPartitionsByCodes(graphName, codes);
+            HgNodePartition[] partitions = new HgNodePartition[codes.length];
+            for (int i = 0; i < codes.length; i++) {
+                Metapb.Shard leader = partShards[i].getValue();
+                if (leader != null) {
+                    partitions[i] = HgNodePartition.of(leader.getStoreId(), codes[i]);
+                }
+            }
+            return partitions;
+        } catch (PDException e) {
+            log.error("An error occurred while getting partition information :{}", e.getMessage());
+            throw new RuntimeException(e.getMessage(), e);
+        }
+    }
+
     @Override
     public String partition(String graphName, byte[] startKey) throws PDException {
         var shard = pdClient.getPartition(graphName, startKey).getValue();
@@ -175,8 +200,19 @@ public class HgStoreNodePartitionerImpl implements HgStoreNodePartitioner,
     @Override
     public int notice(String graphName, HgStoreNotice storeNotice) {
         log.warn(storeNotice.toString());
+        // Routes handed back by the store replace the stale ones, no need to ask pd for them
+        Set<Integer> routed = new HashSet<>();
+        if (storeNotice.getPartitionRoutes() != null) {
+            storeNotice.getPartitionRoutes().forEach(route -> {
+                updatePartitionRoute(graphName, route);
+                routed.add(route.getPartitionId());
+            });
+        }
         if (storeNotice.getPartitionLeaders() != null) {
             storeNotice.getPartitionLeaders().forEach((partId, leader) -> {
+                if (routed.contains(partId)) {
+                    return;
+                }
                 pdClient.updatePartitionLeader(graphName, partId, leader);
                 log.warn("updatePartitionLeader:{}-{}-{}",
                          graphName, partId, leader);
@@ -184,7 +220,9 @@ public class HgStoreNodePartitionerImpl implements HgStoreNodePartitioner,
         }
         if (storeNotice.getPartitionIds() != null) {
             storeNotice.getPartitionIds().forEach(partId -> {
-                pdClient.invalidPartitionCache(graphName, partId);
+                if (!routed.contains(partId)) {
+                    pdClient.invalidPartitionCache(graphName, partId);
+                }
             });
         }
         if (!storeNotice.getNodeStatus().equals(
@@ -197,6 +235,27 @@ public class HgStoreNodePartitionerImpl implements HgStoreNodePartitioner,
         return 0;
     }
 
+    private void updatePartitionRoute(String graphName, PartitionRoute route) {
+        Metapb.Partition partition = Metapb.Partition.newBuilder()
+                                                     .setId(route.getPartitionId())
+                                                     .setGraphName(graphName)
+                                                     .setStartKey(route.getStartKey())
+                                                     .setEndKey(route.getEndKey())
+                                                     .setVersion(route.getVersion())
+                                                     .setStateValue(route.getState())
+                                                     .build();
+        Metapb.Shard leader = null;
+        if (route.getLeaderId() != 0) {
+            leader = Metapb.Shard.newBuilder()
+                                 .setStoreId(route.getLeaderId())
+                                 .setRole(Metapb.ShardRole.Leader)
+                                 .build();
+        }
+        pdClient.updatePartitionCache(partition, leader);
+        log.warn("updatePartitionRoute:{}-{} [{}, {}) v{}", graphName, route.getPartitionId(),
+                 route.getStartKey(), route.getEndKey(), route.getVersion());
+    }
+
     public Metapb.Graph delGraph(String graphName) {
         try {
             return pdClient.delGraph(graphName);
@@ -221,5 +280,10 @@ public class HgStoreNodePartitionerImpl implements HgStoreNodePartitioner,
         }
         return list;
     }
+
+    @Override
+    public List<String> getLearnerStores(String graphName) throws PDException {
+        return pdClient.getCache().getLearnerStoreAddresses();
+    }
 }
 
@@ -24,6 +24,7 @@ import javax.annotation.concurrent.NotThreadSafe;
 
 import org.apache.hugegraph.store.client.type.HgNodeStatus;
 import org.apache.hugegraph.store.client.util.HgAssert;
+import org.apache.hugegraph.store.grpc.session.PartitionRoute;
 
 /**
  * 2021/11/16
@@ -36,6 +37,7 @@ public class HgStoreNotice {
     private final String message;
     private Map<Integer, Long> partitionLeaders;
     private List<Integer> partitionIds;
+    private List<PartitionRoute> partitionRoutes;
 
     private HgStoreNotice(Long nodeId, HgNodeStatus nodeStatus, String message) {
         this.nodeId = nodeId;
@@ -87,6 +89,15 @@ public class HgStoreNotice {
         return this;
     }
 
+    public List<PartitionRoute> getPartitionRoutes() {
+        return partitionRoutes;
+    }
+
+    public HgStoreNotice setPartitionRoutes(List<PartitionRoute> partitionRoutes) {
+        this.partitionRoutes = partitionRoutes;
+        return this;
+    }
+
     @Override
     public String toString() {
         return "HgStoreNotice{" +
@@ -95,6 +106,7 @@ public class HgStoreNotice {
                ", message='" + message + '\'' +
                ", partitionLeaders=" + partitionLeaders +
                ", partitionIds=" + partitionIds +
+               ", partitionRoutes=" + partitionRoutes +
                '}';
     }
 }
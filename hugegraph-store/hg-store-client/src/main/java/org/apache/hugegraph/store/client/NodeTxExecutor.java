@@ -122,9 +122,22 @@ final class NodeTxExecutor {
                     return true;
                 }
                 AtomicBoolean allSuccess = new AtomicBoolean(true);
+                // Route the single-key entries in one pass, the others one by one
+                HgNodePartition[] partitions = this.proxy.doPartition(
+                        this.entries.stream()
+                                    .map(e -> e.getKey().getZ() == null ? e.getKey().getY() :
+                                              null)
+                                    .collect(Collectors.toList()));
+                int i = 0;
                 for (HgPair<HgTriple<String, HgOwnerKey, Object>, Function<NodeTkv, Boolean>> e :
                         this.entries) {
-                    doAction(e.getKey(), e.getValue());
+                    HgNodePartition partition = partitions[i++];
+                    if (partition != null) {
+                        this.proxy.doAction(e.getKey().getX(), e.getKey().getY(), partition,
+                                            e.getValue());
+                    } else {
+                        doAction(e.getKey(), e.getValue());
+                    }
                 }
                 if (!allSuccess.get()) {
                     throw HgStoreClientException.of(msg);
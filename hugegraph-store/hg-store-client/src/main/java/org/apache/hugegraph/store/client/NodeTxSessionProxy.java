@@ -685,6 +685,18 @@ public class NodeTxSessionProxy implements HgStoreSession {
         return true;
     }
 
+    /**
+     * Apply the action to a key already routed by {@link #doPartition(List)}
+     */
+    boolean doAction(String table, HgOwnerKey key, HgNodePartition partition,
+                     Function<NodeTkv, Boolean> action) {
+        HgStoreNode storeNode = this.getStoreNode(partition.getNodeId());
+        HgStoreSession session = this.txExecutor.openNodeSession(storeNode);
+        NodeTkv data = new NodeTkv(partition, table, key, key);
+        data.setSession(session);
+        return action.apply(data);
+    }
+
     public boolean doAction(String table, HgOwnerKey startKey, Integer code,
                             Function<NodeTkv, Boolean> action) {
         Collection<HgNodePartition> partitions = this.doPartition(table, code);
@@ -802,6 +814,33 @@ public class NodeTxSessionProxy implements HgStoreSession {
         return partitions;
     }
 
+    /**
+     * Route the keys of a batch in one pass, the keys that can not be routed this way are
+     * left null and routed one by one.
+     */
+    HgNodePartition[] doPartition(List<HgOwnerKey> keys) {
+        HgNodePartition[] partitions = new HgNodePartition[keys.size()];
+        List<byte[]> owners = new ArrayList<>(keys.size());
+        int[] index = new int[keys.size()];
+        for (int i = 0; i < partitions.length; i++) {
+            HgOwnerKey key = keys.get(i);
+            if (key != null && key.getOwner() != HgStoreClientConst.ALL_PARTITION_OWNER) {
+                index[owners.size()] = i;
+                owners.add(key.getOwner());
+            }
+        }
+        if (owners.isEmpty()) {
+            return partitions;
+        }
+        HgNodePartition[] routed = this.nodePartitioner.partition(this.graphName, owners);
+        if (routed != null) {
+            for (int i = 0; i < routed.length; i++) {
+                partitions[index[i]] = routed[i];
+            }
+        }
+        return partitions;
+    }
+
     Collection<HgNodePartition> doPartition(String table, int partitionId) {
         HgNodePartitionerBuilder partitionerBuilder = HgNodePartitionerBuilder.resetAndGet();
         int status =
@@ -0,0 +1,248 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.client.grpc;
+
+import java.util.ArrayList;
+import java.util.HashSet;
+import java.util.LinkedList;
+import java.util.List;
+import java.util.Map;
+import java.util.Queue;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.locks.Condition;
+import java.util.concurrent.locks.ReentrantLock;
+import java.util.function.Function;
+
+import org.apache.hugegraph.store.client.HgStoreNodeSession;
+import org.apache.hugegraph.store.client.type.HgStoreClientException;
+import org.apache.hugegraph.store.client.util.HgStoreClientConfig;
+import org.apache.hugegraph.store.grpc.common.ResCode;
+import org.apache.hugegraph.store.grpc.common.ResStatus;
+import org.apache.hugegraph.store.grpc.session.BatchEntry;
+import org.apache.hugegraph.store.grpc.session.FeedbackRes;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Group commit of the batch writes sent to one store node.
+ * While a Batch RPC to the node is in flight, the commits of other transactions queue up and
+ * the next sender carries all of them in one Batch, so the node proposes one raft task per
+ * partition for many small transactions instead of one per transaction.
+ * When some partitions of the Batch fail, only the transactions with entries in them get the
+ * error, and only they are retried by their callers. The coalescer of a node is dropped once
+ * no transaction uses it.
+ */
+@Slf4j
+final class GrpcBatchCoalescer {
+
+    // The key code of the entries sent to all the partitions
+    private static final int ALL_PARTITIONS_CODE = -1;
+    private static final FeedbackRes SUCCESS =
+            FeedbackRes.newBuilder()
+                       .setStatus(ResStatus.newBuilder().setCode(ResCode.RES_CODE_OK))
+                       .build();
+
+    private static final Map<String, GrpcBatchCoalescer> coalescers = new ConcurrentHashMap<>();
+
+    private final int maxEntries;
+    private final Queue<Pending> queue = new ConcurrentLinkedQueue<>();
+    private final ReentrantLock lock = new ReentrantLock();
+    private final Condition sent = this.lock.newCondition();
+    private boolean sending;
+    // The count of transactions submitting, guarded by the map of coalescers
+    private int users;
+
+    private GrpcBatchCoalescer(int maxEntries) {
+        this.maxEntries = maxEntries;
+    }
+
+    /**
+     * @return whether the batch writes are coalesced, false if disabled
+     */
+    static boolean enabled() {
+        return HgStoreClientConfig.of().getNetBatchCoalesceMaxEntries() > 0;
+    }
+
+    /**
+     * Send the entries with the coalescer shared by the sessions of the node and graph
+     *
+     * @param sender sends one Batch RPC with the given entries
+     */
+    static FeedbackRes submit(HgStoreNodeSession nodeSession, List<BatchEntry> entries,
+                              Function<List<BatchEntry>, FeedbackRes> sender) {
+        String key = nodeSession.getStoreNode().getNodeId() + "/" + nodeSession.getGraphName();
+        return submit(key, HgStoreClientConfig.of().getNetBatchCoalesceMaxEntries(), entries,
+                      sender);
+    }
+
+    static FeedbackRes submit(String key, int maxEntries, List<BatchEntry> entries,
+                              Function<List<BatchEntry>, FeedbackRes> sender) {
+        GrpcBatchCoalescer coalescer = coalescers.compute(key, (k, c) -> {
+            if (c == null) {
+                c = new GrpcBatchCoalescer(maxEntries);
+            }
+            c.users++;
+            return c;
+        });
+        try {
+            return coalescer.submit(entries, sender);
+        } finally {
+            // Evict it when idle, the next transaction creates a new one
+            coalescers.computeIfPresent(key, (k, c) -> --c.users == 0 ? null : c);
+        }
+    }
+
+    static boolean contains(String key) {
+        return coalescers.containsKey(key);
+    }
+
+    private FeedbackRes submit(List<BatchEntry> entries,
+                               Function<List<BatchEntry>, FeedbackRes> sender) {
+        Pending pending = new Pending(entries);
+        this.queue.add(pending);
+        while (true) {
+            this.lock.lock();
+            try {
+                // Wait for the Batch in flight, which may carry the entries
+                while (this.sending && !pending.done) {
+                    this.sent.awaitUninterruptibly();
+                }
+                if (pending.done) {
+                    return pending.get();
+                }
+                this.sending = true;
+            } finally {
+                this.lock.unlock();
+            }
+
+            try {
+                List<Pending> group = this.drain();
+                if (!group.isEmpty()) {
+                    this.send(group, sender);
+                }
+            } finally {
+                this.lock.lock();
+                try {
+                    this.sending = false;
+                    this.sent.signalAll();
+                } finally {
+                    this.lock.unlock();
+                }
+            }
+        }
+    }
+
+    private List<Pending> drain() {
+        List<Pending> group = new LinkedList<>();
+        int count = 0;
+        Pending pending;
+        while (count < this.maxEntries && (pending = this.queue.poll()) != null) {
+            group.add(pending);
+            count += pending.entries.size();
+        }
+        return group;
+    }
+
+    private void send(List<Pending> group, Function<List<BatchEntry>, FeedbackRes> sender) {
+        if (group.size() == 1) {
+            Pending pending = group.get(0);
+            try {
+                pending.complete(sender.apply(pending.entries), null);
+            } catch (Throwable t) {
+                pending.complete(null, t);
+            }
+            return;
+        }
+
+        List<BatchEntry> entries = new ArrayList<>();
+        for (Pending pending : group) {
+            entries.addAll(pending.entries);
+        }
+        if (log.isDebugEnabled()) {
+            log.debug("coalesced {} transactions into a batch of {} entries",
+                      group.size(), entries.size());
+        }
+        FeedbackRes res;
+        try {
+            res = sender.apply(entries);
+        } catch (Throwable t) {
+            for (Pending pending : group) {
+                pending.complete(null, t);
+            }
+            return;
+        }
+        for (Pending pending : group) {
+            pending.complete(resultOf(pending.entries, res), null);
+        }
+    }
+
+    /**
+     * The response of the Batch to a transaction it carried: success if none of the entries
+     * was grouped into the failed partitions by the node, otherwise the response, which is
+     * handled and retried by the caller as if the transaction was sent alone. An entry that
+     * can't be told applied is taken as failed.
+     */
+    static FeedbackRes resultOf(List<BatchEntry> entries, FeedbackRes res) {
+        if (res.getStatus().getCode() == ResCode.RES_CODE_OK) {
+            return res;
+        }
+        Set<Integer> failed = new HashSet<>(res.getPartitionFaultResponse()
+                                               .getFailedCodesList());
+        if (failed.isEmpty()) {
+            // Unknown which entries failed
+            return res;
+        }
+        for (BatchEntry entry : entries) {
+            int code = entry.getStartKey().getCode();
+            if (code == ALL_PARTITIONS_CODE || failed.contains(code)) {
+                return res;
+            }
+        }
+        return SUCCESS;
+    }
+
+    private static class Pending {
+
+        private final List<BatchEntry> entries;
+        private volatile FeedbackRes res;
+        private volatile Throwable error;
+        private volatile boolean done;
+
+        Pending(List<BatchEntry> entries) {
+            this.entries = entries;
+        }
+
+        void complete(FeedbackRes res, Throwable error) {
+            this.res = res;
+            this.error = error;
+            this.done = true;
+        }
+
+        FeedbackRes get() {
+            if (this.error == null) {
+                return this.res;
+            }
+            if (this.error instanceof RuntimeException) {
+                throw (RuntimeException) this.error;
+            }
+            throw HgStoreClientException.of(this.error);
+        }
+    }
+}
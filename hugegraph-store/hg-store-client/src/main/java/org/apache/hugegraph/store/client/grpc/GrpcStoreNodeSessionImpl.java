@@ -233,8 +233,16 @@ class GrpcStoreNodeSessionImpl implements HgStoreNodeSession {
     }
 
     private boolean doCommit(List<BatchEntry> entries) {
+        String batchId = this.getBatchId();
+        if (!GrpcBatchCoalescer.enabled()) {
+            return this.notifier.invoke(
+                    () -> this.storeSessionClient.doBatch(this, batchId, entries),
+                    e -> true
+            ).orElse(false);
+        }
         return this.notifier.invoke(
-                () -> this.storeSessionClient.doBatch(this, this.getBatchId(), entries),
+                () -> GrpcBatchCoalescer.submit(this, entries, list ->
+                        this.storeSessionClient.doBatch(this, batchId, list)),
                 e -> true
         ).orElse(false);
     }
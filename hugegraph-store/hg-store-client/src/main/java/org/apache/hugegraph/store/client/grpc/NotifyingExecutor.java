@@ -222,6 +222,7 @@ final class NotifyingExecutor {
                                                     )
                                             )
                                  )
+                                 .setPartitionRoutes(res.getPartitionRoutesList())
             );
         };
     }
@@ -236,6 +237,7 @@ final class NotifyingExecutor {
                     this.graphName,
                     HgStoreNotice.of(this.nodeSession.getStoreNode().getNodeId(), status)
                                  .setPartitionIds(res.getPartitionIdsList())
+                                 .setPartitionRoutes(res.getPartitionRoutesList())
             );
         };
     }
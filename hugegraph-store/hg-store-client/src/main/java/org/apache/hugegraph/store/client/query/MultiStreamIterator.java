@@ -27,9 +27,12 @@ public class MultiStreamIterator<E> implements HgKvIterator<E> {
 
     private HgKvIterator<E> currentIterator = null;
 
+    private final List<HgKvIterator<E>> iterators;
+
     private final Iterator<HgKvIterator<E>> listIterator;
 
     public MultiStreamIterator(List<HgKvIterator<E>> iterators) {
+        this.iterators = iterators;
         this.listIterator = iterators.iterator();
     }
 
@@ -45,10 +48,8 @@ public class MultiStreamIterator<E> implements HgKvIterator<E> {
 
     @Override
     public void close() {
-        //Todo is syntax correct?
-        if (currentIterator != null && currentIterator.hasNext()) {
-            currentIterator.close();
-        }
+        // All the streams are requested at beginning, close them to stop the servers
+        this.iterators.forEach(HgKvIterator::close);
     }
 
     @Override
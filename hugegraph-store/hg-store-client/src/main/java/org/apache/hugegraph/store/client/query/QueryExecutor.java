@@ -71,6 +71,8 @@ public class QueryExecutor {
 
     private static final BinaryElementSerializer serializer = new BinaryElementSerializer();
 
+    private static final int MIN_RANKED_BATCH_SIZE = 64;
+
     private final HugeGraphSupplier supplier;
 
     /**
@@ -107,8 +109,17 @@ public class QueryExecutor {
         if (isSimpleCountQuery(query)) {
             iterators = getCountIterator(query);
         } else {
+            var tasks = getNodeTasks(query);
+            if (isRankedQuery(query) && !tasks.isEmpty()) {
+                // Each node sends its local top-k page by page, the sorted merge pulls the
+                // next page only from the node whose results are consumed
+                int batchSize = Math.max(MIN_RANKED_BATCH_SIZE,
+                                         2 * (query.getLimit() + tasks.size() - 1) /
+                                         tasks.size());
+                tasks.forEach(task -> task.getV2().setBatchSize(batchSize));
+            }
             // Obtain iterator of all nodes
-            iterators = getNodeTasks(query)
+            iterators = tasks
                     .parallelStream()
                     .map(tuple -> getIterator(tuple.getV1(), tuple.getV2().build()))
                     .collect(Collectors.toList());
@@ -286,6 +297,15 @@ public class QueryExecutor {
             for (String addr : stores) {
                 tasks.computeIfAbsent(addr, t -> fromQuery(query));
             }
+            if (query.isReadLearner() && query.getQueryType() == StoreQueryType.TABLE_SCAN &&
+                !isSimpleCountQuery(query)) {
+                // Partitions with a learner are scanned by the learner store, the rest by
+                // their leaders, so the learner stores join the leaders as targets.
+                // Simple counts read the leader partitions only and stay on the leaders.
+                for (String addr : this.nodePartitioner.getLearnerStores(graph)) {
+                    tasks.computeIfAbsent(addr, t -> fromQuery(query));
+                }
+            }
         }
 
         if (filterStore.get() != null) {
@@ -363,6 +383,7 @@ public class QueryExecutor {
         }
 
         builder.setCheckTtl(query.isCheckTTL());
+        builder.setReadLearner(query.isReadLearner());
 
         return builder;
     }
@@ -490,6 +511,18 @@ public class QueryExecutor {
         return false;
     }
 
+    /**
+     * Judge if it is an order by + limit query without aggregation
+     *
+     * @param param query param
+     * @return true if it is a ranked query
+     */
+    private boolean isRankedQuery(StoreQueryParam param) {
+        return isEmpty(param.getFuncList()) && !isEmpty(param.getOrderBy()) &&
+               param.getLimit() > 0 &&
+               param.getSortOrder() != StoreQueryParam.SORT_ORDER.STRICT_ORDER;
+    }
+
     /**
      * Judge if it is a simple agg query
      *
@@ -20,6 +20,8 @@ package org.apache.hugegraph.store.client.query;
 import java.util.concurrent.atomic.AtomicInteger;
 
 import org.apache.hugegraph.store.client.grpc.AbstractGrpcClient;
+import org.apache.hugegraph.store.grpc.query.KHopRequest;
+import org.apache.hugegraph.store.grpc.query.KHopResponse;
 import org.apache.hugegraph.store.grpc.query.QueryServiceGrpc;
 
 import io.grpc.ManagedChannel;
@@ -53,6 +55,14 @@ public class QueryV2Client extends AbstractGrpcClient {
         // return (QueryServiceGrpc.QueryServiceStub) getAsyncStub(target);
     }
 
+    /**
+     * Expand multi-hop neighbors on the store nodes, any node can serve the request and
+     * forwards the frontier vertices to the nodes owning them.
+     */
+    public KHopResponse khop(String target, KHopRequest request) {
+        return getQueryServiceBlockingStub(target).khop(request);
+    }
+
     private ManagedChannel getManagedChannel(String target) {
         return getChannels(target)[Math.abs(seq.getAndIncrement() % concurrency)];
     }
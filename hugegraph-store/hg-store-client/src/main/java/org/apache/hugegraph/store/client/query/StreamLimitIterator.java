@@ -26,6 +26,8 @@ public class StreamLimitIterator<E> implements HgKvIterator<E> {
 
     private int count = 0;
 
+    private boolean closed = false;
+
     public StreamLimitIterator(HgKvIterator<E> iterator, Integer limit) {
         this.iterator = iterator;
         this.limit = limit;
@@ -43,7 +45,10 @@ public class StreamLimitIterator<E> implements HgKvIterator<E> {
 
     @Override
     public void close() {
-        iterator.close();
+        if (!this.closed) {
+            this.closed = true;
+            iterator.close();
+        }
     }
 
     @Override
@@ -58,7 +63,12 @@ public class StreamLimitIterator<E> implements HgKvIterator<E> {
 
     @Override
     public boolean hasNext() {
-        return count < limit && iterator.hasNext();
+        if (count >= limit) {
+            // Stop the servers early, the left results are not needed
+            close();
+            return false;
+        }
+        return iterator.hasNext();
     }
 
     @Override
@@ -33,6 +33,7 @@ public final class HgStoreClientConfig {
 
     private static final int NET_KV_SCANNER_PAGE_SIZE = 10_000;
     private static final int NET_KV_SCANNER_HAVE_NEXT_TIMEOUT = 30 * 60;
+    private static final int NET_BATCH_COALESCE_MAX_ENTRIES = 10_000;
     private static final String fileName = "hg-store-client";
     private static PropertyResourceBundle prb = null;
     private static HgStoreClientConfig defaultInstance;
@@ -41,6 +42,7 @@ public final class HgStoreClientConfig {
     private Integer grpcMaxOutboundMessageSize = GRPC_DEFAULT_MAX_OUTBOUND_MESSAGE_SIZE;
     private Integer netKvScannerPageSize = NET_KV_SCANNER_PAGE_SIZE;
     private Integer netKvScannerHaveNextTimeout = NET_KV_SCANNER_HAVE_NEXT_TIMEOUT;
+    private Integer netBatchCoalesceMaxEntries = NET_BATCH_COALESCE_MAX_ENTRIES;
 
     private HgStoreClientConfig() {
     }
@@ -83,6 +85,11 @@ public final class HgStoreClientConfig {
                 , config.netKvScannerPageSize))
         );
         log.info("net.kv.scanner.have.next.timeout = {}", config.netKvScannerHaveNextTimeout);
+        log.info("net.batch.coalesce.max.entries = "
+                 + (config.netBatchCoalesceMaxEntries =
+                            wrapper.getInt("net.batch.coalesce.max.entries",
+                                           config.netBatchCoalesceMaxEntries))
+        );
     }
 
     public Integer getGrpcTimeoutSeconds() {
@@ -130,6 +137,15 @@ public final class HgStoreClientConfig {
         return this;
     }
 
+    public Integer getNetBatchCoalesceMaxEntries() {
+        return netBatchCoalesceMaxEntries;
+    }
+
+    public HgStoreClientConfig setNetBatchCoalesceMaxEntries(Integer netBatchCoalesceMaxEntries) {
+        this.netBatchCoalesceMaxEntries = netBatchCoalesceMaxEntries;
+        return this;
+    }
+
     private static class PropertiesWrapper {
 
         private final PropertyResourceBundle prb;
@@ -21,22 +21,36 @@ import java.nio.ByteBuffer;
 import java.util.concurrent.BlockingQueue;
 import java.util.concurrent.LinkedBlockingQueue;
 import java.util.concurrent.TimeUnit;
-import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
 
 public class ByteBufferAllocator {
 
     // size of each Buffer
     final int capacity;
-    // max num of Buffers
-    final int maxCount;
+    // max bytes of all the Buffers, direct Buffers are not bounded by the heap size
+    final long maxBytes;
     final BlockingQueue<ByteBuffer> freeQueue = new LinkedBlockingQueue<>();
-    // current num of Buffers in queue
-    AtomicInteger totalCount;
+    // allocate off-heap Buffers, which don't count against the heap
+    final boolean direct;
+    // current bytes of the Buffers allocated
+    AtomicLong totalBytes;
 
     public ByteBufferAllocator(int cap, int count) {
+        this(cap, count, false);
+    }
+
+    public ByteBufferAllocator(int cap, int count, boolean direct) {
+        this(cap, (long) cap * count, direct);
+    }
+
+    /**
+     * @param maxBytes at least one Buffer is allocated even if it's less than cap
+     */
+    public ByteBufferAllocator(int cap, long maxBytes, boolean direct) {
         this.capacity = cap;
-        this.maxCount = count;
-        this.totalCount = new AtomicInteger(0);
+        this.maxBytes = maxBytes;
+        this.direct = direct;
+        this.totalBytes = new AtomicLong(0);
     }
 
     public ByteBuffer get() throws InterruptedException {
@@ -44,9 +58,9 @@ public class ByteBufferAllocator {
         while (buffer == null) {
             if (freeQueue.size() > 0) {
                 buffer = freeQueue.poll();
-            } else if (totalCount.get() < maxCount) {
-                buffer = ByteBuffer.allocate(capacity);
-                totalCount.incrementAndGet();
+            } else if (reserve()) {
+                buffer = direct ? ByteBuffer.allocateDirect(capacity) :
+                         ByteBuffer.allocate(capacity);
             } else {
                 buffer = freeQueue.poll(1, TimeUnit.SECONDS);
             }
@@ -54,10 +68,34 @@ public class ByteBufferAllocator {
         return buffer;
     }
 
+    private boolean reserve() {
+        long total;
+        do {
+            total = totalBytes.get();
+            if (total > 0 && total + capacity > maxBytes) {
+                return false;
+            }
+        } while (!totalBytes.compareAndSet(total, total + capacity));
+        return true;
+    }
+
+    public boolean isDirect() {
+        return direct;
+    }
+
+    public long getTotalBytes() {
+        return totalBytes.get();
+    }
+
     public void release(ByteBuffer buffer) {
-        if (freeQueue.size() < maxCount) {
+        if (buffer == null || buffer.capacity() != capacity || buffer.isDirect() != direct) {
+            return;
+        }
+        if ((long) freeQueue.size() * capacity < maxBytes) {
             buffer.clear();
             freeQueue.add(buffer);
+        } else {
+            totalBytes.addAndGet(-capacity);
         }
     }
 }
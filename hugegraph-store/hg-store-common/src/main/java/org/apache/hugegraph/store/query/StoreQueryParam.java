@@ -100,6 +100,10 @@ public class StoreQueryParam {
      * Used in non-order-by, non-aggregation queries
      */
     private byte[] position;
+    /**
+     * Serve a TABLE_SCAN from learner replicas instead of leaders
+     */
+    private boolean readLearner;
     /**
      * Add corresponding attributes from the OLAP table to the HgElement (Vertex)
      */
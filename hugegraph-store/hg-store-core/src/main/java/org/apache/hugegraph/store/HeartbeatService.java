@@ -23,6 +23,7 @@ import java.util.ArrayList;
 import java.util.Collections;
 import java.util.List;
 import java.util.Map;
+import java.util.stream.Collectors;
 
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.common.PDRuntimeException;
@@ -35,6 +36,7 @@ import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.PartitionRole;
 import org.apache.hugegraph.store.meta.Store;
 import org.apache.hugegraph.store.meta.StoreMetadata;
+import org.apache.hugegraph.store.metric.PartitionLoadCollector;
 import org.apache.hugegraph.store.options.HgStoreEngineOptions;
 import org.apache.hugegraph.store.pd.PdProvider;
 import org.apache.hugegraph.store.util.IpUtil;
@@ -62,6 +64,7 @@ public class HeartbeatService implements Lifecycle<HgStoreEngineOptions>, Partit
     private StoreMetadata storeMetadata;
     private final List<StoreStateListener> stateListeners;
     private final Object partitionThreadLock = new Object();
+    private final PartitionLoadCollector loadCollector = new PartitionLoadCollector();
     private final Object storeThreadLock = new Object();
     private int heartbeatFailCount = 0;
     private int reportErrCount = 0;
@@ -301,6 +304,9 @@ public class HeartbeatService implements Lifecycle<HgStoreEngineOptions>, Partit
                                                                    .getStore().getId())
                                                .setRole(Metapb.ShardRole.Leader)
                                                .build();
+        Map<Integer, Metapb.PartitionLoad> loads = loadCollector.collect(
+                partitions.stream().map(PartitionEngine::getGroupId)
+                          .collect(Collectors.toList()));
         // Get information for each shard.
         for (PartitionEngine partition : partitions) {
             Metapb.PartitionStats.Builder stats = Metapb.PartitionStats.newBuilder();
@@ -339,6 +345,9 @@ public class HeartbeatService implements Lifecycle<HgStoreEngineOptions>, Partit
                                                 .setState(state).build());
             });
             stats.addAllShardStats(shardStats);
+            if (loads.containsKey(partition.getGroupId())) {
+                stats.setLoad(loads.get(partition.getGroupId()));
+            }
             stats.setTimestamp(System.currentTimeMillis());
 
             statsList.add(stats.build());
@@ -29,11 +29,18 @@ import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
 import java.util.Objects;
+import java.util.Queue;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedQueue;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicReference;
+import java.util.function.BooleanSupplier;
+import java.util.stream.Collectors;
 
 import org.apache.commons.collections.ListUtils;
 import org.apache.commons.collections.SetUtils;
@@ -42,15 +49,22 @@ import org.apache.commons.lang.StringUtils;
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.grpc.MetaTask;
 import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.pd.grpc.pulse.CleanType;
 import org.apache.hugegraph.pd.raft.RaftReflectionUtil;
 import org.apache.hugegraph.store.business.BusinessHandler;
 import org.apache.hugegraph.store.business.BusinessHandlerImpl;
+import org.apache.hugegraph.store.business.DataManager;
+import org.apache.hugegraph.store.business.DataManagerImpl;
+import org.apache.hugegraph.store.business.MigrationDelta;
 import org.apache.hugegraph.store.cmd.HgCmdClient;
 import org.apache.hugegraph.store.cmd.request.BatchPutRequest;
 import org.apache.hugegraph.store.cmd.request.CleanDataRequest;
 import org.apache.hugegraph.store.cmd.request.DbCompactionRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
+import org.apache.hugegraph.store.cmd.request.RedirectRaftTaskRequest;
 import org.apache.hugegraph.store.cmd.request.UpdatePartitionRequest;
 import org.apache.hugegraph.store.listener.PartitionStateListener;
+import org.apache.hugegraph.store.meta.HandoffManager;
 import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.PartitionManager;
 import org.apache.hugegraph.store.meta.Shard;
@@ -59,6 +73,7 @@ import org.apache.hugegraph.store.meta.Store;
 import org.apache.hugegraph.store.meta.TaskManager;
 import org.apache.hugegraph.store.options.HgStoreEngineOptions;
 import org.apache.hugegraph.store.options.PartitionEngineOptions;
+import org.apache.hugegraph.store.raft.BatchRaftClosure;
 import org.apache.hugegraph.store.raft.DefaultRaftClosure;
 import org.apache.hugegraph.store.raft.PartitionStateMachine;
 import org.apache.hugegraph.store.raft.RaftClosure;
@@ -66,6 +81,7 @@ import org.apache.hugegraph.store.raft.RaftOperation;
 import org.apache.hugegraph.store.raft.RaftStateListener;
 import org.apache.hugegraph.store.raft.RaftTaskHandler;
 import org.apache.hugegraph.store.raft.util.RaftUtils;
+import org.apache.hugegraph.store.snapshot.ParallelSnapshotStorage;
 import org.apache.hugegraph.store.snapshot.SnapshotHandler;
 import org.apache.hugegraph.store.util.FutureClosure;
 import org.apache.hugegraph.store.util.HgRaftError;
@@ -78,6 +94,7 @@ import com.alipay.sofa.jraft.Node;
 import com.alipay.sofa.jraft.RaftGroupService;
 import com.alipay.sofa.jraft.ReplicatorGroup;
 import com.alipay.sofa.jraft.Status;
+import com.alipay.sofa.jraft.closure.ReadIndexClosure;
 import com.alipay.sofa.jraft.conf.Configuration;
 import com.alipay.sofa.jraft.core.DefaultJRaftServiceFactory;
 import com.alipay.sofa.jraft.core.NodeMetrics;
@@ -88,8 +105,10 @@ import com.alipay.sofa.jraft.error.RaftException;
 import com.alipay.sofa.jraft.option.NodeOptions;
 import com.alipay.sofa.jraft.option.RaftOptions;
 import com.alipay.sofa.jraft.storage.LogStorage;
+import com.alipay.sofa.jraft.storage.SnapshotStorage;
 import com.alipay.sofa.jraft.storage.impl.RocksDBLogStorage;
 import com.alipay.sofa.jraft.storage.log.RocksDBSegmentLogStorage;
+import com.alipay.sofa.jraft.util.BytesUtil;
 import com.alipay.sofa.jraft.util.Endpoint;
 import com.alipay.sofa.jraft.util.ThreadId;
 import com.alipay.sofa.jraft.util.Utils;
@@ -106,6 +125,7 @@ import lombok.extern.slf4j.Slf4j;
 public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftStateListener {
 
     private static final ThreadPoolExecutor raftLogWriteExecutor = null;
+    private static final int REBUILD_ATTEMPTS = 3;
     public final String raftPrefix = "hg_";
 
     private final HgStoreEngine storeEngine;
@@ -115,12 +135,23 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
     private final AtomicBoolean changingPeer;
     private final AtomicBoolean snapshotFlag;
     private final Object leaderChangedEvent = "leaderChangedEvent";
+    // graph -> key ranges handed off by an online split or migration, not writable here any more,
+    // kept in the partition meta by the handoff manager as well
+    private final Map<String, List<Metapb.Partition>> writeFences;
+    // graph -> writes applied while the graph is migrated to another partition by sst files
+    private final Map<String, MigrationDelta> migrationDeltas;
+    // split task id -> handoff running on this replica, awaited by the leader of the split
+    private final Map<Long, CompletableFuture<Status>> handoffs;
+    // Tasks waiting to be submitted to raft, the data writes among them are merged into one entry
+    private final Queue<DefaultRaftClosure> pendingTasks;
+    private final AtomicBoolean submitting;
 
     private PartitionEngineOptions options;
     private PartitionStateMachine stateMachine;
     @Getter
     private RaftGroupService raftGroupService;
     private TaskManager taskManager;
+    private HandoffManager handoffManager;
     private SnapshotHandler snapshotHandler;
     private Node raftNode;
     private volatile boolean started;
@@ -130,6 +161,11 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
         this.shardGroup = shardGroup;
         this.changingPeer = new AtomicBoolean(false);
         this.snapshotFlag = new AtomicBoolean(false);
+        this.writeFences = new ConcurrentHashMap<>();
+        this.migrationDeltas = new ConcurrentHashMap<>();
+        this.handoffs = new ConcurrentHashMap<>();
+        this.pendingTasks = new ConcurrentLinkedQueue<>();
+        this.submitting = new AtomicBoolean(false);
         partitionManager = storeEngine.getPartitionManager();
         stateListeners = Collections.synchronizedList(new ArrayList());
     }
@@ -148,6 +184,10 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
     public void removePartition(String graphName) {
         partitionManager.removePartition(graphName, options.getGroupId());
+        writeFences.remove(graphName);
+        if (handoffManager != null) {
+            handoffManager.deleteWriteFences(graphName);
+        }
     }
 
     public boolean hasPartition(String graphName) {
@@ -173,8 +213,12 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
         log.info("PartitionEngine starting: {}", this);
         this.taskManager = new TaskManager(storeEngine.getBusinessHandler(), opts.getGroupId());
+        this.handoffManager = new HandoffManager(storeEngine.getBusinessHandler(),
+                                                 opts.getGroupId());
+        reloadHandoffState();
         this.snapshotHandler = new SnapshotHandler(this);
-        this.stateMachine = new PartitionStateMachine(opts.getGroupId(), snapshotHandler);
+        this.stateMachine = new PartitionStateMachine(opts.getGroupId(), snapshotHandler,
+                                                      opts.getRaftOptions().isBatchApply());
         // probably null in test case
         if (opts.getTaskHandler() != null) {
             this.stateMachine.addTaskHandler(opts.getTaskHandler());
@@ -220,13 +264,17 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
                     return new RocksDBLogStorage(uri, raftOptions);
                 }
             }
+
+            @Override
+            public SnapshotStorage createSnapshotStorage(final String uri,
+                                                         final RaftOptions raftOptions) {
+                return new ParallelSnapshotStorage(uri, raftOptions, raft);
+            }
         });
         // Initial cluster
         nodeOptions.setInitialConf(initConf);
         // Snapshot time interval
         nodeOptions.setSnapshotIntervalSecs(raft.getSnapshotIntervalSecs());
-        //todo soya fix
-        // nodeOptions.setSnapShotDownloadingThreads(raft.getSnapshotDownloadingThreads());
 
         // nodeOptions.setSnapshotLogIndexMargin(options.getRaftOptions()
         // .getSnapshotLogIndexMargin());
@@ -239,6 +287,7 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
         RaftOptions raftOptions = nodeOptions.getRaftOptions();
         raftOptions.setDisruptorBufferSize(raft.getDisruptorBufferSize());
         raftOptions.setMaxEntriesSize(raft.getMaxEntriesSize());
+        raftOptions.setMaxBodySize(raft.getMaxBodySize());
         raftOptions.setMaxReplicatorInflightMsgs(raft.getMaxReplicatorInflightMsgs());
         raftOptions.setMaxByteCountPerRpc(1024 * 1024);
         nodeOptions.setEnableMetrics(true);
@@ -285,24 +334,28 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
      * 5.2, Modify learner to peer, join raft group
      * 6. Existence of deleted peer
      * 6.1, Notify peer, delete state machine and delete data
+     * The learners kept for read-only scans are added and removed between 5 and 6.
      *
-     * @param peers
+     * @param peers    voters
+     * @param learners learners serving read-only scans
      * @param done
      * @return true means completed, false means not completed
      */
-    public Status changePeers(List<String> peers, final Closure done) {
-        if (ListUtils.isEqualList(peers, RaftUtils.getPeerEndpoints(raftNode))) {
+    public Status changePeers(List<String> peers, List<String> learners, final Closure done) {
+        if (ListUtils.isEqualList(peers, RaftUtils.getPeerEndpoints(raftNode)) &&
+            SetUtils.isEqualSet(learners, RaftUtils.getLearnerEndpoints(raftNode))) {
             return Status.OK();
         }
 
         Status result = HgRaftError.TASK_CONTINUE.toStatus();
         List<String> oldPeers = RaftUtils.getAllEndpoints(raftNode);
-        log.info("Raft {} changePeers start, old peer is {}, new peer is {}",
-                 getGroupId(), oldPeers, peers);
+        log.info("Raft {} changePeers start, old peer is {}, new peer is {}, new learner is {}",
+                 getGroupId(), oldPeers, peers, learners);
         // Check the peer that needs to be added.
         List<String> addPeers = ListUtils.removeAll(peers, oldPeers);
         // learner to be deleted. Possible peer change.
-        List<String> removedPeers = ListUtils.removeAll(oldPeers, peers);
+        List<String> removedPeers =
+                ListUtils.removeAll(ListUtils.removeAll(oldPeers, peers), learners);
 
         HgCmdClient rpcClient = storeEngine.getHgCmdClient();
         // Generate a new Configuration object
@@ -370,7 +423,7 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
             closure = new FutureClosure();
             // 2.3 change learner to follower (first remove, then add follower)
-            raftNode.removeLearners(conf.listLearners(), closure);
+            raftNode.removeLearners(toPeerIds(addPeers), closure);
             if (!closure.get().isOk()) {
                 log.error("Raft {} remove learner error, result:{}", getGroupId(), status);
                 return HgRaftError.TASK_ERROR.toStatus();
@@ -390,6 +443,11 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
             }
         }
 
+        Status learnerStatus = changeLearners(learners);
+        if (!learnerStatus.isOk()) {
+            return learnerStatus;
+        }
+
         boolean removeSelf = false;
         // case 3:
         if (!removedPeers.isEmpty()) {
@@ -397,17 +455,19 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
             removeSelf = removedPeers.contains(self);
             // 3.1 remove peers
             List<String> toDestroy = new ArrayList<>();
+            // The learners may have been changed above
+            Configuration removeConf = getCurrentConf();
             for (var peer : removedPeers) {
                 if (Objects.equals(peer, self)) {
                     continue;
                 }
-                conf.removeLearner(JRaftUtils.getPeerId(peer));
-                conf.removePeer(JRaftUtils.getPeerId(peer));
+                removeConf.removeLearner(JRaftUtils.getPeerId(peer));
+                removeConf.removePeer(JRaftUtils.getPeerId(peer));
                 toDestroy.add(peer);
             }
 
             closure = new FutureClosure();
-            raftNode.changePeers(conf, closure);
+            raftNode.changePeers(removeConf, closure);
             var status = closure.get();
 
             if (!status.isOk()) {
@@ -433,14 +493,204 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
         return removeSelf ? HgRaftError.TASK_CONTINUE.toStatus() : HgRaftError.OK.toStatus();
     }
 
+    /**
+     * Add and remove the learners serving read-only scans. A new learner catches up in the
+     * background, it refuses the scans until then, see {@link #isCaughtUp}
+     */
+    private Status changeLearners(List<String> learners) {
+        Configuration conf = getCurrentConf();
+        List<String> oldLearners = RaftUtils.getLearnerEndpoints(conf);
+        List<String> addLearners = ListUtils.removeAll(learners, oldLearners);
+        List<String> removedLearners = ListUtils.removeAll(oldLearners, learners);
+        HgCmdClient rpcClient = storeEngine.getHgCmdClient();
+        FutureClosure closure;
+
+        if (!addLearners.isEmpty()) {
+            addLearners.forEach(peer -> conf.addLearner(JRaftUtils.getPeerId(peer)));
+            for (var peer : addLearners) {
+                closure = new FutureClosure();
+                rpcClient.createRaftNode(peer, partitionManager.getPartitionList(getGroupId()),
+                                         conf, closure);
+                var status = closure.get();
+                if (!status.isOk()) {
+                    log.info("Raft {} createRaftNode of learner, peer:{}, reason:{}",
+                             getGroupId(), peer, status.getErrorMsg());
+                    return status;
+                }
+            }
+            closure = new FutureClosure();
+            raftNode.addLearners(toPeerIds(addLearners), closure);
+            var status = closure.get();
+            if (!status.isOk()) {
+                log.error("Raft {} add learners {} error, result:{}", getGroupId(), addLearners,
+                          status);
+                return HgRaftError.TASK_ERROR.toStatus();
+            }
+        }
+
+        if (!removedLearners.isEmpty()) {
+            closure = new FutureClosure();
+            raftNode.removeLearners(toPeerIds(removedLearners), closure);
+            var status = closure.get();
+            if (!status.isOk()) {
+                log.error("Raft {} remove learners {} error, result:{}", getGroupId(),
+                          removedLearners, status);
+                return HgRaftError.TASK_ERROR.toStatus();
+            }
+            for (var peer : removedLearners) {
+                closure = new FutureClosure();
+                rpcClient.destroyRaftNode(peer, partitionManager.getPartitionList(getGroupId()),
+                                          closure);
+                log.info("Raft {} destroy learner {}, result:{}", getGroupId(), peer,
+                         closure.get());
+            }
+        }
+        return Status.OK();
+    }
+
+    private static List<PeerId> toPeerIds(List<String> endpoints) {
+        List<PeerId> peerIds = new ArrayList<>();
+        endpoints.forEach(endpoint -> peerIds.add(JRaftUtils.getPeerId(endpoint)));
+        return peerIds;
+    }
+
+    /**
+     * Whether this replica applies the log committed by the leader within timeoutMs, the
+     * commit index is asked from the leader by a read index request. A learner installing
+     * its first snapshot or lagging behind has not.
+     */
+    public boolean isCaughtUp(long timeoutMs) {
+        return raftNode.getLastAppliedLogIndex() > 0 && waitForCatchUp(timeoutMs);
+    }
+
+    /**
+     * Wait until this replica applied the log the leader committed at the call, asking the
+     * leader for its commit index by a read index request
+     *
+     * @return false if it did not catch up within timeoutMs
+     */
+    public boolean waitForCatchUp(long timeoutMs) {
+        CompletableFuture<Status> future = new CompletableFuture<>();
+        raftNode.readIndex(BytesUtil.EMPTY_BYTES, new ReadIndexClosure() {
+            @Override
+            public void run(Status status, long index, byte[] reqCtx) {
+                future.complete(status);
+            }
+        });
+        try {
+            return future.get(timeoutMs, TimeUnit.MILLISECONDS).isOk();
+        } catch (Exception e) {
+            log.warn("Raft {} wait for catch up failed, {}", getGroupId(), e.getMessage());
+            return false;
+        }
+    }
+
+    /**
+     * Rebuild this replica from a snapshot of the leader, for its data diverged from what the
+     * raft log gives, e.g. a handoff could not be ingested into it. The leader takes a snapshot,
+     * which truncates its log, then this replica drops its log and snapshots and restarts, so
+     * the leader installs its snapshot here. That is retried while restored is false after
+     * catching up, the leader replays its log instead if the snapshot was not done in time.
+     */
+    public void rebuildReplica(String graph, BooleanSupplier restored) {
+        Utils.runInThread(() -> {
+            long timeout = options.getRaftOptions().getElectionTimeoutMs() * 10L;
+            for (int i = 0; i < REBUILD_ATTEMPTS; i++) {
+                try {
+                    if (isLeader()) {
+                        raftNode.transferLeadershipTo(PeerId.ANY_PEER);
+                        Thread.sleep(options.getRaftOptions().getElectionTimeoutMs());
+                    }
+                    Endpoint leader = waitForLeader(timeout);
+                    if (leader == null || isLeader()) {
+                        continue;
+                    }
+                    var response = storeEngine.getHgCmdClient().redirectRaftTask(
+                            new RedirectRaftTaskRequest(graph, getGroupId(),
+                                                        RaftOperation.DO_SNAPSHOT, null));
+                    log.warn("Raft {} rebuild from a snapshot of {}, attempt {}, snapshot {}",
+                             getGroupId(), leader, i, response.getStatus());
+                    shutdown();
+                    FileUtils.deleteDirectory(new File(options.getRaftDataPath(), "log"));
+                    FileUtils.deleteDirectory(new File(options.getRaftSnapShotPath(), "snapshot"));
+                    init(options);
+                    if (waitForCatchUp(timeout) && restored.getAsBoolean()) {
+                        log.info("Raft {} rebuilt", getGroupId());
+                        return;
+                    }
+                } catch (Exception e) {
+                    log.error("Raft {} rebuild failed", getGroupId(), e);
+                }
+            }
+            log.error("Raft {} was not rebuilt after {} attempts", getGroupId(), REBUILD_ATTEMPTS);
+        });
+    }
+
     public void addRaftTask(RaftOperation operation, RaftClosure closure) {
         if (!isLeader()) {
             closure.run(new Status(HgRaftError.NOT_LEADER.getNumber(), "Not leader"));
             return;
         }
+        if (!options.getRaftOptions().isBatchApply()) {
+            applyTask(new DefaultRaftClosure(operation, closure));
+            return;
+        }
+        this.pendingTasks.add(new DefaultRaftClosure(operation, closure));
+        submitPendingTasks();
+    }
+
+    /**
+     * Submit the pending tasks in order. The thread winning the submission drains the queue, so
+     * the data writes queued concurrently meanwhile are merged into entries of up to maxBodySize
+     */
+    private void submitPendingTasks() {
+        int maxBodySize = options.getRaftOptions().getMaxBodySize();
+        while (!this.pendingTasks.isEmpty() && this.submitting.compareAndSet(false, true)) {
+            try {
+                List<DefaultRaftClosure> batch = new ArrayList<>();
+                long batchSize = 0;
+                DefaultRaftClosure task;
+                while ((task = this.pendingTasks.poll()) != null) {
+                    int size = task.getOperation().getValues().length;
+                    if (!isBatchable(task.getOperation())) {
+                        applyTasks(batch);
+                        batch.clear();
+                        batchSize = 0;
+                        applyTask(task);
+                        continue;
+                    }
+                    if (!batch.isEmpty() && batchSize + size > maxBodySize) {
+                        applyTasks(batch);
+                        batch.clear();
+                        batchSize = 0;
+                    }
+                    batch.add(task);
+                    batchSize += size;
+                }
+                applyTasks(batch);
+            } finally {
+                this.submitting.set(false);
+            }
+        }
+    }
+
+    private boolean isBatchable(RaftOperation operation) {
+        return options.getTaskHandler() != null &&
+               options.getTaskHandler().isBatchable(operation.getOp());
+    }
+
+    private void applyTasks(List<DefaultRaftClosure> tasks) {
+        if (tasks.size() == 1) {
+            applyTask(tasks.get(0));
+        } else if (tasks.size() > 1) {
+            applyTask(new BatchRaftClosure(new ArrayList<>(tasks)));
+        }
+    }
+
+    private void applyTask(DefaultRaftClosure done) {
         final Task task = new Task();
-        task.setData(ByteBuffer.wrap(operation.getValues()));
-        task.setDone(new DefaultRaftClosure(operation, closure));
+        task.setData(ByteBuffer.wrap(done.getOperation().getValues()));
+        task.setDone(done);
         this.raftNode.apply(task);
     }
 
@@ -664,7 +914,10 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
                 // });
                 try {
                     var pdGroup = storeEngine.getPdProvider().getShardGroupDirect(getGroupId());
-                    List<String> peers = partitionManager.shards2Peers(pdGroup.getShardsList());
+                    List<String> peers = partitionManager.shards2Peers(
+                            pdGroup.getShardsList().stream()
+                                   .filter(s -> s.getRole() != Metapb.ShardRole.Learner)
+                                   .collect(Collectors.toList()));
 
                     Long leaderStoreId = null;
                     for (var shard : pdGroup.getShardsList()) {
@@ -727,6 +980,50 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
         return this.taskManager;
     }
 
+    /**
+     * Record the writes of graph this partition applies from now on, until
+     * stopMigrationDelta
+     */
+    public MigrationDelta startMigrationDelta(String graph) {
+        MigrationDelta delta = new MigrationDelta();
+        migrationDeltas.put(graph, delta);
+        return delta;
+    }
+
+    public void stopMigrationDelta(String graph) {
+        migrationDeltas.remove(graph);
+    }
+
+    /**
+     * @return null if graph is not being migrated
+     */
+    public MigrationDelta getMigrationDelta(String graph) {
+        return migrationDeltas.isEmpty() ? null : migrationDeltas.get(graph);
+    }
+
+    public HandoffManager getHandoffManager() {
+        return this.handoffManager;
+    }
+
+    /**
+     * Load the write fences from the partition meta, at start and after a snapshot replaced it
+     */
+    public void reloadHandoffState() {
+        handoffManager.reload();
+        writeFences.clear();
+        writeFences.putAll(handoffManager.loadWriteFences());
+        if (!writeFences.isEmpty()) {
+            log.info("Raft {}, write fences {}", getGroupId(), writeFences);
+        }
+    }
+
+    /**
+     * Take the handoff of a split task run on this replica, once the leader applied it
+     */
+    public CompletableFuture<Status> takeHandoff(long taskId) {
+        return handoffs.remove(taskId);
+    }
+
     /**
      * Received PD's leader transfer command
      *
@@ -758,18 +1055,28 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
             log.info("Raft {} doChangeShard task is {}", getGroupId(), task);
             Utils.runInThread(() -> {
-                List<String> peers =
-                        partitionManager.shards2Peers(task.getChangeShard().getShardList());
+                List<Metapb.Shard> voters = new ArrayList<>();
+                List<Metapb.Shard> learnerShards = new ArrayList<>();
+                task.getChangeShard().getShardList().forEach(shard -> {
+                    if (shard.getRole() == Metapb.ShardRole.Learner) {
+                        learnerShards.add(shard);
+                    } else {
+                        voters.add(shard);
+                    }
+                });
+                List<String> peers = partitionManager.shards2Peers(voters);
+                List<String> learners = partitionManager.shards2Peers(learnerShards);
                 HashSet<String> hashSet = new HashSet<>(peers);
+                hashSet.addAll(learners);
 
                 try {
                     // If there are duplicate peers in the task, it indicates the task itself has errors, ignore the task
-                    if (peers.size() != hashSet.size()) {
+                    if (peers.size() + learners.size() != hashSet.size()) {
                         log.info("Raft {} doChangeShard peer is repeat, peers:{}", getGroupId(),
                                  peers);
                         return;
                     }
-                    Status result = changePeers(peers, null);
+                    Status result = changePeers(peers, learners, null);
 
                     if (result.getCode() == HgRaftError.TASK_CONTINUE.getNumber()) {
                         // Need to resend a request
@@ -858,7 +1165,8 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
     }
 
     /**
-     * Corresponding to the divisional splitting task
+     * Corresponding to the divisional splitting task. The source partition keeps serving
+     * while its data is handed off to the new partitions, see {@link DataManager#split}
      *
      * @param task split partition task
      * @return task execution result
@@ -876,22 +1184,22 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
             for (int i = 0; i < newPartitions.size(); i++) {
                 storeEngine.createPartitionGroups(new Partition(newPartitions.get(i)));
             }
-            // Copy data from the source machine to the target machine
-            status = storeEngine.getDataManager().move(task.getPartition(), newPartitions);
+            // Hand off the data of the new partitions on every replica of the source
+            status = storeEngine.getDataManager().split(task);
 
             if (status.isOk()) {
                 var source = Metapb.Partition.newBuilder(targets.get(0))
                                              .setState(Metapb.PartitionState.PState_Normal)
                                              .build();
-                // Update local key range, and synchronize follower
+                // Update local key range, and synchronize follower, which drops the data
+                // handed off on every replica
                 partitionManager.updatePartition(source, true);
-                partitionManager.updateRange(source,
-                                             (int) source.getStartKey(),
-                                             (int) source.getEndKey());
-            }
-
-            if (!status.isOk()) {
-                throw new Exception(status.getErrorMsg());
+                var response = partitionManager.updateRange(source,
+                                                            (int) source.getStartKey(),
+                                                            (int) source.getEndKey());
+                if (response == null || !response.getStatus().isOK()) {
+                    status = new Status(-1, "update range of source partition fail");
+                }
             }
         } catch (Exception e) {
             log.error("Partition {}-{} moveData exception {}",
@@ -899,9 +1207,117 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
             status = new Status(-1, e.getMessage());
         }
 
+        if (!status.isOk()) {
+            // Keep the source range, which lifts the write fence of the handoff
+            var source = task.getPartition();
+            partitionManager.updatePartition(source, true);
+            partitionManager.updateRange(source, (int) source.getStartKey(),
+                                         (int) source.getEndKey());
+        }
         return status;
     }
 
+    /**
+     * Applies the handoff of a split task on this replica. The data of the new partitions is
+     * handed off as of this log index, so writes to their ranges are refused from now on,
+     * until a range update of the partition covers them again. The export and ingestion run
+     * off the apply thread, the leader of the split waits for them by {@link #takeHandoff}.
+     */
+    private void handleSplitHandoff(MetaTask.Task task, RaftClosure response) {
+        var source = task.getPartition();
+        var targets = task.getSplitPartition().getNewPartitionList();
+        setWriteFence(source.getGraphName(), List.copyOf(targets.subList(1, targets.size())));
+
+        CompletableFuture<Status> future = storeEngine.getDataManager().handoff(task);
+        if (response != null) {
+            handoffs.put(task.getId(), future);
+        }
+        future.thenAccept(status -> {
+            log.info("Raft {}, split handoff of {}-{} to {}, result: {}", getGroupId(),
+                     source.getGraphName(), source.getId(), targets, status);
+        });
+    }
+
+    /**
+     * Applies the fence of a migration task on this replica, the data of the partition is
+     * exported as of this log index, so writes to it are refused from now on, until the
+     * partition is cleaned or a range update of it.
+     */
+    private void handleMoveFence(Metapb.Partition partition) {
+        log.info("Raft {}, fence writes of {}-{} for migration", getGroupId(),
+                 partition.getGraphName(), partition.getId());
+        setWriteFence(partition.getGraphName(), List.of(partition));
+    }
+
+    private void setWriteFence(String graph, List<Metapb.Partition> fences) {
+        handoffManager.putWriteFences(graph, fences);
+        writeFences.put(graph, fences);
+    }
+
+    /**
+     * Whether the key code of graph was handed off to another partition by an online split
+     * or a migration
+     */
+    public boolean isWriteFenced(String graph, int code) {
+        var fences = writeFences.get(graph);
+        if (fences == null) {
+            return false;
+        }
+        for (var fence : fences) {
+            if (code >= fence.getStartKey() && code < fence.getEndKey()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Release the write fence of graph, if the range the partition is updated to overlaps it
+     *
+     * @return whether graph stays fenced, its fenced ranges were handed off for good then
+     */
+    private boolean releaseWriteFence(String graph, long startKey, long endKey) {
+        var fences = writeFences.get(graph);
+        if (fences == null || startKey < 0 || endKey <= 0) {
+            return false;
+        }
+        if (fences.stream().anyMatch(f -> f.getStartKey() < endKey &&
+                                          f.getEndKey() > startKey)) {
+            log.info("Raft {}, release write fence of {}: {}", getGroupId(), graph, fences);
+            writeFences.remove(graph);
+            handoffManager.deleteWriteFences(graph);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Ingests the sst files of a migration on this replica, every replica received the same
+     * files before the task was submitted. A replica failing to ingest for a local reason,
+     * e.g. a missing file, would diverge from the others, so it is rebuilt from a snapshot of
+     * a replica that ingested the files. Invalid files fail on every replica alike, nothing is
+     * rebuilt then and the migration fails.
+     *
+     * @param index log index of the entry
+     */
+    private void handleIngestOp(IngestSstRequest request, RaftClosure response, long index) {
+        Status status = storeEngine.getDataManager().ingest(request, index);
+        log.info("Raft {}, ingest sst files of {}-{} from {} at {}, result: {}", getGroupId(),
+                 request.getGraphName(), request.getPartitionId(), request.getTransferId(),
+                 index, status);
+        if (!status.isOk()) {
+            if (response != null) {
+                response.run(status);
+            }
+            if (status.getCode() == DataManagerImpl.INGEST_INVALID) {
+                return;
+            }
+            String graph = request.getGraphName();
+            rebuildReplica(graph, () -> handoffManager.isIngested(graph,
+                                                                  request.getTransferId()));
+        }
+    }
+
     /**
      * Corresponding to partition data movement task
      *
@@ -922,6 +1338,12 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
             log.error("handleMoveTask got exception: ", e);
             status = new Status(-1, e.getMessage());
         }
+        if (!status.isOk()) {
+            // Keep the source range, which lifts the write fence of the migration
+            var source = task.getPartition();
+            partitionManager.updateRange(source, (int) source.getStartKey(),
+                                         (int) source.getEndKey());
+        }
         return status;
     }
 
@@ -1190,30 +1612,49 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
     class TaskHandler implements RaftTaskHandler {
 
+        // The tasks are applied by PartitionStateMachine only, with the index of the entry
         @Override
         public boolean invoke(final int groupId, byte[] request,
                               RaftClosure response) throws HgStoreException {
+            throw new UnsupportedOperationException("invoke without the log index");
+        }
+
+        @Override
+        public boolean invoke(final int groupId, byte methodId, Object req,
+                              RaftClosure response) throws HgStoreException {
+            throw new UnsupportedOperationException("invoke without the log index");
+        }
+
+        @Override
+        public boolean invoke(final int groupId, byte[] request,
+                              RaftClosure response, long index) throws HgStoreException {
             try {
                 CodedInputStream input = CodedInputStream.newInstance(request);
                 byte methodId = input.readRawByte();
                 switch (methodId) {
                     case RaftOperation.SYNC_PARTITION_TASK:
-                        invoke(groupId, methodId, MetaTask.Task.parseFrom(input), response);
+                    case RaftOperation.SPLIT_HANDOFF:
+                        invoke(groupId, methodId, MetaTask.Task.parseFrom(input), response,
+                               index);
                         break;
                     case RaftOperation.SYNC_PARTITION:
-                        invoke(groupId, methodId, Metapb.Partition.parseFrom(input), response);
+                    case RaftOperation.MOVE_FENCE:
+                        invoke(groupId, methodId, Metapb.Partition.parseFrom(input), response,
+                               index);
                         break;
                     case RaftOperation.DO_SNAPSHOT:
                     case RaftOperation.DO_SYNC_SNAPSHOT:
                     case RaftOperation.BLANK_TASK:
                     case RaftOperation.SYNC_BLANK_TASK:
-                        invoke(groupId, methodId, null, response);
+                        invoke(groupId, methodId, null, response, index);
                         break;
                     case RaftOperation.IN_WRITE_OP:
                     case RaftOperation.RAFT_UPDATE_PARTITION:
                     case RaftOperation.IN_CLEAN_OP:
                     case RaftOperation.DB_COMPACTION:
-                        invoke(groupId, methodId, RaftOperation.toObject(request, 0), response);
+                    case RaftOperation.IN_INGEST_OP:
+                        invoke(groupId, methodId, RaftOperation.toObject(request, 0), response,
+                               index);
                         break;
                     default:
                         return false;
@@ -1226,7 +1667,7 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
 
         @Override
         public boolean invoke(final int groupId, byte methodId, Object req,
-                              RaftClosure response) throws HgStoreException {
+                              RaftClosure response, long index) throws HgStoreException {
             switch (methodId) {
                 case RaftOperation.SYNC_PARTITION_TASK: {
                     MetaTask.Task task = (MetaTask.Task) req;
@@ -1240,9 +1681,12 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
                 break;
                 case RaftOperation.SYNC_PARTITION:
                     log.info("receive sync partition {}", req);
+                    Metapb.Partition partition = (Metapb.Partition) req;
                     if (!isLeader()) {
-                        partitionManager.updatePartition((Metapb.Partition) req, true);
+                        partitionManager.updatePartition(partition, true);
                     }
+                    releaseWriteFence(partition.getGraphName(), partition.getStartKey(),
+                                      partition.getEndKey());
                     break;
                 case RaftOperation.BLANK_TASK:
                     break;
@@ -1259,6 +1703,18 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
                     log.info("Raft {}, receive raft updatePartitionRangeOrState {}",
                              getGroupId(), req);
                     partitionManager.updatePartitionRangeOrState((UpdatePartitionRequest) (req));
+                    UpdatePartitionRequest updateRequest = (UpdatePartitionRequest) req;
+                    if (releaseWriteFence(updateRequest.getGraphName(),
+                                          updateRequest.getStartKey(),
+                                          updateRequest.getEndKey())) {
+                        // The range was narrowed to exclude the handoff, drop the data of it
+                        log.info("Raft {}, drop the data of {} handed off", getGroupId(),
+                                 updateRequest.getGraphName());
+                        storeEngine.getBusinessHandler().cleanPartition(
+                                updateRequest.getGraphName(), getGroupId(),
+                                updateRequest.getStartKey(), updateRequest.getEndKey(),
+                                CleanType.CLEAN_TYPE_KEEP_RANGE);
+                    }
                     break;
                 case RaftOperation.DB_COMPACTION:
                     DbCompactionRequest dbCompactionRequest = (DbCompactionRequest) (req);
@@ -1273,6 +1729,15 @@ public class PartitionEngine implements Lifecycle<PartitionEngineOptions>, RaftS
                 case RaftOperation.SYNC_BLANK_TASK:
                     doBlankTaskSync(response);
                     break;
+                case RaftOperation.SPLIT_HANDOFF:
+                    handleSplitHandoff((MetaTask.Task) req, response);
+                    break;
+                case RaftOperation.MOVE_FENCE:
+                    handleMoveFence((Metapb.Partition) req);
+                    break;
+                case RaftOperation.IN_INGEST_OP:
+                    handleIngestOp((IngestSstRequest) req, response, index);
+                    break;
                 default:
                     return false;
             }
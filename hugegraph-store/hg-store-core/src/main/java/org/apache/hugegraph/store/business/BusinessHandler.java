@@ -20,6 +20,7 @@ package org.apache.hugegraph.store.business;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.TimeoutException;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.function.Consumer;
@@ -35,6 +36,8 @@ import org.apache.hugegraph.store.grpc.common.Key;
 import org.apache.hugegraph.store.grpc.common.OpType;
 import org.apache.hugegraph.store.grpc.query.DeDupOption;
 import org.apache.hugegraph.store.grpc.session.BatchEntry;
+import org.apache.hugegraph.store.meta.HandoffManager;
+import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.base.DBSessionBuilder;
 import org.apache.hugegraph.store.metric.HgStoreMetric;
 import org.apache.hugegraph.store.query.QueryTypeParam;
@@ -60,8 +63,21 @@ public interface BusinessHandler extends DBSessionBuilder {
 
     byte[] doGet(String graph, int code, String table, byte[] key) throws HgStoreException;
 
+    /**
+     * Get the value of key from the partition partId, whichever partition the code routes to
+     */
+    byte[] doGet(String graph, int partId, int code, String table, byte[] key) throws
+                                                                               HgStoreException;
+
     ScanIterator scanAll(String graph, String table) throws HgStoreException;
 
+    /**
+     * @param readLearner scan the learner replicas on this store rather than the leaders,
+     *                    see {@link #getLearnerScanPartitionIds}
+     */
+    ScanIterator scanAll(String graph, String table, boolean readLearner) throws
+                                                                          HgStoreException;
+
     ScanIterator scanAll(String graph, String table, byte[] query) throws HgStoreException;
 
     ScanIterator scan(String graph, String table, int codeFrom, int codeTo) throws HgStoreException;
@@ -118,8 +134,19 @@ public interface BusinessHandler extends DBSessionBuilder {
 
     Set<Integer> getLeaderPartitionIdSet();
 
+    /**
+     * Partitions of graph scanned on this store by the scans that read learners, the learners
+     * are used for the partitions having one, and the leaders for the others
+     */
+    List<Integer> getLearnerScanPartitionIds(String graph) throws HgStoreException;
+
     HgStoreMetric.Graph getGraphMetric(String graph, int partId);
 
+    /**
+     * Usage of the node-wide block cache and write buffer, with the memtables of every db
+     */
+    HgStoreMetric.Memory getMemoryMetric();
+
     void saveSnapshot(String snapshotPath, String graph, int partId) throws HgStoreException;
 
     void loadSnapshot(String snapshotPath, String graph, int partId, long version) throws
@@ -133,6 +160,33 @@ public interface BusinessHandler extends DBSessionBuilder {
     void ingestSstFile(String graph, int partId, Map<byte[], List<String>> sstFiles) throws
                                                                                      HgStoreException;
 
+    /**
+     * Hand the data of graph in partId over to the targets whose key code range it falls in.
+     * The data is fixed as of the call, the export into sst files and the ingestion into the
+     * targets' dbs run on the returned future. A target that ingested it before is skipped,
+     * one that took writes already fails the handoff, see {@link HandoffManager#ingestOnce}
+     */
+    CompletableFuture<Void> handoffPartition(String graph, int partId, List<Partition> targets,
+                                             long taskId) throws HgStoreException;
+
+    HandoffManager getHandoffManager(int partId);
+
+    /**
+     * Export the data of graph in partId as of now into sst files under dir
+     *
+     * @return table name -> sst files
+     */
+    Map<String, List<String>> exportPartition(String graph, int partId, String dir) throws
+                                                                                   HgStoreException;
+
+    /**
+     * Ingest the sst files exported by {@link #exportPartition} from another db, the keys are
+     * rewritten if graph has another id in the db of partId. The files are copied into the db
+     * and kept.
+     */
+    void ingestPartition(String graph, int partId, Map<String, List<String>> sstFiles) throws
+                                                                                       HgStoreException;
+
     // Submit partition split, delete old data
     // Delete partition data
     boolean deletePartition(String graph, int partId);
@@ -148,6 +202,17 @@ public interface BusinessHandler extends DBSessionBuilder {
 
     TxBuilder txBuilder(String graph, int partId);
 
+    /**
+     * Open a write batch of partId for the raft apply thread, the transactions of partId built
+     * by the thread write into it and are committed together by commitApplyBatch
+     */
+    void beginApplyBatch(int partId);
+
+    /**
+     * Commit the write batch opened by beginApplyBatch in one db write
+     */
+    void commitApplyBatch(int partId) throws HgStoreException;
+
     boolean cleanTtl(String graph, int partId, String table, List<ByteString> ids);
 
     default void doBatch(String graph, int partId, List<BatchEntry> entryList) {
@@ -26,12 +26,16 @@ import static org.apache.hugegraph.store.util.HgStoreConst.SCAN_ALL_PARTITIONS_I
 
 import java.io.File;
 import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Paths;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Comparator;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
 import java.util.concurrent.Semaphore;
@@ -81,6 +85,8 @@ import org.apache.hugegraph.store.business.itrv2.MapJoinIterator;
 import org.apache.hugegraph.store.business.itrv2.MapLimitIterator;
 import org.apache.hugegraph.store.business.itrv2.MapUnionIterator;
 import org.apache.hugegraph.store.business.itrv2.MultiListIterator;
+import org.apache.hugegraph.store.business.itrv2.SortedIntersectionIterator;
+import org.apache.hugegraph.store.business.itrv2.SortedMergeIterator;
 import org.apache.hugegraph.store.business.itrv2.TypeTransIterator;
 import org.apache.hugegraph.store.business.itrv2.UnionFilterIterator;
 import org.apache.hugegraph.store.business.itrv2.io.SortShuffleSerializer;
@@ -92,14 +98,17 @@ import org.apache.hugegraph.store.grpc.Graphpb.ScanPartitionRequest;
 import org.apache.hugegraph.store.grpc.Graphpb.ScanPartitionRequest.Request;
 import org.apache.hugegraph.store.grpc.Graphpb.ScanPartitionRequest.ScanType;
 import org.apache.hugegraph.store.grpc.query.DeDupOption;
+import org.apache.hugegraph.store.meta.HandoffManager;
 import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.PartitionManager;
 import org.apache.hugegraph.store.meta.asynctask.AsyncTaskState;
 import org.apache.hugegraph.store.meta.asynctask.CleanTask;
 import org.apache.hugegraph.store.metric.HgStoreMetric;
+import org.apache.hugegraph.store.options.RaftRocksdbOptions;
 import org.apache.hugegraph.store.pd.DefaultPdProvider;
 import org.apache.hugegraph.store.pd.PdProvider;
 import org.apache.hugegraph.store.query.QueryTypeParam;
+import org.apache.hugegraph.store.query.Tuple2;
 import org.apache.hugegraph.store.raft.RaftClosure;
 import org.apache.hugegraph.store.raft.RaftOperation;
 import org.apache.hugegraph.store.term.Bits;
@@ -110,6 +119,8 @@ import org.apache.hugegraph.structure.BaseElement;
 import org.apache.hugegraph.util.Bytes;
 import org.rocksdb.Cache;
 import org.rocksdb.MemoryUsageType;
+import org.rocksdb.RocksDBException;
+import org.rocksdb.Snapshot;
 
 import com.alipay.sofa.jraft.util.Utils;
 import com.google.protobuf.ByteString;
@@ -142,6 +153,10 @@ public class BusinessHandlerImpl implements BusinessHandler {
             ExecutorUtil.createExecutor(PoolNames.COMPACT, compactionThreadCount,
                                         compactionMaxThreadCount, compactionQueueSize);
     private static final int timeoutMillis = 6 * 3600 * 1000;
+    private static final ThreadPoolExecutor handoffPool =
+            ExecutorUtil.createExecutor(PoolNames.HANDOFF, 4, 4, 1000);
+    // Write batch opened by the raft apply thread, shared by the entries applied in a round
+    private static final ThreadLocal<ApplyBatch> applyBatch = new ThreadLocal<>();
     private final BinaryElementSerializer serializer = BinaryElementSerializer.getInstance();
     private final DirectBinarySerializer directBinarySerializer = new DirectBinarySerializer();
     private final PartitionManager partitionManager;
@@ -276,7 +291,12 @@ public class BusinessHandlerImpl implements BusinessHandler {
         if (!partitionManager.hasPartition(graph, partId)) {
             return null;
         }
+        return doGet(graph, partId, code, table, key);
+    }
 
+    @Override
+    public byte[] doGet(String graph, int partId, int code, String table, byte[] key) throws
+                                                                                      HgStoreException {
         try (RocksDBSession dbSession = getSession(graph, table, partId)) {
             byte[] targetKey = keyCreator.getKey(partId, graph, code, key);
             return dbSession.sessionOp().get(table, targetKey);
@@ -288,7 +308,14 @@ public class BusinessHandlerImpl implements BusinessHandler {
 
     @Override
     public ScanIterator scanAll(String graph, String table) throws HgStoreException {
-        List<Integer> ids = this.getLeaderPartitionIds(graph);
+        return scanAll(graph, table, false);
+    }
+
+    @Override
+    public ScanIterator scanAll(String graph, String table, boolean readLearner) throws
+                                                                                 HgStoreException {
+        List<Integer> ids = readLearner ? this.getLearnerScanPartitionIds(graph) :
+                            this.getLeaderPartitionIds(graph);
 
         BiFunction<Integer, byte[], ScanIterator> function = (id, position) -> {
             try (RocksDBSession dbSession = getSession(graph, table, id)) {
@@ -698,6 +725,12 @@ public class BusinessHandlerImpl implements BusinessHandler {
                                                                     }, "replace-pk");
         }
 
+        if (dedupOption == DeDupOption.PRECISE_DEDUP && limit <= 0 &&
+            params.stream().allMatch(BusinessHandlerImpl::isExactIndexScan)) {
+            // The element ids of each prefix index scan are ordered, merge them as stream
+            return sortedIndexIntersection(graph, params, filterTTL, lookup);
+        }
+
         var iterators =
                 params.stream().map(param -> scanIndexToElementId(graph, param, filterTTL, lookup))
                       .collect(Collectors.toList());
@@ -787,13 +820,94 @@ public class BusinessHandlerImpl implements BusinessHandler {
 
     private ScanIterator scanIndexToElementId(String graph, QueryTypeParam param, boolean filterTTL,
                                               boolean lookup) {
-        long now = System.currentTimeMillis();
         return new TypeTransIterator<RocksDBSession.BackendColumn, RocksDBSession.BackendColumn>(
                 param.isRangeIndexScan() ?
                 scan(graph, param.getCode(), INDEX_TABLE, param.getStart(), param.getEnd(),
                      param.getBoundary()) :
                 scanPrefix(graph, param.getCode(), INDEX_TABLE, param.getStart(),
-                           param.getBoundary()), column -> {
+                           param.getBoundary()),
+                indexToElementId(graph, param, filterTTL, lookup),
+                "trans-index-to-element-id");
+    }
+
+    /**
+     * Whether the param scans the index keys of exactly one string index value, which ends
+     * with the string ending byte. Their keys are ordered by the element id that follows,
+     * unlike the keys of a value prefix or a range.
+     */
+    public static boolean isExactIndexScan(QueryTypeParam param) {
+        if (!param.isPrefixIndexScan()) {
+            return false;
+        }
+        byte[] start = param.getStart();
+        return start[start.length - 1] == BytesBuffer.STRING_ENDING_BYTE;
+    }
+
+    /**
+     * Intersect the exact value index scans by streaming merge instead of map or sort
+     * shuffle. The index keys of one index value are ordered by element id in a partition,
+     * so the scans of all partitions are merged in order for each param, then the sorted
+     * streams of params are intersected with leapfrog, no temp file is needed and the
+     * memory is O(params * partitions).
+     * The output is ordered by element id key across partitions, so the position of the
+     * iterator is the element id key of the last element.
+     */
+    private ScanIterator sortedIndexIntersection(String graph, List<QueryTypeParam> params,
+                                                 boolean filterTTL, boolean lookup) {
+        // Compare the element id part of keys, which follows the index prefix
+        Comparator<Tuple2<byte[], RocksDBSession.BackendColumn>> comparator =
+                (o1, o2) -> Arrays.compareUnsigned(o1.getV1(), o2.getV1());
+
+        List<ScanIterator> streams = new ArrayList<>(params.size());
+        for (QueryTypeParam param : params) {
+            List<Integer> ids;
+            if (param.getCode() == SCAN_ALL_PARTITIONS_ID) {
+                ids = this.getLeaderPartitionIds(graph);
+            } else {
+                ids = List.of(partitionManager.getPartitionIdByCode(graph, param.getCode()));
+            }
+            var function = indexToElementId(graph, param, filterTTL, lookup);
+            int offset = param.getStart().length;
+            List<ScanIterator> partitions = new ArrayList<>(ids.size());
+            for (int id : ids) {
+                ScanIterator scan;
+                try (RocksDBSession dbSession = getSession(graph, INDEX_TABLE, id)) {
+                    scan = new InnerKeyFilter(dbSession.sessionOp().scan(
+                            INDEX_TABLE, keyCreator.getPrefixKey(id, graph, param.getStart()),
+                            param.getBoundary()));
+                }
+                partitions.add(new TypeTransIterator<RocksDBSession.BackendColumn,
+                        Tuple2<byte[], RocksDBSession.BackendColumn>>(scan, column -> {
+                    byte[] key = Arrays.copyOfRange(column.name, offset, column.name.length);
+                    var elementId = function.apply(column);
+                    return elementId == null ? null : Tuple2.of(key, elementId);
+                }));
+            }
+            streams.add(partitions.size() == 1 ? partitions.get(0) :
+                        new SortedMergeIterator<>(partitions, comparator));
+        }
+
+        var intersection = new SortedIntersectionIterator<>(streams, comparator,
+                                                            Tuple2::getV1);
+        return new TypeTransIterator<Tuple2<byte[], RocksDBSession.BackendColumn>,
+                RocksDBSession.BackendColumn>(intersection, Tuple2::getV2,
+                                              "sorted-index-intersection") {
+            @Override
+            public byte[] position() {
+                return intersection.position();
+            }
+
+            @Override
+            public void seek(byte[] position) {
+                intersection.seek(position);
+            }
+        };
+    }
+
+    private Function<RocksDBSession.BackendColumn, RocksDBSession.BackendColumn> indexToElementId(
+            String graph, QueryTypeParam param, boolean filterTTL, boolean lookup) {
+        long now = System.currentTimeMillis();
+        return column -> {
             if (filterTTL && isIndexExpire(column, now)) {
                 return null;
             }
@@ -820,7 +934,7 @@ public class BusinessHandlerImpl implements BusinessHandler {
                 // column.value = KeyUtil.idToBytes(BinaryElementSerializer.ownerId(index));
             }
             return column;
-        }, "trans-index-to-element-id");
+        };
     }
 
     private ScanIterator scanIndexToBaseElement(String graph, QueryTypeParam param,
@@ -865,7 +979,8 @@ public class BusinessHandlerImpl implements BusinessHandler {
         int startCode = request.getStartCode();
         int endCode = request.getEndCode();
         if (partitionId == SCAN_ALL_PARTITIONS_ID) {
-            ids = this.getLeaderPartitionIds(graph);
+            ids = request.getReadLearner() ? this.getLearnerScanPartitionIds(graph) :
+                  this.getLeaderPartitionIds(graph);
         } else {
             ids = new ArrayList<>();
             if (startCode != 0 || endCode != 0) {
@@ -979,6 +1094,32 @@ public class BusinessHandlerImpl implements BusinessHandler {
         }
     }
 
+    @Override
+    public HgStoreMetric.Memory getMemoryMetric() {
+        HgStoreMetric.Memory memory = new HgStoreMetric.Memory();
+        memory.setBlockCacheCapacity(RaftRocksdbOptions.getBlockCacheCapacity());
+        memory.setWriteBufferCapacity(RaftRocksdbOptions.getWriteCacheCapacity());
+        memory.setDbMemoryQuota(factory.getHugeConfig().get(RocksDBOptions.DB_MEMORY_QUOTA));
+
+        Map<String, Long> memTables = factory.getMemTableUsage();
+        memory.setDbMemTableUsage(memTables);
+        memory.setWriteBufferUsage(memTables.values().stream().mapToLong(Long::longValue).sum());
+
+        // The block cache is shared, any db reports the usage of the whole node
+        for (String dbName : factory.getGraphNames()) {
+            try (RocksDBSession dbSession = factory.queryGraphDB(dbName)) {
+                if (dbSession != null) {
+                    memory.setBlockCacheUsage(Long.parseLong(
+                            dbSession.getProperty("rocksdb.block-cache-usage")));
+                    memory.setBlockCachePinnedUsage(Long.parseLong(
+                            dbSession.getProperty("rocksdb.block-cache-pinned-usage")));
+                    break;
+                }
+            }
+        }
+        return memory;
+    }
+
     @Override
     public void batchGet(String graph, String table, Supplier<HgPair<Integer, byte[]>> s,
                          Consumer<HgPair<byte[], byte[]>> c) throws HgStoreException {
@@ -1066,6 +1207,22 @@ public class BusinessHandlerImpl implements BusinessHandler {
         return partitionManager.getLeaderPartitionIdSet();
     }
 
+    @Override
+    public List<Integer> getLearnerScanPartitionIds(String graph) throws HgStoreException {
+        List<Integer> ids = partitionManager.getLearnerScanPartitionIds(graph);
+        HgStoreEngine storeEngine = HgStoreEngine.getInstance();
+        int waitMs = storeEngine.getOption().getRaftOptions().getLearnerScanWaitMs();
+        for (Integer id : ids) {
+            PartitionEngine engine = storeEngine.getPartitionEngine(id);
+            if (engine != null && !engine.isLeader() && !engine.isCaughtUp(waitMs)) {
+                // Do not return the partial data of a learner installing snapshots
+                throw new HgStoreException(HgStoreException.EC_LEARNER_NOT_READY,
+                                           "learner of partition %s is catching up", id);
+            }
+        }
+        return ids;
+    }
+
     @Override
     public void saveSnapshot(String snapshotPath, String graph, int partId) throws
                                                                             HgStoreException {
@@ -1112,6 +1269,150 @@ public class BusinessHandlerImpl implements BusinessHandler {
         }
     }
 
+    @Override
+    public CompletableFuture<Void> handoffPartition(String graph, int partId,
+                                                    List<Partition> targets, long taskId) throws
+                                                                                          HgStoreException {
+        for (Partition target : targets) {
+            // The data is ingested into the local db of target, outside of its raft log
+            if (!partitionManager.isLocalPartition(target)) {
+                throw new HgStoreException(HgStoreException.EC_RKDB_TRANSFER_SNAPSHOT_FAIL,
+                                           "partition " + target.getId() +
+                                           " has no replica on this store");
+            }
+        }
+        RocksDBSession dbSession = getSession(graph, partId);
+        // Fix the data as of now, the export reads it later on the handoff pool
+        Snapshot snapshot = dbSession.getSnapshot();
+        try {
+            return CompletableFuture.runAsync(
+                    () -> handoffPartition(dbSession, snapshot, graph, partId, targets, taskId),
+                    handoffPool).whenComplete((r, t) -> {
+                dbSession.releaseSnapshot(snapshot);
+                dbSession.close();
+            });
+        } catch (RuntimeException e) {
+            dbSession.releaseSnapshot(snapshot);
+            dbSession.close();
+            throw e;
+        }
+    }
+
+    private void handoffPartition(RocksDBSession dbSession, Snapshot snapshot, String graph,
+                                  int partId, List<Partition> targets, long taskId) {
+        // Graph ids are allocated per db, so the keys are rewritten to the target's graph id
+        Map<Integer, byte[]> prefixes = new HashMap<>();
+        for (Partition target : targets) {
+            keyCreator.getGraphIdOrCreate(target.getId(), graph);
+            prefixes.put(target.getId(), keyCreator.getStartKey(target.getId(), graph));
+        }
+        String dir = Paths.get(partitionManager.getDbDataPath(partId))
+                          .resolveSibling("split").resolve(String.valueOf(partId)).toString();
+        try {
+            var sstFiles = dbSession.exportSstFiles(
+                    snapshot, dir, keyCreator.getStartKey(partId, graph),
+                    keyCreator.getEndKey(partId, graph),
+                    key -> {
+                        int code = keyCreator.parseKeyCode(key);
+                        for (Partition target : targets) {
+                            if (code >= target.getStartKey() && code < target.getEndKey()) {
+                                return target.getId();
+                            }
+                        }
+                        return -1;
+                    }, prefixes::get);
+            for (Partition target : targets) {
+                var files = sstFiles.get(target.getId());
+                boolean ingested = getHandoffManager(target.getId()).ingestOnce(
+                        graph, partId, taskId, () -> {
+                            if (files != null) {
+                                try (RocksDBSession session = getSession(graph, target.getId())) {
+                                    session.ingestSstFile(files);
+                                }
+                            }
+                        });
+                if (!ingested) {
+                    throw new HgStoreException(HgStoreException.EC_RKDB_TRANSFER_SNAPSHOT_FAIL,
+                                               "partition " + target.getId() +
+                                               " took writes before the handoff");
+                }
+            }
+        } catch (DBStoreException e) {
+            throw new HgStoreException(HgStoreException.EC_RKDB_TRANSFER_SNAPSHOT_FAIL,
+                                       e.toString());
+        } finally {
+            FileUtils.deleteQuietly(new File(dir));
+        }
+    }
+
+    @Override
+    public HandoffManager getHandoffManager(int partId) {
+        PartitionEngine engine = HgStoreEngine.getInstance().getPartitionEngine(partId);
+        return engine != null ? engine.getHandoffManager() : new HandoffManager(this, partId);
+    }
+
+    @Override
+    public Map<String, List<String>> exportPartition(String graph, int partId, String dir) throws
+                                                                                          HgStoreException {
+        Map<String, List<String>> result = new HashMap<>();
+        try (RocksDBSession dbSession = getSession(graph, partId)) {
+            var sstFiles = dbSession.exportSstFiles(dir, keyCreator.getStartKey(partId, graph),
+                                                    keyCreator.getEndKey(partId, graph),
+                                                    key -> 0, target -> null);
+            sstFiles.getOrDefault(0, Map.of()).forEach((table, files) -> {
+                result.put(new String(table, StandardCharsets.UTF_8), files);
+            });
+        } catch (DBStoreException e) {
+            throw new HgStoreException(HgStoreException.EC_RKDB_EXPORT_SNAPSHOT_FAIL,
+                                       e.toString());
+        }
+        return result;
+    }
+
+    @Override
+    public void ingestPartition(String graph, int partId,
+                                Map<String, List<String>> sstFiles) throws HgStoreException {
+        // Graph ids are allocated per db, so the keys may need the graph id of this db
+        keyCreator.getGraphIdOrCreate(partId, graph);
+        byte[] prefix = keyCreator.getStartKey(partId, graph);
+        Map<byte[], List<String>> files = new HashMap<>();
+        try (RocksDBSession dbSession = getSession(graph, partId)) {
+            for (var entry : sstFiles.entrySet()) {
+                for (String file : entry.getValue()) {
+                    dbSession.rewriteSstFile(entry.getKey(), file, prefix);
+                }
+                files.put(entry.getKey().getBytes(StandardCharsets.UTF_8), entry.getValue());
+            }
+            // Copied, the files are kept for replaying the raft entry
+            dbSession.ingestSstFile(files, false);
+        } catch (DBStoreException e) {
+            throw new HgStoreException(isInvalidSst(e) ?
+                                       HgStoreException.EC_RKDB_INVALID_SST :
+                                       HgStoreException.EC_RKDB_IMPORT_SNAPSHOT_FAIL,
+                                       e.toString());
+        }
+    }
+
+    /**
+     * Whether the sst files failed for their content rather than for this store, such as a
+     * missing file or a full disk
+     */
+    private static boolean isInvalidSst(DBStoreException e) {
+        Throwable cause = DBStoreException.rootCause(e);
+        if (!(cause instanceof RocksDBException) ||
+            ((RocksDBException) cause).getStatus() == null) {
+            return false;
+        }
+        switch (((RocksDBException) cause).getStatus().getCode()) {
+            case Corruption:
+            case InvalidArgument:
+            case NotSupported:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     @Override
     public boolean cleanPartition(String graph, int partId) {
         Partition partition = partitionManager.getPartitionFromPD(graph, partId);
@@ -1287,9 +1588,40 @@ public class BusinessHandlerImpl implements BusinessHandler {
 
     @Override
     public TxBuilder txBuilder(String graph, int partId) throws HgStoreException {
+        ApplyBatch batch = applyBatch.get();
+        if (batch != null && batch.partId == partId) {
+            if (batch.op == null) {
+                batch.dbSession = getSession(graph, partId);
+                batch.op = batch.dbSession.sessionOp();
+                batch.op.prepare();
+            }
+            return new TxBuilderImpl(graph, partId, batch.op);
+        }
         return new TxBuilderImpl(graph, partId, getSession(graph, partId));
     }
 
+    @Override
+    public void beginApplyBatch(int partId) {
+        applyBatch.set(new ApplyBatch(partId));
+    }
+
+    @Override
+    public void commitApplyBatch(int partId) throws HgStoreException {
+        ApplyBatch batch = applyBatch.get();
+        applyBatch.remove();
+        if (batch == null || batch.op == null) {
+            return;
+        }
+        try {
+            batch.op.commit();
+        } catch (DBStoreException e) {
+            batch.op.rollback();
+            throw new HgStoreException(HgStoreException.EC_RKDB_DOPUT_FAIL, e.toString());
+        } finally {
+            batch.dbSession.close();
+        }
+    }
+
     @Override
     public boolean cleanTtl(String graph, int partId, String table, List<ByteString> ids) {
 
@@ -1573,6 +1905,17 @@ public class BusinessHandlerImpl implements BusinessHandler {
             this.op.prepare();
         }
 
+        /**
+         * Transaction in the write batch of the raft apply thread, committed with the batch
+         */
+        private TxBuilderImpl(String graph, int partId, SessionOperator op) {
+            this.graph = graph;
+            this.partId = partId;
+            this.dbSession = null;
+            this.op = op;
+            this.op.setSavePoint();
+        }
+
         @Override
         public TxBuilder put(int code, String table, byte[] key, byte[] value) throws
                                                                                HgStoreException {
@@ -1628,8 +1971,14 @@ public class BusinessHandlerImpl implements BusinessHandler {
                                                                                     HgStoreException {
 
             try {
-                this.op.deleteRange(table, keyCreator.getStartKey(this.partId, graph, start),
-                                    keyCreator.getEndKey(this.partId, graph, end));
+                byte[] startKey = keyCreator.getStartKey(this.partId, graph, start);
+                byte[] endKey = keyCreator.getEndKey(this.partId, graph, end);
+                if (this.dbSession == null) {
+                    // Keep the shared write batch and the save points of the apply round
+                    this.op.deleteRangeInBatch(table, startKey, endKey);
+                } else {
+                    this.op.deleteRange(table, startKey, endKey);
+                }
             } catch (DBStoreException e) {
                 throw new HgStoreException(HgStoreException.EC_RKDB_DODELRANGE_FAIL, e.toString());
             }
@@ -1655,6 +2004,16 @@ public class BusinessHandlerImpl implements BusinessHandler {
             return new Tx() {
                 @Override
                 public void commit() throws HgStoreException {
+                    if (dbSession == null) {
+                        // The writes stay in the batch, only drop the save point of this tx
+                        try {
+                            op.popSavePoint();
+                        } catch (DBStoreException e) {
+                            throw new HgStoreException(HgStoreException.EC_RKDB_DOPUT_FAIL,
+                                                       e.toString());
+                        }
+                        return;
+                    }
                     op.commit();  // After an exception occurs in commit, rollback must be
                     // called, otherwise it will cause the lock not to be released.
                     dbSession.close();
@@ -1662,6 +2021,16 @@ public class BusinessHandlerImpl implements BusinessHandler {
 
                 @Override
                 public void rollback() throws HgStoreException {
+                    if (dbSession == null) {
+                        // Only discard the writes of this transaction from the batch
+                        try {
+                            op.rollbackToSavePoint();
+                        } catch (DBStoreException e) {
+                            throw new HgStoreException(HgStoreException.EC_RKDB_DOPUT_FAIL,
+                                                       e.toString());
+                        }
+                        return;
+                    }
                     try {
                         op.rollback();
                     } finally {
@@ -1672,6 +2041,17 @@ public class BusinessHandlerImpl implements BusinessHandler {
         }
     }
 
+    private static class ApplyBatch {
+
+        private final int partId;
+        private RocksDBSession dbSession;
+        private SessionOperator op;
+
+        private ApplyBatch(int partId) {
+            this.partId = partId;
+        }
+    }
+
     public static void clearCache() {
         GRAPH_SUPPLIER_CACHE.clear();
     }
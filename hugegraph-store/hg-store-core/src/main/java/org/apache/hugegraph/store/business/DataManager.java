@@ -18,11 +18,15 @@
 package org.apache.hugegraph.store.business;
 
 import java.util.List;
+import java.util.concurrent.CompletableFuture;
 
+import org.apache.hugegraph.pd.grpc.MetaTask;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.store.cmd.HgCmdClient;
 import org.apache.hugegraph.store.cmd.request.BatchPutRequest;
 import org.apache.hugegraph.store.cmd.request.CleanDataRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
+import org.apache.hugegraph.store.cmd.request.SstFileRequest;
 import org.apache.hugegraph.store.meta.PartitionManager;
 
 import com.alipay.sofa.jraft.Status;
@@ -50,7 +54,11 @@ public interface DataManager {
     Status move(Metapb.Partition source, List<Metapb.Partition> targets) throws Exception;
 
     /**
-     * Copy all data from source partition to target partition
+     * Copy all data from source partition to target partition. The data is exported into sst
+     * files that are shipped to every replica of target and ingested through its raft log,
+     * and copied row by row if that fails before target took any of it. Then writes to source
+     * are refused from a raft index on, until the source is cleaned or its range is updated,
+     * and the writes applied since the export are copied to target.
      *
      * @param source source partition
      * @param target target partition
@@ -59,6 +67,53 @@ public interface DataManager {
      */
     Status move(Metapb.Partition source, Metapb.Partition target) throws Exception;
 
+    /**
+     * Split the source partition of a split task into its new partitions online. The handoff
+     * goes through the raft log of the source, so every replica hands off its own data as of
+     * the same index, and the source keeps serving reads and the writes of its kept range.
+     *
+     * @param task split partition task
+     * @return execution result
+     * @throws Exception execution exception
+     */
+    Status split(MetaTask.Task task) throws Exception;
+
+    /**
+     * Hand the data of a split task off to the new partitions on this replica, called when
+     * the raft log of the source partition applies it. The data is fixed as of the entry, the
+     * export and ingestion run off the apply thread. A replica of a new partition here that
+     * could not take the handoff is rebuilt from a snapshot of its leader.
+     *
+     * @param task split partition task
+     * @return execution result
+     */
+    CompletableFuture<Status> handoff(MetaTask.Task task);
+
+    /**
+     * Receive a chunk of an sst file of a partition migration
+     *
+     * @param request file chunk
+     * @return execution result, an error if the checksum of the file does not match
+     */
+    Status receive(SstFileRequest request);
+
+    /**
+     * Ingest the received sst files of a partition migration on this replica, called when the
+     * raft log of the target partition applies it. An ingest replayed from the log is skipped,
+     * the files are kept for the replay until a snapshot covers the entry.
+     *
+     * @param request ingest request
+     * @param index   log index of the entry
+     * @return execution result
+     */
+    Status ingest(IngestSstRequest request, long index);
+
+    /**
+     * Delete the received sst files of the migrations into partId ingested up to index, which
+     * a snapshot of the partition covers
+     */
+    void cleanTransfers(int partId, long index);
+
     //UpdatePartitionResponse updatePartitionState(Metapb.Partition partition, Metapb
     // .PartitionState state);
     //
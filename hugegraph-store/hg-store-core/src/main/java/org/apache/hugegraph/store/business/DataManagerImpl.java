@@ -21,18 +21,33 @@ import static org.apache.hugegraph.store.constant.HugeServerTables.INDEX_TABLE;
 import static org.apache.hugegraph.store.constant.HugeServerTables.OUT_EDGE_TABLE;
 import static org.apache.hugegraph.store.constant.HugeServerTables.VERTEX_TABLE;
 
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.RandomAccessFile;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Paths;
+import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.Collections;
 import java.util.HashMap;
+import java.util.HashSet;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicReference;
 import java.util.function.BiFunction;
+import java.util.zip.CRC32;
 
+import org.apache.commons.io.FileUtils;
 import org.apache.hugegraph.backend.BackendColumn;
 import org.apache.hugegraph.id.IdUtil;
 import org.apache.hugegraph.pd.common.PartitionUtils;
+import org.apache.hugegraph.pd.grpc.MetaTask;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.Metapb.PartitionState;
 import org.apache.hugegraph.pd.grpc.pulse.CleanType;
@@ -40,16 +55,25 @@ import org.apache.hugegraph.rocksdb.access.RocksDBSession;
 import org.apache.hugegraph.rocksdb.access.ScanIterator;
 import org.apache.hugegraph.serializer.BinaryElementSerializer;
 import org.apache.hugegraph.store.HgStoreEngine;
+import org.apache.hugegraph.store.PartitionEngine;
 import org.apache.hugegraph.store.cmd.HgCmdClient;
 import org.apache.hugegraph.store.cmd.request.BatchPutRequest;
 import org.apache.hugegraph.store.cmd.request.CleanDataRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
+import org.apache.hugegraph.store.cmd.request.SstFileRequest;
 import org.apache.hugegraph.store.cmd.response.BatchPutResponse;
+import org.apache.hugegraph.store.cmd.response.IngestSstResponse;
+import org.apache.hugegraph.store.cmd.response.SstFileResponse;
 import org.apache.hugegraph.store.cmd.response.UpdatePartitionResponse;
+import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.PartitionManager;
+import org.apache.hugegraph.store.meta.ShardGroup;
+import org.apache.hugegraph.store.meta.Store;
 import org.apache.hugegraph.store.query.util.KeyUtil;
 import org.apache.hugegraph.store.raft.RaftClosure;
 import org.apache.hugegraph.store.raft.RaftOperation;
 import org.apache.hugegraph.store.term.Bits;
+import org.apache.hugegraph.store.util.HgStoreException;
 import org.apache.hugegraph.struct.schema.IndexLabel;
 import org.apache.hugegraph.structure.BaseEdge;
 import org.apache.hugegraph.structure.BaseElement;
@@ -65,6 +89,14 @@ import lombok.extern.slf4j.Slf4j;
 public class DataManagerImpl implements DataManager {
 
     public static final int BATCH_PUT_SIZE = 2000;
+    public static final int SST_CHUNK_SIZE = 1024 * 1024;
+    // The target took a part of the migrated data, copying the rows over it would keep the
+    // rows source deleted meanwhile
+    private static final int MIGRATE_PARTIAL = -3;
+    // The sst files of a migration are invalid, every replica fails to ingest them alike
+    public static final int INGEST_INVALID = -4;
+    // Written into the directory of a transfer once its files are ingested, holds the index
+    private static final String INGESTED_MARKER = "INGESTED";
     private BusinessHandler businessHandler;
     private PartitionManager metaManager;
     private HgCmdClient client;
@@ -125,10 +157,378 @@ public class DataManagerImpl implements DataManager {
         return status;
     }
 
+    @Override
+    public Status split(MetaTask.Task task) throws Exception {
+        Metapb.Partition source = task.getPartition();
+        List<Metapb.Partition> newPartitions = task.getSplitPartition().getNewPartitionList();
+        List<Metapb.Partition> targets = newPartitions.subList(1, newPartitions.size());
+
+        var engine = HgStoreEngine.getInstance().getPartitionEngine(source.getId());
+        if (engine == null || !engine.isLeader()) {
+            return new Status(-1, "source partition is not leader");
+        }
+        for (var target : targets) {
+            if (!isColocated(source.getId(), target.getId())) {
+                // PD reuses an existing shard group for the new partition, the replicas of
+                // source can't hand off the data into their local dbs, copy it through the
+                // raft log of the new partitions instead
+                log.info("split {}-{}, shard group of {} is on other stores, copy the data",
+                         source.getGraphName(), source.getId(), target.getId());
+                return move(source, targets);
+            }
+        }
+
+        Status status = addRaftTaskSync(engine,
+                                        RaftOperation.create(RaftOperation.SPLIT_HANDOFF, task));
+        CompletableFuture<Status> handoff = engine.takeHandoff(task.getId());
+        if (status.isOk()) {
+            status = handoff != null ? handoff.get() :
+                     new Status(-1, "source partition lost leader during handoff");
+        }
+        // Bring the new partitions online
+        for (var target : targets) {
+            if (status.isOk()) {
+                if (!(metaManager.updateRange(target, (int) target.getStartKey(),
+                                              (int) target.getEndKey())
+                                 .getStatus().isOK()
+                      &&
+                      metaManager.updateState(target, PartitionState.PState_Normal).getStatus()
+                                 .isOK())) {
+                    status.setError(-3, "new partition online fail");
+                }
+            }
+        }
+        return status;
+    }
+
+    /**
+     * Whether the shard group of target lives on the same stores as the one of source
+     */
+    private boolean isColocated(int sourceId, int targetId) {
+        ShardGroup sourceGroup = metaManager.getShardGroup(sourceId);
+        ShardGroup targetGroup = metaManager.getShardGroup(targetId);
+        if (sourceGroup == null || targetGroup == null) {
+            return false;
+        }
+        return storeIds(sourceGroup).equals(storeIds(targetGroup));
+    }
+
+    private static Set<Long> storeIds(ShardGroup shardGroup) {
+        Set<Long> storeIds = new HashSet<>();
+        shardGroup.getShards().forEach(shard -> storeIds.add(shard.getStoreId()));
+        return storeIds;
+    }
+
+    @Override
+    public CompletableFuture<Status> handoff(MetaTask.Task task) {
+        Metapb.Partition source = task.getPartition();
+        String graph = source.getGraphName();
+        List<Metapb.Partition> newPartitions = task.getSplitPartition().getNewPartitionList();
+        List<Partition> targets = new ArrayList<>();
+        for (var target : newPartitions.subList(1, newPartitions.size())) {
+            targets.add(new Partition(target));
+        }
+        CompletableFuture<Void> future;
+        try {
+            future = businessHandler.handoffPartition(graph, source.getId(), targets,
+                                                      task.getId());
+        } catch (Exception e) {
+            future = CompletableFuture.failedFuture(e);
+        }
+        return future.handle((r, e) -> {
+            if (e == null) {
+                return Status.OK();
+            }
+            log.error("handoff {}-{} to {} failed", graph, source.getId(), targets, e);
+            var engine = HgStoreEngine.getInstance().getPartitionEngine(source.getId());
+            // The split fails if the leader failed, the new partitions are dropped then
+            if (engine != null && !engine.isLeader()) {
+                for (Partition target : targets) {
+                    var handoffs = businessHandler.getHandoffManager(target.getId());
+                    var targetEngine = HgStoreEngine.getInstance()
+                                                    .getPartitionEngine(target.getId());
+                    if (targetEngine != null && !handoffs.isHandedOff(graph, source.getId())) {
+                        targetEngine.rebuildReplica(graph, () -> handoffs.isHandedOff(
+                                graph, source.getId()));
+                    }
+                }
+            }
+            return new Status(-2, "handoff data fail: " + e.getMessage());
+        });
+    }
+
+    @Override
+    public Status receive(SstFileRequest request) {
+        File file = Paths.get(getMigrateDir(request.getPartitionId(), "in",
+                                            request.getTransferId()),
+                              Paths.get(request.getFileName()).getFileName().toString())
+                         .toFile();
+        try {
+            FileUtils.forceMkdirParent(file);
+            try (RandomAccessFile out = new RandomAccessFile(file, "rw")) {
+                if (request.getOffset() == 0) {
+                    out.setLength(0);
+                }
+                out.seek(request.getOffset());
+                out.write(request.getData());
+            }
+            if (request.isLast() && FileUtils.checksumCRC32(file) != request.getChecksum()) {
+                FileUtils.deleteQuietly(file);
+                return new Status(-2, "checksum mismatch of " + file);
+            }
+        } catch (IOException e) {
+            log.error("receive sst file {} error", file, e);
+            return new Status(-2, "receive sst file fail: " + e.getMessage());
+        }
+        return Status.OK();
+    }
+
+    @Override
+    public Status ingest(IngestSstRequest request, long index) {
+        String graph = request.getGraphName();
+        String dir = getMigrateDir(request.getPartitionId(), "in", request.getTransferId());
+        Map<String, List<String>> sstFiles = new HashMap<>();
+        request.getFiles().forEach((table, names) -> {
+            List<String> files = new ArrayList<>();
+            names.forEach(name -> files.add(Paths.get(dir, name).toString()));
+            sstFiles.put(table, files);
+        });
+        try {
+            businessHandler.getHandoffManager(request.getPartitionId()).ingestTransferOnce(
+                    graph, request.getTransferId(),
+                    () -> businessHandler.ingestPartition(graph, request.getPartitionId(),
+                                                          sstFiles));
+            // The files are kept for replaying the entry until a snapshot covers it
+            FileUtils.writeStringToFile(new File(dir, INGESTED_MARKER), String.valueOf(index),
+                                        StandardCharsets.UTF_8);
+        } catch (Exception e) {
+            log.error("ingest {}-{} of {} failed", graph, request.getPartitionId(),
+                      request.getTransferId(), e);
+            int code = e instanceof HgStoreException &&
+                       ((HgStoreException) e).getCode() ==
+                       HgStoreException.EC_RKDB_INVALID_SST ? INGEST_INVALID : -2;
+            return new Status(code, "ingest sst files fail: " + e.getMessage());
+        }
+        return Status.OK();
+    }
+
+    @Override
+    public void cleanTransfers(int partId, long index) {
+        File[] dirs = new File(getMigrateDir(partId, "in", "")).listFiles(File::isDirectory);
+        if (dirs == null) {
+            return;
+        }
+        for (File dir : dirs) {
+            File marker = new File(dir, INGESTED_MARKER);
+            try {
+                if (marker.exists() &&
+                    Long.parseLong(FileUtils.readFileToString(marker, StandardCharsets.UTF_8)
+                                            .trim()) <= index) {
+                    log.info("Partition {}, delete the ingested transfer {}", partId, dir);
+                    FileUtils.deleteQuietly(dir);
+                }
+            } catch (IOException | NumberFormatException e) {
+                log.warn("Partition {}, read {} error", partId, marker, e);
+            }
+        }
+    }
+
     @Override
     public Status move(Metapb.Partition source, Metapb.Partition target) throws Exception {
-        // Only write to target
-        return move(source, Collections.singletonList(target), (partitions, integer) -> target);
+        Status status = migrate(source, target);
+        if (!status.isOk() && status.getCode() != MIGRATE_PARTIAL) {
+            log.warn("migrate {}-{} to {} by sst files failed: {}, copy the data instead",
+                     source.getGraphName(), source.getId(), target.getId(), status);
+            // Only write to target
+            status = move(source, Collections.singletonList(target),
+                          (partitions, integer) -> target);
+        }
+        return status;
+    }
+
+    /**
+     * Migrate the data of source to target by sst files:
+     * 1. Record the writes source applies from now on
+     * 2. Export the data of source into sst files, writes are still served
+     * 3. Ship the files with checksums to every replica of target
+     * 4. Ingest the files through the raft log of target, the replicas that lag behind
+     * catch up with it like any other entry of the log
+     * 5. Fence the writes of source through its raft log, and copy the writes recorded since
+     * the export to target, so the fence only lasts for this short delta
+     *
+     * @param source source partition, whose leader is local
+     * @param target target partition
+     * @return execution result, MIGRATE_PARTIAL if target took a part of the data
+     */
+    private Status migrate(Metapb.Partition source, Metapb.Partition target) throws Exception {
+        var engine = HgStoreEngine.getInstance().getPartitionEngine(source.getId());
+        if (engine == null || !engine.isLeader()) {
+            return new Status(-1, "source partition is not leader");
+        }
+        String graphName = source.getGraphName();
+        String transferId = source.getId() + "-" + target.getId() + "-" +
+                            System.currentTimeMillis();
+        String dir = getMigrateDir(source.getId(), "out", transferId);
+        MigrationDelta delta = engine.startMigrationDelta(graphName);
+        try {
+            // The entries applied before the barrier, recorded or not, are in the export
+            Status status = addRaftTaskSync(engine,
+                                            RaftOperation.create(RaftOperation.BLANK_TASK));
+            if (!status.isOk()) {
+                return status;
+            }
+            long start = System.currentTimeMillis();
+            var sstFiles = businessHandler.exportPartition(graphName, source.getId(), dir);
+            if (!sstFiles.isEmpty()) {
+                status = shipAndIngest(graphName, target.getId(), transferId, sstFiles);
+                if (!status.isOk()) {
+                    return status;
+                }
+            }
+            long fenced = System.currentTimeMillis();
+            status = addRaftTaskSync(engine,
+                                     RaftOperation.create(RaftOperation.MOVE_FENCE, source));
+            if (!status.isOk()) {
+                return new Status(MIGRATE_PARTIAL, "fence writes fail: " + status.getErrorMsg());
+            }
+            var entries = delta.toEntries(
+                    (table, code, key) -> businessHandler.doGet(graphName, source.getId(), code,
+                                                                table, key));
+            WriteBatch batch = new WriteBatch(graphName);
+            int count = 0;
+            for (BatchPutRequest.KV kv : entries) {
+                batch.add(target.getId(), kv);
+                if (++count % BATCH_PUT_SIZE == 0 && !batch.sync()) {
+                    return new Status(MIGRATE_PARTIAL, "copy the delta fail");
+                }
+            }
+            if (count % BATCH_PUT_SIZE != 0 && !batch.sync()) {
+                return new Status(MIGRATE_PARTIAL, "copy the delta fail");
+            }
+            log.info("migrate {}-{} to {} by sst files {}, {} writes after the export, " +
+                     "time cost {} ms, fenced {} ms", graphName, source.getId(), target.getId(),
+                     sstFiles.keySet(), entries.size(), System.currentTimeMillis() - start,
+                     System.currentTimeMillis() - fenced);
+            return Status.OK();
+        } catch (Exception e) {
+            log.error("migrate {}-{} to {} got exception", graphName, source.getId(),
+                      target.getId(), e);
+            return new Status(-2, "migrate fail: " + e.getMessage());
+        } finally {
+            engine.stopMigrationDelta(graphName);
+            FileUtils.deleteQuietly(new File(dir));
+        }
+    }
+
+    /**
+     * Ship the sst files to every replica of the target partition and ingest them through its
+     * raft log
+     */
+    private Status shipAndIngest(String graphName, int targetId, String transferId,
+                                 Map<String, List<String>> sstFiles) throws IOException {
+        ShardGroup shardGroup = metaManager.getShardGroup(targetId);
+        if (shardGroup == null) {
+            return new Status(-2, "shard group of target partition not found");
+        }
+        Map<String, List<String>> names = new HashMap<>();
+        sstFiles.forEach((table, files) -> {
+            List<String> list = new ArrayList<>();
+            files.forEach(file -> list.add(Paths.get(file).getFileName().toString()));
+            names.put(table, list);
+        });
+        // Every replica must have the files before the ingest is applied
+        for (var shard : shardGroup.getShards()) {
+            Store store = metaManager.getStore(shard.getStoreId());
+            if (store == null) {
+                return new Status(-2, "store " + shard.getStoreId() + " not found");
+            }
+            for (var entry : sstFiles.entrySet()) {
+                for (String file : entry.getValue()) {
+                    if (!sendSstFile(store.getRaftAddress(), graphName, targetId, transferId,
+                                     entry.getKey(), file)) {
+                        return new Status(-2, "send sst file fail: " + file);
+                    }
+                }
+            }
+        }
+
+        IngestSstRequest request = new IngestSstRequest();
+        request.setGraphName(graphName);
+        request.setPartitionId(targetId);
+        request.setTransferId(transferId);
+        request.setFiles(names);
+        IngestSstResponse response = client.ingestSstFile(request);
+        if (response == null || !response.getStatus().isOK()) {
+            // Replicas may have ingested it even so
+            return new Status(MIGRATE_PARTIAL, "ingest sst files fail: " +
+                                               (response != null ?
+                                                response.getStatus().getMsg() :
+                                                "EMPTY_RESPONSE"));
+        }
+        return Status.OK();
+    }
+
+    /**
+     * Send an sst file in chunks to the store at address, the last chunk carries the checksum
+     */
+    private boolean sendSstFile(String address, String graphName, int partId, String transferId,
+                                String table, String file) throws IOException {
+        String fileName = Paths.get(file).getFileName().toString();
+        CRC32 crc32 = new CRC32();
+        long offset = 0;
+        long length = new File(file).length();
+        byte[] buffer = new byte[SST_CHUNK_SIZE];
+        try (InputStream in = new FileInputStream(file)) {
+            do {
+                int n = Math.max(in.readNBytes(buffer, 0, buffer.length), 0);
+                crc32.update(buffer, 0, n);
+
+                SstFileRequest request = new SstFileRequest();
+                request.setGraphName(graphName);
+                request.setPartitionId(partId);
+                request.setTransferId(transferId);
+                request.setTable(table);
+                request.setFileName(fileName);
+                request.setOffset(offset);
+                request.setData(Arrays.copyOf(buffer, n));
+                offset += n;
+                request.setLast(offset >= length);
+                request.setChecksum(request.isLast() ? crc32.getValue() : 0L);
+
+                SstFileResponse response = client.sendSstFile(address, request);
+                if (response == null || !response.getStatus().isOK()) {
+                    log.error("send sst file {} to {} error, status:{}", file, address,
+                              response != null ? response.getStatus() : "EMPTY_RESPONSE");
+                    return false;
+                }
+            } while (offset < length);
+        }
+        return true;
+    }
+
+    private String getMigrateDir(int partId, String direction, String transferId) {
+        return Paths.get(metaManager.getDbDataPath(partId)).resolveSibling("migrate")
+                    .resolve(direction).resolve(String.valueOf(partId)).resolve(transferId)
+                    .toString();
+    }
+
+    /**
+     * Submit a raft task to the local leader and wait for it, the first status the closure
+     * receives is the result of the task
+     */
+    private Status addRaftTaskSync(PartitionEngine engine, RaftOperation operation) throws
+                                                                                    InterruptedException {
+        CountDownLatch latch = new CountDownLatch(1);
+        AtomicReference<Status> result = new AtomicReference<>();
+        engine.addRaftTask(operation, new RaftClosure() {
+            @Override
+            public void run(Status status) {
+                result.compareAndSet(null, status);
+                latch.countDown();
+            }
+        });
+        latch.await();
+        return result.get();
     }
 
     /**
@@ -225,9 +625,23 @@ public class DataManagerImpl implements DataManager {
         BusinessHandler.TxBuilder tx =
                 businessHandler.txBuilder(request.getGraphName(), request.getPartitionId());
         for (BatchPutRequest.KV kv : request.getEntries()) {
-            tx.put(kv.getCode(), kv.getTable(), kv.getKey(), kv.getValue());
+            if (kv.getValue() != null) {
+                tx.put(kv.getCode(), kv.getTable(), kv.getKey(), kv.getValue());
+            } else if (kv.isPrefix()) {
+                tx.delPrefix(kv.getCode(), kv.getTable(), kv.getKey());
+            } else if (kv.getEndKey() != null) {
+                tx.delRange(kv.getCode(), kv.getTable(), kv.getKey(), kv.getEndKey());
+            } else {
+                tx.del(kv.getCode(), kv.getTable(), kv.getKey());
+            }
         }
         tx.build().commit();
+        var engine = HgStoreEngine.getInstance().getPartitionEngine(request.getPartitionId());
+        MigrationDelta delta = engine != null ? engine.getMigrationDelta(request.getGraphName()) :
+                               null;
+        if (delta != null) {
+            delta.recordKVs(request.getEntries());
+        }
     }
 
     @Override
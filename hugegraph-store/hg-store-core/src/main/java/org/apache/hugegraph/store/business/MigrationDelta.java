@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.business;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Objects;
+import java.util.Set;
+
+import org.apache.hugegraph.store.cmd.request.BatchPutRequest;
+import org.apache.hugegraph.store.constant.HugeServerTables;
+import org.apache.hugegraph.store.grpc.common.OpType;
+import org.apache.hugegraph.store.grpc.session.BatchEntry;
+
+/**
+ * The writes a partition applies while its data is migrated by sst files. The export misses
+ * the writes applied after it, so once the writes of the partition are fenced they are copied
+ * to the target by what is recorded here: the range deletes in order, then the written keys
+ * with their values at the fence.
+ */
+public class MigrationDelta {
+
+    private final List<BatchPutRequest.KV> rangeDeletes = new ArrayList<>();
+    private final Set<WrittenKey> keys = new LinkedHashSet<>();
+
+    public synchronized void record(List<BatchEntry> entries) {
+        for (BatchEntry entry : entries) {
+            String table = HugeServerTables.TABLES[entry.getTable()];
+            int code = entry.getStartKey().getCode();
+            byte[] key = entry.getStartKey().getKey().toByteArray();
+            switch (entry.getOpType().getNumber()) {
+                case OpType.OP_TYPE_DEL_PREFIX_VALUE:
+                    rangeDeletes.add(BatchPutRequest.KV.ofDeletePrefix(table, code, key));
+                    break;
+                case OpType.OP_TYPE_DEL_RANGE_VALUE:
+                    rangeDeletes.add(BatchPutRequest.KV.ofDeleteRange(
+                            table, code, key, entry.getEndKey().getKey().toByteArray()));
+                    break;
+                default:
+                    keys.add(new WrittenKey(table, code, key));
+            }
+        }
+    }
+
+    public synchronized void recordKVs(List<BatchPutRequest.KV> entries) {
+        for (BatchPutRequest.KV kv : entries) {
+            if (kv.isPrefix() || kv.getEndKey() != null) {
+                rangeDeletes.add(kv);
+            } else {
+                keys.add(new WrittenKey(kv.getTable(), kv.getCode(), kv.getKey()));
+            }
+        }
+    }
+
+    public synchronized int size() {
+        return rangeDeletes.size() + keys.size();
+    }
+
+    /**
+     * @param reader reads the value of a key from the fenced source, null if it is deleted
+     * @return the writes that bring the target up to the source
+     */
+    public synchronized List<BatchPutRequest.KV> toEntries(ValueReader reader) {
+        List<BatchPutRequest.KV> entries = new ArrayList<>(rangeDeletes);
+        for (WrittenKey key : keys) {
+            byte[] value = reader.get(key.table, key.code, key.key);
+            entries.add(value != null ? BatchPutRequest.KV.of(key.table, key.code, key.key, value) :
+                        BatchPutRequest.KV.ofDelete(key.table, key.code, key.key));
+        }
+        return entries;
+    }
+
+    @FunctionalInterface
+    public interface ValueReader {
+
+        byte[] get(String table, int code, byte[] key);
+    }
+
+    private static class WrittenKey {
+
+        private final String table;
+        private final int code;
+        private final byte[] key;
+
+        private WrittenKey(String table, int code, byte[] key) {
+            this.table = table;
+            this.code = code;
+            this.key = key;
+        }
+
+        @Override
+        public boolean equals(Object o) {
+            if (this == o) {
+                return true;
+            }
+            if (!(o instanceof WrittenKey)) {
+                return false;
+            }
+            WrittenKey that = (WrittenKey) o;
+            return code == that.code && table.equals(that.table) && Arrays.equals(key, that.key);
+        }
+
+        @Override
+        public int hashCode() {
+            return Objects.hash(table, code) * 31 + Arrays.hashCode(key);
+        }
+    }
+}
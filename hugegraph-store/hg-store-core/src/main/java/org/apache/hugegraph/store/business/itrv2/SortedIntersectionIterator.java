@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.business.itrv2;
+
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.List;
+import java.util.NoSuchElementException;
+import java.util.function.Function;
+
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+
+/**
+ * Leapfrog intersection of sorted iterators: every iterator is advanced to the
+ * largest head until all the heads are equal. Only one element of each iterator
+ * is kept in memory, the output is sorted and distinct.
+ * With only one iterator, it just removes the adjacent duplicates.
+ * If a positioner is given, the position is the key of the last returned element,
+ * seek(position) skips the elements whose key is not greater than the position.
+ *
+ * @param <T> element type
+ */
+public class SortedIntersectionIterator<T> implements ScanIterator {
+
+    private final List<ScanIterator> iterators;
+
+    private final Comparator<T> comparator;
+
+    private final Function<T, byte[]> positioner;
+
+    private final Object[] heads;
+
+    private T current;
+
+    private T last;
+
+    private byte[] from;
+
+    private boolean finished = false;
+
+    public SortedIntersectionIterator(List<ScanIterator> iterators, Comparator<T> comparator) {
+        this(iterators, comparator, null);
+    }
+
+    /**
+     * @param positioner the key of an element, must be ordered as the comparator
+     */
+    public SortedIntersectionIterator(List<ScanIterator> iterators, Comparator<T> comparator,
+                                      Function<T, byte[]> positioner) {
+        assert iterators != null && !iterators.isEmpty();
+        this.iterators = iterators;
+        this.comparator = comparator;
+        this.positioner = positioner;
+        this.heads = new Object[iterators.size()];
+    }
+
+    @Override
+    public boolean hasNext() {
+        while (this.current == null && !this.finished) {
+            this.current = this.findNext();
+            this.finished = this.current == null;
+            if (this.current != null && this.from != null &&
+                Arrays.compareUnsigned(this.positioner.apply(this.current), this.from) <= 0) {
+                this.current = null;
+            }
+        }
+        return this.current != null;
+    }
+
+    @Override
+    public boolean isValid() {
+        return true;
+    }
+
+    @Override
+    public <E> E next() {
+        if (!this.hasNext()) {
+            throw new NoSuchElementException();
+        }
+        try {
+            return (E) this.current;
+        } finally {
+            this.last = this.current;
+            this.current = null;
+        }
+    }
+
+    @Override
+    public byte[] position() {
+        if (this.positioner == null || this.last == null) {
+            return new byte[0];
+        }
+        return this.positioner.apply(this.last);
+    }
+
+    @Override
+    public void seek(byte[] position) {
+        if (this.positioner == null || position == null || position.length == 0) {
+            return;
+        }
+        this.from = position;
+        if (this.current != null &&
+            Arrays.compareUnsigned(this.positioner.apply(this.current), position) <= 0) {
+            this.current = null;
+        }
+    }
+
+    /**
+     * Find the next element which exists in all the iterators
+     *
+     * @return the element, null if any iterator is exhausted
+     */
+    private T findNext() {
+        int size = this.heads.length;
+        for (int i = 0; i < size; i++) {
+            if (this.heads[i] == null && !this.advance(i)) {
+                return null;
+            }
+        }
+
+        while (true) {
+            T max = this.head(0);
+            for (int i = 1; i < size; i++) {
+                if (this.comparator.compare(this.head(i), max) > 0) {
+                    max = this.head(i);
+                }
+            }
+
+            boolean matched = true;
+            for (int i = 0; i < size; i++) {
+                int cmp;
+                while ((cmp = this.comparator.compare(this.head(i), max)) < 0) {
+                    if (!this.advance(i)) {
+                        return null;
+                    }
+                }
+                if (cmp > 0) {
+                    matched = false;
+                }
+            }
+
+            if (matched) {
+                T result = this.head(0);
+                // Skip the duplicates, the exhausted iterator is found by next findNext
+                for (int i = 0; i < size; i++) {
+                    while (this.heads[i] != null &&
+                           this.comparator.compare(this.head(i), result) == 0) {
+                        if (!this.advance(i)) {
+                            break;
+                        }
+                    }
+                }
+                return result;
+            }
+        }
+    }
+
+    private T head(int index) {
+        return (T) this.heads[index];
+    }
+
+    private boolean advance(int index) {
+        ScanIterator iterator = this.iterators.get(index);
+        while (iterator.hasNext()) {
+            Object next = iterator.next();
+            if (next != null) {
+                this.heads[index] = next;
+                return true;
+            }
+        }
+        this.heads[index] = null;
+        return false;
+    }
+
+    @Override
+    public void close() {
+        this.iterators.forEach(ScanIterator::close);
+    }
+}
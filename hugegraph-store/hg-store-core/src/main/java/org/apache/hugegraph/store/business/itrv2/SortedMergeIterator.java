@@ -0,0 +1,98 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.business.itrv2;
+
+import java.util.Comparator;
+import java.util.List;
+import java.util.NoSuchElementException;
+import java.util.PriorityQueue;
+
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+
+/**
+ * k-way merge of sorted iterators, the output is sorted and keeps the duplicates
+ *
+ * @param <T> element type
+ */
+public class SortedMergeIterator<T> implements ScanIterator {
+
+    private final List<ScanIterator> iterators;
+
+    private final Object[] heads;
+
+    /**
+     * index of the iterators ordered by their heads
+     */
+    private final PriorityQueue<Integer> queue;
+
+    private boolean initialized = false;
+
+    public SortedMergeIterator(List<ScanIterator> iterators, Comparator<T> comparator) {
+        this.iterators = iterators;
+        this.heads = new Object[iterators.size()];
+        this.queue = new PriorityQueue<>(Math.max(1, iterators.size()),
+                                         (i1, i2) -> comparator.compare((T) this.heads[i1],
+                                                                        (T) this.heads[i2]));
+    }
+
+    @Override
+    public boolean hasNext() {
+        if (!this.initialized) {
+            for (int i = 0; i < this.iterators.size(); i++) {
+                this.advance(i);
+            }
+            this.initialized = true;
+        }
+        return !this.queue.isEmpty();
+    }
+
+    @Override
+    public boolean isValid() {
+        return true;
+    }
+
+    @Override
+    public <E> E next() {
+        if (!this.hasNext()) {
+            throw new NoSuchElementException();
+        }
+        int index = this.queue.poll();
+        Object current = this.heads[index];
+        this.advance(index);
+        return (E) current;
+    }
+
+    private void advance(int index) {
+        ScanIterator iterator = this.iterators.get(index);
+        while (iterator.hasNext()) {
+            Object next = iterator.next();
+            if (next != null) {
+                this.heads[index] = next;
+                this.queue.add(index);
+                return;
+            }
+        }
+        this.heads[index] = null;
+    }
+
+    @Override
+    public void close() {
+        this.iterators.forEach(ScanIterator::close);
+        this.queue.clear();
+    }
+}
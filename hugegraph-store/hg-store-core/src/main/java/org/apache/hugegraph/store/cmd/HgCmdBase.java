@@ -36,6 +36,8 @@ public class HgCmdBase {
     public static final byte BLANK_TASK = 0x09;
 
     public static final byte REDIRECT_RAFT_TASK = 0x10;
+    public static final byte SST_FILE = 0x11;
+    public static final byte INGEST_SST = 0x12;
 
     @Data
     public abstract static class BaseRequest implements Serializable {
@@ -28,12 +28,16 @@ import org.apache.hugegraph.store.cmd.request.CleanDataRequest;
 import org.apache.hugegraph.store.cmd.request.CreateRaftRequest;
 import org.apache.hugegraph.store.cmd.request.DestroyRaftRequest;
 import org.apache.hugegraph.store.cmd.request.GetStoreInfoRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
 import org.apache.hugegraph.store.cmd.request.RedirectRaftTaskRequest;
+import org.apache.hugegraph.store.cmd.request.SstFileRequest;
 import org.apache.hugegraph.store.cmd.request.UpdatePartitionRequest;
 import org.apache.hugegraph.store.cmd.response.BatchPutResponse;
 import org.apache.hugegraph.store.cmd.response.CleanDataResponse;
 import org.apache.hugegraph.store.cmd.response.GetStoreInfoResponse;
+import org.apache.hugegraph.store.cmd.response.IngestSstResponse;
 import org.apache.hugegraph.store.cmd.response.RedirectRaftTaskResponse;
+import org.apache.hugegraph.store.cmd.response.SstFileResponse;
 import org.apache.hugegraph.store.cmd.response.UpdatePartitionResponse;
 import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.meta.Store;
@@ -56,6 +60,9 @@ import lombok.extern.slf4j.Slf4j;
 public class HgCmdClient {
 
     private static final int MAX_RETRY_TIMES = 5;
+    private static final long CALL_TIMEOUT = 5000;
+    // Ingesting may rewrite the sst files, the processor waits for raft up to 1 minute
+    private static final long INGEST_TIMEOUT = 2 * 60 * 1000;
     protected volatile RpcClient rpcClient;
     private RpcOptions rpcOptions;
     private PartitionAgent ptAgent;
@@ -153,6 +160,33 @@ public class HgCmdClient {
         return (RedirectRaftTaskResponse) tryInternalCallSyncWithRpc(request);
     }
 
+    /**
+     * Send a chunk of an sst file to the store at address, without going to the leader
+     *
+     * @param address raft address of the store
+     * @param request file chunk
+     * @return null if the call fails
+     */
+    public SstFileResponse sendSstFile(String address, SstFileRequest request) {
+        try {
+            return internalCallSyncWithRpc(JRaftUtils.getEndPoint(address), request);
+        } catch (Exception e) {
+            log.error("sendSstFile {} to {} error: {}", request.getFileName(), address,
+                      e.getMessage());
+            return null;
+        }
+    }
+
+    /**
+     * Through raft to ingest the sst files shipped to every replica of the partition
+     *
+     * @param request
+     * @return
+     */
+    public IngestSstResponse ingestSstFile(IngestSstRequest request) {
+        return (IngestSstResponse) tryInternalCallSyncWithRpc(request, INGEST_TIMEOUT);
+    }
+
     /**
      * Find Leader, retry on error, handle Leader redirection
      *
@@ -160,6 +194,11 @@ public class HgCmdClient {
      * @return
      */
     public HgCmdBase.BaseResponse tryInternalCallSyncWithRpc(HgCmdBase.BaseRequest request) {
+        return tryInternalCallSyncWithRpc(request, CALL_TIMEOUT);
+    }
+
+    private HgCmdBase.BaseResponse tryInternalCallSyncWithRpc(HgCmdBase.BaseRequest request,
+                                                              long timeout) {
         HgCmdBase.BaseResponse response = null;
 
         for (int i = 0; i < MAX_RETRY_TIMES; i++) {
@@ -173,7 +212,7 @@ public class HgCmdClient {
                     continue;
                 }
 
-                response = internalCallSyncWithRpc(leader, request);
+                response = internalCallSyncWithRpc(leader, request, timeout);
                 if (response != null) {
                     if (response.getStatus().isOK()) {
                         break;
@@ -202,10 +241,18 @@ public class HgCmdClient {
     private <V> V internalCallSyncWithRpc(final Endpoint endpoint,
                                           final HgCmdBase.BaseRequest request)
             throws ExecutionException, InterruptedException, TimeoutException {
+        return internalCallSyncWithRpc(endpoint, request, CALL_TIMEOUT);
+    }
+
+    private <V> V internalCallSyncWithRpc(final Endpoint endpoint,
+                                          final HgCmdBase.BaseRequest request,
+                                          final long timeout)
+            throws ExecutionException, InterruptedException, TimeoutException {
         FutureClosureAdapter<V> response = new FutureClosureAdapter<>();
-        internalCallAsyncWithRpc(endpoint, request, response);
+        internalCallAsyncWithRpc(endpoint, request, response,
+                                 Math.max(timeout, this.rpcOptions.getRpcDefaultTimeout()));
         try {
-            return response.future.get(5000, TimeUnit.MILLISECONDS);
+            return response.future.get(timeout, TimeUnit.MILLISECONDS);
         } catch (Exception e) {
             throw e;
         }
@@ -222,35 +269,37 @@ public class HgCmdClient {
                 done.run(status);
             }
         };
-        tryWithTimes(endpoint, request, response, invokeCtx, retryCount);
+        tryWithTimes(endpoint, request, response, invokeCtx, retryCount,
+                     this.rpcOptions.getRpcDefaultTimeout());
         return response.future;
     }
 
     private <V> void internalCallAsyncWithRpc(final Endpoint endpoint,
                                               final HgCmdBase.BaseRequest request,
-                                              final FutureClosureAdapter<V> closure) {
+                                              final FutureClosureAdapter<V> closure,
+                                              final long timeout) {
         final InvokeContext invokeCtx = null;
         int[] retryCount = new int[]{0};
-        tryWithTimes(endpoint, request, closure, invokeCtx, retryCount);
+        tryWithTimes(endpoint, request, closure, invokeCtx, retryCount, timeout);
     }
 
     private <V> void tryWithTimes(Endpoint endpoint, HgCmdBase.BaseRequest request,
                                   FutureClosureAdapter<V> closure,
                                   InvokeContext invokeCtx,
-                                  int[] retryCount) {
+                                  int[] retryCount, long timeout) {
         InvokeCallback invokeCallback = (result, err) -> {
             if (err == null) {
                 final HgCmdBase.BaseResponse response = (HgCmdBase.BaseResponse) result;
                 closure.setResponse((V) response);
             } else {
-                tryWithThrowable(endpoint, request, closure, invokeCtx, retryCount, err);
+                tryWithThrowable(endpoint, request, closure, invokeCtx, retryCount, timeout,
+                                 err);
             }
         };
         try {
-            this.rpcClient.invokeAsync(endpoint, request, invokeCtx, invokeCallback,
-                                       this.rpcOptions.getRpcDefaultTimeout());
+            this.rpcClient.invokeAsync(endpoint, request, invokeCtx, invokeCallback, timeout);
         } catch (final Throwable err) {
-            tryWithThrowable(endpoint, request, closure, invokeCtx, retryCount, err);
+            tryWithThrowable(endpoint, request, closure, invokeCtx, retryCount, timeout, err);
         }
     }
 
@@ -258,7 +307,7 @@ public class HgCmdClient {
                                       HgCmdBase.BaseRequest request,
                                       FutureClosureAdapter<V> closure,
                                       InvokeContext invokeCtx,
-                                      int[] retryCount, Throwable err) {
+                                      int[] retryCount, long timeout, Throwable err) {
         if (retryCount[0] >= MAX_RETRY_TIMES) {
             closure.failure(err);
             closure.run(new Status(-1, err.getMessage()));
@@ -269,7 +318,7 @@ public class HgCmdClient {
             } catch (InterruptedException e) {
                 closure.run(new Status(-1, e.getMessage()));
             }
-            tryWithTimes(endpoint, request, closure, invokeCtx, retryCount);
+            tryWithTimes(endpoint, request, closure, invokeCtx, retryCount, timeout);
         }
     }
 
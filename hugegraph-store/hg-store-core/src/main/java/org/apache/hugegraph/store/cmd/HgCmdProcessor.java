@@ -29,7 +29,9 @@ import org.apache.hugegraph.store.cmd.request.CleanDataRequest;
 import org.apache.hugegraph.store.cmd.request.CreateRaftRequest;
 import org.apache.hugegraph.store.cmd.request.DestroyRaftRequest;
 import org.apache.hugegraph.store.cmd.request.GetStoreInfoRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
 import org.apache.hugegraph.store.cmd.request.RedirectRaftTaskRequest;
+import org.apache.hugegraph.store.cmd.request.SstFileRequest;
 import org.apache.hugegraph.store.cmd.request.UpdatePartitionRequest;
 import org.apache.hugegraph.store.cmd.response.BatchPutResponse;
 import org.apache.hugegraph.store.cmd.response.CleanDataResponse;
@@ -37,7 +39,9 @@ import org.apache.hugegraph.store.cmd.response.CreateRaftResponse;
 import org.apache.hugegraph.store.cmd.response.DefaultResponse;
 import org.apache.hugegraph.store.cmd.response.DestroyRaftResponse;
 import org.apache.hugegraph.store.cmd.response.GetStoreInfoResponse;
+import org.apache.hugegraph.store.cmd.response.IngestSstResponse;
 import org.apache.hugegraph.store.cmd.response.RedirectRaftTaskResponse;
+import org.apache.hugegraph.store.cmd.response.SstFileResponse;
 import org.apache.hugegraph.store.cmd.response.UpdatePartitionResponse;
 import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.raft.RaftClosure;
@@ -76,6 +80,8 @@ public class HgCmdProcessor<T extends HgCmdBase.BaseRequest> implements RpcProce
         rpcServer.registerProcessor(new HgCmdProcessor<>(DestroyRaftRequest.class, engine));
         rpcServer.registerProcessor(new HgCmdProcessor<>(BlankTaskRequest.class, engine));
         rpcServer.registerProcessor(new HgCmdProcessor<>(ProcessBuilder.Redirect.class, engine));
+        rpcServer.registerProcessor(new HgCmdProcessor<>(SstFileRequest.class, engine));
+        rpcServer.registerProcessor(new HgCmdProcessor<>(IngestSstRequest.class, engine));
     }
 
     @Override
@@ -124,6 +130,16 @@ public class HgCmdProcessor<T extends HgCmdBase.BaseRequest> implements RpcProce
                                        (RedirectRaftTaskResponse) response);
                 break;
             }
+            case HgCmdBase.SST_FILE: {
+                response = new SstFileResponse();
+                handleSstFile((SstFileRequest) request, (SstFileResponse) response);
+                break;
+            }
+            case HgCmdBase.INGEST_SST: {
+                response = new IngestSstResponse();
+                handleIngestSst((IngestSstRequest) request, (IngestSstResponse) response);
+                break;
+            }
             default: {
                 log.warn("HgCmdProcessor magic {} is not recognized ", request.magic());
             }
@@ -154,6 +170,21 @@ public class HgCmdProcessor<T extends HgCmdBase.BaseRequest> implements RpcProce
         raftSyncTask(request, response, RaftOperation.IN_CLEAN_OP);
     }
 
+    public void handleSstFile(SstFileRequest request, SstFileResponse response) {
+        var status = engine.getDataManager().receive(request);
+        if (status.isOk()) {
+            response.setStatus(Status.OK);
+        } else {
+            response.setStatus(Status.IO_ERROR.setMsg(status.getErrorMsg()));
+        }
+    }
+
+    public void handleIngestSst(IngestSstRequest request, IngestSstResponse response) {
+        log.info("IngestSst rpc call received, {}-{}, {}", request.getGraphName(),
+                 request.getPartitionId(), request.getTransferId());
+        raftSyncTask(request, response, RaftOperation.IN_INGEST_OP);
+    }
+
     public void handleCreateRaft(CreateRaftRequest request, CreateRaftResponse response) {
         log.info("CreateRaftNode rpc call received, {}, {}", request.getPartitions(),
                  request.getConf());
@@ -221,6 +252,10 @@ public class HgCmdProcessor<T extends HgCmdBase.BaseRequest> implements RpcProce
                            RaftOperation.create(op, raftReq), new RaftClosure() {
                     @Override
                     public void run(com.alipay.sofa.jraft.Status status) {
+                        if (latch.getCount() == 0) {
+                            // The task reported its error before the state machine ran it OK
+                            return;
+                        }
                         Status responseStatus = Status.UNKNOWN;
                         switch (HgRaftError.forNumber(status.getCode())) {
                             case OK:
@@ -40,7 +40,12 @@ public class BatchPutRequest extends HgCmdBase.BaseRequest {
         private String table;
         private int code;
         private byte[] key;
+        // The key is deleted if value is null
         private byte[] value;
+        // Delete the range from key to endKey if it is set
+        private byte[] endKey;
+        // Delete the keys starting with key
+        private boolean prefix;
 
         public static KV of(String table, int code, byte[] key, byte[] value) {
             KV kv = new KV();
@@ -50,5 +55,21 @@ public class BatchPutRequest extends HgCmdBase.BaseRequest {
             kv.value = value;
             return kv;
         }
+
+        public static KV ofDelete(String table, int code, byte[] key) {
+            return of(table, code, key, null);
+        }
+
+        public static KV ofDeleteRange(String table, int code, byte[] start, byte[] end) {
+            KV kv = of(table, code, start, null);
+            kv.endKey = end;
+            return kv;
+        }
+
+        public static KV ofDeletePrefix(String table, int code, byte[] prefix) {
+            KV kv = of(table, code, prefix, null);
+            kv.prefix = true;
+            return kv;
+        }
     }
 }
@@ -0,0 +1,42 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.cmd.request;
+
+import java.util.List;
+import java.util.Map;
+
+import org.apache.hugegraph.store.cmd.HgCmdBase;
+
+import lombok.Data;
+
+/**
+ * Ingest the sst files of a partition migration, which were shipped to every replica of the
+ * partition before, through raft
+ */
+@Data
+public class IngestSstRequest extends HgCmdBase.BaseRequest {
+
+    private String transferId;
+    // table name -> sst file names
+    private Map<String, List<String>> files;
+
+    @Override
+    public byte magic() {
+        return HgCmdBase.INGEST_SST;
+    }
+}
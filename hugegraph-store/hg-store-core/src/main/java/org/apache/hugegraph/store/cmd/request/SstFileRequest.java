@@ -0,0 +1,43 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.cmd.request;
+
+import org.apache.hugegraph.store.cmd.HgCmdBase;
+
+import lombok.Data;
+
+/**
+ * A chunk of an sst file shipped by a partition migration, the checksum is the crc32 of the
+ * whole file and is verified when the last chunk arrives
+ */
+@Data
+public class SstFileRequest extends HgCmdBase.BaseRequest {
+
+    private String transferId;
+    private String table;
+    private String fileName;
+    private long offset;
+    private byte[] data;
+    private boolean last;
+    private long checksum;
+
+    @Override
+    public byte magic() {
+        return HgCmdBase.SST_FILE;
+    }
+}
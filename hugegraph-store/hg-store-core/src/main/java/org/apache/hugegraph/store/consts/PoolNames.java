@@ -31,5 +31,7 @@ public class PoolNames {
     public static final String COMPACT = "hg-compact";
     public static final String HEARTBEAT = "hg-heartbeat";
     public static final String P_HEARTBEAT = "hg-p-heartbeat";
+    public static final String SNAPSHOT = "hg-snapshot";
+    public static final String HANDOFF = "hg-handoff";
 
 }
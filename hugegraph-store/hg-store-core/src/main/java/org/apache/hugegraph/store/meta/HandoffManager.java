@@ -0,0 +1,160 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.meta;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.store.meta.base.DBSessionBuilder;
+import org.apache.hugegraph.store.meta.base.PartitionMetaStore;
+
+import com.google.protobuf.Int64Value;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Keeps the state of the data handoffs of a partition in its meta, so that it goes with the
+ * raft snapshots of the partition: the write fences of the ranges a source handed off, and
+ * for a target, which handoffs and migrated sst files it ingested and whether a graph took
+ * writes.
+ */
+@Slf4j
+public class HandoffManager extends PartitionMetaStore {
+
+    // graphs known to have taken writes, saves a meta read per write batch
+    private final Set<String> writtenGraphs = ConcurrentHashMap.newKeySet();
+    private final int partitionId;
+
+    public HandoffManager(DBSessionBuilder sessionBuilder, int partId) {
+        super(sessionBuilder, partId);
+        this.partitionId = partId;
+    }
+
+    /**
+     * Replace the write fences of graph
+     */
+    public void putWriteFences(String graph, List<Metapb.Partition> fences) {
+        deletePrefix(MetadataKeyHelper.getWriteFencePrefix(graph));
+        for (Metapb.Partition fence : fences) {
+            put(MetadataKeyHelper.getWriteFenceKey(graph, fence.getId()), fence);
+        }
+    }
+
+    public void deleteWriteFences(String graph) {
+        deletePrefix(MetadataKeyHelper.getWriteFencePrefix(graph));
+    }
+
+    /**
+     * @return graph -> write fences
+     */
+    public Map<String, List<Metapb.Partition>> loadWriteFences() {
+        Map<String, List<Metapb.Partition>> fences = new ConcurrentHashMap<>();
+        for (Metapb.Partition fence : scan(Metapb.Partition.parser(),
+                                           MetadataKeyHelper.getWriteFencePrefix())) {
+            fences.computeIfAbsent(fence.getGraphName(), k -> new ArrayList<>()).add(fence);
+        }
+        fences.replaceAll((graph, list) -> List.copyOf(list));
+        return fences;
+    }
+
+    /**
+     * Whether the handoff of graph from sourceId was ingested into this partition
+     */
+    public boolean isHandedOff(String graph, int sourceId) {
+        return get(MetadataKeyHelper.getHandoffKey(graph, sourceId)) != null;
+    }
+
+    /**
+     * Run the ingestion of the handoff of graph from sourceId into this partition once, writes
+     * of the graph wait for it. It is skipped if it was ingested before, and refused once the
+     * graph took writes, since the ingested data would overwrite them.
+     *
+     * @return false if refused
+     */
+    public synchronized boolean ingestOnce(String graph, int sourceId, long taskId,
+                                           Runnable ingest) {
+        if (isHandedOff(graph, sourceId)) {
+            log.info("Partition {}, handoff of {}-{} was ingested already", partitionId,
+                     graph, sourceId);
+            return true;
+        }
+        if (isWritten(graph)) {
+            log.warn("Partition {}, {} took writes before the handoff from {}", partitionId,
+                     graph, sourceId);
+            return false;
+        }
+        ingest.run();
+        put(MetadataKeyHelper.getHandoffKey(graph, sourceId), Int64Value.of(taskId));
+        return true;
+    }
+
+    /**
+     * Whether the sst files of the migration transferId were ingested into this partition
+     */
+    public boolean isIngested(String graph, String transferId) {
+        return get(MetadataKeyHelper.getIngestedKey(graph, transferId)) != null;
+    }
+
+    /**
+     * Run the ingestion of the sst files of the migration transferId once, a replay of the
+     * entry is skipped
+     */
+    public synchronized void ingestTransferOnce(String graph, String transferId,
+                                                Runnable ingest) {
+        if (isIngested(graph, transferId)) {
+            log.info("Partition {}, sst files of {} were ingested already", partitionId,
+                     transferId);
+            return;
+        }
+        ingest.run();
+        put(MetadataKeyHelper.getIngestedKey(graph, transferId),
+            Int64Value.of(System.currentTimeMillis()));
+    }
+
+    /**
+     * Record that graph takes writes in this partition, called before a write is applied
+     */
+    public void markWritten(String graph) {
+        if (writtenGraphs.contains(graph)) {
+            return;
+        }
+        synchronized (this) {
+            if (!isWritten(graph)) {
+                put(MetadataKeyHelper.getGraphWrittenKey(graph),
+                    Int64Value.of(System.currentTimeMillis()));
+            }
+            writtenGraphs.add(graph);
+        }
+    }
+
+    private boolean isWritten(String graph) {
+        return writtenGraphs.contains(graph) ||
+               get(MetadataKeyHelper.getGraphWrittenKey(graph)) != null;
+    }
+
+    /**
+     * Drop the cached state, the meta was replaced by a snapshot
+     */
+    public void reload() {
+        writtenGraphs.clear();
+    }
+}
@@ -38,6 +38,10 @@ public class MetadataKeyHelper {
     private static final String CID_PREFIX = "CID";
     private static final String CID_SLOT_PREFIX = "CID_SLOT";
     private static final String GRAPH_ID_PREFIX = "GRAPH_ID";
+    private static final String WRITE_FENCE = "WRITE_FENCE";
+    private static final String HANDOFF = "HANDOFF";
+    private static final String GRAPH_WRITTEN = "GRAPH_WRITTEN";
+    private static final String INGESTED = "INGESTED";
 
     public static byte[] getPartitionKey(String graph, Integer partId) {
         // HUGEGRAPH/Partition/{graph}/partId
@@ -283,6 +287,68 @@ public class MetadataKeyHelper {
         return key.getBytes(StandardCharsets.UTF_8);
     }
 
+    public static byte[] getWriteFenceKey(String graph, int partId) {
+        // HUGEGRAPH/WRITE_FENCE/{graph}/{partId}
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(WRITE_FENCE).append(DELIMITER)
+                                        .append(graph).append(DELIMITER)
+                                        .append(partId)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
+    public static byte[] getWriteFencePrefix(String graph) {
+        // HUGEGRAPH/WRITE_FENCE/{graph}/
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(WRITE_FENCE).append(DELIMITER)
+                                        .append(graph).append(DELIMITER)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
+    public static byte[] getWriteFencePrefix() {
+        // HUGEGRAPH/WRITE_FENCE/
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(WRITE_FENCE).append(DELIMITER)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
+    public static byte[] getHandoffKey(String graph, int sourceId) {
+        // HUGEGRAPH/HANDOFF/{graph}/{sourceId}
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(HANDOFF).append(DELIMITER)
+                                        .append(graph).append(DELIMITER)
+                                        .append(sourceId)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
+    public static byte[] getGraphWrittenKey(String graph) {
+        // HUGEGRAPH/GRAPH_WRITTEN/{graph}
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(GRAPH_WRITTEN).append(DELIMITER)
+                                        .append(graph)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
+    public static byte[] getIngestedKey(String graph, String transferId) {
+        // HUGEGRAPH/INGESTED/{graph}/{transferId}
+        String key = StringBuilderHelper.get()
+                                        .append(HUGEGRAPH).append(DELIMITER)
+                                        .append(INGESTED).append(DELIMITER)
+                                        .append(graph).append(DELIMITER)
+                                        .append(transferId)
+                                        .toString();
+        return key.getBytes(StandardCharsets.UTF_8);
+    }
+
     static class StringBuilderHelper {
 
         private static final int DISCARD_LIMIT = 1024 << 3;     // 8k
@@ -50,6 +50,7 @@ import org.apache.hugegraph.store.util.PartitionMetaStoreWrapper;
 import org.apache.hugegraph.util.Log;
 import org.slf4j.Logger;
 
+import com.alipay.sofa.jraft.conf.Configuration;
 import com.alipay.sofa.jraft.core.ElectionPriority;
 
 import lombok.extern.slf4j.Slf4j;
@@ -430,9 +431,10 @@ public class PartitionManager extends GlobalMetaStore {
         writeLock.lock();
         try {
             Partition partition = findPartition(req.getGraphName(), req.getPartitionId());
+            // A split keeps one bound of the source, so either bound may change
             if (req.getStartKey() >= 0 && req.getEndKey() > 0
-                && partition.getStartKey() != req.getStartKey() &&
-                partition.getEndKey() != req.getEndKey()) {
+                && (partition.getStartKey() != req.getStartKey() ||
+                    partition.getEndKey() != req.getEndKey())) {
                 changeKeyRange(partition, req.getStartKey(), req.getEndKey());
             }
             if (req.getWorkState() != null) {
@@ -774,6 +776,30 @@ public class PartitionManager extends GlobalMetaStore {
         return ids;
     }
 
+    /**
+     * Partitions of graph scanned here by the scans that read learners: the partitions whose
+     * scan store is this store. Both the learner and the leader are taken from the roles of
+     * the shard group, so that every store decides from the same source and no partition is
+     * scanned twice or missed.
+     */
+    public List<Integer> getLearnerScanPartitionIds(String graph) {
+        long storeId = getStore().getId();
+        List<Integer> ids = new ArrayList<>();
+        if (partitions.containsKey(graph)) {
+            partitions.get(graph).forEach((k, v) -> {
+                ShardGroup shardGroup = getShardGroup(k);
+                if (!useRaft || shardGroup == null) {
+                    if (!useRaft || v.isLeader()) {
+                        ids.add(k);
+                    }
+                } else if (shardGroup.getScanStore() == storeId) {
+                    ids.add(k);
+                }
+            });
+        }
+        return ids;
+    }
+
     /**
      * Generate partition peer string, containing priority information *
      *
@@ -788,6 +814,11 @@ public class PartitionManager extends GlobalMetaStore {
             for (Shard shard : shardGroup.getShards()) {
                 Store store = getStore(shard.getStoreId());
                 if (store != null && !store.getRaftAddress().isEmpty()) {
+                    if (shard.getRole() == Metapb.ShardRole.Learner) {
+                        // Learners never vote nor elect
+                        peers.add(store.getRaftAddress() + Configuration.LEARNER_POSTFIX);
+                        continue;
+                    }
                     peers.add(store.getRaftAddress() + "::" + priority);
                     final int gap = Math.max(decayPriorityGap, (priority / 5));
                     priority = Math.max(ElectionPriority.MinValue, (priority - gap));
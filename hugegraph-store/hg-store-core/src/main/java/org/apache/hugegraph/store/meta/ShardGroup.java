@@ -93,6 +93,32 @@ public class ShardGroup {
         return this;
     }
 
+    /**
+     * Store of the learner serving the scans that read learners, the learner with the least
+     * store id, 0 if the group has no learner
+     */
+    public long getScanLearner() {
+        return shards.stream()
+                     .filter(shard -> shard.getRole() == Metapb.ShardRole.Learner)
+                     .mapToLong(Shard::getStoreId)
+                     .min().orElse(0L);
+    }
+
+    /**
+     * Store serving the scans that read learners: the scan learner, or the leader if the
+     * group has no learner, 0 if neither is known
+     */
+    public long getScanStore() {
+        long learner = getScanLearner();
+        if (learner != 0L) {
+            return learner;
+        }
+        return shards.stream()
+                     .filter(shard -> shard.getRole() == Metapb.ShardRole.Leader)
+                     .mapToLong(Shard::getStoreId)
+                     .findFirst().orElse(0L);
+    }
+
     public synchronized List<Metapb.Shard> getMetaPbShard() {
         List<Metapb.Shard> shardList = new ArrayList<>();
         shards.forEach(shard -> {
@@ -18,6 +18,7 @@
 package org.apache.hugegraph.store.metric;
 
 import java.util.List;
+import java.util.Map;
 
 import lombok.Data;
 
@@ -44,4 +45,16 @@ public class HgStoreMetric {
         private long approxDataSize;
         private long approxKeyCount;
     }
+
+    @Data
+    public static class Memory {
+
+        private long blockCacheCapacity;
+        private long blockCacheUsage;
+        private long blockCachePinnedUsage;
+        private long writeBufferCapacity;
+        private long writeBufferUsage;
+        private long dbMemoryQuota;
+        private Map<String, Long> dbMemTableUsage;
+    }
 }
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.metric;
+
+import java.lang.management.ManagementFactory;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.rocksdb.access.RocksDBFactory;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.store.business.BusinessHandlerImpl;
+import org.rocksdb.Statistics;
+import org.rocksdb.TickerType;
+
+import com.sun.management.OperatingSystemMXBean;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Read/write load of each partition, computed from the tickers of the partition db between
+ * two heartbeats. The cpu of the process is shared out by the operations of each partition.
+ */
+@Slf4j
+public class PartitionLoadCollector {
+
+    private static final int READS = 0;
+    private static final int WRITES = 1;
+    private static final int READ_BYTES = 2;
+    private static final int WRITE_BYTES = 3;
+    private static final int TIME = 4;
+
+    private final Map<Integer, long[]> lastSamples = new ConcurrentHashMap<>();
+
+    public Map<Integer, Metapb.PartitionLoad> collect(List<Integer> partitionIds) {
+        Map<Integer, long[]> deltas = new HashMap<>();
+        long totalOps = 0;
+        for (Integer partId : partitionIds) {
+            long[] current = sample(partId);
+            if (current == null) {
+                continue;
+            }
+            long[] last = this.lastSamples.put(partId, current);
+            if (last == null || current[TIME] <= last[TIME]) {
+                continue;
+            }
+            long[] delta = new long[current.length];
+            for (int i = 0; i < current.length; i++) {
+                // Tickers restart from 0 when the db is reopened
+                delta[i] = Math.max(0L, current[i] - last[i]);
+            }
+            deltas.put(partId, delta);
+            totalOps += delta[READS] + delta[WRITES];
+        }
+        this.lastSamples.keySet().retainAll(partitionIds);
+
+        OperatingSystemMXBean osBean =
+                (OperatingSystemMXBean) ManagementFactory.getOperatingSystemMXBean();
+        double processCpu = Math.max(0.0, osBean.getProcessCpuLoad()) * 100;
+
+        Map<Integer, Metapb.PartitionLoad> loads = new HashMap<>();
+        for (Map.Entry<Integer, long[]> entry : deltas.entrySet()) {
+            long[] delta = entry.getValue();
+            double seconds = delta[TIME] / 1000.0;
+            long ops = delta[READS] + delta[WRITES];
+            Metapb.PartitionLoad.Builder load = Metapb.PartitionLoad.newBuilder();
+            load.setReadQps((long) (delta[READS] / seconds));
+            load.setWriteQps((long) (delta[WRITES] / seconds));
+            load.setReadBytes((long) (delta[READ_BYTES] / seconds));
+            load.setWriteBytes((long) (delta[WRITE_BYTES] / seconds));
+            load.setCpuUsage(totalOps == 0 ? 0.0 : processCpu * ops / totalOps);
+            loads.put(entry.getKey(), load.build());
+        }
+        return loads;
+    }
+
+    private long[] sample(int partId) {
+        String dbName = BusinessHandlerImpl.getDbName(partId);
+        try (RocksDBSession session = RocksDBFactory.getInstance().queryGraphDB(dbName)) {
+            if (session == null) {
+                return null;
+            }
+            Statistics stats = session.getRocksDbStats();
+            long[] sample = new long[TIME + 1];
+            sample[READS] = stats.getTickerCount(TickerType.NUMBER_KEYS_READ) +
+                            stats.getTickerCount(TickerType.NUMBER_DB_SEEK);
+            sample[WRITES] = stats.getTickerCount(TickerType.NUMBER_KEYS_WRITTEN);
+            sample[READ_BYTES] = stats.getTickerCount(TickerType.BYTES_READ) +
+                                 stats.getTickerCount(TickerType.ITER_BYTES_READ);
+            sample[WRITE_BYTES] = stats.getTickerCount(TickerType.BYTES_WRITTEN);
+            sample[TIME] = System.currentTimeMillis();
+            return sample;
+        } catch (Exception e) {
+            log.warn("sample load of partition {} failed, {}", partId, e.getMessage());
+            return null;
+        }
+    }
+}
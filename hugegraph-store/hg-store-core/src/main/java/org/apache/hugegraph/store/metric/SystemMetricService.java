@@ -159,6 +159,16 @@ public class SystemMetricService {
         map.put("rocksdb.cache.total", dbMem.get(MemoryUsageType.kCacheTotal));
         map.put("rocksdb.mem.table.un_flushed", dbMem.get(MemoryUsageType.kMemTableUnFlushed));
 
+        HgStoreMetric.Memory memory = storeEngine.getBusinessHandler().getMemoryMetric();
+        map.put("rocksdb.block_cache.capacity", memory.getBlockCacheCapacity());
+        map.put("rocksdb.block_cache.usage", memory.getBlockCacheUsage());
+        map.put("rocksdb.block_cache.pinned_usage", memory.getBlockCachePinnedUsage());
+        map.put("rocksdb.write_buffer.capacity", memory.getWriteBufferCapacity());
+        map.put("rocksdb.write_buffer.usage", memory.getWriteBufferUsage());
+        memory.getDbMemTableUsage().forEach((name, usage) -> {
+            map.put("rocksdb.graph." + name + ".mem_table_usage", usage);
+        });
+
         RocksDBFactory dbFactory = RocksDBFactory.getInstance();
         Set<String> names = dbFactory.getGraphNames();
         if (names != null) {
@@ -113,6 +113,11 @@ public class HgStoreEngineOptions {
         private final int keepInMemorySegmentCount = 2;
         private final int preAllocateSegmentCount = 1;
         private final int splitPartitionLogIndexMargin = 10;
+        /**
+         * A learner not applying the commit index of the leader within the milliseconds
+         * refuses the scans
+         */
+        private final int learnerScanWaitMs = 1000;
         /**
          * RPC request default timeout in milliseconds
          */
@@ -123,7 +128,11 @@ public class HgStoreEngineOptions {
         //
         // Default: 3600 (1 hour)
         private int snapshotIntervalSecs = 3600;
+        // Files of a snapshot downloaded at the same time, the threads are shared by all
+        // partitions of the store
         private int snapshotDownloadingThreads = 4;
+        // Bandwidth limit of downloading snapshots for the store, 0 means no limit
+        private long snapshotDownloadingBytesPerSec = 0;
         // A snapshot saving would be triggered every |snapshot_interval_s| seconds,
         // and at this moment when state machine's lastAppliedIndex value
         // minus lastSnapshotId value is greater than snapshotLogIndexMargin value,
@@ -152,6 +161,12 @@ public class HgStoreEngineOptions {
         private double aveLogEntrySizeRatio = 0.95;
         private boolean useRocksDBSegmentLogStorage = true;
         private int maxSegmentFileSize = 64 * 1024 * 1024;
+        /**
+         * Merge the data writes submitted concurrently into one log entry and apply them in one
+         * write batch. Stores of older versions can not apply merged entries, so enable it only
+         * after every store of the cluster is upgraded
+         */
+        private boolean batchApply = false;
     }
 
     @Data
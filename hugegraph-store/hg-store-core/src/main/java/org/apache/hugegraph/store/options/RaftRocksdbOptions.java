@@ -17,6 +17,7 @@
 
 package org.apache.hugegraph.store.options;
 
+import java.util.HashMap;
 import java.util.Map;
 
 import org.apache.hugegraph.config.HugeConfig;
@@ -100,6 +101,7 @@ public class RaftRocksdbOptions {
         config.put(RocksDBOptions.ENV, rocksdbConfig.getEnv());
         config.put(RocksDBOptions.WRITE_BUFFER_MANAGER, rocksdbConfig.getBufferManager());
         config.put(RocksDBOptions.BLOCK_TABLE_CONFIG, rocksdbConfig.getTableConfig());
+        config.put(RocksDBOptions.TABLE_CONFIGS, rocksdbConfig.getTableConfigs());
         config.put(RocksDBOptions.BLOCK_CACHE, rocksdbConfig.getBlockCache());
         config.put(RocksDBOptions.WRITE_CACHE, rocksdbConfig.getWriteCache());
     }
@@ -135,6 +137,7 @@ public class RaftRocksdbOptions {
         private final LRUCache writeCache;
         private final WriteBufferManager bufferManager;
         private final BlockBasedTableConfig tableConfig;
+        private final Map<String, BlockBasedTableConfig> tableConfigs;
         private final long blockCacheCapacity;
         private final long writeCacheCapacity;
 
@@ -144,38 +147,52 @@ public class RaftRocksdbOptions {
             double writeBufferRatio = options.get(RocksDBOptions.WRITE_BUFFER_RATIO);
             this.writeCacheCapacity =
                     (long) (options.get(RocksDBOptions.TOTAL_MEMORY_SIZE) * writeBufferRatio);
-            this.blockCacheCapacity =
-                    options.get(RocksDBOptions.TOTAL_MEMORY_SIZE) - writeCacheCapacity;
-            this.writeCache = new LRUCache(writeCacheCapacity);
-            this.blockCache = new LRUCache(blockCacheCapacity);
+            if (options.get(RocksDBOptions.WRITE_BUFFER_COST_TO_BLOCK_CACHE)) {
+                // One budget for the node: memtables reserve their memory in the block cache
+                this.blockCacheCapacity = options.get(RocksDBOptions.TOTAL_MEMORY_SIZE);
+                this.blockCache = new LRUCache(blockCacheCapacity);
+                this.writeCache = this.blockCache;
+            } else {
+                this.blockCacheCapacity =
+                        options.get(RocksDBOptions.TOTAL_MEMORY_SIZE) - writeCacheCapacity;
+                this.writeCache = new LRUCache(writeCacheCapacity);
+                this.blockCache = new LRUCache(blockCacheCapacity);
+            }
             this.bufferManager = new WriteBufferManager(writeCacheCapacity, writeCache,
                                                         options.get(
                                                                 RocksDBOptions.WRITE_BUFFER_ALLOW_STALL));
-            this.tableConfig = new BlockBasedTableConfig() //
-                                                           .setIndexType(
-                                                                   IndexType.kTwoLevelIndexSearch) //
-                                                           .setPartitionFilters(true) //
-                                                           .setMetadataBlockSize(8 * SizeUnit.KB) //
-                                                           .setCacheIndexAndFilterBlocks(
-                                                                   options.get(
-                                                                           RocksDBOptions.PUT_FILTER_AND_INDEX_IN_CACHE)) //
-                                                           .setCacheIndexAndFilterBlocksWithHighPriority(
-                                                                   true) //
-                                                           .setPinL0FilterAndIndexBlocksInCache(
-                                                                   options.get(
-                                                                           RocksDBOptions.PIN_L0_FILTER_AND_INDEX_IN_CACHE)) //
-                                                           .setBlockSize(4 * SizeUnit.KB)//
-                                                           .setBlockCache(blockCache);
-
-            int bitsPerKey = options.get(RocksDBOptions.BLOOM_FILTER_BITS_PER_KEY);
+            this.tableConfig = newTableConfig(options,
+                                              options.get(
+                                                      RocksDBOptions.BLOOM_FILTER_BITS_PER_KEY));
+            // Tables with their own bloom filter, like g+v for the point reads of vertices
+            this.tableConfigs = new HashMap<>();
+            RocksDBOptions.tableValues(options.get(RocksDBOptions.BLOOM_FILTER_TABLES))
+                          .forEach((table, bits) -> this.tableConfigs.put(
+                                  table, newTableConfig(options, bits)));
+            log.info("RocksdbConfig {}, tables {}",
+                     options.get(RocksDBOptions.BLOOM_FILTER_BITS_PER_KEY),
+                     options.get(RocksDBOptions.BLOOM_FILTER_TABLES));
+        }
+
+        private BlockBasedTableConfig newTableConfig(HugeConfig options, int bitsPerKey) {
+            BlockBasedTableConfig config = new BlockBasedTableConfig()
+                    .setIndexType(IndexType.kTwoLevelIndexSearch)
+                    .setPartitionFilters(true)
+                    .setMetadataBlockSize(8 * SizeUnit.KB)
+                    .setCacheIndexAndFilterBlocks(
+                            options.get(RocksDBOptions.PUT_FILTER_AND_INDEX_IN_CACHE))
+                    .setCacheIndexAndFilterBlocksWithHighPriority(true)
+                    .setPinL0FilterAndIndexBlocksInCache(
+                            options.get(RocksDBOptions.PIN_L0_FILTER_AND_INDEX_IN_CACHE))
+                    .setBlockSize(4 * SizeUnit.KB)
+                    .setBlockCache(blockCache);
             if (bitsPerKey >= 0) {
-                tableConfig.setFilterPolicy(new BloomFilter(bitsPerKey,
-                                                            options.get(
-                                                                    RocksDBOptions.BLOOM_FILTER_MODE)));
+                config.setFilterPolicy(new BloomFilter(bitsPerKey,
+                                                       options.get(
+                                                               RocksDBOptions.BLOOM_FILTER_MODE)));
             }
-            tableConfig.setWholeKeyFiltering(
-                    options.get(RocksDBOptions.BLOOM_FILTER_WHOLE_KEY));
-            log.info("RocksdbConfig {}", options.get(RocksDBOptions.BLOOM_FILTER_BITS_PER_KEY));
+            config.setWholeKeyFiltering(options.get(RocksDBOptions.BLOOM_FILTER_WHOLE_KEY));
+            return config;
         }
 
         public Env getEnv() {
@@ -198,6 +215,10 @@ public class RaftRocksdbOptions {
             return tableConfig;
         }
 
+        public Map<String, BlockBasedTableConfig> getTableConfigs() {
+            return tableConfigs;
+        }
+
         public long getBlockCacheCapacity() {
             return blockCacheCapacity;
         }
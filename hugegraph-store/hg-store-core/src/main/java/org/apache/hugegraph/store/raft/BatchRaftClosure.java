@@ -0,0 +1,53 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.raft;
+
+import java.util.List;
+import java.util.stream.Collectors;
+
+import com.alipay.sofa.jraft.Status;
+
+/**
+ * Closure of a log entry merged from the concurrent data writes of a partition
+ */
+public class BatchRaftClosure extends DefaultRaftClosure {
+
+    private final List<DefaultRaftClosure> tasks;
+
+    public BatchRaftClosure(List<DefaultRaftClosure> tasks) {
+        super(RaftOperation.createBatch(tasks.stream()
+                                             .map(DefaultRaftClosure::getOperation)
+                                             .collect(Collectors.toList())), null);
+        this.tasks = tasks;
+    }
+
+    @Override
+    public void run(Status status) {
+        tasks.forEach(task -> task.run(status));
+    }
+
+    public List<DefaultRaftClosure> getTasks() {
+        return tasks;
+    }
+
+    @Override
+    public void clear() {
+        super.clear();
+        tasks.forEach(DefaultRaftClosure::clear);
+    }
+}
@@ -17,6 +17,7 @@
 
 package org.apache.hugegraph.store.raft;
 
+import java.util.ArrayList;
 import java.util.Base64;
 import java.util.List;
 import java.util.concurrent.CopyOnWriteArrayList;
@@ -54,13 +55,16 @@ public class PartitionStateMachine extends StateMachineAdapter {
     private final Integer groupId;
     private final List<RaftTaskHandler> taskHandlers;
     private final List<RaftStateListener> stateListeners;
+    private final boolean batchApply;
 
     private final Lock lock = new ReentrantLock();
     private long committedIndex;
 
-    public PartitionStateMachine(Integer groupId, SnapshotHandler snapshotHandler) {
+    public PartitionStateMachine(Integer groupId, SnapshotHandler snapshotHandler,
+                                 boolean batchApply) {
         this.groupId = groupId;
         this.snapshotHandler = snapshotHandler;
+        this.batchApply = batchApply;
         this.stateListeners = new CopyOnWriteArrayList<>();
         this.taskHandlers = new CopyOnWriteArrayList<>();
     }
@@ -77,44 +81,150 @@ public class PartitionStateMachine extends StateMachineAdapter {
         return this.leaderTerm.get() > 0;
     }
 
+    /**
+     * Consecutive data write entries are applied in one write batch of the partition db, the
+     * closures of them are done and the committed index is moved once the batch is committed.
+     * An entry no handler knows stops the state machine rather than being skipped, otherwise
+     * the replica silently diverges from the others
+     */
     @Override
     public void onApply(Iterator iter) {
-        while (iter.hasNext()) {
-            final DefaultRaftClosure done = (DefaultRaftClosure) iter.done();
-            try {
-                for (RaftTaskHandler handler : taskHandlers) {
-                    if (done != null) {
-                        // Leader branch, call locally
-                        RaftOperation operation = done.getOperation();
-                        if (handler.invoke(groupId, operation.getOp(), operation.getReq(),
-                                           done.getClosure())) {
-                            done.run(Status.OK());
-                            break;
+        final List<DefaultRaftClosure> batched = new ArrayList<>();
+        boolean batching = false;
+        long batchIndex = committedIndex;
+        try {
+            while (iter.hasNext()) {
+                final DefaultRaftClosure done = (DefaultRaftClosure) iter.done();
+                try {
+                    byte[] data = iter.getData().array();
+                    boolean batchable = isBatchable(done, data);
+                    if (batching && !batchable) {
+                        batching = false;
+                        commitBatch(batched, batchIndex);
+                    } else if (!batching && batchable) {
+                        HgStoreEngine.getInstance().getBusinessHandler().beginApplyBatch(groupId);
+                        batching = true;
+                    }
+                    List<DefaultRaftClosure> closures = batching ? batched : null;
+                    boolean handled = true;
+                    if (done instanceof BatchRaftClosure) {
+                        for (DefaultRaftClosure task : ((BatchRaftClosure) done).getTasks()) {
+                            handled &= applyTask(task, null, closures, iter.getIndex());
                         }
-                    } else {
-                        if (handler.invoke(groupId, iter.getData().array(), null)) {
-                            break;
+                    } else if (done == null && data.length > 0 &&
+                               data[0] == RaftOperation.BATCH_TASK) {
+                        for (byte[] values : RaftOperation.splitBatch(data)) {
+                            handled &= applyTask(null, values, null, iter.getIndex());
                         }
+                    } else {
+                        handled = applyTask(done, data, closures, iter.getIndex());
+                    }
+                    if (!handled) {
+                        log.error("StateMachine {} meet unknown operation at index {}: {}",
+                                  groupId, iter.getIndex(),
+                                  data.length > 0 ? data[0] : "empty");
+                        iter.setErrorAndRollback(1, new Status(RaftError.ESTATEMACHINE,
+                                                               "Unknown operation at %d",
+                                                               iter.getIndex()));
+                        return;
+                    }
+                } catch (Throwable t) {
+                    log.info("{}", Base64.getEncoder().encode(iter.getData().array()));
+                    log.error(String.format("StateMachine %s meet critical error:", groupId), t);
+                    if (done != null) {
+                        log.error("StateMachine meet critical error: op = {} {}.",
+                                  done.getOperation().getOp(),
+                                  done.getOperation().getReq());
                     }
                 }
-            } catch (Throwable t) {
-                log.info("{}", Base64.getEncoder().encode(iter.getData().array()));
-                log.error(String.format("StateMachine %s meet critical error:", groupId), t);
+                if (batching) {
+                    batchIndex = iter.getIndex();
+                } else {
+                    committedIndex = iter.getIndex();
+                    stateListeners.forEach(listener -> listener.onDataCommitted(committedIndex));
+                }
+                // clear data
                 if (done != null) {
-                    log.error("StateMachine meet critical error: op = {} {}.",
-                              done.getOperation().getOp(),
-                              done.getOperation().getReq());
+                    done.clear();
                 }
+                // next entry
+                iter.next();
+            }
+        } finally {
+            if (batching) {
+                commitBatch(batched, batchIndex);
             }
-            committedIndex = iter.getIndex();
-            stateListeners.forEach(listener -> listener.onDataCommitted(committedIndex));
-            // clear data
+        }
+    }
+
+    private boolean isBatchable(DefaultRaftClosure done, byte[] data) {
+        byte op;
+        if (done != null) {
+            op = done.getOperation().getOp();
+        } else if (data.length > 0) {
+            op = data[0];
+        } else {
+            return false;
+        }
+        if (!batchApply) {
+            return false;
+        }
+        if (op == RaftOperation.BATCH_TASK) {
+            return true;
+        }
+        for (RaftTaskHandler handler : taskHandlers) {
+            if (handler.isBatchable(op)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Apply one operation, the closure of the leader is added to batched rather than done if
+     * the operation is written into the open write batch
+     *
+     * @param index log index of the entry
+     * @return false if no handler knows the operation
+     */
+    private boolean applyTask(DefaultRaftClosure done, byte[] data,
+                              List<DefaultRaftClosure> batched, long index) {
+        for (RaftTaskHandler handler : taskHandlers) {
             if (done != null) {
-                done.clear();
+                // Leader branch, call locally
+                RaftOperation operation = done.getOperation();
+                if (handler.invoke(groupId, operation.getOp(), operation.getReq(),
+                                   done.getClosure(), index)) {
+                    if (batched != null) {
+                        batched.add(done);
+                    } else {
+                        done.run(Status.OK());
+                    }
+                    return true;
+                }
+            } else {
+                if (handler.invoke(groupId, data, null, index)) {
+                    return true;
+                }
             }
-            // next entry
-            iter.next();
         }
+        return false;
+    }
+
+    private void commitBatch(List<DefaultRaftClosure> batched, long index) {
+        Status status = Status.OK();
+        try {
+            HgStoreEngine.getInstance().getBusinessHandler().commitApplyBatch(groupId);
+        } catch (Throwable t) {
+            log.error(String.format("StateMachine %s failed to commit write batch:", groupId), t);
+            status = new Status(RaftError.EIO, "%s", t.getMessage());
+        }
+        committedIndex = index;
+        stateListeners.forEach(listener -> listener.onDataCommitted(committedIndex));
+        for (DefaultRaftClosure done : batched) {
+            done.run(status);
+        }
+        batched.clear();
     }
 
     public long getCommittedIndex() {
@@ -190,11 +300,14 @@ public class PartitionStateMachine extends StateMachineAdapter {
 
     @Override
     public void onSnapshotSave(final SnapshotWriter writer, final Closure done) {
+        // The entries applied so far are in the snapshot
+        final long snapshotIndex = committedIndex;
         HgStoreEngine.getUninterruptibleJobs().execute(() -> {
             try {
                 lock.lock();
                 snapshotHandler.onSnapshotSave(writer);
                 log.info("Raft {} onSnapshotSave success", groupId);
+                snapshotHandler.onSnapshotSaved(snapshotIndex);
                 done.run(Status.OK());
             } catch (HgStoreException e) {
                 log.error(String.format("Raft %s onSnapshotSave failed. {}", groupId), e);
@@ -20,6 +20,9 @@ package org.apache.hugegraph.store.raft;
 import java.io.ByteArrayInputStream;
 import java.io.ByteArrayOutputStream;
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
 
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
@@ -46,6 +49,14 @@ public class RaftOperation {
     public static final byte DB_COMPACTION = 0x67;
     public static final byte DO_SYNC_SNAPSHOT = 0x68;
     public static final byte SYNC_BLANK_TASK = 0x69;
+    // Online split, hands the data of new partitions off on every replica
+    public static final byte SPLIT_HANDOFF = 0x6A;
+    // Partition migration, refuses the writes of the migrated partition from this index
+    public static final byte MOVE_FENCE = 0x6B;
+    // Partition migration, ingests the sst files shipped to every replica
+    public static final byte IN_INGEST_OP = 0x6C;
+    // Data writes submitted concurrently, merged into one log entry by the leader
+    public static final byte BATCH_TASK = 0x6D;
 
     final static byte[] EMPTY_Bytes = new byte[0];
     private static final Logger LOG = LoggerFactory.getLogger(RaftOperation.class);
@@ -101,6 +112,40 @@ public class RaftOperation {
         return create(op, buffer, req);
     }
 
+    /**
+     * Merge operations into one, the values are framed as BATCH_TASK | count | (length | values)*
+     */
+    public static RaftOperation createBatch(final List<RaftOperation> operations) {
+        int size = 1 + Integer.BYTES;
+        for (RaftOperation operation : operations) {
+            size += Integer.BYTES + operation.getValues().length;
+        }
+        ByteBuffer buffer = ByteBuffer.allocate(size);
+        buffer.put(BATCH_TASK);
+        buffer.putInt(operations.size());
+        for (RaftOperation operation : operations) {
+            buffer.putInt(operation.getValues().length);
+            buffer.put(operation.getValues());
+        }
+        return create(BATCH_TASK, buffer.array(), operations);
+    }
+
+    /**
+     * Values of the operations merged by {@link #createBatch}
+     */
+    public static List<byte[]> splitBatch(final byte[] values) {
+        ByteBuffer buffer = ByteBuffer.wrap(values);
+        buffer.get();
+        int count = buffer.getInt();
+        List<byte[]> operations = new ArrayList<>(count);
+        for (int i = 0; i < count; i++) {
+            byte[] bytes = new byte[buffer.getInt()];
+            buffer.get(bytes);
+            operations.add(bytes);
+        }
+        return operations;
+    }
+
     public static byte[] toByteArray(final byte op) throws IOException {
         try (ByteArrayOutputStream bos = new ByteArrayOutputStream()) {
             bos.write(op);
@@ -29,4 +29,26 @@ public interface RaftTaskHandler {
 
     boolean invoke(final int groupId, final byte methodId, final Object req,
                    RaftClosure response) throws HgStoreException;
+
+    /**
+     * Invoke the operation of the log entry at index, for the handlers that need the index
+     * of the entry applied
+     */
+    default boolean invoke(final int groupId, final byte[] request, RaftClosure response,
+                           long index) throws HgStoreException {
+        return invoke(groupId, request, response);
+    }
+
+    default boolean invoke(final int groupId, final byte methodId, final Object req,
+                           RaftClosure response, long index) throws HgStoreException {
+        return invoke(groupId, methodId, req, response);
+    }
+
+    /**
+     * Whether the operation only writes data into the db of the partition, such operations
+     * submitted concurrently are merged into one log entry and applied in one write batch
+     */
+    default boolean isBatchable(final byte methodId) {
+        return false;
+    }
 }
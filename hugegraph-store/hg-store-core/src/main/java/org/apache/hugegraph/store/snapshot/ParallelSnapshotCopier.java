@@ -0,0 +1,379 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.snapshot;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Queue;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+import java.util.concurrent.RejectedExecutionException;
+
+import org.apache.commons.io.FileUtils;
+
+import com.alipay.sofa.jraft.entity.LocalFileMetaOutter.LocalFileMeta;
+import com.alipay.sofa.jraft.error.RaftError;
+import com.alipay.sofa.jraft.option.SnapshotCopierOptions;
+import com.alipay.sofa.jraft.storage.SnapshotThrottle;
+import com.alipay.sofa.jraft.storage.snapshot.Snapshot;
+import com.alipay.sofa.jraft.storage.snapshot.SnapshotCopier;
+import com.alipay.sofa.jraft.storage.snapshot.SnapshotReader;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshot;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshotStorage;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshotWriter;
+import com.alipay.sofa.jraft.storage.snapshot.remote.RemoteFileCopier;
+import com.alipay.sofa.jraft.storage.snapshot.remote.Session;
+import com.alipay.sofa.jraft.util.ByteBufferCollector;
+import com.alipay.sofa.jraft.util.Utils;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Download a remote snapshot with several files in flight.
+ * <p>
+ * Unlike the copier of jraft, the files of a failed install are kept, so the next
+ * install only downloads what is missing. Files with the same checksum as the last
+ * local snapshot are hard linked instead of downloaded, and each downloaded file is
+ * verified against the checksum of the leader.
+ */
+@Slf4j
+public class ParallelSnapshotCopier extends SnapshotCopier {
+
+    private final LocalSnapshotStorage storage;
+    private final ExecutorService executor;
+    private final int concurrency;
+    private final Set<Session> sessions = ConcurrentHashMap.newKeySet();
+    private RemoteFileCopier copier;
+    private LocalSnapshot remoteSnapshot;
+    private LocalSnapshotWriter writer;
+    private volatile SnapshotReader reader;
+    private volatile boolean cancelled;
+    private Future<?> future;
+
+    public ParallelSnapshotCopier(LocalSnapshotStorage storage, ExecutorService executor,
+                                  int concurrency) {
+        this.storage = storage;
+        this.executor = executor;
+        this.concurrency = Math.max(1, concurrency);
+    }
+
+    public boolean init(String uri, SnapshotThrottle throttle, SnapshotCopierOptions opts) {
+        this.copier = new RemoteFileCopier();
+        this.remoteSnapshot = new LocalSnapshot(opts.getRaftOptions());
+        return this.copier.init(uri, throttle, opts);
+    }
+
+    @Override
+    public void start() {
+        this.future = Utils.runInThread(this::startCopy);
+    }
+
+    @Override
+    public void cancel() {
+        synchronized (this) {
+            if (this.cancelled) {
+                return;
+            }
+            if (isOk()) {
+                setError(RaftError.ECANCELED, "Cancel the copier manually.");
+            }
+            this.cancelled = true;
+        }
+        for (Session session : this.sessions) {
+            session.cancel();
+        }
+    }
+
+    @Override
+    public void join() throws InterruptedException {
+        if (this.future == null) {
+            return;
+        }
+        try {
+            this.future.get();
+        } catch (ExecutionException e) {
+            log.error("Fail to join snapshot copier", e);
+        }
+    }
+
+    @Override
+    public SnapshotReader getReader() {
+        return this.reader;
+    }
+
+    @Override
+    public void close() throws IOException {
+        cancel();
+        try {
+            join();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+
+    private void startCopy() {
+        try {
+            loadMetaTable();
+            if (isOk()) {
+                filter();
+            }
+            if (isOk()) {
+                copyFiles();
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            fail(RaftError.ECANCELED.getNumber(), "Copy is interrupted");
+        } catch (IOException e) {
+            log.error("Fail to copy snapshot", e);
+            fail(RaftError.EIO.getNumber(), "Fail to copy snapshot: " + e.getMessage());
+        }
+        if (this.writer != null) {
+            if (!isOk() && this.writer.isOk()) {
+                this.writer.setError(getCode(), getErrorMsg());
+            }
+            try {
+                // Keep the downloaded files on error, the next install resumes from them
+                this.writer.close(true);
+            } catch (IOException e) {
+                log.error("Fail to close snapshot writer {}", this.writer.getPath(), e);
+            }
+            this.writer = null;
+        }
+        if (isOk()) {
+            this.reader = this.storage.open();
+        }
+    }
+
+    private void loadMetaTable() throws InterruptedException {
+        ByteBufferCollector metaBuf = ByteBufferCollector.allocate(0);
+        Session session = startSession(() -> this.copier.startCopy2IoBuffer(
+                Snapshot.JRAFT_SNAPSHOT_META_FILE, metaBuf, null));
+        if (session == null) {
+            return;
+        }
+        try {
+            session.join();
+        } finally {
+            endSession(session);
+        }
+        if (!session.status().isOk()) {
+            fail(session.status().getCode(), "Fail to copy snapshot meta: " +
+                                             session.status().getErrorMsg());
+            return;
+        }
+        if (!this.remoteSnapshot.getMetaTable().loadFromIoBufferAsRemote(metaBuf.getBuffer())) {
+            fail(-1, "Bad meta_table format");
+            return;
+        }
+        if (!this.remoteSnapshot.getMetaTable().hasMeta()) {
+            fail(-1, "Remote snapshot has no meta");
+        }
+    }
+
+    /**
+     * Reuse the files of the last failed install and of the last local snapshot
+     */
+    private void filter() throws IOException {
+        this.writer = (LocalSnapshotWriter) this.storage.create(false);
+        if (this.writer == null) {
+            fail(RaftError.EIO.getNumber(), "Fail to create snapshot writer");
+            return;
+        }
+        int kept = 0;
+        for (String file : this.writer.listFiles()) {
+            if (sameChecksum(this.writer.getFileMeta(file),
+                             this.remoteSnapshot.getFileMeta(file))) {
+                kept++;
+                continue;
+            }
+            this.writer.removeFile(file);
+            FileUtils.deleteQuietly(new File(this.writer.getPath(), file));
+        }
+
+        int linked = 0;
+        SnapshotReader lastSnapshot = this.storage.open();
+        if (lastSnapshot != null) {
+            try {
+                for (String file : this.remoteSnapshot.listFiles()) {
+                    Object remoteMeta = this.remoteSnapshot.getFileMeta(file);
+                    if (this.writer.getFileMeta(file) != null ||
+                        !sameChecksum(lastSnapshot.getFileMeta(file), remoteMeta)) {
+                        continue;
+                    }
+                    Path source = Paths.get(lastSnapshot.getPath(), file);
+                    Path dest = Paths.get(this.writer.getPath(), file);
+                    Files.createDirectories(dest.getParent());
+                    Files.deleteIfExists(dest);
+                    Files.createLink(dest, source);
+                    this.writer.addFile(file, (LocalFileMeta) remoteMeta);
+                    linked++;
+                }
+            } finally {
+                Utils.closeQuietly(lastSnapshot);
+            }
+        }
+
+        this.writer.saveMeta(this.remoteSnapshot.getMetaTable().getMeta());
+        if (!this.writer.sync()) {
+            fail(RaftError.EIO.getNumber(), "Fail to sync snapshot writer");
+            return;
+        }
+        log.info("Copy snapshot to {}, kept {} files, linked {} files of the last snapshot",
+                 this.writer.getPath(), kept, linked);
+    }
+
+    private static boolean sameChecksum(Object local, Object remote) {
+        if (!(local instanceof LocalFileMeta) || !(remote instanceof LocalFileMeta)) {
+            return false;
+        }
+        LocalFileMeta localMeta = (LocalFileMeta) local;
+        LocalFileMeta remoteMeta = (LocalFileMeta) remote;
+        return localMeta.hasChecksum() && remoteMeta.hasChecksum() &&
+               localMeta.getChecksum().equals(remoteMeta.getChecksum());
+    }
+
+    /**
+     * Download the missing files, at most `concurrency` at a time
+     */
+    private void copyFiles() throws InterruptedException {
+        Queue<String> files = new ConcurrentLinkedQueue<>();
+        for (String file : this.remoteSnapshot.listFiles()) {
+            if (this.writer.getFileMeta(file) == null) {
+                files.add(file);
+            }
+        }
+        if (files.isEmpty()) {
+            return;
+        }
+        log.info("Copy snapshot to {}, {} files to download", this.writer.getPath(),
+                 files.size());
+
+        Runnable worker = () -> {
+            String file;
+            while (isOk() && (file = files.poll()) != null) {
+                try {
+                    copyFile(file);
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    fail(RaftError.ECANCELED.getNumber(), "Copy is interrupted");
+                } catch (IOException e) {
+                    log.error("Fail to copy file {}", file, e);
+                    fail(RaftError.EIO.getNumber(), "Fail to copy " + file);
+                }
+            }
+        };
+        List<Future<?>> workers = new ArrayList<>(this.concurrency);
+        for (int i = 1; i < this.concurrency; i++) {
+            try {
+                workers.add(this.executor.submit(worker));
+            } catch (RejectedExecutionException e) {
+                break;
+            }
+        }
+        // The copier thread works as well
+        worker.run();
+        for (Future<?> f : workers) {
+            try {
+                f.get();
+            } catch (ExecutionException e) {
+                fail(RaftError.EIO.getNumber(), "Fail to copy snapshot: " + e.getMessage());
+            }
+        }
+    }
+
+    private void copyFile(String file) throws IOException, InterruptedException {
+        String filePath = this.writer.getPath() + File.separator + file;
+        File parent = new File(filePath).getParentFile();
+        if (parent != null && !parent.exists() && !parent.mkdirs()) {
+            fail(RaftError.EIO.getNumber(), "Fail to create directory " + parent);
+            return;
+        }
+        LocalFileMeta meta = (LocalFileMeta) this.remoteSnapshot.getFileMeta(file);
+        Session session = startSession(() -> this.copier.startCopyToFile(file, filePath, null));
+        if (session == null) {
+            return;
+        }
+        try {
+            session.join();
+        } finally {
+            endSession(session);
+        }
+        if (!session.status().isOk()) {
+            fail(session.status().getCode(), "Fail to copy " + file + ": " +
+                                             session.status().getErrorMsg());
+            return;
+        }
+        if (meta != null && meta.hasChecksum() &&
+            !SnapshotHandler.verifyChecksum(filePath, meta.getChecksum())) {
+            // Dropped, so the next install downloads it again
+            FileUtils.deleteQuietly(new File(filePath));
+            fail(RaftError.EIO.getNumber(), "Checksum mismatch of " + file);
+            return;
+        }
+        synchronized (this) {
+            if (!this.writer.addFile(file, meta) || !this.writer.sync()) {
+                fail(RaftError.EIO.getNumber(), "Fail to add file " + file);
+            }
+        }
+    }
+
+    private interface SessionStarter {
+
+        Session start() throws IOException;
+    }
+
+    private Session startSession(SessionStarter starter) {
+        synchronized (this) {
+            if (this.cancelled) {
+                return null;
+            }
+            try {
+                Session session = starter.start();
+                if (session == null) {
+                    fail(RaftError.EIO.getNumber(), "Fail to start copy session");
+                    return null;
+                }
+                this.sessions.add(session);
+                return session;
+            } catch (IOException e) {
+                fail(RaftError.EIO.getNumber(), "Fail to start copy session: " + e.getMessage());
+                return null;
+            }
+        }
+    }
+
+    private void endSession(Session session) {
+        this.sessions.remove(session);
+        Utils.closeQuietly(session);
+    }
+
+    private synchronized void fail(int code, String msg) {
+        if (isOk()) {
+            setError(code, "%s", msg);
+        }
+    }
+}
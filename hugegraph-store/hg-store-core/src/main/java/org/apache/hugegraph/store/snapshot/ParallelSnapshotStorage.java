@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.snapshot;
+
+import java.util.concurrent.ThreadPoolExecutor;
+
+import org.apache.hugegraph.store.consts.PoolNames;
+import org.apache.hugegraph.store.options.HgStoreEngineOptions;
+import org.apache.hugegraph.store.util.ExecutorUtil;
+
+import com.alipay.sofa.jraft.option.RaftOptions;
+import com.alipay.sofa.jraft.option.SnapshotCopierOptions;
+import com.alipay.sofa.jraft.storage.SnapshotThrottle;
+import com.alipay.sofa.jraft.storage.snapshot.SnapshotCopier;
+import com.alipay.sofa.jraft.storage.snapshot.ThroughputSnapshotThrottle;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshotStorage;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Snapshot storage of a partition that installs remote snapshots with a
+ * ParallelSnapshotCopier. The downloading threads and the bandwidth limit are
+ * shared by all the partitions of the store.
+ */
+@Slf4j
+public class ParallelSnapshotStorage extends LocalSnapshotStorage {
+
+    private static ThreadPoolExecutor downloadExecutor;
+    private static SnapshotThrottle downloadThrottle;
+
+    private final HgStoreEngineOptions.RaftOptions options;
+    private SnapshotThrottle snapshotThrottle;
+
+    public ParallelSnapshotStorage(String path, RaftOptions raftOptions,
+                                   HgStoreEngineOptions.RaftOptions options) {
+        super(path, raftOptions);
+        this.options = options;
+        this.snapshotThrottle = getDownloadThrottle(options);
+    }
+
+    private static synchronized ThreadPoolExecutor getDownloadExecutor(
+            HgStoreEngineOptions.RaftOptions options) {
+        if (downloadExecutor == null) {
+            int threads = Math.max(1, options.getSnapshotDownloadingThreads());
+            downloadExecutor = ExecutorUtil.createExecutor(PoolNames.SNAPSHOT, threads, threads,
+                                                           Integer.MAX_VALUE);
+        }
+        return downloadExecutor;
+    }
+
+    private static synchronized SnapshotThrottle getDownloadThrottle(
+            HgStoreEngineOptions.RaftOptions options) {
+        if (downloadThrottle == null && options.getSnapshotDownloadingBytesPerSec() > 0) {
+            downloadThrottle = new ThroughputSnapshotThrottle(
+                    options.getSnapshotDownloadingBytesPerSec(), 1);
+        }
+        return downloadThrottle;
+    }
+
+    @Override
+    public void setSnapshotThrottle(SnapshotThrottle snapshotThrottle) {
+        super.setSnapshotThrottle(snapshotThrottle);
+        if (this.snapshotThrottle == null) {
+            this.snapshotThrottle = snapshotThrottle;
+        }
+    }
+
+    @Override
+    public SnapshotCopier startToCopyFrom(String uri, SnapshotCopierOptions opts) {
+        ParallelSnapshotCopier copier =
+                new ParallelSnapshotCopier(this, getDownloadExecutor(this.options),
+                                           this.options.getSnapshotDownloadingThreads());
+        if (!copier.init(uri, this.snapshotThrottle, opts)) {
+            log.error("Fail to init snapshot copier to {}", uri);
+            return null;
+        }
+        copier.start();
+        return copier;
+    }
+}
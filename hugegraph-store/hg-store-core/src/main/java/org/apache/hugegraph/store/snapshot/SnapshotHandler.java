@@ -18,12 +18,22 @@
 package org.apache.hugegraph.store.snapshot;
 
 import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
 import java.io.IOException;
-import java.io.RandomAccessFile;
+import java.io.InputStream;
+import java.io.OutputStream;
 import java.nio.charset.Charset;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.nio.file.attribute.BasicFileAttributes;
 import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
+import java.util.Properties;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.zip.Checksum;
 
@@ -46,10 +56,15 @@ import lombok.extern.slf4j.Slf4j;
 public class SnapshotHandler {
 
     private static final String SHOULD_NOT_LOAD = "should_not_load";
+    private static final String SST_CHECKSUMS = "sst_checksums";
     private static final String SNAPSHOT_DATA_PATH = "data";
+    private static final int CHECKSUM_BUFFER_SIZE = 64 * 1024;
+    private static final String CHECKSUM_PREFIX = "crc64_";
 
     private final PartitionEngine partitionEngine;
     private final BusinessHandler businessHandler;
+    // sst file path, length, mtime and inode -> checksum
+    private final Map<String, String> sstChecksums = new ConcurrentHashMap<>();
 
     public SnapshotHandler(PartitionEngine partitionEngine) {
         this.partitionEngine = partitionEngine;
@@ -87,6 +102,16 @@ public class SnapshotHandler {
         return partitionEngine.getPartitions();
     }
 
+    /**
+     * Delete the sst files of the migrations ingested up to index, the snapshot saved at index
+     * covers them. If the snapshot is not completed after all, a replay of the ingest fails
+     * and the replica is rebuilt from another snapshot.
+     */
+    public void onSnapshotSaved(long index) {
+        partitionEngine.getStoreEngine().getDataManager()
+                       .cleanTransfers(partitionEngine.getGroupId(), index);
+    }
+
     /**
      * create rocksdb checkpoint
      */
@@ -109,8 +134,10 @@ public class SnapshotHandler {
             findFileList(dir, rootDirFile, files);
 
             // load snapshot by learner ??
+            Set<String> sstFiles = new HashSet<>();
             for (String file : files) {
-                String checksum = calculateChecksum(writer.getPath() + File.separator + file);
+                String path = writer.getPath() + File.separator + file;
+                String checksum = getChecksum(file, path, sstFiles);
                 if (checksum.length() != 0) {
                     LocalFileMetaOutter.LocalFileMeta meta =
                             LocalFileMetaOutter.LocalFileMeta.newBuilder()
@@ -121,49 +148,87 @@ public class SnapshotHandler {
                     writer.addFile(file);
                 }
             }
+            // forget the sst files compacted away
+            sstChecksums.keySet().retainAll(sstFiles);
+            saveSstChecksums(writer);
             // should_not_load wound not sync to learner
             markShouldNotLoad(writer, true);
         }
     }
 
-    private String calculateChecksum(String path) {
-        // only calculate .sst and .log(wal file) file
-        final String emptyString = "";
-        if (path.endsWith(".sst") || path.endsWith(".log")) {
-            final int maxFullCheckLength = 8192;
-            final int checkLength = 4096;
-            try {
-                File file = new File(path);
-                long length = file.length();
-                Checksum checksum = new CRC64();
-                try (final RandomAccessFile raf = new RandomAccessFile(file, "r")) {
-                    byte[] buf = new byte[checkLength];
-                    if (length <= maxFullCheckLength) {
-                        int totalReadLen = 0;
-                        while (totalReadLen < length) {
-                            int readLen = raf.read(buf);
-                            checksum.update(buf, 0, readLen);
-                            totalReadLen += readLen;
-                        }
-                    } else {
-                        // head
-                        int readLen = raf.read(buf);
-                        checksum.update(buf, 0, readLen);
-                        // tail
-                        raf.seek(length - checkLength);
-                        readLen = raf.read(buf);
-                        checksum.update(buf, 0, readLen);
-                    }
-                }
-                // final checksum = crc checksum + file length
-                return Long.toHexString(checksum.getValue()) + "_" + Long.toHexString(length);
-            } catch (IOException e) {
-                log.error("Failed to calculateChecksum for file {}. {}", path, e);
-                return emptyString;
+    /**
+     * Sst files are immutable, so their checksums are only computed once. Other files are
+     * small and computed every time
+     */
+    private String getChecksum(String file, String path, Set<String> sstFiles) {
+        String key = path.endsWith(".sst") ? sstKey(file, path) : null;
+        if (key == null) {
+            return calculateChecksum(path);
+        }
+        sstFiles.add(key);
+        String checksum = sstChecksums.get(key);
+        if (checksum == null) {
+            checksum = calculateChecksum(path);
+            if (!checksum.isEmpty()) {
+                sstChecksums.put(key, checksum);
             }
-        } else {
-            return emptyString;
         }
+        return checksum;
+    }
+
+    /**
+     * A recreated db may reuse the name of an sst file, even with the same length, the
+     * checkpoint hard links the db files, so their mtime and inode tell the files apart
+     *
+     * @return the key of the cached checksum, null if the file can not be read
+     */
+    private static String sstKey(String file, String path) {
+        BasicFileAttributes attrs;
+        try {
+            attrs = Files.readAttributes(Paths.get(path), BasicFileAttributes.class);
+        } catch (IOException e) {
+            log.error("Failed to read attributes of file {}. {}", path, e);
+            return null;
+        }
+        StringBuilder key = new StringBuilder(file);
+        key.append("_").append(Long.toHexString(attrs.size()))
+           .append("_").append(Long.toHexString(attrs.lastModifiedTime().toMillis()));
+        if (attrs.fileKey() != null) {
+            key.append("_").append(attrs.fileKey());
+        }
+        return key.toString();
+    }
+
+    /**
+     * The checksum is the crc of the whole file plus its length, the followers verify
+     * each downloaded file with it
+     *
+     * @return the checksum, empty if the file can not be read
+     */
+    public static String calculateChecksum(String path) {
+        File file = new File(path);
+        Checksum checksum = new CRC64();
+        try (InputStream input = new FileInputStream(file)) {
+            byte[] buf = new byte[CHECKSUM_BUFFER_SIZE];
+            int readLen;
+            while ((readLen = input.read(buf)) > 0) {
+                checksum.update(buf, 0, readLen);
+            }
+        } catch (IOException e) {
+            log.error("Failed to calculateChecksum for file {}. {}", path, e);
+            return "";
+        }
+        // final checksum = crc checksum + file length
+        return CHECKSUM_PREFIX + Long.toHexString(checksum.getValue()) + "_" +
+               Long.toHexString(file.length());
+    }
+
+    /**
+     * Snapshots of older stores only checksum the head and tail of a file, they are
+     * not verified
+     */
+    public static boolean verifyChecksum(String path, String checksum) {
+        return !checksum.startsWith(CHECKSUM_PREFIX) || checksum.equals(calculateChecksum(path));
     }
 
     public void onSnapshotLoad(final SnapshotReader reader, long committedIndex) throws
@@ -173,6 +238,8 @@ public class SnapshotHandler {
         // No need to load locally saved snapshots
         if (shouldNotLoad(reader)) {
             log.info("skip to load snapshot because of should_not_load flag");
+            // Restarted with the last local snapshot, no need to read all sst files again
+            loadSstChecksums(reader);
             return;
         }
 
@@ -181,6 +248,10 @@ public class SnapshotHandler {
         log.info("Raft {} begin loadSnapshot, {}", partitionEngine.getGroupId(), graphSnapshotDir);
         businessHandler.loadSnapshot(graphSnapshotDir, "", partitionEngine.getGroupId(),
                                      committedIndex);
+        // The sst files now come from another store, the file names may be reused
+        sstChecksums.clear();
+        // The write fences and handoff markers came with the meta of the snapshot
+        partitionEngine.reloadHandoffState();
         log.info("Raft {} end loadSnapshot.", partitionEngine.getGroupId());
 
         for (Metapb.Partition snapPartition : partitionEngine.loadPartitionsFromLocalDb()) {
@@ -206,6 +277,40 @@ public class SnapshotHandler {
         markShouldNotLoad(reader, false);
     }
 
+    /**
+     * Keep the sst checksums next to the snapshot meta, like should_not_load it's not added
+     * to the snapshot and won't sync to learner
+     */
+    private void saveSstChecksums(final Snapshot snapshot) {
+        Properties checksums = new Properties();
+        checksums.putAll(sstChecksums);
+        File file = new File(snapshot.getPath(), SST_CHECKSUMS);
+        try (OutputStream output = new FileOutputStream(file)) {
+            checksums.store(output, null);
+        } catch (IOException e) {
+            log.error("Failed to save sst checksums {}. {}", file, e);
+        }
+    }
+
+    private void loadSstChecksums(final Snapshot snapshot) {
+        File file = new File(snapshot.getPath(), SST_CHECKSUMS);
+        if (!sstChecksums.isEmpty() || !file.exists()) {
+            return;
+        }
+        Properties checksums = new Properties();
+        try (InputStream input = new FileInputStream(file)) {
+            checksums.load(input);
+        } catch (IOException e) {
+            log.error("Failed to load sst checksums {}. {}", file, e);
+            return;
+        }
+        for (String key : checksums.stringPropertyNames()) {
+            sstChecksums.put(key, checksums.getProperty(key));
+        }
+        log.info("Raft {} loaded {} sst checksums of the last snapshot",
+                 partitionEngine.getGroupId(), sstChecksums.size());
+    }
+
     private boolean shouldNotLoad(final Snapshot snapshot) {
         String shouldNotLoadPath = getShouldNotLoadPath(snapshot);
         return new File(shouldNotLoadPath).exists();
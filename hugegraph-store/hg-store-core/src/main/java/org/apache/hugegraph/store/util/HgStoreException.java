@@ -24,6 +24,8 @@ public class HgStoreException extends RuntimeException {
     // data format not support
     public static final int EC_DATAFMT_NOT_SUPPORTED = 1001;
     public static final int EC_CLOSE = 1002;
+    // learner still catching up with the leader, not serving scans yet
+    public static final int EC_LEARNER_NOT_READY = 1003;
     public static final int EC_RKDB_CREATE_FAIL = 1201;
     public static final int EC_RKDB_DOPUT_FAIL = 1202;
     public static final int EC_RKDB_DODEL_FAIL = 1203;
@@ -37,6 +39,8 @@ public class HgStoreException extends RuntimeException {
     public static final int EC_RKDB_EXPORT_SNAPSHOT_FAIL = 1214;
     public static final int EC_RKDB_IMPORT_SNAPSHOT_FAIL = 1215;
     public static final int EC_RKDB_TRANSFER_SNAPSHOT_FAIL = 1216;
+    // sst files that no db can ingest, e.g. corrupted ones
+    public static final int EC_RKDB_INVALID_SST = 1217;
     public static final int EC_METRIC_FAIL = 1401;
     private static final long serialVersionUID = 5193624480997934335L;
     private final int code;
@@ -18,8 +18,11 @@
 package org.apache.hugegraph.store.util;
 
 import java.io.Serializable;
+import java.util.Arrays;
 import java.util.List;
 
+import org.apache.hugegraph.store.query.KvSerializer;
+
 import lombok.Data;
 
 @Data
@@ -39,33 +42,54 @@ public class MultiKv implements Comparable<MultiKv>, Serializable {
         return new MultiKv(keys, values);
     }
 
+    /**
+     * Compare the keys in their natural order like KvElement.compareTo of the client,
+     * which merges the sorted groups of all the stores and only combines the adjacent
+     * equal ones. Keys of different types are ordered by their class names, and the
+     * equal keys of one type that aren't equals() by their serialized bytes, so the
+     * order is still total and consistent with equals of the keys.
+     */
     @Override
     public int compareTo(MultiKv o) {
-        if (keys == null && o == null) {
+        if (keys == null && o.keys == null) {
             return 0;
         }
         if (keys == null) {
             return -1;
         } else if (o.keys == null) {
             return 1;
-        } else {
-            int l1 = keys.size();
-            int l2 = o.getKeys().size();
-            for (int i = 0; i < Math.min(l1, l2); i++) {
-                if (keys.get(i) instanceof Comparable && o.getKeys().get(i) instanceof Comparable) {
-                    var ret = ((Comparable) keys.get(i)).compareTo(o.getKeys().get(i));
-                    if (ret != 0) {
-                        return ret;
-                    }
-                } else {
-                    return 1;
-                }
+        }
+
+        int len = Math.min(keys.size(), o.keys.size());
+        for (int i = 0; i < len; i++) {
+            int ret = compareKey(keys.get(i), o.keys.get(i));
+            if (ret != 0) {
+                return ret;
             }
+        }
+        return Integer.compare(keys.size(), o.keys.size());
+    }
 
-            if (l1 != l2) {
-                return l1 > l2 ? 1 : -1;
+    @SuppressWarnings({"unchecked", "rawtypes"})
+    private static int compareKey(Object k1, Object k2) {
+        if (k1 == k2) {
+            return 0;
+        }
+        // Null first as KvElement does
+        if (k1 == null || k2 == null) {
+            return k1 == null ? -1 : 1;
+        }
+        if (k1.getClass() != k2.getClass()) {
+            return k1.getClass().getName().compareTo(k2.getClass().getName());
+        }
+        if (k1 instanceof Comparable) {
+            int ret = ((Comparable) k1).compareTo(k2);
+            if (ret != 0 || k1.equals(k2)) {
+                return ret;
             }
         }
-        return 0;
+        // Such as BigDecimal of different scales, or keys not comparable
+        return Arrays.compareUnsigned(KvSerializer.toBytes(List.of(k1)),
+                                      KvSerializer.toBytes(List.of(k2)));
     }
 }
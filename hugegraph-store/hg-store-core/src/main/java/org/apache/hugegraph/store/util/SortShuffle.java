@@ -17,6 +17,8 @@
 
 package org.apache.hugegraph.store.util;
 
+import java.io.BufferedInputStream;
+import java.io.BufferedOutputStream;
 import java.io.File;
 import java.io.FileInputStream;
 import java.io.FileOutputStream;
@@ -25,14 +27,17 @@ import java.io.InputStream;
 import java.io.OutputStream;
 import java.io.Serializable;
 import java.util.ArrayDeque;
+import java.util.ArrayList;
 import java.util.Comparator;
 import java.util.Deque;
 import java.util.Iterator;
+import java.util.List;
+import java.util.NoSuchElementException;
+import java.util.PriorityQueue;
 import java.util.Queue;
 import java.util.concurrent.ConcurrentLinkedDeque;
 import java.util.concurrent.atomic.AtomicInteger;
 
-import org.apache.hugegraph.store.business.itrv2.FileObjectIterator;
 import org.apache.hugegraph.store.business.itrv2.io.SortShuffleSerializer;
 
 public class SortShuffle<T extends Serializable> {
@@ -57,8 +62,22 @@ public class SortShuffle<T extends Serializable> {
 
     private final Deque<String> files = new ArrayDeque<>();
 
+    private final int batchSize;
+
+    // The spill files opened by the merge iterators, closed with the shuffle
+    private final List<SortedRun> runs = new ArrayList<>();
+
     public SortShuffle(Comparator<T> comparator, SortShuffleSerializer<T> serializer) {
+        this(comparator, serializer, BATCH_SIZE);
+    }
+
+    /**
+     * @param batchSize the max count of objects kept in memory, spill to file when exceeded
+     */
+    public SortShuffle(Comparator<T> comparator, SortShuffleSerializer<T> serializer,
+                       int batchSize) {
         this.comparator = comparator;
+        this.batchSize = batchSize > 0 ? batchSize : BATCH_SIZE;
         path = basePath + Thread.currentThread().getId() + "-" +
                System.currentTimeMillis() % 10000 + "/";
         new File(path).mkdirs();
@@ -81,9 +100,9 @@ public class SortShuffle<T extends Serializable> {
      * @throws IOException
      */
     public void append(T t) throws IOException {
-        if (queue.size() >= BATCH_SIZE) {
+        if (queue.size() >= this.batchSize) {
             synchronized (this) {
-                if (queue.size() >= BATCH_SIZE) {
+                if (queue.size() >= this.batchSize) {
                     writeToFile();
                     queue.clear();
                 }
@@ -100,6 +119,13 @@ public class SortShuffle<T extends Serializable> {
      * Delete file/directory and close resource
      */
     public void close() {
+        synchronized (this.runs) {
+            // The consumer may stop before reaching the end of the runs
+            for (SortedRun run : this.runs) {
+                run.close();
+            }
+            this.runs.clear();
+        }
         if (this.files.size() > 0) {
             while (this.files.size() > 0) {
                 new File(files.pop()).delete();
@@ -125,7 +151,7 @@ public class SortShuffle<T extends Serializable> {
         }
 
         var fn = getFileName();
-        OutputStream fos = new FileOutputStream(fn);
+        OutputStream fos = new BufferedOutputStream(new FileOutputStream(fn));
         queue.stream().sorted(this.comparator).forEach(t -> {
             try {
                 serializer.write(fos, t);
@@ -146,10 +172,10 @@ public class SortShuffle<T extends Serializable> {
      */
     private void minorMerge(String f1, String f2) throws IOException {
         String fn = getFileName();
-        OutputStream fos = new FileOutputStream(fn);
+        OutputStream fos = new BufferedOutputStream(new FileOutputStream(fn));
 
-        InputStream fis1 = new FileInputStream(f1);
-        InputStream fis2 = new FileInputStream(f2);
+        InputStream fis1 = new BufferedInputStream(new FileInputStream(f1));
+        InputStream fis2 = new BufferedInputStream(new FileInputStream(f2));
 
         T o1 = serializer.read(fis1);
         T o2 = serializer.read(fis2);
@@ -189,7 +215,7 @@ public class SortShuffle<T extends Serializable> {
     }
 
     /**
-     * merge all split files
+     * spill the left elements, the split files are merged while reading
      */
     private void finalMerge() throws IOException {
 
@@ -199,14 +225,10 @@ public class SortShuffle<T extends Serializable> {
 
         writeToFile();
         queue.clear();
-
-        while (this.files.size() > 1) {
-            minorMerge(this.files.pop(), this.files.pop());
-        }
     }
 
     /**
-     * read all sorted element
+     * read all element, which are sorted only if spilled to files
      *
      * @return iterator
      */
@@ -214,8 +236,87 @@ public class SortShuffle<T extends Serializable> {
         if (files.size() == 0) {
             return queue.iterator();
         }
+        return new MergeIterator();
+    }
+
+    /**
+     * read all sorted element, the elements in memory are sorted if nothing spilled
+     *
+     * @return iterator
+     */
+    public Iterator<T> getSortedIterator() throws IOException {
+        if (files.size() == 0) {
+            return queue.stream().sorted(this.comparator).iterator();
+        }
+        return new MergeIterator();
+    }
 
-        return new FileObjectIterator<>(files.getFirst(), this.serializer);
+    /**
+     * k-way merge of all the sorted split files
+     */
+    private class MergeIterator implements Iterator<T> {
+
+        private final PriorityQueue<SortedRun> runs;
+
+        public MergeIterator() throws IOException {
+            this.runs = new PriorityQueue<>(files.size(),
+                                            (r1, r2) -> comparator.compare(r1.current,
+                                                                           r2.current));
+            for (String file : files) {
+                SortedRun run = new SortedRun(file);
+                synchronized (SortShuffle.this.runs) {
+                    SortShuffle.this.runs.add(run);
+                }
+                if (run.advance()) {
+                    this.runs.add(run);
+                }
+            }
+        }
+
+        @Override
+        public boolean hasNext() {
+            return !this.runs.isEmpty();
+        }
+
+        @Override
+        public T next() {
+            SortedRun run = this.runs.poll();
+            if (run == null) {
+                throw new NoSuchElementException();
+            }
+            T current = run.current;
+            if (run.advance()) {
+                this.runs.add(run);
+            }
+            return current;
+        }
+    }
+
+    private class SortedRun {
+
+        private final InputStream input;
+        private T current;
+
+        public SortedRun(String file) throws IOException {
+            this.input = new BufferedInputStream(new FileInputStream(file));
+        }
+
+        public boolean advance() {
+            this.current = serializer.read(this.input);
+            if (this.current == null) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        public void close() {
+            try {
+                this.input.close();
+            } catch (IOException ignored) {
+                // pass
+            }
+        }
     }
 
 }
@@ -347,7 +347,11 @@ public final class KvStream extends
             output.writeUInt32(4, version_);
         }
         if (stream_.limit() > 0) {
-            output.writeByteArray(5, stream_.array(), 0, stream_.limit());
+            // The stream may be a pooled direct buffer without a backing array, the output
+            // copies the wrapped bytes
+            ByteBuffer data = stream_.duplicate();
+            data.position(0);
+            output.writeBytes(5, com.google.protobuf.UnsafeByteOperations.unsafeWrap(data));
         }
         if (type_ !=
             org.apache.hugegraph.store.grpc.stream.KvStreamType.STREAM_TYPE_NONE.getNumber()) {
@@ -198,6 +198,16 @@ public class AppConfig {
         private int maxEntriesSize;
         @Value("${raft.maxBodySize:524288}")
         private int maxBodySize;
+        @Value("${raft.snapshotDownloadingThreads:4}")
+        private int snapshotDownloadingThreads;
+        @Value("${raft.snapshotDownloadingBytesPerSec:0}")
+        private long snapshotDownloadingBytesPerSec;
+        // Hosts learner replicas only, PD places no voters on this store
+        @Value("${raft.learner:false}")
+        private boolean learner;
+        // Merge concurrent data writes into one raft entry, all stores must support it
+        @Value("${raft.batchApply:false}")
+        private boolean batchApply;
 
     }
 
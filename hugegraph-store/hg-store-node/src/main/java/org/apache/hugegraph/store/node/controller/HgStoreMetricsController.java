@@ -20,6 +20,7 @@ package org.apache.hugegraph.store.node.controller;
 import java.util.HashMap;
 import java.util.Map;
 
+import org.apache.hugegraph.store.metric.HgStoreMetric;
 import org.apache.hugegraph.store.node.grpc.HgStoreNodeService;
 import org.apache.hugegraph.store.node.metrics.DriveMetrics;
 import org.apache.hugegraph.store.node.metrics.SystemMetrics;
@@ -58,6 +59,11 @@ public class HgStoreMetricsController {
         return this.driveMetrics.metrics();
     }
 
+    @GetMapping("memory")
+    public HgStoreMetric.Memory memory() {
+        return nodeService.getStoreEngine().getBusinessHandler().getMemoryMetric();
+    }
+
     @GetMapping("raft")
     public Map<String, NodeMetrics> getRaftMetrics() {
         return nodeService.getNodeMetrics();
@@ -18,15 +18,18 @@
 package org.apache.hugegraph.store.node.grpc;
 
 import java.util.ArrayList;
+import java.util.Collection;
 import java.util.Collections;
 import java.util.List;
 import java.util.Map;
+import java.util.Set;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicReference;
 import java.util.function.Consumer;
 import java.util.function.Function;
+import java.util.function.IntFunction;
 
 import org.apache.commons.collections.CollectionUtils;
 import org.apache.hugegraph.store.grpc.common.ResCode;
@@ -35,6 +38,7 @@ import org.apache.hugegraph.store.grpc.session.FeedbackRes;
 import org.apache.hugegraph.store.grpc.session.PartitionFaultResponse;
 import org.apache.hugegraph.store.grpc.session.PartitionFaultType;
 import org.apache.hugegraph.store.grpc.session.PartitionLeader;
+import org.apache.hugegraph.store.grpc.session.PartitionRoute;
 import org.apache.hugegraph.store.raft.RaftClosure;
 import org.apache.hugegraph.store.util.HgRaftError;
 
@@ -55,12 +59,17 @@ class BatchGrpcClosure<V> {
     private final List<Status> errorStatus;
     private final List<V> results;
     private final Map<Integer, Long> leaderMap;
+    private final Map<Integer, PartitionRoute> routeMap;
+    // The key codes of the entries grouped into the failed partitions
+    private final Set<Integer> failedCodes;
 
     public BatchGrpcClosure(int count) {
         countDownLatch = new CountDownLatch(count);
         errorStatus = Collections.synchronizedList(new ArrayList<>());
         results = Collections.synchronizedList(new ArrayList<>());
         leaderMap = new ConcurrentHashMap<>();
+        routeMap = new ConcurrentHashMap<>();
+        failedCodes = ConcurrentHashMap.newKeySet();
     }
 
     public RaftClosure newRaftClosure() {
@@ -94,6 +103,51 @@ class BatchGrpcClosure<V> {
         };
     }
 
+    /**
+     * When the partition is not local any more, the route known by this store is returned
+     * with the fault, so the client does not need to ask pd for it
+     *
+     * @param codes the key codes of the entries grouped into the partition
+     */
+    public RaftClosure newRaftClosure(int partitionId, Collection<Integer> codes,
+                                      IntFunction<PartitionRoute> router) {
+        return new GrpcClosure<V>() {
+            @Override
+            public void run(Status status) {
+                if (status.isOk()) {
+                    V result = this.getResult();
+                    if (result instanceof FeedbackRes &&
+                        ((FeedbackRes) result).getStatus().getCode() != ResCode.RES_CODE_OK) {
+                        // None of the entries is applied
+                        failedCodes.addAll(codes);
+                    }
+                    results.add(result);
+                } else {
+                    leaderMap.putAll(this.getLeaderMap());
+                    PartitionRoute route = router.apply(partitionId);
+                    if (route != null &&
+                        HgRaftError.forNumber(status.getCode()) == HgRaftError.NOT_LOCAL) {
+                        routeMap.put(partitionId, route);
+                    }
+                    failedCodes.addAll(codes);
+                    errorStatus.add(status);
+                }
+                countDownLatch.countDown();
+            }
+        };
+    }
+
+    /**
+     * The key codes of the entries in the failed partitions, so the client knows the entries
+     * applied, empty if any partition is not finished in time
+     */
+    private List<Integer> getFailedCodes() {
+        if (countDownLatch.getCount() > 0) {
+            return Collections.emptyList();
+        }
+        return new ArrayList<>(failedCodes);
+    }
+
     /**
      * Not using counter latch
      *
@@ -125,7 +179,8 @@ class BatchGrpcClosure<V> {
                                                                   .setPartitionId(k)
                                                                   .setLeaderId(v).build());
             });
-            errorResponse = partitionFault.build();
+            errorResponse = partitionFault.addAllPartitionRoutes(routeMap.values())
+                                          .addAllFailedCodes(getFailedCodes()).build();
         } else {
             PartitionFaultType faultType = PartitionFaultType.PARTITION_FAULT_TYPE_UNKNOWN;
             switch (HgRaftError.forNumber(errorStatus.get(0).getCode())) {
@@ -141,7 +196,10 @@ class BatchGrpcClosure<V> {
                 default:
                     log.error("Unmatchable errorStatus: " + errorStatus);
             }
-            errorResponse = PartitionFaultResponse.newBuilder().setFaultType(faultType).build();
+            errorResponse = PartitionFaultResponse.newBuilder().setFaultType(faultType)
+                                                  .addAllPartitionRoutes(routeMap.values())
+                                                  .addAllFailedCodes(getFailedCodes())
+                                                  .build();
         }
         return errorResponse;
     }
@@ -210,4 +268,19 @@ class BatchGrpcClosure<V> {
         }
 
     }
+
+    /**
+     * Select the error like selectError, with the key codes of all the failed partitions
+     */
+    public FeedbackRes selectBatchError(List<FeedbackRes> results) {
+        FeedbackRes res = selectError(results);
+        List<Integer> failedCodes = getFailedCodes();
+        if (res.getStatus().getCode() == ResCode.RES_CODE_OK || failedCodes.isEmpty()) {
+            return res;
+        }
+        return res.toBuilder()
+                  .setPartitionFaultResponse(res.getPartitionFaultResponse().toBuilder()
+                                                .addAllFailedCodes(failedCodes))
+                  .build();
+    }
 }
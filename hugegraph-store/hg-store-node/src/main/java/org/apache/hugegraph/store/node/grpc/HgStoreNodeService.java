@@ -102,6 +102,11 @@ public class HgStoreNodeService implements RaftTaskHandler {
                 setMaxReplicatorInflightMsgs(appConfig.getRaft().getMaxReplicatorInflightMsgs());
                 setMaxEntriesSize(appConfig.getRaft().getMaxEntriesSize());
                 setMaxBodySize(appConfig.getRaft().getMaxBodySize());
+                setSnapshotDownloadingThreads(appConfig.getRaft()
+                                                       .getSnapshotDownloadingThreads());
+                setSnapshotDownloadingBytesPerSec(appConfig.getRaft()
+                                                           .getSnapshotDownloadingBytesPerSec());
+                setBatchApply(appConfig.getRaft().isBatchApply());
             }});
             setFakePdOptions(new FakePdOptions() {{
                 setStoreList(appConfig.getFakePdConfig().getStoreList());
@@ -122,6 +127,9 @@ public class HgStoreNodeService implements RaftTaskHandler {
         RaftRocksdbOptions.initRocksdbGlobalConfig(options.getRocksdbConfig());
 
         options.getLabels().put("rest.port", Integer.toString(appConfig.getRestPort()));
+        if (appConfig.getRaft().isLearner()) {
+            options.getLabels().put("replica-role", "learner");
+        }
         log.info("HgStoreEngine init {}", options);
         options.setTaskHandler(this);
         options.setDataTransfer(new DataManagerImpl());
@@ -228,6 +236,14 @@ public class HgStoreNodeService implements RaftTaskHandler {
         return true;
     }
 
+    /**
+     * Only batch writes are merged and applied together, the others change tables or graphs
+     */
+    @Override
+    public boolean isBatchable(byte methodId) {
+        return methodId == HgStoreNodeService.BATCH_OP;
+    }
+
     @PreDestroy
     public void destroy() {
         storeEngine.shutdown();
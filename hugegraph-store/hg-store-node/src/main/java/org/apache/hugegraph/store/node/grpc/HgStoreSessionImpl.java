@@ -17,15 +17,20 @@
 
 package org.apache.hugegraph.store.node.grpc;
 
+import java.util.ArrayList;
 import java.util.HashMap;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.Map;
 import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.Collectors;
 
+import org.apache.hugegraph.pd.common.KVPair;
 import org.apache.hugegraph.pd.common.PDException;
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.pd.grpc.Metapb.GraphMode;
+import org.apache.hugegraph.store.PartitionEngine;
+import org.apache.hugegraph.store.business.MigrationDelta;
 import org.apache.hugegraph.store.grpc.common.Key;
 import org.apache.hugegraph.store.grpc.common.Kv;
 import org.apache.hugegraph.store.grpc.common.ResCode;
@@ -40,6 +45,9 @@ import org.apache.hugegraph.store.grpc.session.GetReq;
 import org.apache.hugegraph.store.grpc.session.GraphReq;
 import org.apache.hugegraph.store.grpc.session.HgStoreSessionGrpc;
 import org.apache.hugegraph.store.grpc.session.KeyValueResponse;
+import org.apache.hugegraph.store.grpc.session.PartitionFaultResponse;
+import org.apache.hugegraph.store.grpc.session.PartitionFaultType;
+import org.apache.hugegraph.store.grpc.session.PartitionRoute;
 import org.apache.hugegraph.store.grpc.session.TableReq;
 import org.apache.hugegraph.store.grpc.session.ValueResponse;
 import org.apache.hugegraph.store.meta.Graph;
@@ -300,13 +308,18 @@ public class HgStoreSessionImpl extends HgStoreSessionGrpc.HgStoreSessionImplBas
                                                                   .addAllEntry(
                                                                           entries))
                                              .build(),
-                                     closure.newRaftClosure());
+                                     closure.newRaftClosure(
+                                             partition,
+                                             entries.stream()
+                                                    .map(e -> e.getStartKey().getCode())
+                                                    .collect(Collectors.toSet()),
+                                             id -> getPartitionRoute(graph, id)));
         });
 
         if (!graph.isEmpty()) {
             log.debug(" batch: waiting raft...");
             // Wait for the return result
-            closure.waitFinish(observer, r -> closure.selectError(r),
+            closure.waitFinish(observer, r -> closure.selectBatchError(r),
                                appConfig.getRaft().getRpcTimeOut());
             log.debug(" batch: ended waiting");
         } else {
@@ -325,6 +338,33 @@ public class HgStoreSessionImpl extends HgStoreSessionGrpc.HgStoreSessionImplBas
         FeedbackRes.Builder builder = FeedbackRes.newBuilder();
         List<BatchEntry> entries = request.getWriteReq().getEntryList();
         try {
+            PartitionEngine engine = storeService.getStoreEngine().getPartitionEngine(partId);
+            if (engine != null && entries.stream().anyMatch(
+                    e -> engine.isWriteFenced(graph, e.getStartKey().getCode()))) {
+                // The range was handed off by a split or migration, the route is stale,
+                // hand the new routes back so that the client can retry with them
+                builder.setStatus(HgGrpc.fail("partition " + partId +
+                                              " is fenced, key code moved"));
+                if (response != null) {
+                    PartitionFaultType faultType = PartitionFaultType.PARTITION_FAULT_TYPE_KEY_MOVED;
+                    builder.setPartitionFaultResponse(
+                            PartitionFaultResponse.newBuilder()
+                                                  .setFaultType(faultType)
+                                                  .addAllPartitionRoutes(
+                                                          getMovedRoutes(engine, graph, entries)));
+                }
+                GrpcClosure.setResult(response, builder.build());
+                return;
+            }
+            if (engine != null && !entries.isEmpty()) {
+                // A split handoff must not be ingested over the writes, see HandoffManager
+                engine.getHandoffManager().markWritten(graph);
+                // A migration copies the writes after its export once it fences them
+                MigrationDelta delta = engine.getMigrationDelta(graph);
+                if (delta != null) {
+                    delta.record(entries);
+                }
+            }
             getWrapper().doBatch(graph, partId, entries);
             builder.setStatus(HgGrpc.success());
         } catch (Throwable t) {
@@ -335,6 +375,56 @@ public class HgStoreSessionImpl extends HgStoreSessionGrpc.HgStoreSessionImplBas
         GrpcClosure.setResult(response, builder.build());
     }
 
+    private List<PartitionRoute> getMovedRoutes(PartitionEngine engine, String graph,
+                                                List<BatchEntry> entries) {
+        Map<Integer, PartitionRoute> routes = new HashMap<>();
+        entries.stream()
+               .map(e -> e.getStartKey().getCode())
+               .filter(code -> engine.isWriteFenced(graph, code))
+               .distinct()
+               .forEach(code -> {
+                   try {
+                       PartitionRoute route =
+                               toRoute(getPD().getPDClient().getPartitionByCode(graph, code));
+                       if (route != null) {
+                           routes.putIfAbsent(route.getPartitionId(), route);
+                       }
+                   } catch (PDException e) {
+                       log.warn("Failed to get route of {}-{}", graph, code, e);
+                   }
+               });
+        return new ArrayList<>(routes.values());
+    }
+
+    /**
+     * Route of the partition known by this store, null if it is unknown
+     */
+    private PartitionRoute getPartitionRoute(String graph, int partId) {
+        try {
+            return toRoute(getPD().getPDClient().getPartitionById(graph, partId));
+        } catch (PDException e) {
+            log.warn("Failed to get route of {}-{}", graph, partId, e);
+            return null;
+        }
+    }
+
+    private static PartitionRoute toRoute(KVPair<Metapb.Partition, Metapb.Shard> pair) {
+        if (pair == null || pair.getKey() == null) {
+            return null;
+        }
+        Metapb.Partition partition = pair.getKey();
+        PartitionRoute.Builder route = PartitionRoute.newBuilder()
+                                                     .setPartitionId(partition.getId())
+                                                     .setStartKey(partition.getStartKey())
+                                                     .setEndKey(partition.getEndKey())
+                                                     .setVersion(partition.getVersion())
+                                                     .setState(partition.getStateValue());
+        if (pair.getValue() != null) {
+            route.setLeaderId(pair.getValue().getStoreId());
+        }
+        return route.build();
+    }
+
     // private static HgBusinessHandler.Batch toBatch(BatchEntry entry) {
     //    return new HgBusinessHandler.Batch() {
     //        @Override
@@ -49,6 +49,7 @@ import lombok.extern.slf4j.Slf4j;
 public class ParallelScanIterator implements ScanIterator {
 
     private static final int waitDataMaxTryTimes = 600;
+    private static final int MAX_PREFETCH = 8;
     protected static int maxBodySize =
             PropertyUtil.getInt("app.scan.stream.body.size", 1024 * 1024);
     private final int batchSize = PropertyUtil.getInt("app.scan.stream.entries.size", 20000);
@@ -64,7 +65,9 @@ public class ParallelScanIterator implements ScanIterator {
     private final boolean orderVertex;
     private final boolean orderEdge;
     private int maxWorkThreads = Utils.cpus() / 8;
-    private int maxInQueue = maxWorkThreads * 2;
+    private volatile int maxInQueue = maxWorkThreads * 2;
+    // the bytes of a batch, adjusted by the consumer of the iterator
+    private volatile int bodySize = maxBodySize;
     private volatile boolean finished;
     private List<KV> current = null;
 
@@ -86,8 +89,8 @@ public class ParallelScanIterator implements ScanIterator {
                     Math.max(1, Math.min(query.getConditionCount() / 16, maxWorkThreads));
         }
         this.maxInQueue = maxWorkThreads * 2;
-        // Edge sorted requires a larger queue
-        queue = new LinkedBlockingQueue<>(maxInQueue * 2);
+        // Edge sorted requires a larger queue, and leave room to prefetch ahead of the consumer
+        queue = new LinkedBlockingQueue<>(Math.max(maxInQueue * 2, MAX_PREFETCH));
         createScanner();
     }
 
@@ -138,12 +141,30 @@ public class ParallelScanIterator implements ScanIterator {
     public List<KV> next() {
         List<KV> t = current;
         current = null;
-        if (queue.size() < maxWorkThreads) {
+        if (queue.size() < maxInQueue) {
             wakeUpScanner();
         }
         return t;
     }
 
+    /**
+     * Size the following batches, in bytes, no larger than app.scan.stream.body.size
+     */
+    public void setBodySize(int bodySize) {
+        this.bodySize = Math.max(1, Math.min(bodySize, maxBodySize));
+    }
+
+    /**
+     * Number of batches read from RocksDB ahead of the consumer
+     */
+    public void setPrefetch(int batches) {
+        int capacity = this.queue.size() + this.queue.remainingCapacity();
+        this.maxInQueue = Math.max(maxWorkThreads, Math.min(batches, capacity - 1));
+        if (this.queue.size() < this.maxInQueue) {
+            wakeUpScanner();
+        }
+    }
+
     @Override
     public void close() {
         finished = true;
@@ -328,13 +349,14 @@ public class ParallelScanIterator implements ScanIterator {
             iteratorLock.lock();
             try {
                 long entriesSize = 0, bodySize = 0;
+                int bodyLimit = ParallelScanIterator.this.bodySize;
                 while (canNext && !closed) {
                     iterator = this.getIterator();
                     if (iterator == null) {
                         break;
                     }
                     while (iterator.hasNext() && entriesSize < batchSize &&
-                           bodySize < maxBodySize &&
+                           bodySize < bodyLimit &&
                            counter < limit && !closed) {
                         KV kv = KV.of(iterator.next());
                         dataList.add(orderVertex ? kv.setNo(query.getSerialNo()) : kv);
@@ -342,8 +364,8 @@ public class ParallelScanIterator implements ScanIterator {
                         entriesSize++;
                         counter++;
                     }
-                    if ((entriesSize >= batchSize || bodySize >= maxBodySize) ||
-                        (orderEdge && bodySize >= maxBodySize / 2)) {
+                    if ((entriesSize >= batchSize || bodySize >= bodyLimit) ||
+                        (orderEdge && bodySize >= bodyLimit / 2)) {
                         if (orderEdge) {
                             // Sort the edges, ensure all edges of one point are consecutive,
                             // prevent other points from inserting.
@@ -354,6 +376,7 @@ public class ParallelScanIterator implements ScanIterator {
                         dataList = new ArrayList<>(batchSize);
                         dataList.ensureCapacity(batchSize);
                         entriesSize = bodySize = 0;
+                        bodyLimit = ParallelScanIterator.this.bodySize;
                     }
                 }
                 if (!dataList.isEmpty()) {
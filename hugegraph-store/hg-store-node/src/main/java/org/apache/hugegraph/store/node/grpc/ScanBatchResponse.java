@@ -24,7 +24,6 @@ import java.util.concurrent.ThreadPoolExecutor;
 import java.util.concurrent.locks.Lock;
 import java.util.concurrent.locks.ReentrantLock;
 
-import org.apache.hugegraph.rocksdb.access.ScanIterator;
 import org.apache.hugegraph.store.buffer.ByteBufferAllocator;
 import org.apache.hugegraph.store.buffer.KVByteBuffer;
 import org.apache.hugegraph.store.grpc.stream.KvStream;
@@ -33,6 +32,7 @@ import org.apache.hugegraph.store.grpc.stream.ScanStreamBatchReq;
 import org.apache.hugegraph.store.node.util.HgGrpc;
 import org.apache.hugegraph.store.node.util.PropertyUtil;
 
+import io.grpc.stub.ServerCallStreamObserver;
 import io.grpc.stub.StreamObserver;
 import lombok.extern.slf4j.Slf4j;
 
@@ -42,24 +42,36 @@ import lombok.extern.slf4j.Slf4j;
  * 2. The client returns the batch number to the server after consuming each batch of data.
  * 3. The server decides how much data to send based on the batch number, ensuring the
  * uninterrupted transmission of data,
+ * 4. Batches are packed into pooled buffers instead of a new array per batch. This is not
+ * zero-copy, the rocksdb keys and values are copied into the buffer, and protobuf copies
+ * it again when the message is serialized. The buffer returns to the pool once serialized,
+ * and sending pauses until the transport is ready again, so the number of buffers held by
+ * the transport stays bounded.
+ * 5. The batch size in bytes, the number of batches in flight and the prefetch depth of the
+ * iterator follow the consumer throughput, see {@link ScanFlowControl}.
  */
 @Slf4j
 public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
 
-    static ByteBufferAllocator bfAllocator =
-            new ByteBufferAllocator(ParallelScanIterator.maxBodySize * 3 / 2, 1000);
+    // the pool is bounded by bytes, a buffer is 1.5 times of the body size
     static ByteBufferAllocator alloc =
-            new ByteBufferAllocator(ParallelScanIterator.maxBodySize * 3 / 2, 1000);
+            new ByteBufferAllocator(ParallelScanIterator.maxBodySize * 3 / 2,
+                                    PropertyUtil.getInt("app.scan.stream.buffer.mb", 512) *
+                                    1024L * 1024L,
+                                    PropertyUtil.getBoolean("app.scan.stream.direct", true));
     private final int maxInFlightCount = PropertyUtil.getInt("app.scan.stream.inflight", 16);
     private final StreamObserver<KvStream> sender;
+    // null when the transport does not expose its readiness
+    private final ServerCallStreamObserver<KvStream> callObserver;
     // unit: second
     private final int activeTimeout = PropertyUtil.getInt("app.scan.stream.timeout", 60);
     private final HgStoreWrapperEx wrapper;
     private final ThreadPoolExecutor executor;
     private final Object stateLock = new Object();
     private final Lock iteratorLock = new ReentrantLock();
+    private final ScanFlowControl flow;
     // Currently traversing iterator
-    private ScanIterator iterator;
+    private ParallelScanIterator iterator;
     // Next send sequence number
     private volatile int seqNo;
     // Client consumed sequence number
@@ -82,6 +94,13 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
         this.seqNo = 1;
         this.state = State.IDLE;
         this.activeTime = System.currentTimeMillis();
+        this.flow = new ScanFlowControl(ParallelScanIterator.maxBodySize, maxInFlightCount);
+        if (response instanceof ServerCallStreamObserver) {
+            this.callObserver = (ServerCallStreamObserver<KvStream>) response;
+            this.callObserver.setOnReadyHandler(this::trySendEntries);
+        } else {
+            this.callObserver = null;
+        }
     }
 
     /**
@@ -100,13 +119,16 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
                 break;
             case RECEIPT_REQUEST:   // Message asynchronous response
                 this.clientSeqNo = request.getReceiptRequest().getTimes();
-                if (seqNo - clientSeqNo < maxInFlightCount) {
+                adjustFlow();
+                if (flow.hasCredit(seqNo - clientSeqNo)) {
                     synchronized (stateLock) {
                         if (state == State.IDLE) {
-                            state = State.DOING;
-                            executor.execute(() -> {
-                                sendEntries();
-                            });
+                            if (isSenderReady()) {
+                                state = State.DOING;
+                                executor.execute(() -> {
+                                    sendEntries();
+                                });
+                            }
                         } else if (state == State.DONE) {
                             sendNoDataEntries();
                         }
@@ -158,6 +180,7 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
      */
     private void closeQuery() {
         setStateDone();
+        flow.close();
         try {
             closeIter();
             this.sender.onCompleted();
@@ -195,14 +218,15 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
             }
             KvStream.Builder dataBuilder = KvStream.newBuilder().setVersion(1);
             while (state != State.DONE && iterator.hasNext()
-                   && (seqNo - clientSeqNo < maxInFlightCount)
-                   && this.count < limit) {
+                   && flow.hasCredit(seqNo - clientSeqNo)
+                   && this.count < limit && isSenderReady()) {
                 KVByteBuffer buffer = new KVByteBuffer(alloc.get());
                 List<ParallelScanIterator.KV> dataList = iterator.next();
                 dataList.forEach(kv -> {
                     kv.write(buffer);
                     this.count++;
                 });
+                flow.onSent(seqNo, buffer.position());
                 dataBuilder.setStream(buffer.flip().getBuffer());
                 dataBuilder.setSeqNo(seqNo++);
                 dataBuilder.complete(e -> alloc.release(buffer.getBuffer()));
@@ -215,6 +239,8 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
                 setStateDone();
             } else {
                 setStateIdle();
+                // The transport may have turned ready before the state went back to idle
+                trySendEntries();
             }
         } catch (Throwable e) {
             if (this.state != State.DONE) {
@@ -233,6 +259,34 @@ public class ScanBatchResponse implements StreamObserver<ScanStreamBatchReq> {
         }
     }
 
+    /**
+     * Resume sending when the client window and the transport both have room.
+     */
+    private void trySendEntries() {
+        if (iterator == null || !flow.hasCredit(seqNo - clientSeqNo) || !isSenderReady()) {
+            return;
+        }
+        synchronized (stateLock) {
+            if (state == State.IDLE) {
+                state = State.DOING;
+                executor.execute(this::sendEntries);
+            }
+        }
+    }
+
+    private void adjustFlow() {
+        flow.onReceipt(clientSeqNo);
+        ParallelScanIterator iter = this.iterator;
+        if (iter != null) {
+            iter.setBodySize(flow.batchBytes());
+            iter.setPrefetch(flow.credits());
+        }
+    }
+
+    private boolean isSenderReady() {
+        return callObserver == null || callObserver.isReady();
+    }
+
     private void sendNoDataEntries() {
         try {
             this.sender.onNext(KvStream.newBuilder().setOver(true).build());
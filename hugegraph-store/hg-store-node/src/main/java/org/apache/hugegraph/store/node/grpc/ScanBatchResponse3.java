@@ -194,7 +194,7 @@ public class ScanBatchResponse3 {
         }
     }
 
-    private static class OrderDeliverer {
+    static class OrderDeliverer {
 
         private final StreamObserver<KvPageRes> responseObserver;
         private final AtomicBoolean finishFlag = new AtomicBoolean();
@@ -248,7 +248,7 @@ public class ScanBatchResponse3 {
     }
 
     /*** Worker ***/
-    private static class OrderWorker {
+    static class OrderWorker {
 
         private final ScanIterator iterator;
         private final OrderDeliverer deliverer;
@@ -260,6 +260,7 @@ public class ScanBatchResponse3 {
         private final AtomicInteger receiptTimes = new AtomicInteger();
         private final AtomicInteger curTimes = new AtomicInteger();
         private final ThreadPoolExecutor executor;
+        private final ScanFlowControl flow;
         private final long limit;
         private long packageSize;
         private long counter;
@@ -271,6 +272,7 @@ public class ScanBatchResponse3 {
             this.iterator = iterator;
             this.deliverer = deliverer;
             this.executor = executor;
+            this.flow = new ScanFlowControl(ParallelScanIterator.maxBodySize, MAX_NOT_RECEIPT);
 
             if (this.packageSize <= 0) {
                 this.packageSize = DEFAULT_PACKAGE_SIZE;
@@ -303,11 +305,12 @@ public class ScanBatchResponse3 {
 
         void setReceipt(int times) {
             this.receiptTimes.set(times);
+            this.flow.onReceipt(times);
             this.continueWorking();
         }
 
         boolean checkContinue() {
-            return (this.curTimes.get() - this.receiptTimes.get() < MAX_NOT_RECEIPT);
+            return this.flow.hasCredit(this.curTimes.get() - this.receiptTimes.get());
         }
 
         void continueWorking() {
@@ -325,6 +328,15 @@ public class ScanBatchResponse3 {
             }
         }
 
+        /**
+         * Deliver a package, the last one is sent and counted in the metrics as well
+         */
+        private void deliver(KvPageRes.Builder dataBuilder, long packageBytes, boolean isOver) {
+            int times = this.curTimes.incrementAndGet();
+            this.flow.onSent(times, packageBytes);
+            this.deliverer.deliver(dataBuilder, times, isOver);
+        }
+
         private void working() {
             if (this.isWorking.getAndSet(true)) {
                 return;
@@ -337,6 +349,7 @@ public class ScanBatchResponse3 {
                     KvPageRes.Builder dataBuilder = KvPageRes.newBuilder();
                     Kv.Builder kvBuilder = Kv.newBuilder();
                     long packageCount = 0;
+                    long packageBytes = 0;
 
                     while (iterator.hasNext()) {
                         if (++this.counter > limit) {
@@ -344,13 +357,13 @@ public class ScanBatchResponse3 {
                             break;
                         }
 
-                        if (++packageCount > packageSize) {
+                        if (++packageCount > packageSize || packageBytes >= flow.batchBytes()) {
 
                             if (this.breakdown.get()) {
                                 break;
                             }
 
-                            deliverer.deliver(dataBuilder, curTimes.incrementAndGet(), false);
+                            this.deliver(dataBuilder, packageBytes, false);
                             Thread.yield();
 
                             if (!this.checkContinue()) {
@@ -375,10 +388,12 @@ public class ScanBatchResponse3 {
                             }
 
                             packageCount = 1;
+                            packageBytes = 0;
                             dataBuilder = KvPageRes.newBuilder();
                         }
 
                         RocksDBSession.BackendColumn col = iterator.next();
+                        packageBytes += col.name.length + col.value.length;
 
                         dataBuilder.addData(kvBuilder
                                                     .setKey(ByteString.copyFrom(col.name))
@@ -392,7 +407,7 @@ public class ScanBatchResponse3 {
 
                     this.completeFlag.set(true);
 
-                    deliverer.deliver(dataBuilder, curTimes.incrementAndGet(), true);
+                    this.deliver(dataBuilder, packageBytes, true);
 
                 }
 
@@ -410,6 +425,7 @@ public class ScanBatchResponse3 {
             } finally {
                 this.workingLock.unlock();
                 this.iterator.close();
+                this.flow.close();
             }
         }
 
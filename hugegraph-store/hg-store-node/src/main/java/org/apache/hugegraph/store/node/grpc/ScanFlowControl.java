@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.grpc;
+
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+import org.apache.hugegraph.store.node.metrics.ScanStreamMetrics;
+import org.apache.hugegraph.store.node.util.PropertyUtil;
+
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Credit based flow control of a scan stream.
+ * Each batch sent and not yet acknowledged by a client receipt holds one credit. The consumer
+ * throughput is measured from the acknowledged bytes, the batch size in bytes and the number
+ * of credits follow it, so that about {@code app.scan.stream.latency} milliseconds of data is
+ * in flight: slow consumers do not pile up batches on the node, fast consumers are not starved
+ * by a small window.
+ */
+@Slf4j
+public class ScanFlowControl {
+
+    private static final int MIN_BATCH_BYTES =
+            PropertyUtil.getInt("app.scan.stream.body.min", 64 * 1024);
+    // unit: millisecond
+    private static final int TARGET_LATENCY =
+            PropertyUtil.getInt("app.scan.stream.latency", 200);
+    private static final int MIN_CREDITS = 2;
+    // weight of the latest sample in the throughput moving average
+    private static final double ALPHA = 0.3;
+
+    private final int maxBatchBytes;
+    private final int maxCredits;
+    private final long startTime;
+    private final AtomicBoolean closed = new AtomicBoolean();
+    // seq no and size of the batches not yet acknowledged
+    private final Deque<long[]> unacked = new ArrayDeque<>();
+    private long lastReceiptTime;
+    private long sentBytes;
+    private long sentBatches;
+    // bytes per second
+    private volatile double throughput;
+    private volatile int batchBytes;
+    private volatile int credits;
+
+    public ScanFlowControl(int maxBatchBytes, int maxCredits) {
+        this.maxBatchBytes = Math.max(maxBatchBytes, 1);
+        this.maxCredits = Math.max(maxCredits, MIN_CREDITS);
+        this.batchBytes = this.maxBatchBytes;
+        this.credits = this.maxCredits;
+        this.startTime = System.nanoTime();
+        this.lastReceiptTime = this.startTime;
+        ScanStreamMetrics.streamOpened();
+    }
+
+    public boolean hasCredit(int inFlight) {
+        return inFlight < this.credits;
+    }
+
+    public int batchBytes() {
+        return this.batchBytes;
+    }
+
+    public int credits() {
+        return this.credits;
+    }
+
+    public double throughput() {
+        return this.throughput;
+    }
+
+    public synchronized void onSent(int seqNo, long bytes) {
+        this.unacked.addLast(new long[]{seqNo, bytes});
+        this.sentBytes += bytes;
+        this.sentBatches++;
+        ScanStreamMetrics.batchSent(bytes);
+    }
+
+    /**
+     * The client has consumed all batches up to seqNo
+     */
+    public synchronized void onReceipt(int seqNo) {
+        long acked = 0;
+        while (!this.unacked.isEmpty() && this.unacked.peekFirst()[0] <= seqNo) {
+            acked += this.unacked.pollFirst()[1];
+        }
+        long now = System.nanoTime();
+        long elapsed = now - this.lastReceiptTime;
+        if (acked <= 0 || elapsed <= 0) {
+            return;
+        }
+        this.lastReceiptTime = now;
+
+        double rate = acked * 1e9 / elapsed;
+        this.throughput = this.throughput == 0 ? rate :
+                          ALPHA * rate + (1 - ALPHA) * this.throughput;
+        // The bytes the consumer drains within the target latency, split into batches so
+        // that the next one is already on the wire while the client handles the current one.
+        double window = this.throughput * TARGET_LATENCY / 1000;
+        this.batchBytes = (int) Math.max(Math.min(window / MIN_CREDITS, this.maxBatchBytes),
+                                         Math.min(MIN_BATCH_BYTES, this.maxBatchBytes));
+        this.credits = (int) Math.max(Math.min(Math.ceil(window / this.batchBytes),
+                                               this.maxCredits), MIN_CREDITS);
+    }
+
+    public void close() {
+        if (this.closed.getAndSet(true)) {
+            return;
+        }
+        long sent;
+        long batches;
+        synchronized (this) {
+            sent = this.sentBytes;
+            batches = this.sentBatches;
+        }
+        double seconds = (System.nanoTime() - this.startTime) / 1e9;
+        double rate = seconds > 0 ? sent / seconds : 0;
+        ScanStreamMetrics.streamClosed(rate);
+        if (log.isDebugEnabled()) {
+            log.debug("scan stream closed, sent {} bytes in {} batches, {} bytes/s, " +
+                      "consumer {} bytes/s", sent, batches, (long) rate, (long) this.throughput);
+        }
+    }
+}
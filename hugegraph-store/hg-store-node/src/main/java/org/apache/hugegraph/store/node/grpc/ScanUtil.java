@@ -151,8 +151,9 @@ class ScanUtil {
     /**
      * Support for multi-iterators with parallel reading
      */
-    static ScanIterator getParallelIterator(String graph, ScanQueryRequest request,
-                                            HgStoreWrapperEx wrapper, ThreadPoolExecutor executor) {
+    static ParallelScanIterator getParallelIterator(String graph, ScanQueryRequest request,
+                                                    HgStoreWrapperEx wrapper,
+                                                    ThreadPoolExecutor executor) {
         ScanIteratorSupplier supplier = new ScanIteratorSupplier(graph, request, wrapper);
         return ParallelScanIterator.of(supplier, supplier.getLimitSupplier(),
                                        request, executor);
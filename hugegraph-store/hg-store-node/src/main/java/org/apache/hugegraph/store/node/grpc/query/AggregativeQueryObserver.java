@@ -54,9 +54,13 @@ import lombok.extern.slf4j.Slf4j;
 public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
 
     private static final int RESULT_COUNT = 16;
+    // Only one page in flight when the client pulls pages lazily
+    private static final int PAGED_RESULT_COUNT = 2;
+    private static final int EXECUTE_BATCH_SIZE = 1024;
     private final ExecutorService threadPool;
     private final long timeout;
-    private final int batchSize;
+    private int batchSize;
+    private int resultCount = RESULT_COUNT;
     private final AtomicInteger consumeCount = new AtomicInteger(0);
     private final AtomicInteger sendCount = new AtomicInteger(0);
     private final AtomicBoolean clientCanceled = new AtomicBoolean(false);
@@ -85,6 +89,10 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
         // the first request, start the sending thread
         if (iterator == null) {
             long current = System.nanoTime();
+            if (request.getBatchSize() > 0) {
+                this.batchSize = Math.min(this.batchSize, request.getBatchSize());
+                this.resultCount = PAGED_RESULT_COUNT;
+            }
             iterator = QueryUtil.getIterator(request);
             plan = QueryUtil.buildPlan(request);
             threadPool.submit(this::sendData);
@@ -93,6 +101,7 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
         } else {
             this.consumeCount.incrementAndGet();
             log.debug("query id: {}, send feedback of {}", queryId, this.consumeCount.get());
+            this.notifySender();
         }
     }
 
@@ -100,6 +109,7 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
     public void onError(Throwable t) {
         // Stop calculating when channel got error
         this.clientCanceled.set(true);
+        this.notifySender();
         log.error("AggregativeQueryService, query id: {},  got error", this.queryId, t);
     }
 
@@ -107,6 +117,13 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
     public void onCompleted() {
         // client my be cancelled earlier
         this.clientCanceled.set(true);
+        this.notifySender();
+    }
+
+    private void notifySender() {
+        synchronized (this.consumeCount) {
+            this.consumeCount.notifyAll();
+        }
     }
 
     public void sendData() {
@@ -117,7 +134,7 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
 
             while (!this.clientCanceled.get()) {
                 // produces more result than consumer, just waiting
-                if (sendCount.get() - consumeCount.get() >= RESULT_COUNT) {
+                if (sendCount.get() - consumeCount.get() >= this.resultCount) {
                     // read timeout, takes long time not to read data
                     if (System.currentTimeMillis() - lastSend > timeout) {
                         this.sender.onNext(errorResponse(getBuilder(), queryId,
@@ -128,7 +145,13 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
                     }
 
                     try {
-                        Thread.sleep(1000);
+                        // Woken up by the feedback of client
+                        synchronized (this.consumeCount) {
+                            if (sendCount.get() - consumeCount.get() >= this.resultCount &&
+                                !this.clientCanceled.get()) {
+                                this.consumeCount.wait(1000);
+                            }
+                        }
                         continue;
                     } catch (InterruptedException ignore) {
                         log.warn("send data is interrupted, {}", ignore.getMessage());
@@ -320,10 +343,18 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
     private void execute(ScanIterator itr) {
         long recordCount = 0;
         long current = System.nanoTime();
+        PipelineResult[] batch = new PipelineResult[EXECUTE_BATCH_SIZE];
         while (itr.hasNext() && !this.clientCanceled.get()) {
             try {
-                recordCount++;
-                executePipeline(itr.next());
+                int size = 0;
+                while (size < batch.length && itr.hasNext()) {
+                    PipelineResult input = toPipelineResult(itr.next());
+                    if (input != null) {
+                        batch[size++] = input;
+                    }
+                }
+                recordCount += size;
+                plan.executeBatch(batch, size);
                 if (System.nanoTime() - current > timeout * 1_000_000) {
                     throw new RuntimeException("execution timeout");
                 }
@@ -337,18 +368,22 @@ public class AggregativeQueryObserver implements StreamObserver<QueryRequest> {
     }
 
     private Object executePipeline(Object obj) throws EarlyStopException {
-        PipelineResult input;
-        if (obj instanceof RocksDBSession.BackendColumn) {
-            input = new PipelineResult((RocksDBSession.BackendColumn) obj);
-        } else if (obj instanceof BaseElement) {
-            input = new PipelineResult((BaseElement) obj);
-        } else {
+        PipelineResult input = toPipelineResult(obj);
+        if (input == null) {
             return null;
         }
-
         return plan.execute(input);
     }
 
+    private static PipelineResult toPipelineResult(Object obj) {
+        if (obj instanceof RocksDBSession.BackendColumn) {
+            return new PipelineResult((RocksDBSession.BackendColumn) obj);
+        } else if (obj instanceof BaseElement) {
+            return new PipelineResult((BaseElement) obj);
+        }
+        return null;
+    }
+
     private QueryResponse.Builder getBuilder() {
         return QueryResponse.newBuilder();
         // return localBuilder.get().clear();
@@ -22,10 +22,14 @@ import java.util.List;
 import java.util.concurrent.ThreadPoolExecutor;
 import java.util.concurrent.atomic.AtomicLong;
 
+import javax.annotation.PreDestroy;
+
 import org.apache.hugegraph.rocksdb.access.RocksDBSession;
 import org.apache.hugegraph.store.HgStoreEngine;
 import org.apache.hugegraph.store.consts.PoolNames;
 import org.apache.hugegraph.store.grpc.common.Kv;
+import org.apache.hugegraph.store.grpc.query.KHopRequest;
+import org.apache.hugegraph.store.grpc.query.KHopResponse;
 import org.apache.hugegraph.store.grpc.query.QueryRequest;
 import org.apache.hugegraph.store.grpc.query.QueryResponse;
 import org.apache.hugegraph.store.grpc.query.QueryServiceGrpc;
@@ -148,4 +152,37 @@ public class AggregativeQueryService extends QueryServiceGrpc.QueryServiceImplBa
         }
         observer.onCompleted();
     }
+
+    /**
+     * Expand the neighbors of the source vertices within depth hops
+     *
+     * @param request  k-hop request object
+     * @param observer Observer object for receiving the vertices or their count
+     */
+    @Override
+    public void khop(KHopRequest request, StreamObserver<KHopResponse> observer) {
+        log.debug("query id : {}, khop of {} sources, depth: {}", request.getQueryId(),
+                  request.getSourcesCount(), request.getDepth());
+        KHopResponse response;
+        try {
+            long start = System.currentTimeMillis();
+            response = new KHopExpander(request, new QueryUtil().getHandler()).execute();
+            log.debug("query id: {}, khop of cost: {} ms", request.getQueryId(),
+                      System.currentTimeMillis() - start);
+        } catch (Exception e) {
+            log.error("query id: {}, khop failed", request.getQueryId(), e);
+            response = KHopResponse.newBuilder()
+                                   .setQueryId(request.getQueryId())
+                                   .setIsOk(false)
+                                   .setMessage(e.getMessage() == null ? "" : e.getMessage())
+                                   .build();
+        }
+        observer.onNext(response);
+        observer.onCompleted();
+    }
+
+    @PreDestroy
+    public void destroy() {
+        KHopExpander.shutdownChannels();
+    }
 }
@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.grpc.query;
+
+import static org.apache.hugegraph.store.constant.HugeServerTables.IN_EDGE_TABLE;
+import static org.apache.hugegraph.store.constant.HugeServerTables.OUT_EDGE_TABLE;
+
+import java.nio.ByteBuffer;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashSet;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.TimeUnit;
+
+import org.apache.hugegraph.id.Id;
+import org.apache.hugegraph.pd.client.PDClient;
+import org.apache.hugegraph.pd.common.KVPair;
+import org.apache.hugegraph.pd.common.PDException;
+import org.apache.hugegraph.pd.common.PartitionUtils;
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.serializer.BytesBuffer;
+import org.apache.hugegraph.store.HgStoreEngine;
+import org.apache.hugegraph.store.PartitionEngine;
+import org.apache.hugegraph.store.business.BusinessHandler;
+import org.apache.hugegraph.store.grpc.query.KHopDirection;
+import org.apache.hugegraph.store.grpc.query.KHopRequest;
+import org.apache.hugegraph.store.grpc.query.KHopResponse;
+import org.apache.hugegraph.store.grpc.query.QueryServiceGrpc;
+
+import com.google.protobuf.ByteString;
+
+import io.grpc.ManagedChannel;
+import io.grpc.ManagedChannelBuilder;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Multi-hop neighbor expansion on store nodes.
+ * The frontier of each hop is grouped by the partition owning the vertex: the vertices of
+ * leader partitions on this node are expanded by prefix scans of the edge tables, the others
+ * are forwarded to the node leading their partition with a one hop local_only request. Only
+ * the final vertices, or their count, return to the caller.
+ * Vertices reached in a former hop are not expanded again, as kout with nearest and kneighbor.
+ * Like the degree, the limit bounds each hop: a hop stops expanding once it reaches as many new
+ * vertices as the result could still take.
+ */
+@Slf4j
+public class KHopExpander {
+
+    private static final long FORWARD_TIMEOUT = 60;
+    private static final Map<String, ManagedChannel> channels = new ConcurrentHashMap<>();
+
+    private final KHopRequest request;
+    private final String graph;
+    private final BusinessHandler handler;
+    private final HgStoreEngine engine;
+    private final Set<Id> labels = new HashSet<>();
+    private final long degree;
+    private final long limit;
+
+    public KHopExpander(KHopRequest request, BusinessHandler handler) {
+        this.request = request;
+        this.graph = request.getGraph();
+        this.handler = handler;
+        this.engine = HgStoreEngine.getInstance();
+        this.degree = request.getDegree() <= 0 ? Long.MAX_VALUE : request.getDegree();
+        this.limit = request.getLimit() <= 0 ? Long.MAX_VALUE : request.getLimit();
+        for (ByteString label : request.getLabelsList()) {
+            this.labels.add(BytesBuffer.wrap(label.toByteArray()).readId());
+        }
+    }
+
+    /**
+     * Close the channels to other store nodes, called when the store node stops
+     */
+    public static void shutdownChannels() {
+        for (ManagedChannel channel : channels.values()) {
+            channel.shutdownNow();
+        }
+        channels.clear();
+    }
+
+    public KHopResponse execute() throws PDException {
+        Set<ByteBuffer> frontier = new LinkedHashSet<>();
+        for (ByteString source : this.request.getSourcesList()) {
+            frontier.add(ByteBuffer.wrap(source.toByteArray()));
+        }
+
+        if (this.request.getLocalOnly()) {
+            /*
+             * The sender routed the vertices by its view of the leaders, expanding them on a
+             * follower could miss the edges not applied yet, so let the sender fail and retry
+             */
+            for (ByteBuffer vertex : frontier) {
+                if (!this.isLocalLeader(vertex)) {
+                    throw new IllegalStateException(String.format(
+                            "The partition of vertex %s isn't led by this store, graph: %s",
+                            BytesBuffer.wrap(vertex.array()).readId(), this.graph));
+                }
+            }
+            return this.response(this.expandLocal(frontier, Collections.emptySet(),
+                                                  this.limit));
+        }
+
+        Set<ByteBuffer> visited = new HashSet<>(frontier);
+        Set<ByteBuffer> result = new LinkedHashSet<>();
+        int depth = Math.max(this.request.getDepth(), 1);
+        for (int i = 0; i < depth && !frontier.isEmpty(); i++) {
+            long budget = this.request.getAllLayers() ? this.limit - result.size() : this.limit;
+            Set<ByteBuffer> next = this.expand(frontier, visited, budget);
+            visited.addAll(next);
+            frontier = next;
+            if (this.request.getAllLayers()) {
+                result.addAll(next);
+                if (result.size() >= this.limit) {
+                    break;
+                }
+            }
+        }
+        return this.response(this.request.getAllLayers() ? result : frontier);
+    }
+
+    private KHopResponse response(Set<ByteBuffer> vertices) {
+        KHopResponse.Builder builder = KHopResponse.newBuilder()
+                                                   .setQueryId(this.request.getQueryId())
+                                                   .setIsOk(true);
+        long count = Math.min(vertices.size(), this.limit);
+        builder.setCount(count);
+        if (!this.request.getCountOnly()) {
+            for (ByteBuffer vertex : vertices) {
+                if (builder.getVerticesCount() >= count) {
+                    break;
+                }
+                builder.addVertices(ByteString.copyFrom(vertex.array()));
+            }
+        }
+        return builder.build();
+    }
+
+    /**
+     * Expand one hop to at most budget vertices not visited, forwarding the vertices led by
+     * other nodes
+     */
+    private Set<ByteBuffer> expand(Set<ByteBuffer> frontier, Set<ByteBuffer> visited,
+                                   long budget) throws PDException {
+        Set<ByteBuffer> local = new LinkedHashSet<>();
+        Map<Long, Set<ByteBuffer>> remote = new HashMap<>();
+        for (ByteBuffer vertex : frontier) {
+            if (this.isLocalLeader(vertex)) {
+                local.add(vertex);
+                continue;
+            }
+            KVPair<Metapb.Partition, Metapb.Shard> partition =
+                    this.pdClient().getPartitionByCode(this.graph, code(vertex));
+            remote.computeIfAbsent(partition.getValue().getStoreId(),
+                                   k -> new LinkedHashSet<>()).add(vertex);
+        }
+
+        Set<ByteBuffer> next = this.expandLocal(local, visited, budget);
+        for (Map.Entry<Long, Set<ByteBuffer>> e : remote.entrySet()) {
+            if (next.size() >= budget) {
+                break;
+            }
+            String address = this.pdClient().getStore(e.getKey()).getAddress();
+            /*
+             * The other node doesn't know the visited vertices, those it returns count
+             * against its limit, so the hop may end with a bit less than the budget
+             */
+            addNext(next, this.forward(address, e.getValue(), budget - next.size()),
+                    visited, budget);
+        }
+        return next;
+    }
+
+    private PDClient pdClient() {
+        return this.engine.getPdProvider().getPDClient();
+    }
+
+    protected boolean isLocalLeader(ByteBuffer vertex) throws PDException {
+        KVPair<Metapb.Partition, Metapb.Shard> partition =
+                this.pdClient().getPartitionByCode(this.graph, code(vertex));
+        PartitionEngine partitionEngine =
+                this.engine.getPartitionEngine(partition.getKey().getId());
+        return partitionEngine != null && partitionEngine.isLeader();
+    }
+
+    private Collection<ByteBuffer> forward(String address, Set<ByteBuffer> vertices,
+                                           long limit) {
+        KHopRequest.Builder builder = this.request.toBuilder()
+                                                  .clearSources()
+                                                  .setDepth(1)
+                                                  .setLimit(limit == Long.MAX_VALUE ? 0 : limit)
+                                                  .setAllLayers(false)
+                                                  .setCountOnly(false)
+                                                  .setLocalOnly(true);
+        for (ByteBuffer vertex : vertices) {
+            builder.addSources(ByteString.copyFrom(vertex.array()));
+        }
+        ManagedChannel channel = channels.computeIfAbsent(
+                address, k -> ManagedChannelBuilder.forTarget(k).usePlaintext().build());
+        KHopResponse response = QueryServiceGrpc.newBlockingStub(channel)
+                                                .withDeadlineAfter(FORWARD_TIMEOUT,
+                                                                   TimeUnit.SECONDS)
+                                                .khop(builder.build());
+        if (!response.getIsOk()) {
+            throw new IllegalStateException(String.format(
+                    "Failed to expand %s vertices on store %s: %s", vertices.size(), address,
+                    response.getMessage()));
+        }
+        Set<ByteBuffer> next = new LinkedHashSet<>(response.getVerticesCount());
+        for (ByteString vertex : response.getVerticesList()) {
+            next.add(ByteBuffer.wrap(vertex.toByteArray()));
+        }
+        return next;
+    }
+
+    private Set<ByteBuffer> expandLocal(Set<ByteBuffer> vertices, Set<ByteBuffer> visited,
+                                        long budget) {
+        Set<ByteBuffer> next = new LinkedHashSet<>();
+        KHopDirection direction = this.request.getDirection();
+        for (ByteBuffer vertex : vertices) {
+            if (next.size() >= budget) {
+                break;
+            }
+            int code = code(vertex);
+            if (direction != KHopDirection.KHOP_IN) {
+                this.scanEdges(OUT_EDGE_TABLE, code, vertex.array(), visited, next, budget);
+            }
+            if (direction != KHopDirection.KHOP_OUT) {
+                this.scanEdges(IN_EDGE_TABLE, code, vertex.array(), visited, next, budget);
+            }
+        }
+        return next;
+    }
+
+    private void scanEdges(String table, int code, byte[] ownerId, Set<ByteBuffer> visited,
+                           Set<ByteBuffer> next, long budget) {
+        long count = 0;
+        try (ScanIterator iterator = this.scanPrefix(table, code, ownerId)) {
+            while (count < this.degree && next.size() < budget && iterator.hasNext()) {
+                RocksDBSession.BackendColumn column = iterator.next();
+                // owner-vertex + dir + edge-label + sub-label + sort-values + other-vertex
+                BytesBuffer buffer = BytesBuffer.wrap(column.name);
+                buffer.readId();
+                buffer.read();
+                Id label = buffer.readId();
+                Id subLabel = buffer.readId();
+                if (!this.labels.isEmpty() && !this.labels.contains(label) &&
+                    !this.labels.contains(subLabel)) {
+                    continue;
+                }
+                buffer.readStringWithEnding();
+                Id other = buffer.readId();
+                ByteBuffer vertex = ByteBuffer.wrap(BytesBuffer.allocate(1 + other.length())
+                                                               .writeId(other).bytes());
+                if (!visited.contains(vertex)) {
+                    next.add(vertex);
+                }
+                // The degree caps the edges of a vertex, visited or not
+                count++;
+            }
+        }
+    }
+
+    protected ScanIterator scanPrefix(String table, int code, byte[] ownerId) {
+        return this.handler.scanPrefix(this.graph, code, table, ownerId);
+    }
+
+    private static void addNext(Set<ByteBuffer> next, Collection<ByteBuffer> vertices,
+                                Set<ByteBuffer> visited, long budget) {
+        for (ByteBuffer vertex : vertices) {
+            if (next.size() >= budget) {
+                break;
+            }
+            if (!visited.contains(vertex)) {
+                next.add(vertex);
+            }
+        }
+    }
+
+    private static int code(ByteBuffer vertex) {
+        Id id = BytesBuffer.wrap(vertex.array()).readId();
+        return PartitionUtils.calcHashcode(id.asBytes());
+    }
+}
@@ -36,6 +36,28 @@ public interface QueryStage {
         return null;
     }
 
+    /**
+     * Handle a chunk of results in place, the kept results are moved to the
+     * head of the chunk. By default it calls handle() for each row, stages
+     * override it to hoist per-chunk work out of the row loop. Only called on
+     * the stages which are not iterator.
+     *
+     * @param batch the input results
+     * @param size  the count of valid results in batch
+     * @return the count of kept results
+     * @throws EarlyStopException when reach the limit of limit stage
+     */
+    default int handleBatch(PipelineResult[] batch, int size) throws EarlyStopException {
+        int kept = 0;
+        for (int i = 0; i < size; i++) {
+            PipelineResult ret = handle(batch[i]);
+            if (ret != null) {
+                batch[kept++] = ret;
+            }
+        }
+        return kept;
+    }
+
     default boolean isIterator() {
         return false;
     }
@@ -71,6 +71,14 @@ public class QueryUtil {
     private static final Set<String> vertexTables =
             new HashSet<>(List.of(VERTEX_TABLE, OLAP_TABLE, TASK_TABLE));
 
+    /**
+     * The max count of elements/groups kept in memory by sort and aggregation stages
+     */
+    private static int memoryLimitCount() {
+        return HgStoreEngine.getInstance().getOption().getQueryPushDownOption()
+                            .getMemoryLimitCount();
+    }
+
     /**
      * Requires semantic and sequential relationships
      *
@@ -148,7 +156,7 @@ public class QueryUtil {
             for (var func : request.getFunctionsList()) {
                 funcMetas.add(new Tuple2<>(func.getFuncType(), func.getType()));
             }
-            agg.init(funcMetas);
+            agg.init(funcMetas, memoryLimitCount());
             plan.addStage(agg);
         }
 
@@ -168,7 +176,7 @@ public class QueryUtil {
                 var order = QueryStages.ofOrderByStage();
                 order.init(request.getOrderByList(), request.getGroupByList(),
                            !isEmpty(request.getFunctionsList()),
-                           request.getSortOrder());
+                           request.getSortOrder(), memoryLimitCount());
                 plan.addStage(order);
             }
 
@@ -220,7 +228,8 @@ public class QueryUtil {
 
         switch (request.getScanType()) {
             case TABLE_SCAN:
-                return handler.scanAll(request.getGraph(), request.getTable());
+                return handler.scanAll(request.getGraph(), request.getTable(),
+                                       request.getReadLearner());
 
             case PRIMARY_SCAN:
                 // id scan
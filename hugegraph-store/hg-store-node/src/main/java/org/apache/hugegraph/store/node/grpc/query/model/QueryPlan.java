@@ -19,7 +19,6 @@ package org.apache.hugegraph.store.node.grpc.query.model;
 
 import java.util.ArrayList;
 import java.util.Iterator;
-import java.util.LinkedList;
 import java.util.List;
 import java.util.stream.Collectors;
 
@@ -31,7 +30,7 @@ public class QueryPlan {
     private final List<QueryStage> stages;
 
     public QueryPlan() {
-        stages = new LinkedList<>();
+        stages = new ArrayList<>();
     }
 
     public void addStage(QueryStage pipeline) {
@@ -63,13 +62,51 @@ public class QueryPlan {
         if (data == null || this.stages.isEmpty()) {
             return data;
         }
+        return this.execute(data, 0);
+    }
+
+    /**
+     * execute pipeline chunk by chunk, the leading plain stages are dispatched once per
+     * chunk of rows instead of once per row, then the left rows are passed to the first
+     * iterator stage one by one. The rows are still PipelineResult objects, this is not
+     * columnar execution. Only used when the plan has iterator stage, the plain results
+     * are dropped.
+     *
+     * @param batch the input data, will be modified by stages
+     * @param size  the count of valid data in batch
+     * @throws EarlyStopException throws early stop exception when reach the limit of limit stage
+     */
+    public void executeBatch(PipelineResult[] batch, int size) throws EarlyStopException {
+        int index = 0;
+        for (; index < this.stages.size() && size > 0; index++) {
+            QueryStage stage = this.stages.get(index);
+            if (stage.isIterator()) {
+                break;
+            }
+            size = stage.handleBatch(batch, size);
+        }
+
+        if (index == this.stages.size()) {
+            return;
+        }
+
+        QueryStage stage = this.stages.get(index);
+        for (int i = 0; i < size; i++) {
+            Iterator<PipelineResult> ret = stage.handleIterator(batch[i]);
+            // Aggregative stages only output results when meet the last empty element
+            if (ret != null && index + 1 < this.stages.size()) {
+                this.execute(ret, index + 1);
+            }
+        }
+    }
 
+    private Object execute(Object data, int from) throws EarlyStopException {
         List<Object> current = new ArrayList<>();
         List<Object> next = new ArrayList<>();
 
         next.add(data);
 
-        for (QueryStage stage : stages) {
+        for (QueryStage stage : stages.subList(from, stages.size())) {
             current.clear();
             current.addAll(next);
             next.clear();
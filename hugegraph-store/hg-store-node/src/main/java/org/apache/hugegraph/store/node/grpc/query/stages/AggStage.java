@@ -17,18 +17,17 @@
 
 package org.apache.hugegraph.store.node.grpc.query.stages;
 
-import java.io.File;
-import java.io.FileOutputStream;
 import java.io.IOException;
-import java.io.ObjectOutputStream;
 import java.util.ArrayList;
 import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
+import java.util.NoSuchElementException;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.locks.ReadWriteLock;
+import java.util.concurrent.locks.ReentrantReadWriteLock;
 import java.util.stream.Collectors;
 
-import org.apache.hugegraph.store.business.itrv2.FileObjectIterator;
 import org.apache.hugegraph.store.business.itrv2.TypeTransIterator;
 import org.apache.hugegraph.store.business.itrv2.io.SortShuffleSerializer;
 import org.apache.hugegraph.store.grpc.query.AggregationType;
@@ -43,7 +42,8 @@ import org.apache.hugegraph.store.util.MultiKv;
 import org.apache.hugegraph.store.util.SortShuffle;
 
 /**
- * Aggregation calculation
+ * Aggregation calculation, the partial results are spilled to sorted files when the
+ * count of groups exceeds the memory limit, and merged by group while reading
  */
 public class AggStage implements QueryStage {
 
@@ -51,13 +51,19 @@ public class AggStage implements QueryStage {
 
     private final Map<List<Object>, List<AggregationFunction>> maps = new ConcurrentHashMap<>();
 
+    // Iterating functions shares the lock, spilling the groups holds it exclusively
+    private final ReadWriteLock spillLock = new ReentrantReadWriteLock();
+
     private List<Tuple2<AggregationType, String>> funcMetas = new ArrayList<>();
 
     private Integer functionSize;
 
-    private String file;
+    // The field class of avg functions, null for other functions
+    private Class[] avgFieldTypes;
+
+    private int memoryLimit = MAP_SIZE;
 
-    private String path;
+    private SortShuffle<MultiKv> spill;
 
     @Override
     public boolean isIterator() {
@@ -67,14 +73,24 @@ public class AggStage implements QueryStage {
     /**
      * Initialization method for initializing aggregation function metadata list and path.
      *
-     * @param objects parameter array, the first parameter is the list of aggregation function metadata.
+     * @param objects parameter array, the first parameter is the list of aggregation function
+     *                metadata, the optional second one is the max count of groups in memory.
      */
     @Override
     public void init(Object... objects) {
         this.funcMetas = (List<Tuple2<AggregationType, String>>) objects[0];
         functionSize = funcMetas.size();
-        path = SortShuffle.getBasePath() + "agg_tmp_" + Thread.currentThread().getId() + "/";
-        new File(path).mkdirs();
+        avgFieldTypes = new Class[functionSize];
+        List<AggregationFunction> functions = generateFunctions();
+        for (int i = 0; i < functionSize; i++) {
+            if (functions.get(i) instanceof AggregationFunctions.AvgFunction) {
+                avgFieldTypes[i] = ((AggregationFunctions.AvgFunction) functions.get(i))
+                        .getFiledClassType();
+            }
+        }
+        if (objects.length > 1 && (int) objects[1] > 0) {
+            this.memoryLimit = (int) objects[1];
+        }
     }
 
     /**
@@ -87,42 +103,51 @@ public class AggStage implements QueryStage {
     public Iterator<PipelineResult> handleIterator(PipelineResult result) {
         if (result.getResultType() == PipelineResultType.MKV) {
             var kv = result.getKv();
-            if (!maps.containsKey(kv.getKeys())) {
-                maps.putIfAbsent(kv.getKeys(), generateFunctions());
-            }
-
-            for (int i = 0; i < functionSize; i++) {
-                var function = maps.get(kv.getKeys()).get(i);
-                Object value = kv.getValues().get(i);
-                if (function instanceof AggregationFunctions.AvgFunction) {
-                    var avgFunction = (AggregationFunctions.AvgFunction) function;
-                    value = transValue(avgFunction.getFiledClassType(), value);
+            this.spillLock.readLock().lock();
+            try {
+                // Look up the group only once for all the functions
+                var functions = maps.computeIfAbsent(kv.getKeys(), k -> generateFunctions());
+                var values = kv.getValues();
+                for (int i = 0; i < functionSize; i++) {
+                    Object value = values.get(i);
+                    if (avgFieldTypes[i] != null) {
+                        value = transValue(avgFieldTypes[i], value);
+                    }
+                    functions.get(i).iterate(value);
                 }
-                function.iterate(value);
+            } finally {
+                this.spillLock.readLock().unlock();
             }
         }
 
-        if (maps.size() > MAP_SIZE) {
-            // write to local buffer
-            synchronized (this.maps) {
-                if (maps.size() > MAP_SIZE) {
-                    writeToFile(changeToList());
+        if (maps.size() > this.memoryLimit) {
+            this.spillLock.writeLock().lock();
+            try {
+                if (maps.size() > this.memoryLimit) {
+                    spillToFile();
                 }
+            } finally {
+                this.spillLock.writeLock().unlock();
             }
         }
 
         if (result.isEmpty()) {
-            var list = changeToList();
-            if (this.file == null) {
+            if (this.spill == null) {
+                var list = changeToList();
                 return new TypeTransIterator<>(list.iterator(), PipelineResult::new,
                                                () -> PipelineResult.EMPTY).toIterator();
             } else {
-                writeToFile(list);
-                return new TypeTransIterator<>(
-                        new FileObjectIterator<>(this.file,
-                                                 SortShuffleSerializer.ofBackendColumnSerializer()),
-                        PipelineResult::new, () -> PipelineResult.EMPTY
-                ).toIterator();
+                Iterator<MultiKv> spilled;
+                try {
+                    spillToFile();
+                    this.spill.finish();
+                    spilled = this.spill.getSortedIterator();
+                } catch (IOException e) {
+                    throw new RuntimeException("Failed to read spilled aggregation", e);
+                }
+                return new TypeTransIterator<>(new GroupMergeIterator(spilled),
+                                               PipelineResult::new,
+                                               () -> PipelineResult.EMPTY).toIterator();
             }
         }
 
@@ -188,25 +213,94 @@ public class AggStage implements QueryStage {
         return result;
     }
 
-    private void writeToFile(List<MultiKv> list) {
-        if (this.file == null) {
-            file = path + System.currentTimeMillis() % 10000 + ".dat";
+    /**
+     * Move the partial results of all groups in memory to the sort shuffle, which
+     * writes them to a sorted file when its memory limit is reached
+     */
+    private void spillToFile() {
+        if (this.spill == null) {
+            this.spill = new SortShuffle<>(MultiKv::compareTo,
+                                           SortShuffleSerializer.ofMultiKvSerializer(),
+                                           this.memoryLimit);
         }
 
         try {
-            ObjectOutputStream oos = new ObjectOutputStream(new FileOutputStream(this.file, true));
-            for (var item : list) {
-                oos.writeObject(item);
+            for (var entry : this.maps.entrySet()) {
+                this.spill.append(new MultiKv(entry.getKey(), getBuffers(entry.getValue())));
             }
             this.maps.clear();
         } catch (IOException e) {
-            throw new RuntimeException(e);
+            throw new RuntimeException("Failed to spill aggregation", e);
+        }
+    }
+
+    private static List<Object> getBuffers(List<AggregationFunction> functions) {
+        List<Object> buffers = new ArrayList<>(functions.size());
+        for (var function : functions) {
+            buffers.add(function.getBuffer());
         }
+        return buffers;
     }
 
     @Override
     public void close() {
         this.maps.clear();
         this.funcMetas.clear();
+        if (this.spill != null) {
+            this.spill.close();
+        }
+    }
+
+    /**
+     * Merge the adjacent partial results of the same group from the sorted spill files
+     */
+    private class GroupMergeIterator implements Iterator<MultiKv> {
+
+        private final Iterator<MultiKv> iterator;
+        private MultiKv pending;
+
+        public GroupMergeIterator(Iterator<MultiKv> iterator) {
+            this.iterator = iterator;
+            this.pending = iterator.hasNext() ? iterator.next() : null;
+        }
+
+        @Override
+        public boolean hasNext() {
+            return this.pending != null;
+        }
+
+        @Override
+        public MultiKv next() {
+            if (this.pending == null) {
+                throw new NoSuchElementException();
+            }
+
+            MultiKv current = this.pending;
+            this.pending = null;
+            List<AggregationFunction> functions = null;
+            while (this.iterator.hasNext()) {
+                MultiKv kv = this.iterator.next();
+                if (!current.getKeys().equals(kv.getKeys())) {
+                    this.pending = kv;
+                    break;
+                }
+                if (functions == null) {
+                    functions = generateFunctions();
+                    mergeBuffers(functions, current.getValues());
+                }
+                mergeBuffers(functions, kv.getValues());
+            }
+
+            if (functions == null) {
+                return current;
+            }
+            return new MultiKv(current.getKeys(), getBuffers(functions));
+        }
+
+        private void mergeBuffers(List<AggregationFunction> functions, List<Object> buffers) {
+            for (int i = 0; i < functionSize; i++) {
+                functions.get(i).merge(buffers.get(i));
+            }
+        }
     }
 }
@@ -17,8 +17,8 @@
 
 package org.apache.hugegraph.store.node.grpc.query.stages;
 
+import java.util.ArrayList;
 import java.util.List;
-import java.util.stream.Collectors;
 
 import org.apache.hugegraph.id.Id;
 import org.apache.hugegraph.store.node.grpc.query.QueryStage;
@@ -81,9 +81,11 @@ public class ExtractAggFieldStage implements QueryStage {
     }
 
     private List<Object> getFields(List<Id> ids, BaseElement element) {
-        return ids.stream()
-                  .map(id -> id == null ? null : element.getPropertyValue(id))
-                  .collect(Collectors.toList());
+        List<Object> values = new ArrayList<>(ids.size());
+        for (Id id : ids) {
+            values.add(id == null ? null : element.getPropertyValue(id));
+        }
+        return values;
     }
 
     private List<Object> getSchemaId(BaseElement element) {
@@ -20,6 +20,7 @@ package org.apache.hugegraph.store.node.grpc.query.stages;
 import org.apache.hugegraph.query.ConditionQuery;
 import org.apache.hugegraph.store.node.grpc.query.QueryStage;
 import org.apache.hugegraph.store.node.grpc.query.model.PipelineResult;
+import org.apache.hugegraph.structure.BaseElement;
 
 /**
  * Filter
@@ -28,9 +29,13 @@ public class FilterStage implements QueryStage {
 
     private ConditionQuery conditionQUery;
 
+    private boolean testElement;
+
     @Override
     public void init(Object... objects) {
         this.conditionQUery = ConditionQuery.fromBytes((byte[]) objects[0]);
+        this.testElement = conditionQUery.resultType().isVertex() ||
+                           conditionQUery.resultType().isEdge();
     }
 
     @Override
@@ -43,14 +48,35 @@ public class FilterStage implements QueryStage {
             return null;
         }
 
-        if (conditionQUery.resultType().isVertex() || conditionQUery.resultType().isEdge()) {
-            if (!conditionQUery.test(result.getElement())) {
-                return null;
-            }
+        if (this.testElement && !conditionQUery.test(result.getElement())) {
+            return null;
         }
         return result;
     }
 
+    /**
+     * Keep the matched elements at the head of batch, compacting it in place
+     */
+    @Override
+    public int handleBatch(PipelineResult[] batch, int size) {
+        int kept = 0;
+        for (int i = 0; i < size; i++) {
+            PipelineResult result = batch[i];
+            if (result == null) {
+                continue;
+            }
+            if (!result.isEmpty()) {
+                BaseElement element = result.getElement();
+                if (element == null ||
+                    this.testElement && !conditionQUery.test(element)) {
+                    continue;
+                }
+            }
+            batch[kept++] = result;
+        }
+        return kept;
+    }
+
     @Override
     public String getName() {
         return "FILTER_STAGE";
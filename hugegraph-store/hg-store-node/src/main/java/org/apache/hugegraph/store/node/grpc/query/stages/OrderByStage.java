@@ -57,24 +57,29 @@ public class OrderByStage implements QueryStage {
         var orderBys = QueryUtil.fromStringBytes((List<ByteString>) objects[0]);
         var groupBys = QueryUtil.fromStringBytes((List<ByteString>) objects[1]);
         this.isAsc = (boolean) objects[3];
+        // Spill to file when exceeding the memory limit, use the default limit if absent
+        int memoryLimit = objects.length > 4 ? (int) objects[4] : 0;
 
         // agg
         if ((Boolean) objects[2]) {
             if (orderBys == null) {
                 sortShuffle = new SortShuffle<>(MultiKv::compareTo,
-                                                SortShuffleSerializer.ofMultiKvSerializer());
+                                                SortShuffleSerializer.ofMultiKvSerializer(),
+                                                memoryLimit);
             } else {
                 List<Integer> orders = new ArrayList<>();
                 for (Id id : orderBys) {
                     orders.add(groupBys.indexOf(id));
                 }
                 sortShuffle = new SortShuffle<>(new MultiKeyComparator(orders),
-                                                SortShuffleSerializer.ofMultiKvSerializer());
+                                                SortShuffleSerializer.ofMultiKvSerializer(),
+                                                memoryLimit);
             }
             resultType = PipelineResultType.MKV;
         } else {
             sortShuffle = new SortShuffle<>(new BaseElementComparator(orderBys, this.isAsc),
-                                            SortShuffleSerializer.ofBaseElementSerializer());
+                                            SortShuffleSerializer.ofBaseElementSerializer(),
+                                            memoryLimit);
             resultType = PipelineResultType.HG_ELEMENT;
         }
 
@@ -105,7 +110,7 @@ public class OrderByStage implements QueryStage {
             // last empty flag
             try {
                 sortShuffle.finish();
-                iterator = sortShuffle.getIterator();
+                iterator = sortShuffle.getSortedIterator();
             } catch (Exception e) {
                 log.error("GROUP_BY_STAGE:", e);
             }
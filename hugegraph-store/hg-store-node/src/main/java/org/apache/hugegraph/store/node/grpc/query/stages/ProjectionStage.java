@@ -22,10 +22,16 @@ import java.util.List;
 import java.util.Set;
 
 import org.apache.hugegraph.id.Id;
+import org.apache.hugegraph.id.IdGenerator;
 import org.apache.hugegraph.store.node.grpc.query.QueryStage;
 import org.apache.hugegraph.store.node.grpc.query.QueryUtil;
 import org.apache.hugegraph.store.node.grpc.query.model.PipelineResult;
 import org.apache.hugegraph.store.node.grpc.query.model.PipelineResultType;
+import org.apache.hugegraph.structure.BaseElement;
+import org.apache.hugegraph.structure.BaseProperty;
+import org.eclipse.collections.api.map.primitive.MutableIntObjectMap;
+import org.eclipse.collections.impl.list.mutable.primitive.IntArrayList;
+import org.eclipse.collections.impl.set.mutable.primitive.IntHashSet;
 
 import com.google.protobuf.ByteString;
 
@@ -36,12 +42,22 @@ public class ProjectionStage implements QueryStage {
 
     private Set<Id> propertySet;
 
+    // The kept property ids as the keys of the element properties
+    private IntHashSet propertyKeys;
+
     private boolean removeAllProperty;
 
     @Override
     public void init(Object... objects) {
         this.propertySet = new HashSet<>(QueryUtil.fromStringBytes((List<ByteString>) objects[0]));
         this.removeAllProperty = (Boolean) objects[1];
+        this.propertyKeys = new IntHashSet();
+        for (Id id : this.propertySet) {
+            // The properties of elements are keyed by the long ids
+            if (id instanceof IdGenerator.LongId) {
+                this.propertyKeys.add(BaseElement.intFromId(id));
+            }
+        }
     }
 
     @Override
@@ -51,12 +67,7 @@ public class ProjectionStage implements QueryStage {
         }
 
         if (result.getResultType() == PipelineResultType.HG_ELEMENT) {
-            var element = result.getElement();
-            for (var id : element.getProperties().entrySet()) {
-                if (!this.propertySet.contains(id.getKey()) || this.removeAllProperty) {
-                    element.removeProperty(id.getKey());
-                }
-            }
+            prune(result.getElement(), new IntArrayList());
             return result;
         } else if (result.getResultType() == PipelineResultType.BACKEND_COLUMN &&
                    this.removeAllProperty) {
@@ -66,6 +77,51 @@ public class ProjectionStage implements QueryStage {
         return result;
     }
 
+    /**
+     * Prune the whole batch in one pass, sharing the buffer of the removed keys
+     */
+    @Override
+    public int handleBatch(PipelineResult[] batch, int size) {
+        IntArrayList removed = new IntArrayList();
+        int kept = 0;
+        for (int i = 0; i < size; i++) {
+            PipelineResult result = batch[i];
+            if (result == null) {
+                continue;
+            }
+            if (result.getResultType() == PipelineResultType.HG_ELEMENT) {
+                prune(result.getElement(), removed);
+            } else if (result.getResultType() == PipelineResultType.BACKEND_COLUMN &&
+                       this.removeAllProperty) {
+                result.getColumn().value = new byte[0];
+            }
+            batch[kept++] = result;
+        }
+        return kept;
+    }
+
+    /**
+     * Remove the properties not projected on the int keys, without building the id map
+     * of the element
+     */
+    private void prune(BaseElement element, IntArrayList removed) {
+        MutableIntObjectMap<BaseProperty<?>> properties = element.properties();
+        if (properties.isEmpty()) {
+            return;
+        }
+        if (this.removeAllProperty) {
+            properties.clear();
+            return;
+        }
+        removed.clear();
+        properties.forEachKey(key -> {
+            if (!this.propertyKeys.contains(key)) {
+                removed.add(key);
+            }
+        });
+        removed.forEach(properties::removeKey);
+    }
+
     @Override
     public String getName() {
         return "PROJECTION_STAGE";
@@ -74,5 +130,6 @@ public class ProjectionStage implements QueryStage {
     @Override
     public void close() {
         this.propertySet.clear();
+        this.propertyKeys.clear();
     }
 }
@@ -41,7 +41,6 @@ public class TopStage implements QueryStage {
 
     private int limit;
 
-    // todo: check concurrency
     @Override
     public void init(Object... objects) {
         this.limit = (int) objects[0];
@@ -86,14 +85,14 @@ public class TopStage implements QueryStage {
         }
 
         if (result.getResultType() == PipelineResultType.HG_ELEMENT) {
-            if (this.queue.size() < this.limit) {
-                this.queue.add(result.getElement());
-            } else {
-                var top = this.queue.peek();
-                var element = result.getElement();
-                if (this.comparator.compare(element, top) > 0) {
+            var element = result.getElement();
+            // Partitions are handled in parallel, check and replace the top atomically
+            synchronized (this.queue) {
+                if (this.queue.size() < this.limit) {
+                    this.queue.add(element);
+                } else if (this.comparator.compare(element, this.queue.peek()) > 0) {
                     this.queue.poll();
-                    this.queue.add(result.getElement());
+                    this.queue.add(element);
                 }
             }
         }
@@ -42,6 +42,7 @@ public class MetricsConfig {
             JRaftMetrics.init(registry);
             ProcfsMetrics.init(registry);
             GRpcExMetrics.init(registry);
+            ScanStreamMetrics.init(registry);
         };
     }
 
@@ -141,6 +141,18 @@ public class RocksDBMetrics {
                 );
             }
 
+            // Probes that passed the bloom filter but found nothing: the useless ones
+            saveGraphMeter(g,
+                           Gauge.builder(PREFIX + ".bloom.filter.false.positive",
+                                         () -> stats.getTickerCount(
+                                                 TickerType.BLOOM_FILTER_FULL_POSITIVE) -
+                                               stats.getTickerCount(
+                                                       TickerType.BLOOM_FILTER_FULL_TRUE_POSITIVE))
+                                .description("Bloom filter probes passed without the key existing")
+                                .tag("graph", g)
+                                .register(registry)
+            );
+
             for (final HistogramType histogram : HISTOGRAMS) {
                 registerHistogram(g, registry, histogram, stats);
             }
@@ -67,6 +67,8 @@ public final class RocksDBMetricsConst {
             TickerType.BLOCK_CACHE_BYTES_READ, // Bytes read from cache.
             TickerType.BLOCK_CACHE_BYTES_WRITE, // Bytes written to cache.
             TickerType.BLOOM_FILTER_USEFUL, // Bloom filter passes.
+            TickerType.BLOOM_FILTER_FULL_POSITIVE, // Full bloom filter did not reject the key.
+            TickerType.BLOOM_FILTER_FULL_TRUE_POSITIVE, // Full bloom filter positive and key exists.
             TickerType.PERSISTENT_CACHE_HIT, // Hits in persistent cache.
             TickerType.PERSISTENT_CACHE_MISS, // Misses in persistent cache.
             TickerType.SIM_BLOCK_CACHE_HIT, // Simulated block cache hits.
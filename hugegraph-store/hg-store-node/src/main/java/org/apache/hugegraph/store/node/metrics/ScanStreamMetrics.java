@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.metrics;
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+import io.micrometer.core.instrument.Counter;
+import io.micrometer.core.instrument.DistributionSummary;
+import io.micrometer.core.instrument.Gauge;
+import io.micrometer.core.instrument.MeterRegistry;
+
+/**
+ * Throughput of the scan streams served by this node
+ */
+public class ScanStreamMetrics {
+
+    public final static String PREFIX = "scan.stream";
+    private final static AtomicInteger activeStreams = new AtomicInteger();
+    private static MeterRegistry registry;
+    private static volatile Counter sentBytes;
+    private static volatile DistributionSummary batchBytes;
+    private static volatile DistributionSummary throughput;
+
+    private ScanStreamMetrics() {
+    }
+
+    public synchronized static void init(MeterRegistry meterRegistry) {
+        if (registry == null) {
+            registry = meterRegistry;
+            registerMeters();
+        }
+    }
+
+    private static void registerMeters() {
+        Gauge.builder(PREFIX + ".active", activeStreams, AtomicInteger::get)
+             .description("The number of open scan streams.")
+             .register(registry);
+
+        sentBytes = Counter.builder(PREFIX + ".sent")
+                           .description("The bytes sent by scan streams.")
+                           .baseUnit("bytes")
+                           .register(registry);
+
+        batchBytes = DistributionSummary.builder(PREFIX + ".batch.size")
+                                        .description("The size of the batches sent by scan " +
+                                                     "streams.")
+                                        .baseUnit("bytes")
+                                        .register(registry);
+
+        throughput = DistributionSummary.builder(PREFIX + ".throughput")
+                                        .description("The throughput of each closed scan " +
+                                                     "stream.")
+                                        .baseUnit("bytes/s")
+                                        .register(registry);
+    }
+
+    public static void streamOpened() {
+        activeStreams.incrementAndGet();
+    }
+
+    public static void batchSent(long bytes) {
+        if (sentBytes != null) {
+            sentBytes.increment(bytes);
+            batchBytes.record(bytes);
+        }
+    }
+
+    public static void streamClosed(double bytesPerSecond) {
+        activeStreams.decrementAndGet();
+        if (throughput != null) {
+            throughput.record(bytesPerSecond);
+        }
+    }
+}
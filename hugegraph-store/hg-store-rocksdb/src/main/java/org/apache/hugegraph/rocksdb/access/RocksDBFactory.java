@@ -19,6 +19,7 @@ package org.apache.hugegraph.rocksdb.access;
 
 import java.io.File;
 import java.util.ArrayList;
+import java.util.HashMap;
 import java.util.HashSet;
 import java.util.Iterator;
 import java.util.List;
@@ -114,6 +115,13 @@ public final class RocksDBFactory {
                 log.error("RocksDBFactory scheduledExecutor exception {}", e);
             }
         }, 60, 60, TimeUnit.SECONDS);
+        scheduledExecutor.scheduleWithFixedDelay(() -> {
+            try {
+                checkMemoryQuota();
+            } catch (Exception e) {
+                log.error("RocksDBFactory checkMemoryQuota exception {}", e);
+            }
+        }, 10, 10, TimeUnit.SECONDS);
     }
 
     public static RocksDBFactory getInstance() {
@@ -310,6 +318,47 @@ public final class RocksDBFactory {
         }
     }
 
+    /**
+     * Memtable usage of every graph db, all of them share the node block cache
+     */
+    public Map<String, Long> getMemTableUsage() {
+        Map<String, Long> usage = new HashMap<>();
+        for (String dbName : getGraphNames()) {
+            try (RocksDBSession session = this.queryGraphDB(dbName)) {
+                if (session != null) {
+                    usage.put(dbName, session.getMemTableUsage());
+                }
+            }
+        }
+        return usage;
+    }
+
+    /**
+     * Flush the graph dbs whose memtables exceed rocksdb.db_memory_quota, so that one
+     * busy db cannot take the write buffer of the whole node, it's checked every 10s
+     */
+    public void checkMemoryQuota() {
+        if (this.hugeConfig == null || this.closing.get()) {
+            return;
+        }
+        long quota = this.hugeConfig.get(RocksDBOptions.DB_MEMORY_QUOTA);
+        if (quota <= 0) {
+            return;
+        }
+        getMemTableUsage().forEach((dbName, usage) -> {
+            if (usage <= quota) {
+                return;
+            }
+            try (RocksDBSession session = this.queryGraphDB(dbName)) {
+                if (session != null) {
+                    log.info("db {} memtables {} exceed quota {}, flush it",
+                             dbName, usage, quota);
+                    session.flush(false);
+                }
+            }
+        });
+    }
+
     public void addRocksdbChangedListener(RocksdbChangedListener listener) {
         rocksdbChangedListeners.add(listener);
     }
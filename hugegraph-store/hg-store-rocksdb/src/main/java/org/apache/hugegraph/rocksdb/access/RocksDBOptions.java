@@ -23,8 +23,14 @@ import static org.apache.hugegraph.config.OptionChecker.inValues;
 import static org.apache.hugegraph.config.OptionChecker.rangeDouble;
 import static org.apache.hugegraph.config.OptionChecker.rangeInt;
 
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
 import org.apache.hugegraph.config.ConfigConvOption;
 import org.apache.hugegraph.config.ConfigListConvOption;
+import org.apache.hugegraph.config.ConfigListOption;
 import org.apache.hugegraph.config.ConfigOption;
 import org.apache.hugegraph.config.OptionHolder;
 import org.apache.hugegraph.util.Bytes;
@@ -56,6 +62,23 @@ public class RocksDBOptions extends OptionHolder {
                     disallowEmpty(),
                     false
             );
+    public static final ConfigOption<Boolean> WRITE_BUFFER_COST_TO_BLOCK_CACHE =
+            new ConfigOption<>(
+                    "rocksdb.write_buffer_cost_to_block_cache",
+                    "If set true, the memtables of all dbs are charged to the shared block " +
+                    "cache, so total_memory_size bounds memtables and blocks together.",
+                    disallowEmpty(),
+                    true
+            );
+    public static final ConfigOption<Long> DB_MEMORY_QUOTA =
+            new ConfigOption<>(
+                    "rocksdb.db_memory_quota",
+                    "The memtable memory quota of each db, a db exceeding it will be " +
+                    "flushed, 0 means no quota. A db holds one partition of all the " +
+                    "graphs, so the quota bounds a partition rather than a graph.",
+                    rangeInt(0L, Long.MAX_VALUE),
+                    0L
+            );
 
     //    public static final ConfigListOption<String> DATA_DISKS =
 //            new ConfigListOption<>(
@@ -395,7 +418,35 @@ public class RocksDBOptions extends OptionHolder {
                     disallowEmpty(),
                     false
             );
+    public static final ConfigListOption<String> BLOOM_FILTER_TABLES =
+            new ConfigListOption<>(
+                    "rocksdb.bloom_filter_tables",
+                    "The bits per key in bloom filter of specified tables, " +
+                    "the format of each element: `TABLE:BITS_PER_KEY`, " +
+                    "tables not listed use rocksdb.bloom_filter_bits_per_key.",
+                    null,
+                    "g+v:10", "g+oe:10", "g+ie:10"
+            );
+    public static final ConfigListOption<String> PREFIX_EXTRACTOR_TABLES =
+            new ConfigListOption<>(
+                    "rocksdb.prefix_extractor_tables",
+                    false,
+                    "The capped prefix extractor of specified tables, " +
+                    "the format of each element: `TABLE:PREFIX_LENGTH`, the length " +
+                    "includes the 2 bytes graph id ahead of every key, like [g+oe:11].",
+                    null,
+                    String.class,
+                    Collections.emptyList()
+            );
+    public static final ConfigOption<Double> MEMTABLE_PREFIX_BLOOM_RATIO =
+            new ConfigOption<>(
+                    "rocksdb.memtable_prefix_bloom_size_ratio",
+                    "The memtable prefix bloom size ratio of tables with a prefix extractor.",
+                    rangeDouble(0.0, 0.25),
+                    0.1
+            );
     public static final String BLOCK_TABLE_CONFIG = "rocksdb.block_table_config";
+    public static final String TABLE_CONFIGS = "rocksdb.table_configs";
     public static final String WRITE_BUFFER_MANAGER = "rocksdb.write_buffer_manager";
     public static final String BLOCK_CACHE = "rocksdb.block_cache";
     public static final String WRITE_CACHE = "rocksdb.write_cache";
@@ -406,6 +457,23 @@ public class RocksDBOptions extends OptionHolder {
         super();
     }
 
+    /**
+     * Parse elements like `TABLE:VALUE` into a map from table name to value
+     */
+    public static Map<String, Integer> tableValues(List<String> items) {
+        Map<String, Integer> values = new HashMap<>();
+        for (String item : items) {
+            int pos = item.lastIndexOf(':');
+            if (pos <= 0 || pos == item.length() - 1) {
+                throw new IllegalArgumentException(
+                        "Invalid table option '" + item + "', expect `TABLE:VALUE`");
+            }
+            values.put(item.substring(0, pos).trim(),
+                       Integer.parseInt(item.substring(pos + 1).trim()));
+        }
+        return values;
+    }
+
     public static synchronized RocksDBOptions instance() {
         if (instance == null) {
             instance = new RocksDBOptions();
@@ -24,8 +24,10 @@ import java.io.Serializable;
 import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
 import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
@@ -33,6 +35,8 @@ import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
+import java.util.function.IntFunction;
+import java.util.function.ToIntFunction;
 import java.util.stream.Collectors;
 
 import org.apache.commons.io.FileUtils;
@@ -51,6 +55,7 @@ import org.rocksdb.CompressionType;
 import org.rocksdb.DBOptions;
 import org.rocksdb.DBOptionsInterface;
 import org.rocksdb.Env;
+import org.rocksdb.EnvOptions;
 import org.rocksdb.FlushOptions;
 import org.rocksdb.InfoLogLevel;
 import org.rocksdb.IngestExternalFileOptions;
@@ -58,10 +63,16 @@ import org.rocksdb.MutableColumnFamilyOptionsInterface;
 import org.rocksdb.MutableDBOptionsInterface;
 import org.rocksdb.Options;
 import org.rocksdb.Range;
+import org.rocksdb.ReadOptions;
 import org.rocksdb.RocksDB;
 import org.rocksdb.RocksDBException;
+import org.rocksdb.RocksIterator;
 import org.rocksdb.SizeApproximationFlag;
 import org.rocksdb.Slice;
+import org.rocksdb.Snapshot;
+import org.rocksdb.SstFileReader;
+import org.rocksdb.SstFileReaderIterator;
+import org.rocksdb.SstFileWriter;
 import org.rocksdb.Statistics;
 import org.rocksdb.WriteBufferManager;
 import org.rocksdb.WriteOptions;
@@ -75,6 +86,8 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
     private static final int CPUS = Runtime.getRuntime().availableProcessors();
     final Statistics rocksDbStats;
     final WriteOptions writeOptions;
+    final ReadOptions totalOrderReadOptions;
+    final ReadOptions prefixReadOptions;
     final AtomicInteger refCount;
     final AtomicBoolean shutdown;
     final String tempSuffix = "_temp_";
@@ -82,6 +95,7 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
     private final HugeConfig hugeConfig;
     private final ReentrantReadWriteLock cfHandleLock;
     private final Map<String, ColumnFamilyHandle> tables;
+    private final Map<String, Integer> prefixLengths;
     private transient String dbPath;
     private RocksDB rocksDB;
     private DBOptions dbOptions;
@@ -98,6 +112,10 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
         this.refCount = new AtomicInteger(1);
         this.shutdown = new AtomicBoolean(false);
         this.writeOptions = new WriteOptions();
+        this.totalOrderReadOptions = new ReadOptions().setTotalOrderSeek(true);
+        this.prefixReadOptions = new ReadOptions().setPrefixSameAsStart(true);
+        this.prefixLengths = RocksDBOptions.tableValues(
+                hugeConfig.get(RocksDBOptions.PREFIX_EXTRACTOR_TABLES));
         this.rocksDbStats = new Statistics();
         this.iteratorMap = new ConcurrentHashMap<>();
         openRocksDB(dbDataPath, version);
@@ -112,6 +130,9 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
         this.rocksDB = origin.rocksDB;
         this.dbOptions = origin.dbOptions;
         this.writeOptions = origin.writeOptions;
+        this.totalOrderReadOptions = origin.totalOrderReadOptions;
+        this.prefixReadOptions = origin.prefixReadOptions;
+        this.prefixLengths = origin.prefixLengths;
         this.rocksDbStats = origin.rocksDbStats;
         this.shutdown = origin.shutdown;
         this.iteratorMap = origin.iteratorMap;
@@ -271,6 +292,52 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
         }
     }
 
+    /**
+     * Override the common cf options with the bloom filter and prefix extractor of the table
+     */
+    public static void initTableOptions(HugeConfig conf, String table,
+                                        ColumnFamilyOptions cf) {
+        @SuppressWarnings("unchecked")
+        Map<String, BlockBasedTableConfig> tableConfigs =
+                (Map<String, BlockBasedTableConfig>) conf.getProperty(
+                        RocksDBOptions.TABLE_CONFIGS);
+        if (tableConfigs != null && tableConfigs.containsKey(table)) {
+            cf.setTableFormatConfig(tableConfigs.get(table));
+        }
+
+        Integer prefixLength = RocksDBOptions.tableValues(
+                conf.get(RocksDBOptions.PREFIX_EXTRACTOR_TABLES)).get(table);
+        if (prefixLength != null && prefixLength > 0) {
+            // Keys are graph id + user key (InnerKeyCreator), so the length counts the id
+            cf.useCappedPrefixExtractor(prefixLength);
+            cf.setMemtablePrefixBloomSizeRatio(
+                    conf.get(RocksDBOptions.MEMTABLE_PREFIX_BLOOM_RATIO));
+        }
+    }
+
+    private ColumnFamilyOptions newCFOptions(String table) {
+        ColumnFamilyOptions cfOptions = new ColumnFamilyOptions();
+        RocksDBSession.initOptions(this.hugeConfig, null, null, cfOptions, cfOptions);
+        RocksDBSession.initTableOptions(this.hugeConfig, table, cfOptions);
+        return cfOptions;
+    }
+
+    /**
+     * Read options for the iterators of a table with a prefix extractor: seek within the
+     * prefix if the scan prefix covers the extracted one, else in total order so that the
+     * prefix bloom never hides keys. Returns null for the other tables.
+     */
+    public ReadOptions getIteratorOptions(String table, byte[] prefix) {
+        Integer length = this.prefixLengths.get(table);
+        if (length == null || length <= 0) {
+            return null;
+        }
+        if (prefix != null && prefix.length >= length) {
+            return this.prefixReadOptions;
+        }
+        return this.totalOrderReadOptions;
+    }
+
     @Override
     public RocksDBSession clone() {
         return new RocksDBSession(this);
@@ -437,17 +504,17 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
                     new ArrayList<>();
             List<byte[]> columnFamilyBytes = RocksDB.listColumnFamilies(new Options(), dbPath);
 
-            ColumnFamilyOptions cfOptions = new ColumnFamilyOptions();
-            RocksDBSession.initOptions(this.hugeConfig, null, null, cfOptions, cfOptions);
-
             if (columnFamilyBytes.size() > 0) {
                 for (byte[] columnFamilyByte : columnFamilyBytes) {
                     columnFamilyDescriptorList.add(
-                            new ColumnFamilyDescriptor(columnFamilyByte, cfOptions));
+                            new ColumnFamilyDescriptor(columnFamilyByte,
+                                                       newCFOptions(new String(columnFamilyByte))));
                 }
             } else {
                 columnFamilyDescriptorList.add(
-                        new ColumnFamilyDescriptor(RocksDB.DEFAULT_COLUMN_FAMILY, cfOptions));
+                        new ColumnFamilyDescriptor(RocksDB.DEFAULT_COLUMN_FAMILY,
+                                                   newCFOptions(new String(
+                                                           RocksDB.DEFAULT_COLUMN_FAMILY))));
             }
             List<ColumnFamilyHandle> columnFamilyHandleList = new ArrayList<>();
             this.rocksDB = RocksDB.open(dbOptions, dbPath, columnFamilyDescriptorList,
@@ -467,10 +534,8 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
         try {
             ColumnFamilyHandle handle = tables.get(table);
             if (handle == null) {
-                ColumnFamilyOptions cfOptions = new ColumnFamilyOptions();
-                RocksDBSession.initOptions(this.hugeConfig, null, null, cfOptions, cfOptions);
                 ColumnFamilyDescriptor cfDescriptor =
-                        new ColumnFamilyDescriptor(table.getBytes(), cfOptions);
+                        new ColumnFamilyDescriptor(table.getBytes(), newCFOptions(table));
                 handle = this.rocksDB.createColumnFamily(cfDescriptor);
                 tables.put(table, handle);
             }
@@ -538,7 +603,8 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
                     continue;
                 }
 
-                ColumnFamilyDescriptor cfDescriptor = new ColumnFamilyDescriptor(table.getBytes());
+                ColumnFamilyDescriptor cfDescriptor =
+                        new ColumnFamilyDescriptor(table.getBytes(), newCFOptions(table));
                 cfList.add(cfDescriptor);
             }
 
@@ -642,6 +708,8 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
             if (dbOptions != null) {
                 this.dbOptions.close();
                 this.writeOptions.close();
+                this.totalOrderReadOptions.close();
+                this.prefixReadOptions.close();
                 this.rocksDbStats.close();
                 dbOptions = null;
             }
@@ -955,6 +1023,13 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
     }
 
     public void ingestSstFile(Map<byte[], List<String>> sstFiles) {
+        ingestSstFile(sstFiles, true);
+    }
+
+    /**
+     * @param moveFiles whether the files are moved into the db, or copied and kept
+     */
+    public void ingestSstFile(Map<byte[], List<String>> sstFiles, boolean moveFiles) {
         long startTime = System.currentTimeMillis();
         log.info("begin ingestSstFile. graphName {}", this.graphName);
         try {
@@ -963,7 +1038,7 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
                 try (CFHandleLock cfHandle = this.getCFHandleLock(cfName)) {
                     try (final IngestExternalFileOptions ingestOptions =
                                  new IngestExternalFileOptions()
-                                         .setMoveFiles(true)) {
+                                         .setMoveFiles(moveFiles)) {
                         this.rocksDB.ingestExternalFile(cfHandle.get(), entry.getValue(),
                                                         ingestOptions);
                         log.info("Rocksdb {} ingestSstFile cf:{}, sst: {}", this.graphName, cfName,
@@ -978,6 +1053,162 @@ public class RocksDBSession implements AutoCloseable, Cloneable {
                  System.currentTimeMillis() - startTime);
     }
 
+    /**
+     * Take a snapshot of the db, it must be released by {@link #releaseSnapshot}
+     */
+    public Snapshot getSnapshot() {
+        return this.rocksDB.getSnapshot();
+    }
+
+    public void releaseSnapshot(Snapshot snapshot) {
+        if (snapshot != null && this.rocksDB != null) {
+            this.rocksDB.releaseSnapshot(snapshot);
+        }
+    }
+
+    /**
+     * Export the keys in [start, end) of every table into sst files under dir, reading from a
+     * snapshot taken at call time. The selector maps a key to the target it is exported for,
+     * or to a negative value to skip it. If prefixes gives a non-null value for a target, the
+     * leading bytes of its keys are replaced with it, e.g. with the graph id of another db.
+     *
+     * @return target -> (table name -> sst files), the input of {@link #ingestSstFile}
+     */
+    public Map<Integer, Map<byte[], List<String>>> exportSstFiles(String dir, byte[] start,
+                                                                  byte[] end,
+                                                                  ToIntFunction<byte[]> selector,
+                                                                  IntFunction<byte[]> prefixes) {
+        Snapshot snapshot = getSnapshot();
+        try {
+            return exportSstFiles(snapshot, dir, start, end, selector, prefixes);
+        } finally {
+            releaseSnapshot(snapshot);
+        }
+    }
+
+    /**
+     * Same as {@link #exportSstFiles(String, byte[], byte[], ToIntFunction, IntFunction)}, but
+     * reads from a snapshot taken earlier by {@link #getSnapshot()}, so that the data can be
+     * fixed at one point and exported later on another thread.
+     */
+    public Map<Integer, Map<byte[], List<String>>> exportSstFiles(Snapshot snapshot, String dir,
+                                                                  byte[] start, byte[] end,
+                                                                  ToIntFunction<byte[]> selector,
+                                                                  IntFunction<byte[]> prefixes) {
+        long startTime = System.currentTimeMillis();
+        log.info("begin exportSstFiles. graphName {}, dir {}", this.graphName, dir);
+        Map<Integer, Map<byte[], List<String>>> result = new HashMap<>();
+        cfHandleLock.readLock().lock();
+        try (Slice upperBound = new Slice(end);
+             ReadOptions readOptions = new ReadOptions().setSnapshot(snapshot)
+                                                        .setTotalOrderSeek(true)
+                                                        .setFillCache(false)
+                                                        .setIterateUpperBound(upperBound);
+             EnvOptions envOptions = new EnvOptions()) {
+            FileUtils.forceMkdir(new File(dir));
+            for (Map.Entry<String, ColumnFamilyHandle> table : this.tables.entrySet()) {
+                Map<Integer, SstFileWriter> writers = new HashMap<>();
+                try (ColumnFamilyOptions cfOptions = newCFOptions(table.getKey());
+                     Options options = new Options(this.dbOptions, cfOptions);
+                     RocksIterator iterator = this.rocksDB.newIterator(table.getValue(),
+                                                                       readOptions)) {
+                    for (iterator.seek(start); iterator.isValid(); iterator.next()) {
+                        byte[] key = iterator.key();
+                        int target = selector.applyAsInt(key);
+                        if (target < 0) {
+                            continue;
+                        }
+                        SstFileWriter writer = writers.get(target);
+                        if (writer == null) {
+                            String file = Paths.get(dir, target + "_" + table.getKey() + ".sst")
+                                               .toString();
+                            writer = new SstFileWriter(envOptions, options);
+                            writer.open(file);
+                            writers.put(target, writer);
+                            result.computeIfAbsent(target, k -> new HashMap<>())
+                                  .put(table.getKey().getBytes(StandardCharsets.UTF_8),
+                                       List.of(file));
+                        }
+                        byte[] prefix = prefixes.apply(target);
+                        if (prefix != null) {
+                            System.arraycopy(prefix, 0, key, 0, prefix.length);
+                        }
+                        writer.put(key, iterator.value());
+                    }
+                    iterator.status();
+                    for (SstFileWriter writer : writers.values()) {
+                        writer.finish();
+                    }
+                } finally {
+                    writers.values().forEach(SstFileWriter::close);
+                }
+            }
+        } catch (RocksDBException | IOException e) {
+            throw new DBStoreException("Rocksdb exportSstFiles error " + this.graphName, e);
+        } finally {
+            cfHandleLock.readLock().unlock();
+        }
+        log.info("end exportSstFiles. graphName {}, targets {}, time cost {} ms", this.graphName,
+                 result.keySet(), System.currentTimeMillis() - startTime);
+        return result;
+    }
+
+    /**
+     * Replace the leading bytes of every key in an sst file of table with prefix, in place.
+     * The keys of the file must share their leading bytes, such as the graph id of a db,
+     * so that the order of the keys is kept, and the file is left as is if they equal prefix.
+     */
+    public void rewriteSstFile(String table, String file, byte[] prefix) {
+        String tmpFile = file + ".tmp";
+        try (ColumnFamilyOptions cfOptions = newCFOptions(table);
+             Options options = new Options(this.dbOptions, cfOptions);
+             EnvOptions envOptions = new EnvOptions();
+             ReadOptions readOptions = new ReadOptions().setFillCache(false);
+             SstFileReader reader = new SstFileReader(options);
+             SstFileWriter writer = new SstFileWriter(envOptions, options)) {
+            reader.open(file);
+            try (SstFileReaderIterator iterator = reader.newIterator(readOptions)) {
+                iterator.seekToFirst();
+                if (!iterator.isValid() ||
+                    Bytes.prefixWith(iterator.key(), prefix)) {
+                    return;
+                }
+            }
+            writer.open(tmpFile);
+            try (SstFileReaderIterator iterator = reader.newIterator(readOptions)) {
+                for (iterator.seekToFirst(); iterator.isValid(); iterator.next()) {
+                    byte[] key = iterator.key();
+                    System.arraycopy(prefix, 0, key, 0, prefix.length);
+                    writer.put(key, iterator.value());
+                }
+                iterator.status();
+            }
+            writer.finish();
+            Files.move(Paths.get(tmpFile), Paths.get(file), StandardCopyOption.REPLACE_EXISTING);
+        } catch (RocksDBException | IOException e) {
+            FileUtils.deleteQuietly(new File(tmpFile));
+            throw new DBStoreException("Rocksdb rewriteSstFile error " + file, e);
+        }
+    }
+
+    /**
+     * Memory of the active and unflushed memtables of all tables
+     */
+    public long getMemTableUsage() {
+        cfHandleLock.readLock().lock();
+        try {
+            if (this.rocksDB == null) {
+                return 0L;
+            }
+            return this.rocksDB.getAggregatedLongProperty("rocksdb.cur-size-all-mem-tables");
+        } catch (RocksDBException e) {
+            log.error("getMemTableUsage exception {}", e.getMessage());
+            return 0L;
+        } finally {
+            cfHandleLock.readLock().unlock();
+        }
+    }
+
     public String getProperty(String property) {
         try {
             return rocksDB.getProperty(property);
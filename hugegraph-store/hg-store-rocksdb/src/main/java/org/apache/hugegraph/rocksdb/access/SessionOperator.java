@@ -61,6 +61,12 @@ public interface SessionOperator {
 
     void deleteRange(String table, byte[] keyFrom, byte[] keyTo) throws DBStoreException;
 
+    /**
+     * Delete the range in the current write batch, unlike deleteRange it is written with the
+     * other writes of the batch by the next commit
+     */
+    void deleteRangeInBatch(String table, byte[] keyFrom, byte[] keyTo) throws DBStoreException;
+
     /**
      * Delete all data specified by the cf range
      */
@@ -74,5 +80,17 @@ public interface SessionOperator {
 
     void rollback();
 
+    /**
+     * Mark the writes so far, the writes after it can be discarded by rollbackToSavePoint
+     */
+    void setSavePoint();
+
+    void rollbackToSavePoint() throws DBStoreException;
+
+    /**
+     * Drop the latest save point and keep the writes after it
+     */
+    void popSavePoint() throws DBStoreException;
+
     RocksDBSession getDBSession();
 }
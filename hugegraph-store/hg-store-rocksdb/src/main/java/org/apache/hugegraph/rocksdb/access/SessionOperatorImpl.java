@@ -26,6 +26,7 @@ import org.apache.hugegraph.rocksdb.access.RocksDBSession.CFHandleLock;
 import org.apache.hugegraph.rocksdb.access.util.Asserts;
 import org.apache.hugegraph.store.term.HgPair;
 import org.apache.hugegraph.util.Bytes;
+import org.rocksdb.ColumnFamilyHandle;
 import org.rocksdb.ReadOptions;
 import org.rocksdb.RocksDB;
 import org.rocksdb.RocksDBException;
@@ -78,6 +79,14 @@ public class SessionOperatorImpl implements SessionOperator {
         return session;
     }
 
+    private RocksIterator newIterator(String table, ColumnFamilyHandle handle, byte[] prefix) {
+        ReadOptions options = this.session.getIteratorOptions(table, prefix);
+        if (options == null) {
+            return rocksdb().newIterator(handle);
+        }
+        return rocksdb().newIterator(handle, options);
+    }
+
     private CFHandleLock getLock(String table) {
         CFHandleLock cf = this.session.getCFHandleLock(table);
         return cf;
@@ -87,7 +96,7 @@ public class SessionOperatorImpl implements SessionOperator {
     public HgPair<byte[], byte[]> keyRange(String table) {
         byte[] startKey, endKey;
         try (CFHandleLock handle = this.getLock(table);
-             RocksIterator iter = rocksdb().newIterator(handle.get())) {
+             RocksIterator iter = this.newIterator(table, handle.get(), null)) {
             iter.seekToFirst();
             if (!iter.isValid()) {
                 return null;
@@ -180,14 +189,7 @@ public class SessionOperatorImpl implements SessionOperator {
 
     @Override
     public void deleteRange(String table, byte[] keyFrom, byte[] keyTo) throws DBStoreException {
-        Asserts.isTrue(keyFrom != null, "KeyFrom is null");
-        Asserts.isTrue(keyTo != null, "KeyTo is null");
-
-        if (Bytes.compare(keyTo, keyFrom) < 0) {
-            throw new DBStoreException("[end key: %s ] is lower than [start key: %s]",
-                                       Arrays.toString(keyTo), Arrays.toString(keyFrom));
-        }
-
+        checkRange(keyFrom, keyTo);
         try {
             this.prepare();
             this.getBatch().deleteRange(session.getCF(table), keyFrom, keyTo);
@@ -198,6 +200,27 @@ public class SessionOperatorImpl implements SessionOperator {
         }
     }
 
+    @Override
+    public void deleteRangeInBatch(String table, byte[] keyFrom, byte[] keyTo) throws
+                                                                              DBStoreException {
+        checkRange(keyFrom, keyTo);
+        try {
+            this.getBatch().deleteRange(session.getCF(table), keyFrom, keyTo);
+        } catch (RocksDBException e) {
+            throw new DBStoreException(e);
+        }
+    }
+
+    private static void checkRange(byte[] keyFrom, byte[] keyTo) throws DBStoreException {
+        Asserts.isTrue(keyFrom != null, "KeyFrom is null");
+        Asserts.isTrue(keyTo != null, "KeyTo is null");
+
+        if (Bytes.compare(keyTo, keyFrom) < 0) {
+            throw new DBStoreException("[end key: %s ] is lower than [start key: %s]",
+                                       Arrays.toString(keyTo), Arrays.toString(keyFrom));
+        }
+    }
+
     @Override
     public void deleteRange(byte[] keyFrom, byte[] keyTo) throws DBStoreException {
         for (String name : session.getTables().keySet()) {
@@ -257,6 +280,29 @@ public class SessionOperatorImpl implements SessionOperator {
         }
     }
 
+    @Override
+    public void setSavePoint() {
+        this.getBatch().setSavePoint();
+    }
+
+    @Override
+    public void rollbackToSavePoint() throws DBStoreException {
+        try {
+            this.getBatch().rollbackToSavePoint();
+        } catch (RocksDBException e) {
+            throw new DBStoreException(e);
+        }
+    }
+
+    @Override
+    public void popSavePoint() throws DBStoreException {
+        try {
+            this.getBatch().popSavePoint();
+        } catch (RocksDBException e) {
+            throw new DBStoreException(e);
+        }
+    }
+
     @Override
     public ScanIterator scan(String tableName) {
         try (CFHandleLock handle = this.getLock(tableName)) {
@@ -268,7 +314,7 @@ public class SessionOperatorImpl implements SessionOperator {
 
             var iterator =
                     new RocksDBScanIterator(
-                            this.rocksdb().newIterator(handle.get()),
+                            this.newIterator(tableName, handle.get(), null),
                             null,
                             null,
                             ScanIterator.Trait.SCAN_ANY,
@@ -295,7 +341,7 @@ public class SessionOperatorImpl implements SessionOperator {
             String key = getIteratorKey();
             var iterator =
                     new RocksDBScanIterator(
-                            this.rocksdb().newIterator(handle.get()),
+                            this.newIterator(tableName, handle.get(), prefix),
                             prefix,
                             null,
                             ScanIterator.Trait.SCAN_PREFIX_BEGIN | scanType,
@@ -316,7 +362,7 @@ public class SessionOperatorImpl implements SessionOperator {
             String key = getIteratorKey();
             var iterator =
                     new RocksDBScanIterator(
-                            this.rocksdb().newIterator(handle.get()),
+                            this.newIterator(tableName, handle.get(), null),
                             keyFrom,
                             keyTo,
                             scanType,
@@ -355,7 +401,8 @@ public class SessionOperatorImpl implements SessionOperator {
             public <T> T next() {
                 RocksIterator iterator = null;
                 ReadOptions readOptions = new ReadOptions()
-                        .setSnapshot(snapshot);
+                        .setSnapshot(snapshot)
+                        .setTotalOrderSeek(true);
                 if (keyFrom != null) {
                     readOptions.setIterateLowerBound(new Slice(keyFrom));
                 }
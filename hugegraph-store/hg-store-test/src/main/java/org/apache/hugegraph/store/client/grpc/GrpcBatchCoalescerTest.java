@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.client.grpc;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.apache.hugegraph.store.grpc.common.Key;
+import org.apache.hugegraph.store.grpc.common.ResCode;
+import org.apache.hugegraph.store.grpc.common.ResStatus;
+import org.apache.hugegraph.store.grpc.session.BatchEntry;
+import org.apache.hugegraph.store.grpc.session.FeedbackRes;
+import org.apache.hugegraph.store.grpc.session.PartitionFaultResponse;
+import org.junit.Test;
+
+public class GrpcBatchCoalescerTest {
+
+    private static List<BatchEntry> entries(int... codes) {
+        List<BatchEntry> entries = new ArrayList<>();
+        for (int code : codes) {
+            entries.add(BatchEntry.newBuilder().setStartKey(Key.newBuilder().setCode(code))
+                                  .build());
+        }
+        return entries;
+    }
+
+    private static FeedbackRes response(ResCode code, Integer... failedCodes) {
+        PartitionFaultResponse fault = PartitionFaultResponse.newBuilder()
+                                                             .addAllFailedCodes(
+                                                                     List.of(failedCodes))
+                                                             .build();
+        return FeedbackRes.newBuilder()
+                          .setStatus(ResStatus.newBuilder().setCode(code))
+                          .setPartitionFaultResponse(fault)
+                          .build();
+    }
+
+    @Test
+    public void testCoalesce() throws Exception {
+        String key = "coalesce/g";
+        int count = 20;
+        CountDownLatch first = new CountDownLatch(1);
+        AtomicInteger batches = new AtomicInteger();
+        List<BatchEntry> sent = Collections.synchronizedList(new ArrayList<>());
+
+        ExecutorService executor = Executors.newFixedThreadPool(count);
+        try {
+            List<Future<FeedbackRes>> futures = new ArrayList<>();
+            for (int i = 0; i < count; i++) {
+                int code = i;
+                futures.add(executor.submit(() -> GrpcBatchCoalescer.submit(
+                        key, 1000, entries(code), list -> {
+                            // Hold the first Batch so that the others queue up
+                            if (batches.getAndIncrement() == 0) {
+                                try {
+                                    first.await(10, TimeUnit.SECONDS);
+                                } catch (InterruptedException e) {
+                                    throw new RuntimeException(e);
+                                }
+                            }
+                            sent.addAll(list);
+                            return response(ResCode.RES_CODE_OK);
+                        })));
+            }
+            Thread.sleep(200);
+            first.countDown();
+            for (Future<FeedbackRes> future : futures) {
+                assertEquals(ResCode.RES_CODE_OK,
+                             future.get(10, TimeUnit.SECONDS).getStatus().getCode());
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+
+        assertEquals(count, sent.size());
+        assertTrue(batches.get() < count);
+        // Evicted once idle
+        assertFalse(GrpcBatchCoalescer.contains(key));
+    }
+
+    @Test
+    public void testResultOfFailedPartitions() {
+        FeedbackRes ok = response(ResCode.RES_CODE_OK);
+        assertSame(ok, GrpcBatchCoalescer.resultOf(entries(1), ok));
+
+        // The node grouped the entries of codes 50 and 60 into the failed partitions
+        FeedbackRes failed = response(ResCode.RES_CODE_FAIL, 50, 60);
+        assertSame(failed, GrpcBatchCoalescer.resultOf(entries(200, 50), failed));
+        // Not in the failed partitions, the entries are applied
+        assertEquals(ResCode.RES_CODE_OK,
+                     GrpcBatchCoalescer.resultOf(entries(55, 200), failed).getStatus()
+                                       .getCode());
+        // Sent to all the partitions
+        assertSame(failed, GrpcBatchCoalescer.resultOf(entries(-1), failed));
+
+        // Unknown failed partitions
+        FeedbackRes unknown = response(ResCode.RES_CODE_FAIL);
+        assertSame(unknown, GrpcBatchCoalescer.resultOf(entries(200), unknown));
+    }
+
+    @Test
+    public void testSendError() {
+        String key = "error/g";
+        try {
+            GrpcBatchCoalescer.submit(key, 1000, entries(1), list -> {
+                throw new IllegalStateException("unavailable");
+            });
+            fail("Expect the error of the sender");
+        } catch (IllegalStateException e) {
+            assertEquals("unavailable", e.getMessage());
+        }
+        assertFalse(GrpcBatchCoalescer.contains(key));
+    }
+}
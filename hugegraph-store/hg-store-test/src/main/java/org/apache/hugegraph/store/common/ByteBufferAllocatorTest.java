@@ -17,7 +17,11 @@
 
 package org.apache.hugegraph.store.common;
 
+import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
 
 import org.apache.hugegraph.store.buffer.ByteBufferAllocator;
 import org.junit.Assert;
@@ -63,4 +67,32 @@ public class ByteBufferAllocatorTest extends BaseCommonTest {
 
         latch.await();
     }
+
+    @Test
+    public void maxBytesTest() throws Exception {
+        ByteBufferAllocator allocator = new ByteBufferAllocator(10, 25L, true);
+        ByteBuffer buffer1 = allocator.get();
+        ByteBuffer buffer2 = allocator.get();
+        Assert.assertTrue(buffer1.isDirect());
+        Assert.assertEquals(20, allocator.getTotalBytes());
+
+        // Another buffer would exceed 25 bytes, wait for a released one
+        CompletableFuture<ByteBuffer> buffer3 = CompletableFuture.supplyAsync(() -> {
+            try {
+                return allocator.get();
+            } catch (InterruptedException e) {
+                throw new RuntimeException(e);
+            }
+        });
+        Assert.assertThrows(TimeoutException.class,
+                            () -> buffer3.get(200, TimeUnit.MILLISECONDS));
+        allocator.release(buffer1);
+        Assert.assertSame(buffer1, buffer3.get(5, TimeUnit.SECONDS));
+        Assert.assertEquals(20, allocator.getTotalBytes());
+        allocator.release(buffer2);
+
+        // One buffer is allocated even if it's larger than the max bytes
+        ByteBufferAllocator small = new ByteBufferAllocator(10, 5L, false);
+        Assert.assertEquals(10, small.get().capacity());
+    }
 }
@@ -0,0 +1,282 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.raft;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import org.apache.hugegraph.store.UnitTestBase;
+import org.apache.hugegraph.store.business.BusinessHandler;
+import org.apache.hugegraph.store.business.BusinessHandler.Tx;
+import org.apache.hugegraph.store.business.BusinessHandler.TxBuilder;
+import org.apache.hugegraph.store.core.StoreEngineTestBase;
+import org.apache.hugegraph.store.raft.DefaultRaftClosure;
+import org.apache.hugegraph.store.raft.PartitionStateMachine;
+import org.apache.hugegraph.store.raft.RaftClosure;
+import org.apache.hugegraph.store.raft.RaftOperation;
+import org.apache.hugegraph.store.raft.RaftTaskHandler;
+import org.apache.hugegraph.store.util.HgStoreException;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.alipay.sofa.jraft.Closure;
+import com.alipay.sofa.jraft.Iterator;
+import com.alipay.sofa.jraft.Status;
+
+/**
+ * Applying data writes of partition 0 in one write batch, on the leader and on followers
+ */
+public class PartitionStateMachineTest extends StoreEngineTestBase {
+
+    private static final String GRAPH = "apply-graph";
+    private static final String TABLE = UnitTestBase.DEFAULT_TEST_TABLE;
+    private static final byte PUT = 0x71;
+    private static final byte DEL_RANGE = 0x72;
+    // A transaction whose key or range contains it is rolled back
+    private static final String FAIL = "fail";
+
+    private BusinessHandler handler;
+
+    @Before
+    public void setup() {
+        createPartitionEngine(0, GRAPH);
+        handler = getStoreEngine().getBusinessHandler();
+        handler.doPut(GRAPH, 0, TABLE, "init".getBytes(), "init".getBytes());
+    }
+
+    private PartitionStateMachine stateMachine(boolean batchApply) {
+        PartitionStateMachine stateMachine = new PartitionStateMachine(0, null, batchApply);
+        stateMachine.addTaskHandler(new TestTaskHandler());
+        return stateMachine;
+    }
+
+    private static RaftOperation put(String key) {
+        return operation(PUT, key);
+    }
+
+    private static RaftOperation delRange(String start, String end) {
+        return operation(DEL_RANGE, start + "," + end);
+    }
+
+    private static RaftOperation operation(byte op, String req) {
+        byte[] bytes = req.getBytes(StandardCharsets.UTF_8);
+        byte[] values = new byte[bytes.length + 1];
+        values[0] = op;
+        System.arraycopy(bytes, 0, values, 1, bytes.length);
+        return RaftOperation.create(op, values, req);
+    }
+
+    private byte[] get(String key) {
+        return handler.doGet(GRAPH, 0, TABLE, key.getBytes(StandardCharsets.UTF_8));
+    }
+
+    @Test
+    public void testFailingTxInBatch() {
+        List<Status> statuses = new ArrayList<>();
+        EntryIterator iter = new EntryIterator();
+        for (String key : new String[]{"b1-a", "b1-fail", "b1-b"}) {
+            iter.add(put(key), statuses::add);
+        }
+
+        PartitionStateMachine stateMachine = stateMachine(true);
+        stateMachine.onApply(iter);
+
+        assertNotNull(get("b1-a"));
+        assertNull(get("b1-fail"));
+        assertNotNull(get("b1-b"));
+        assertEquals(3, statuses.size());
+        statuses.forEach(status -> assertTrue(status.isOk()));
+        assertEquals(3, stateMachine.getCommittedIndex());
+    }
+
+    @Test
+    public void testDeleteRangeInBatch() {
+        EntryIterator iter = new EntryIterator();
+        iter.add(put("d1-a"));
+        iter.add(put("d1-b"));
+        iter.add(put("d1-c"));
+        iter.add(delRange("d1-a", "d1-c"));
+        iter.add(put("d1-d"));
+        // Rolled back to its save point, the writes before it are kept
+        iter.add(put("d2-a"));
+        iter.add(delRange("d2-a", "d2-fail"));
+        iter.add(put("d2-b"));
+
+        stateMachine(true).onApply(iter);
+
+        assertNull(get("d1-a"));
+        assertNull(get("d1-b"));
+        assertNotNull(get("d1-c"));
+        assertNotNull(get("d1-d"));
+        assertNotNull(get("d2-a"));
+        assertNotNull(get("d2-b"));
+    }
+
+    @Test
+    public void testFollowerApplyBatchTask() {
+        for (boolean batchApply : new boolean[]{true, false}) {
+            String prefix = "f-" + batchApply + "-";
+            RaftOperation batch = RaftOperation.createBatch(
+                    Arrays.asList(put(prefix + "a"), put(prefix + "fail"), put(prefix + "b"),
+                                  delRange(prefix + "b", prefix + "c")));
+            EntryIterator iter = new EntryIterator();
+            iter.add(batch.getValues());
+            iter.add(put(prefix + "c").getValues());
+
+            PartitionStateMachine stateMachine = stateMachine(batchApply);
+            stateMachine.onApply(iter);
+
+            assertArrayEquals((prefix + "a").getBytes(), get(prefix + "a"));
+            assertNull(get(prefix + "fail"));
+            assertNull(get(prefix + "b"));
+            assertNotNull(get(prefix + "c"));
+            assertEquals(2, stateMachine.getCommittedIndex());
+        }
+    }
+
+    @Test
+    public void testUnknownOperation() {
+        EntryIterator iter = new EntryIterator();
+        iter.add(put("u-a").getValues());
+        iter.add(new byte[]{0x7F});
+        iter.add(put("u-b").getValues());
+
+        PartitionStateMachine stateMachine = stateMachine(true);
+        stateMachine.onApply(iter);
+
+        assertNotNull(iter.error);
+        assertNotNull(get("u-a"));
+        assertNull(get("u-b"));
+        assertEquals(1, stateMachine.getCommittedIndex());
+    }
+
+    /**
+     * Writes the key of PUT as its value and deletes the "start,end" range of DEL_RANGE, each
+     * in its own transaction
+     */
+    private class TestTaskHandler implements RaftTaskHandler {
+
+        @Override
+        public boolean invoke(int groupId, byte[] request, RaftClosure response) throws
+                                                                                 HgStoreException {
+            String req = new String(request, 1, request.length - 1, StandardCharsets.UTF_8);
+            return invoke(groupId, request[0], req, response);
+        }
+
+        @Override
+        public boolean invoke(int groupId, byte methodId, Object req, RaftClosure response)
+                throws HgStoreException {
+            if (methodId != PUT && methodId != DEL_RANGE) {
+                return false;
+            }
+            String value = (String) req;
+            TxBuilder builder = handler.txBuilder(GRAPH, groupId);
+            if (methodId == PUT) {
+                byte[] key = value.getBytes(StandardCharsets.UTF_8);
+                builder.put(0, TABLE, key, key);
+            } else {
+                String[] range = value.split(",");
+                builder.delRange(0, TABLE, range[0].getBytes(StandardCharsets.UTF_8),
+                                 range[1].getBytes(StandardCharsets.UTF_8));
+            }
+            Tx tx = builder.build();
+            if (value.contains(FAIL)) {
+                tx.rollback();
+            } else {
+                tx.commit();
+            }
+            return true;
+        }
+
+        @Override
+        public boolean isBatchable(byte methodId) {
+            return methodId == PUT || methodId == DEL_RANGE;
+        }
+    }
+
+    /**
+     * Log entries from index 1, the closure is null for the entries received as a follower
+     */
+    private static class EntryIterator implements Iterator {
+
+        private final List<byte[]> entries = new ArrayList<>();
+        private final List<Closure> closures = new ArrayList<>();
+        private int index;
+        private Status error;
+
+        private void add(byte[] data) {
+            entries.add(data);
+            closures.add(null);
+        }
+
+        private void add(RaftOperation operation) {
+            add(operation, status -> {
+            });
+        }
+
+        private void add(RaftOperation operation, RaftClosure closure) {
+            entries.add(operation.getValues());
+            closures.add(new DefaultRaftClosure(operation, closure));
+        }
+
+        @Override
+        public ByteBuffer getData() {
+            return ByteBuffer.wrap(entries.get(index));
+        }
+
+        @Override
+        public long getIndex() {
+            return index + 1;
+        }
+
+        @Override
+        public long getTerm() {
+            return 1;
+        }
+
+        @Override
+        public Closure done() {
+            return closures.get(index);
+        }
+
+        @Override
+        public void setErrorAndRollback(long ntail, Status st) {
+            error = st;
+        }
+
+        @Override
+        public boolean hasNext() {
+            return error == null && index < entries.size();
+        }
+
+        @Override
+        public ByteBuffer next() {
+            index++;
+            return index < entries.size() ? getData() : null;
+        }
+    }
+}
@@ -17,6 +17,9 @@
 
 package org.apache.hugegraph.store.core.raft;
 
+import java.util.Arrays;
+import java.util.List;
+
 import org.apache.hugegraph.pd.grpc.Metapb;
 import org.apache.hugegraph.store.raft.RaftOperation;
 import org.junit.Before;
@@ -72,4 +75,20 @@ public class RaftOperationTest {
         assertEquals((byte) 0b0, result.getOp());
 
     }
+
+    @Test
+    public void testCreateBatch() {
+        final RaftOperation op1 = RaftOperation.create((byte) 0x12, "a".getBytes(), "req1");
+        final RaftOperation op2 = RaftOperation.create((byte) 0x12, "bcd".getBytes(), "req2");
+
+        // Run the test
+        final RaftOperation result = RaftOperation.createBatch(Arrays.asList(op1, op2));
+        assertEquals(RaftOperation.BATCH_TASK, result.getOp());
+        assertEquals(Arrays.asList(op1, op2), result.getReq());
+
+        final List<byte[]> values = RaftOperation.splitBatch(result.getValues());
+        assertEquals(2, values.size());
+        assertArrayEquals("a".getBytes(), values.get(0));
+        assertArrayEquals("bcd".getBytes(), values.get(1));
+    }
 }
@@ -18,21 +18,31 @@
 package org.apache.hugegraph.store.core.snapshot;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertTrue;
 
 import java.io.File;
 import java.io.IOException;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.nio.charset.Charset;
+import java.util.HashSet;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
 
 import org.apache.commons.io.FileUtils;
 import org.apache.hugegraph.store.core.StoreEngineTestBase;
 import org.apache.hugegraph.store.meta.Partition;
 import org.apache.hugegraph.store.snapshot.HgSnapshotHandler;
+import org.apache.hugegraph.store.snapshot.SnapshotHandler;
 import org.junit.Before;
 import org.junit.Test;
 
 import com.alipay.sofa.jraft.entity.RaftOutter;
+import com.alipay.sofa.jraft.storage.snapshot.Snapshot;
 import com.alipay.sofa.jraft.storage.snapshot.SnapshotReader;
 import com.alipay.sofa.jraft.storage.snapshot.SnapshotWriter;
 import com.google.protobuf.Message;
@@ -184,4 +194,123 @@ public class HgSnapshotHandlerTest extends StoreEngineTestBase {
 
         // Verify the results
     }
+
+    @Test
+    public void testVerifyChecksum() throws IOException {
+        File file = new File("/tmp/snapshot/data/000001.sst");
+        FileUtils.writeStringToFile(file, "sst data", Charset.defaultCharset());
+        String checksum = SnapshotHandler.calculateChecksum(file.getPath());
+
+        assertTrue(SnapshotHandler.verifyChecksum(file.getPath(), checksum));
+        // checksums of older stores are not verified
+        assertTrue(SnapshotHandler.verifyChecksum(file.getPath(), "1a2b_8"));
+
+        FileUtils.writeStringToFile(file, "sst date", Charset.defaultCharset());
+        assertFalse(SnapshotHandler.verifyChecksum(file.getPath(), checksum));
+    }
+
+    @Test
+    public void testPersistSstChecksums() throws Exception {
+        String path = "/tmp/snapshot-checksums";
+        FileUtils.deleteQuietly(new File(path));
+        FileUtils.forceMkdir(new File(path));
+        SnapshotReader reader = snapshotReader(path);
+
+        SnapshotHandler handler = new SnapshotHandler(createPartitionEngine(0));
+        Map<String, String> checksums = sstChecksums(handler);
+        checksums.put("data/000001.sst_8", "crc64_1a2b_8");
+        Method save = SnapshotHandler.class.getDeclaredMethod("saveSstChecksums",
+                                                              Snapshot.class);
+        save.setAccessible(true);
+        save.invoke(handler, reader);
+        assertTrue(new File(path, "sst_checksums").exists());
+
+        // A restarted store loads them with its local snapshot
+        FileUtils.writeStringToFile(new File(path, "should_not_load"), "saved snapshot",
+                                    Charset.defaultCharset());
+        SnapshotHandler restarted = new SnapshotHandler(createPartitionEngine(0));
+        restarted.onSnapshotLoad(reader, 0L);
+        assertEquals(checksums, sstChecksums(restarted));
+    }
+
+    @Test
+    public void testRecreatedSstChecksum() throws Exception {
+        String path = "/tmp/snapshot-recreated";
+        File file = new File(path, "data/000001.sst");
+        FileUtils.deleteQuietly(new File(path));
+        FileUtils.writeStringToFile(file, "sst data", Charset.defaultCharset());
+
+        SnapshotHandler handler = new SnapshotHandler(createPartitionEngine(0));
+        Method getChecksum = SnapshotHandler.class.getDeclaredMethod("getChecksum",
+                                                                     String.class,
+                                                                     String.class,
+                                                                     Set.class);
+        getChecksum.setAccessible(true);
+        Object checksum = getChecksum.invoke(handler, "data/000001.sst", file.getPath(),
+                                             new HashSet<>());
+        assertEquals(SnapshotHandler.calculateChecksum(file.getPath()), checksum);
+
+        // A recreated db writes another file of the same name and length
+        long mtime = file.lastModified();
+        FileUtils.deleteQuietly(file);
+        FileUtils.writeStringToFile(file, "sst date", Charset.defaultCharset());
+        assertTrue(file.setLastModified(mtime + 2000L));
+        Object recreated = getChecksum.invoke(handler, "data/000001.sst", file.getPath(),
+                                              new HashSet<>());
+        assertEquals(SnapshotHandler.calculateChecksum(file.getPath()), recreated);
+        assertNotEquals(checksum, recreated);
+        assertEquals(2, sstChecksums(handler).size());
+    }
+
+    @SuppressWarnings("unchecked")
+    private static Map<String, String> sstChecksums(SnapshotHandler handler) throws Exception {
+        Field field = SnapshotHandler.class.getDeclaredField("sstChecksums");
+        field.setAccessible(true);
+        return (ConcurrentHashMap<String, String>) field.get(handler);
+    }
+
+    private static SnapshotReader snapshotReader(String path) {
+        return new SnapshotReader() {
+
+            @Override
+            public RaftOutter.SnapshotMeta load() {
+                return null;
+            }
+
+            @Override
+            public String generateURIForCopy() {
+                return null;
+            }
+
+            @Override
+            public boolean init(Void opts) {
+                return true;
+            }
+
+            @Override
+            public void shutdown() {
+
+            }
+
+            @Override
+            public String getPath() {
+                return path;
+            }
+
+            @Override
+            public Set<String> listFiles() {
+                return Set.of();
+            }
+
+            @Override
+            public Message getFileMeta(String fileName) {
+                return null;
+            }
+
+            @Override
+            public void close() {
+
+            }
+        };
+    }
 }
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.snapshot;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotNull;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.io.IOException;
+import java.lang.reflect.Field;
+import java.lang.reflect.Method;
+import java.nio.charset.Charset;
+import java.nio.file.Files;
+import java.util.Set;
+
+import org.apache.commons.io.FileUtils;
+import org.apache.hugegraph.store.snapshot.ParallelSnapshotCopier;
+import org.apache.hugegraph.store.snapshot.SnapshotHandler;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.alipay.sofa.jraft.entity.LocalFileMetaOutter.LocalFileMeta;
+import com.alipay.sofa.jraft.entity.RaftOutter.SnapshotMeta;
+import com.alipay.sofa.jraft.error.RaftError;
+import com.alipay.sofa.jraft.option.RaftOptions;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshot;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshotStorage;
+import com.alipay.sofa.jraft.storage.snapshot.local.LocalSnapshotWriter;
+
+public class ParallelSnapshotCopierTest {
+
+    private static final String PATH = "/tmp/snapshot-copier";
+    private static final String KEPT = "data/000001.sst";
+    private static final String STALE = "data/000002.sst";
+    private static final String LINKED = "data/000003.sst";
+    private static final String MISSING = "data/000004.sst";
+
+    private File source;
+    private LocalSnapshotStorage storage;
+
+    @Before
+    public void setUp() throws IOException {
+        FileUtils.deleteQuietly(new File(PATH));
+        this.source = new File(PATH, "leader");
+        this.storage = new LocalSnapshotStorage(PATH + "/raft", new RaftOptions());
+        assertTrue(this.storage.init(null));
+    }
+
+    @After
+    public void tearDown() {
+        this.storage.shutdown();
+        FileUtils.deleteQuietly(new File(PATH));
+    }
+
+    @Test
+    public void testResumeInterruptedCopy() throws Exception {
+        // The last local snapshot
+        LocalSnapshotWriter last = (LocalSnapshotWriter) this.storage.create(true);
+        addFile(last, LINKED, "sst 3");
+        last.saveMeta(snapshotMeta(5L));
+        last.close();
+
+        // The install interrupted after two files were downloaded
+        LocalSnapshotWriter interrupted = (LocalSnapshotWriter) this.storage.create(true);
+        addFile(interrupted, KEPT, "sst 1");
+        addFile(interrupted, STALE, "sst 2 of an older snapshot");
+        interrupted.setError(RaftError.ECANCELED.getNumber(), "Copy is interrupted");
+        interrupted.close(true);
+
+        LocalSnapshot remote = new LocalSnapshot(new RaftOptions());
+        remote.getMetaTable().addFile(KEPT, fileMeta(KEPT, "sst 1"));
+        remote.getMetaTable().addFile(STALE, fileMeta(STALE, "sst 2"));
+        remote.getMetaTable().addFile(LINKED, fileMeta(LINKED, "sst 3"));
+        remote.getMetaTable().addFile(MISSING, fileMeta(MISSING, "sst 4"));
+        remote.getMetaTable().setMeta(snapshotMeta(10L));
+
+        ParallelSnapshotCopier copier = new ParallelSnapshotCopier(this.storage, null, 2);
+        setField(copier, "remoteSnapshot", remote);
+        Method filter = ParallelSnapshotCopier.class.getDeclaredMethod("filter");
+        filter.setAccessible(true);
+        filter.invoke(copier);
+        assertTrue(copier.isOk());
+
+        LocalSnapshotWriter writer = getField(copier, "writer");
+        try {
+            // Only the stale and the missing files are downloaded again
+            assertEquals(Set.of(KEPT, LINKED), writer.listFiles());
+            assertNull(writer.getFileMeta(STALE));
+            assertNull(writer.getFileMeta(MISSING));
+            assertFalse(new File(writer.getPath(), STALE).exists());
+
+            File linked = new File(writer.getPath(), LINKED);
+            assertTrue(linked.exists());
+            assertEquals("sst 3", FileUtils.readFileToString(linked, Charset.defaultCharset()));
+            assertNotNull(writer.getFileMeta(KEPT));
+        } finally {
+            writer.setError(RaftError.ECANCELED.getNumber(), "Test finished");
+            writer.close(false);
+        }
+    }
+
+    private void addFile(LocalSnapshotWriter writer, String file, String content)
+            throws IOException {
+        File target = new File(writer.getPath(), file);
+        FileUtils.writeStringToFile(target, content, Charset.defaultCharset());
+        assertTrue(writer.addFile(file, LocalFileMeta.newBuilder().setChecksum(
+                SnapshotHandler.calculateChecksum(target.getPath())).build()));
+        assertTrue(writer.sync());
+    }
+
+    private LocalFileMeta fileMeta(String file, String content) throws IOException {
+        File target = new File(this.source, file);
+        FileUtils.writeStringToFile(target, content, Charset.defaultCharset());
+        String checksum = SnapshotHandler.calculateChecksum(target.getPath());
+        Files.delete(target.toPath());
+        return LocalFileMeta.newBuilder().setChecksum(checksum).build();
+    }
+
+    private static SnapshotMeta snapshotMeta(long index) {
+        return SnapshotMeta.newBuilder().setLastIncludedIndex(index)
+                           .setLastIncludedTerm(1L).build();
+    }
+
+    private static void setField(Object owner, String name, Object value) throws Exception {
+        Field field = owner.getClass().getDeclaredField(name);
+        field.setAccessible(true);
+        field.set(owner, value);
+    }
+
+    @SuppressWarnings("unchecked")
+    private static <T> T getField(Object owner, String name) throws Exception {
+        Field field = owner.getClass().getDeclaredField(name);
+        field.setAccessible(true);
+        return (T) field.get(owner);
+    }
+}
@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.store.business;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNotEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.apache.commons.io.FileUtils;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.store.UnitTestBase;
+import org.apache.hugegraph.store.business.BusinessHandler;
+import org.apache.hugegraph.store.business.DataManager;
+import org.apache.hugegraph.store.business.DataManagerImpl;
+import org.apache.hugegraph.store.business.MigrationDelta;
+import org.apache.hugegraph.store.cmd.request.BatchPutRequest;
+import org.apache.hugegraph.store.cmd.request.IngestSstRequest;
+import org.apache.hugegraph.store.cmd.request.SstFileRequest;
+import org.apache.hugegraph.store.core.StoreEngineTestBase;
+import org.apache.hugegraph.store.grpc.common.Key;
+import org.apache.hugegraph.store.grpc.common.OpType;
+import org.apache.hugegraph.store.grpc.session.BatchEntry;
+import org.junit.Before;
+import org.junit.Test;
+
+import com.google.protobuf.ByteString;
+
+/**
+ * Migrating the data of partition 0 into partition 1 by sst files on one replica
+ */
+public class MigrationTest extends StoreEngineTestBase {
+
+    private static final String TABLE_NAME = UnitTestBase.DEFAULT_TEST_TABLE;
+    private BusinessHandler handler;
+    private DataManager dataManager;
+
+    @Before
+    public void setup() {
+        createPartitionEngine(0, "graph0");
+        createPartitionEngine(1, "graph0");
+        handler = getStoreEngine().getBusinessHandler();
+        dataManager = getStoreEngine().getDataManager();
+    }
+
+    private static BatchEntry entry(OpType type, String key, String endKey) {
+        BatchEntry.Builder builder = BatchEntry.newBuilder()
+                                               .setOpType(type)
+                                               .setTable(0)
+                                               .setStartKey(Key.newBuilder().setCode(1).setKey(
+                                                       ByteString.copyFromUtf8(key)));
+        if (endKey != null) {
+            builder.setEndKey(Key.newBuilder().setCode(1)
+                                 .setKey(ByteString.copyFromUtf8(endKey)));
+        }
+        return builder.build();
+    }
+
+    /**
+     * Ship the export of graph in partition 0 to partition 1 as the transfer transferId
+     */
+    private IngestSstRequest ship(String graph, String transferId) throws Exception {
+        String dir = Files.createTempDirectory("migrate-out").toString();
+        Map<String, List<String>> names = new HashMap<>();
+        try {
+            var sstFiles = handler.exportPartition(graph, 0, dir);
+            for (var entry : sstFiles.entrySet()) {
+                List<String> list = new ArrayList<>();
+                for (String file : entry.getValue()) {
+                    SstFileRequest request = new SstFileRequest();
+                    request.setGraphName(graph);
+                    request.setPartitionId(1);
+                    request.setTransferId(transferId);
+                    request.setTable(entry.getKey());
+                    request.setFileName(Paths.get(file).getFileName().toString());
+                    request.setData(Files.readAllBytes(Paths.get(file)));
+                    request.setLast(true);
+                    request.setChecksum(FileUtils.checksumCRC32(new File(file)));
+                    assertTrue(dataManager.receive(request).isOk());
+                    list.add(request.getFileName());
+                }
+                names.put(entry.getKey(), list);
+            }
+        } finally {
+            FileUtils.deleteQuietly(new File(dir));
+        }
+        IngestSstRequest request = new IngestSstRequest();
+        request.setGraphName(graph);
+        request.setPartitionId(1);
+        request.setTransferId(transferId);
+        request.setFiles(names);
+        return request;
+    }
+
+    private long countTarget() {
+        try (RocksDBSession session = handler.getSession(1);
+             ScanIterator iterator = session.sessionOp().scan(TABLE_NAME)) {
+            return iterator.count();
+        }
+    }
+
+    private static File transferDir(String transferId) {
+        String dbPath = getStoreEngine().getPartitionManager().getDbDataPath(1);
+        return Paths.get(dbPath).resolveSibling("migrate").resolve("in").resolve("1")
+                    .resolve(transferId).toFile();
+    }
+
+    @Test
+    public void testMigrationDelta() {
+        MigrationDelta delta = new MigrationDelta();
+        delta.record(List.of(entry(OpType.OP_TYPE_PUT, "k1", null),
+                             entry(OpType.OP_TYPE_DEL, "k2", null),
+                             entry(OpType.OP_TYPE_DEL_RANGE, "r1", "r2"),
+                             entry(OpType.OP_TYPE_PUT, "k1", null)));
+        assertEquals(3, delta.size());
+
+        List<BatchPutRequest.KV> entries = delta.toEntries(
+                (table, code, key) -> "k1".equals(new String(key)) ? "v1".getBytes() : null);
+        assertEquals(3, entries.size());
+        // The range deletes go first, the keys carry their values at the fence
+        assertArrayEquals("r2".getBytes(), entries.get(0).getEndKey());
+        assertArrayEquals("v1".getBytes(), entries.get(1).getValue());
+        assertArrayEquals("k2".getBytes(), entries.get(2).getKey());
+        assertNull(entries.get(2).getValue());
+        assertNull(entries.get(2).getEndKey());
+    }
+
+    @Test
+    public void testIngestKeepsFiles() throws Exception {
+        String graph = "migrate-graph";
+        createPartitionEngine(0, graph);
+        for (int i = 0; i < 100; i++) {
+            handler.doPut(graph, i, TABLE_NAME, ("key" + i).getBytes(), "value".getBytes());
+        }
+        long before = countTarget();
+        IngestSstRequest request = ship(graph, "0-1-keep");
+
+        assertTrue(dataManager.ingest(request, 10).isOk());
+        assertEquals(100, countTarget() - before);
+        assertTrue(handler.getHandoffManager(1).isIngested(graph, "0-1-keep"));
+        assertTrue(transferDir("0-1-keep").exists());
+
+        // Replaying the entry ingests nothing again
+        assertTrue(dataManager.ingest(request, 10).isOk());
+        assertEquals(100, countTarget() - before);
+
+        // Kept until a snapshot covers the entry
+        dataManager.cleanTransfers(1, 9);
+        assertTrue(transferDir("0-1-keep").exists());
+        dataManager.cleanTransfers(1, 10);
+        assertFalse(transferDir("0-1-keep").exists());
+    }
+
+    @Test
+    public void testIngestFailed() throws Exception {
+        String graph = "failed-graph";
+        createPartitionEngine(0, graph);
+        handler.doPut(graph, 1, TABLE_NAME, "key".getBytes(), "value".getBytes());
+        IngestSstRequest request = ship(graph, "0-1-failed");
+        FileUtils.deleteDirectory(transferDir("0-1-failed"));
+
+        // Missing on this replica only, it is rebuilt from a snapshot
+        var status = dataManager.ingest(request, 20);
+        assertFalse(status.isOk());
+        assertNotEquals(DataManagerImpl.INGEST_INVALID, status.getCode());
+        assertFalse(handler.getHandoffManager(1).isIngested(graph, "0-1-failed"));
+    }
+
+    @Test
+    public void testIngestInvalid() throws Exception {
+        String graph = "invalid-graph";
+        createPartitionEngine(0, graph);
+        handler.doPut(graph, 1, TABLE_NAME, "key".getBytes(), "value".getBytes());
+        IngestSstRequest request = ship(graph, "0-1-invalid");
+        for (List<String> names : request.getFiles().values()) {
+            for (String name : names) {
+                FileUtils.writeStringToFile(new File(transferDir("0-1-invalid"), name),
+                                            "not an sst file", StandardCharsets.UTF_8);
+            }
+        }
+
+        // Every replica fails alike, the migration fails without rebuilding them
+        var status = dataManager.ingest(request, 30);
+        assertEquals(DataManagerImpl.INGEST_INVALID, status.getCode());
+        assertFalse(handler.getHandoffManager(1).isIngested(graph, "0-1-invalid"));
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.store.business;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.List;
+import java.util.Random;
+import java.util.TreeSet;
+import java.util.stream.Collectors;
+
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.serializer.BytesBuffer;
+import org.apache.hugegraph.store.business.BusinessHandlerImpl;
+import org.apache.hugegraph.store.business.itrv2.MapJoinIterator;
+import org.apache.hugegraph.store.business.itrv2.SortedIntersectionIterator;
+import org.apache.hugegraph.store.business.itrv2.SortedMergeIterator;
+import org.apache.hugegraph.store.query.QueryTypeParam;
+import org.junit.Test;
+
+public class SortedIteratorTest {
+
+    private static ScanIterator of(Integer... values) {
+        return of(Arrays.asList(values));
+    }
+
+    private static <T> ScanIterator of(List<T> values) {
+        Iterator<T> iterator = values.iterator();
+        return new ScanIterator() {
+            @Override
+            public boolean hasNext() {
+                return iterator.hasNext();
+            }
+
+            @Override
+            public boolean isValid() {
+                return true;
+            }
+
+            @Override
+            public <T> T next() {
+                return (T) iterator.next();
+            }
+
+            @Override
+            public void close() {
+            }
+        };
+    }
+
+    private static byte[] key(Integer value) {
+        return ByteBuffer.allocate(Integer.BYTES).putInt(value).array();
+    }
+
+    private static List<Integer> toList(ScanIterator iterator) {
+        List<Integer> list = new ArrayList<>();
+        while (iterator.hasNext()) {
+            list.add(iterator.next());
+        }
+        return list;
+    }
+
+    @Test
+    public void testMerge() {
+        var iterator = new SortedMergeIterator<Integer>(List.of(of(1, 4, 7), of(), of(2, 4, 9)),
+                                                        Integer::compare);
+        assertEquals(List.of(1, 2, 4, 4, 7, 9), toList(iterator));
+        assertFalse(iterator.hasNext());
+    }
+
+    @Test
+    public void testIntersection() {
+        var iterator = new SortedIntersectionIterator<Integer>(
+                List.of(of(1, 3, 5, 7, 9, 11), of(3, 4, 5, 9, 11, 12), of(0, 3, 9, 9, 11)),
+                Integer::compare);
+        assertEquals(List.of(3, 9, 11), toList(iterator));
+
+        iterator = new SortedIntersectionIterator<>(List.of(of(1, 2), of(3, 4)),
+                                                    Integer::compare);
+        assertEquals(List.of(), toList(iterator));
+
+        iterator = new SortedIntersectionIterator<>(List.of(of(1, 2), of()), Integer::compare);
+        assertEquals(List.of(), toList(iterator));
+    }
+
+    @Test
+    public void testDedup() {
+        var iterator = new SortedIntersectionIterator<Integer>(List.of(of(1, 1, 2, 3, 3, 3)),
+                                                               Integer::compare);
+        assertEquals(List.of(1, 2, 3), toList(iterator));
+    }
+
+    @Test
+    public void testCompareWithMapJoin() {
+        Random random = new Random(20260708);
+        for (int round = 0; round < 20; round++) {
+            int paramCount = 1 + random.nextInt(3);
+            int partitionCount = 1 + random.nextInt(4);
+            // The element ids of each param, spread over the partitions and sorted in each
+            List<List<List<Integer>>> params = new ArrayList<>();
+            for (int p = 0; p < paramCount; p++) {
+                List<List<Integer>> partitions = new ArrayList<>();
+                for (int i = 0; i < partitionCount; i++) {
+                    partitions.add(new ArrayList<>());
+                }
+                TreeSet<Integer> ids = new TreeSet<>();
+                for (int i = 0; i < 200; i++) {
+                    ids.add(random.nextInt(500));
+                }
+                for (int id : ids) {
+                    partitions.get(id % partitionCount).add(id);
+                }
+                params.add(partitions);
+            }
+
+            List<ScanIterator> streams = new ArrayList<>();
+            for (var partitions : params) {
+                List<ScanIterator> scans = partitions.stream().map(SortedIteratorTest::of)
+                                                     .collect(Collectors.toList());
+                streams.add(new SortedMergeIterator<Integer>(scans, Integer::compare));
+            }
+            List<Integer> sorted = toList(new SortedIntersectionIterator<Integer>(
+                    streams, Integer::compare));
+
+            List<ScanIterator> unsorted = new ArrayList<>();
+            for (var partitions : params) {
+                unsorted.add(of(partitions.stream().flatMap(List::stream)
+                                          .collect(Collectors.toList())));
+            }
+            List<Integer> hashed = toList(new MapJoinIterator<Integer, Integer>(unsorted, 0,
+                                                                                id -> id));
+            hashed.sort(Integer::compare);
+            assertEquals(hashed, sorted);
+        }
+    }
+
+    @Test
+    public void testPositionAndSeek() {
+        var iterator = new SortedIntersectionIterator<Integer>(
+                List.of(of(1, 3, 5, 7, 9), of(1, 3, 5, 7, 9)), Integer::compare,
+                SortedIteratorTest::key);
+        assertEquals(0, iterator.position().length);
+        assertEquals(1, (int) iterator.next());
+        assertEquals(3, (int) iterator.next());
+        assertArrayEquals(key(3), iterator.position());
+
+        // Resume a new scan from the position
+        byte[] position = iterator.position();
+        iterator = new SortedIntersectionIterator<>(
+                List.of(of(1, 3, 5, 7, 9), of(1, 3, 5, 7, 9)), Integer::compare,
+                SortedIteratorTest::key);
+        iterator.seek(position);
+        assertEquals(List.of(5, 7, 9), toList(iterator));
+    }
+
+    @Test
+    public void testExactIndexScan() {
+        byte[] value = new byte[]{1, 2, 3, BytesBuffer.STRING_ENDING_BYTE};
+        byte[] prefix = new byte[]{1, 2, 3};
+        assertTrue(BusinessHandlerImpl.isExactIndexScan(
+                new QueryTypeParam(value, null, 0, true, true, -1)));
+        // A prefix of the index value isn't ordered by element id
+        assertFalse(BusinessHandlerImpl.isExactIndexScan(
+                new QueryTypeParam(prefix, null, 0, true, true, -1)));
+        // Range index scan
+        assertFalse(BusinessHandlerImpl.isExactIndexScan(
+                new QueryTypeParam(value, prefix, 0, false, true, -1)));
+    }
+}
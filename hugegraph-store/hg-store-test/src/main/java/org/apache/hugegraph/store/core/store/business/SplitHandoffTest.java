@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.store.business;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.store.UnitTestBase;
+import org.apache.hugegraph.store.business.BusinessHandler;
+import org.apache.hugegraph.store.core.StoreEngineTestBase;
+import org.apache.hugegraph.store.meta.Partition;
+import org.apache.hugegraph.store.meta.ShardGroup;
+import org.apache.hugegraph.store.util.HgStoreException;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * The data handoff of an online split, from partition 0 into partition 1 on one replica
+ */
+public class SplitHandoffTest extends StoreEngineTestBase {
+
+    private static final String TABLE_NAME = UnitTestBase.DEFAULT_TEST_TABLE;
+    private BusinessHandler handler;
+
+    @Before
+    public void setup() {
+        createPartitionEngine(0, "graph0");
+        createPartitionEngine(1, "graph0");
+        handler = getStoreEngine().getBusinessHandler();
+    }
+
+    private void putKeys(String graph, int count) {
+        createPartitionEngine(0, graph);
+        for (int i = 0; i < count; i++) {
+            handler.doPut(graph, i, TABLE_NAME, ("key" + i).getBytes(), "value".getBytes());
+        }
+    }
+
+    private static Partition target(String graph) {
+        Partition target = getPartition(1, graph);
+        target.setStartKey(128);
+        target.setEndKey(65535);
+        return target;
+    }
+
+    private long countTarget() {
+        try (RocksDBSession session = handler.getSession(1);
+             ScanIterator iterator = session.sessionOp().scan(TABLE_NAME)) {
+            return iterator.count();
+        }
+    }
+
+    @Test
+    public void testHandoff() throws Exception {
+        String graph = "handoff-graph";
+        putKeys(graph, 256);
+        long before = countTarget();
+
+        handler.handoffPartition(graph, 0, List.of(target(graph)), 1L).get();
+        assertEquals(128, countTarget() - before);
+        assertTrue(handler.getHandoffManager(1).isHandedOff(graph, 0));
+    }
+
+    @Test
+    public void testHandoffReplayed() throws Exception {
+        String graph = "replay-graph";
+        putKeys(graph, 256);
+        long before = countTarget();
+        handler.handoffPartition(graph, 0, List.of(target(graph)), 1L).get();
+
+        // Replaying the entry after a restart ingests nothing again
+        putKeys(graph, 512);
+        handler.handoffPartition(graph, 0, List.of(target(graph)), 1L).get();
+        assertEquals(128, countTarget() - before);
+    }
+
+    @Test
+    public void testHandoffAfterWrites() throws Exception {
+        String graph = "written-graph";
+        putKeys(graph, 256);
+        handler.getHandoffManager(1).markWritten(graph);
+        long before = countTarget();
+        try {
+            handler.handoffPartition(graph, 0, List.of(target(graph)), 1L).get();
+            fail("handoff over writes");
+        } catch (ExecutionException e) {
+            // expected, the replica is rebuilt from a snapshot instead
+        }
+        assertEquals(0, countTarget() - before);
+        assertFalse(handler.getHandoffManager(1).isHandedOff(graph, 0));
+    }
+
+    @Test
+    public void testHandoffToOtherStores() {
+        String graph = "remote-graph";
+        putKeys(graph, 256);
+        // The shard group of partition 2 is reused by PD, its replicas are on another store
+        Metapb.Shard shard = Metapb.Shard.newBuilder()
+                                         .setStoreId(1L)
+                                         .setRole(Metapb.ShardRole.Leader)
+                                         .build();
+        getStoreEngine().getPartitionManager().updateShardGroup(ShardGroup.from(
+                Metapb.ShardGroup.newBuilder().setId(2).addShards(shard).build()));
+        Partition target = getPartition(2, graph);
+        target.setStartKey(128);
+        target.setEndKey(65535);
+        try {
+            handler.handoffPartition(graph, 0, List.of(target), 1L);
+            fail("handoff into a partition without local replica");
+        } catch (HgStoreException e) {
+            // expected, the split copies the data through the raft log of partition 2
+        }
+        assertFalse(handler.getHandoffManager(2).isHandedOff(graph, 0));
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.store.meta;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.util.List;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.apache.hugegraph.pd.grpc.Metapb;
+import org.apache.hugegraph.store.PartitionEngine;
+import org.apache.hugegraph.store.core.StoreEngineTestBase;
+import org.apache.hugegraph.store.meta.HandoffManager;
+import org.junit.Before;
+import org.junit.Test;
+
+public class HandoffManagerTest extends StoreEngineTestBase {
+
+    private PartitionEngine engine;
+    private HandoffManager manager;
+
+    @Before
+    public void setup() {
+        engine = createPartitionEngine(0, "graph0");
+        manager = engine.getHandoffManager();
+    }
+
+    private static Metapb.Partition fence(String graph, int id, int start, int end) {
+        return Metapb.Partition.newBuilder().setGraphName(graph).setId(id)
+                               .setStartKey(start).setEndKey(end).build();
+    }
+
+    @Test
+    public void testWriteFences() {
+        manager.putWriteFences("fence-graph", List.of(fence("fence-graph", 11, 100, 200),
+                                                      fence("fence-graph", 12, 200, 300)));
+        assertEquals(2, manager.loadWriteFences().get("fence-graph").size());
+
+        // Replaced, and loaded by the engine as after a restart or a snapshot
+        manager.putWriteFences("fence-graph", List.of(fence("fence-graph", 13, 300, 400)));
+        engine.reloadHandoffState();
+        assertFalse(engine.isWriteFenced("fence-graph", 150));
+        assertTrue(engine.isWriteFenced("fence-graph", 350));
+
+        manager.deleteWriteFences("fence-graph");
+        engine.reloadHandoffState();
+        assertFalse(engine.isWriteFenced("fence-graph", 350));
+    }
+
+    @Test
+    public void testIngestOnce() {
+        AtomicInteger ingested = new AtomicInteger();
+        assertTrue(manager.ingestOnce("once-graph", 3, 1L, ingested::incrementAndGet));
+        assertTrue(manager.isHandedOff("once-graph", 3));
+        // A replayed handoff is skipped
+        assertTrue(manager.ingestOnce("once-graph", 3, 1L, ingested::incrementAndGet));
+        assertEquals(1, ingested.get());
+    }
+
+    @Test
+    public void testIngestRefusedAfterWrites() {
+        manager.markWritten("written-graph");
+        AtomicInteger ingested = new AtomicInteger();
+        assertFalse(manager.ingestOnce("written-graph", 3, 1L, ingested::incrementAndGet));
+        assertFalse(manager.isHandedOff("written-graph", 3));
+        assertEquals(0, ingested.get());
+
+        // Kept in the meta, not only in the cache
+        manager.reload();
+        assertFalse(manager.ingestOnce("written-graph", 3, 1L, ingested::incrementAndGet));
+    }
+}
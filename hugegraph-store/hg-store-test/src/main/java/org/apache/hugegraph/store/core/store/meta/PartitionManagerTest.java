@@ -18,6 +18,7 @@
 package org.apache.hugegraph.store.core.store.meta;
 
 import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertSame;
 import static org.junit.Assert.assertTrue;
@@ -32,6 +33,7 @@ import org.apache.hugegraph.store.core.StoreEngineTestBase;
 import org.apache.hugegraph.store.meta.Graph;
 import org.apache.hugegraph.store.meta.GraphManager;
 import org.apache.hugegraph.store.meta.PartitionManager;
+import org.apache.hugegraph.store.meta.ShardGroup;
 import org.apache.hugegraph.store.pd.FakePdServiceProvider;
 import org.junit.Before;
 import org.junit.Test;
@@ -70,6 +72,38 @@ public class PartitionManagerTest extends StoreEngineTestBase {
         assertEquals(store.getId(), store2.getId());
     }
 
+    @Test
+    public void testGetLearnerScanPartitionIds() {
+        long self = FakePdServiceProvider.makeStoreId("127.0.0.1:6511");
+        long other = self + 1;
+        manager.updatePartition(getPartition(11).getProtoObj(), true);
+        manager.updatePartition(getPartition(12).getProtoObj(), true);
+        manager.updatePartition(getPartition(13).getProtoObj(), true);
+
+        // Leader here without learner: scanned here
+        manager.updateShardGroup(shardGroup(11, self, 0L));
+        // Leader here with a learner elsewhere: scanned by the learner
+        manager.updateShardGroup(shardGroup(12, self, other));
+        // Learner here: scanned here, whatever the local raft role is
+        manager.updateShardGroup(shardGroup(13, other, self));
+
+        var ids = manager.getLearnerScanPartitionIds("graph0");
+        assertTrue(ids.contains(11));
+        assertFalse(ids.contains(12));
+        assertTrue(ids.contains(13));
+    }
+
+    private static ShardGroup shardGroup(int id, long leader, long learner) {
+        var builder = Metapb.ShardGroup.newBuilder().setId(id).setConfVer(1).setVersion(1)
+                                       .addShards(Metapb.Shard.newBuilder().setStoreId(leader)
+                                                              .setRole(Metapb.ShardRole.Leader));
+        if (learner != 0L) {
+            builder.addShards(Metapb.Shard.newBuilder().setStoreId(learner)
+                                          .setRole(Metapb.ShardRole.Learner));
+        }
+        return ShardGroup.from(builder.build());
+    }
+
     @Test
     public void testUpdatePartition() {
         var partition = getPartition(5);
@@ -0,0 +1,257 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.core.store.util;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.Iterator;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+import java.util.Set;
+import java.util.concurrent.atomic.AtomicLong;
+
+import org.apache.hugegraph.store.HgKvIterator;
+import org.apache.hugegraph.store.business.itrv2.io.SortShuffleSerializer;
+import org.apache.hugegraph.store.client.query.StreamFinalAggregationIterator;
+import org.apache.hugegraph.store.client.query.StreamSortedIterator;
+import org.apache.hugegraph.store.query.KvSerializer;
+import org.apache.hugegraph.store.query.func.AggregationFunctionParam;
+import org.apache.hugegraph.store.util.MultiKv;
+import org.apache.hugegraph.store.util.SortShuffle;
+import org.apache.hugegraph.structure.BaseElement;
+import org.apache.hugegraph.structure.KvElement;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+public class SortShuffleTest {
+
+    private static final String SHUFFLE_TEST_PATH = "/tmp/sort_shuffle_test/";
+
+    private String basePath;
+
+    @Before
+    public void init() {
+        this.basePath = SortShuffle.getBasePath();
+        SortShuffle.setBasePath(SHUFFLE_TEST_PATH);
+    }
+
+    @After
+    public void teardown() {
+        SortShuffle.setBasePath(this.basePath);
+    }
+
+    private static MultiKv kv(Object... keys) {
+        return MultiKv.of(Arrays.asList(keys), List.of(1L));
+    }
+
+    private static SortShuffle<MultiKv> shuffle(int batchSize) {
+        return new SortShuffle<>(MultiKv::compareTo, SortShuffleSerializer.ofMultiKvSerializer(),
+                                 batchSize);
+    }
+
+    private static int countFiles() {
+        int count = 0;
+        File[] dirs = new File(SHUFFLE_TEST_PATH).listFiles();
+        if (dirs != null) {
+            for (File dir : dirs) {
+                String[] files = dir.list();
+                count += files == null ? 0 : files.length;
+            }
+        }
+        return count;
+    }
+
+    @Test
+    public void testCompareMixedKeys() {
+        List<MultiKv> kvs = new ArrayList<>(List.of(kv("a", 1), kv(1, "a"), kv(1L, 2.0),
+                                                    kv("a"), kv(2, "b"), kv(1, "a")));
+        for (MultiKv x : kvs) {
+            assertEquals(0, x.compareTo(x));
+            for (MultiKv y : kvs) {
+                assertEquals(Integer.signum(x.compareTo(y)), -Integer.signum(y.compareTo(x)));
+                assertEquals(x.getKeys().equals(y.getKeys()), x.compareTo(y) == 0);
+            }
+        }
+    }
+
+    @Test
+    public void testNaturalOrder() {
+        assertTrue(kv(-1).compareTo(kv(1)) < 0);
+        assertTrue(kv(-2L).compareTo(kv(-1L)) < 0);
+        assertTrue(kv("b").compareTo(kv("ab")) > 0);
+        assertTrue(kv("a").compareTo(kv("ab")) < 0);
+        assertTrue(kv((Object) null).compareTo(kv(-1)) < 0);
+        assertTrue(kv(1, "b").compareTo(kv(1, "ab")) > 0);
+    }
+
+    @Test
+    public void testMergeGroupsOfStores() throws IOException {
+        Random random = new Random(11);
+        Map<List<Object>, Long> expected = new HashMap<>();
+        List<HgKvIterator<BaseElement>> stores = new ArrayList<>();
+        List<SortShuffle<MultiKv>> shuffles = new ArrayList<>();
+        for (int store = 0; store < 3; store++) {
+            // The partial counts of the groups on each store
+            Map<List<Object>, Long> groups = new HashMap<>();
+            for (int i = 0; i < 300; i++) {
+                // Negative numbers and strings of different lengths
+                List<Object> keys = Arrays.asList(random.nextInt(21) - 10,
+                                                  "k".repeat(random.nextInt(3) + 1) +
+                                                  (char) ('a' + random.nextInt(3)));
+                groups.merge(keys, 1L, Long::sum);
+                expected.merge(keys, 1L, Long::sum);
+            }
+
+            SortShuffle<MultiKv> shuffle = shuffle(10);
+            for (Map.Entry<List<Object>, Long> e : groups.entrySet()) {
+                shuffle.append(MultiKv.of(e.getKey(), List.of(new AtomicLong(e.getValue()))));
+            }
+            shuffle.finish();
+            shuffles.add(shuffle);
+            stores.add(toElements(shuffle.getSortedIterator()));
+        }
+        assertTrue(countFiles() > 0);
+
+        // Merge the sorted groups of all the stores as the client does
+        HgKvIterator<BaseElement> merged = new StreamSortedIterator<>(
+                stores, (o1, o2) -> ((KvElement) o1).compareTo((KvElement) o2));
+        HgKvIterator<KvElement> results = new StreamFinalAggregationIterator<>(
+                merged, List.of(AggregationFunctionParam.ofCount()));
+
+        Map<List<Object>, Long> actual = new HashMap<>();
+        KvElement last = null;
+        while (results.hasNext()) {
+            KvElement element = results.next();
+            assertFalse(last != null && last.compareTo(element) >= 0);
+            // Each group is returned only once
+            assertNull(actual.put(new ArrayList<>(element.getKeys()),
+                                  (Long) element.getValues().get(0)));
+            last = element;
+        }
+        assertEquals(expected, actual);
+
+        for (SortShuffle<MultiKv> shuffle : shuffles) {
+            shuffle.close();
+        }
+        assertEquals(0, countFiles());
+    }
+
+    /**
+     * The groups a store sends, decoded by the client from the serialized kvs
+     */
+    private static HgKvIterator<BaseElement> toElements(Iterator<MultiKv> iterator) {
+        return new HgKvIterator<>() {
+
+            @Override
+            public boolean hasNext() {
+                return iterator.hasNext();
+            }
+
+            @Override
+            public BaseElement next() {
+                MultiKv kv = iterator.next();
+                return KvElement.of(KvSerializer.fromBytes(KvSerializer.toBytes(kv.getKeys())),
+                                    KvSerializer.fromObjectBytes(
+                                            KvSerializer.toBytes(kv.getValues())));
+            }
+        };
+    }
+
+    @Test
+    public void testSpill() throws IOException {
+        Random random = new Random(7);
+        SortShuffle<MultiKv> shuffle = shuffle(10);
+        List<MultiKv> expected = new ArrayList<>();
+        for (int i = 0; i < 1000; i++) {
+            // Mix the key types to check the order is total
+            MultiKv kv = i % 3 == 0 ? kv(random.nextInt(100), "v" + random.nextInt(10)) :
+                         kv("k" + random.nextInt(100), (long) random.nextInt(10));
+            expected.add(kv);
+            shuffle.append(kv);
+        }
+        shuffle.finish();
+        assertTrue(countFiles() > 0);
+
+        Collections.sort(expected);
+        List<MultiKv> actual = new ArrayList<>();
+        Iterator<MultiKv> iterator = shuffle.getSortedIterator();
+        while (iterator.hasNext()) {
+            actual.add(iterator.next());
+        }
+        assertEquals(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); i++) {
+            assertEquals(expected.get(i).getKeys(), actual.get(i).getKeys());
+        }
+
+        shuffle.close();
+        assertEquals(0, countFiles());
+    }
+
+    @Test
+    public void testCloseBeforeEnd() throws IOException {
+        SortShuffle<MultiKv> shuffle = shuffle(5);
+        for (int i = 0; i < 100; i++) {
+            shuffle.append(kv(100 - i));
+        }
+        shuffle.finish();
+
+        Iterator<MultiKv> iterator = shuffle.getSortedIterator();
+        assertEquals(List.of(1), iterator.next().getKeys());
+        assertEquals(List.of(2), iterator.next().getKeys());
+        // Stop early, the opened runs are closed and the files are deleted
+        shuffle.close();
+        assertEquals(0, countFiles());
+    }
+
+    @Test
+    public void testWithoutSpill() throws IOException {
+        SortShuffle<MultiKv> shuffle = shuffle(100);
+        for (int i = 0; i < 10; i++) {
+            shuffle.append(kv(10 - i));
+        }
+        shuffle.finish();
+        assertEquals(0, countFiles());
+
+        Iterator<MultiKv> iterator = shuffle.getIterator();
+        assertEquals(List.of(10), iterator.next().getKeys());
+
+        Set<Object> keys = new HashSet<>();
+        iterator = shuffle.getSortedIterator();
+        MultiKv last = null;
+        while (iterator.hasNext()) {
+            MultiKv kv = iterator.next();
+            assertFalse(last != null && last.compareTo(kv) > 0);
+            keys.add(kv.getKeys());
+            last = kv;
+        }
+        assertEquals(10, keys.size());
+        shuffle.close();
+    }
+}
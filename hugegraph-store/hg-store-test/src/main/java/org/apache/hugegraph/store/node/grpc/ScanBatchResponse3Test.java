@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.grpc;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.lang.reflect.Field;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.LinkedBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.store.grpc.stream.KvPageRes;
+import org.apache.hugegraph.store.node.metrics.ScanStreamMetrics;
+import org.junit.Test;
+
+import io.grpc.stub.StreamObserver;
+import io.micrometer.core.instrument.Counter;
+import io.micrometer.core.instrument.DistributionSummary;
+import io.micrometer.core.instrument.simple.SimpleMeterRegistry;
+
+public class ScanBatchResponse3Test {
+
+    @Test
+    public void testLastPackageInMetrics() throws Exception {
+        ScanStreamMetrics.init(new SimpleMeterRegistry());
+        Counter sentBytes = meter("sentBytes");
+        DistributionSummary batchBytes = meter("batchBytes");
+        double bytesBefore = sentBytes.count();
+        long batchesBefore = batchBytes.count();
+
+        // 5 columns of 8 bytes in packages of 2, the last package holds one column
+        List<RocksDBSession.BackendColumn> columns = new ArrayList<>();
+        for (int i = 0; i < 5; i++) {
+            columns.add(RocksDBSession.BackendColumn.of(new byte[]{'k', 'e', (byte) i},
+                                                        new byte[]{'v', 'a', 'l', 'u',
+                                                                   (byte) i}));
+        }
+        List<KvPageRes> pages = new ArrayList<>();
+        CountDownLatch completed = new CountDownLatch(1);
+        StreamObserver<KvPageRes> observer = new StreamObserver<>() {
+            @Override
+            public void onNext(KvPageRes page) {
+                pages.add(page);
+            }
+
+            @Override
+            public void onError(Throwable t) {
+                completed.countDown();
+            }
+
+            @Override
+            public void onCompleted() {
+                completed.countDown();
+            }
+        };
+
+        ThreadPoolExecutor executor = new ThreadPoolExecutor(1, 1, 0L, TimeUnit.SECONDS,
+                                                             new LinkedBlockingQueue<>());
+        try {
+            ScanBatchResponse3.OrderDeliverer deliverer =
+                    new ScanBatchResponse3.OrderDeliverer("test", observer);
+            ScanBatchResponse3.OrderWorker worker =
+                    new ScanBatchResponse3.OrderWorker(Long.MAX_VALUE, 2, iterator(columns),
+                                                       deliverer, executor);
+            worker.hereWeGo();
+            assertTrue(completed.await(10, TimeUnit.SECONDS));
+        } finally {
+            executor.shutdownNow();
+        }
+
+        assertEquals(3, pages.size());
+        assertFalse(pages.get(1).getOver());
+        assertTrue(pages.get(2).getOver());
+        assertEquals(1, pages.get(2).getDataCount());
+        assertEquals(40, sentBytes.count() - bytesBefore, 0.0);
+        assertEquals(3, batchBytes.count() - batchesBefore);
+    }
+
+    @SuppressWarnings("unchecked")
+    private static <T> T meter(String name) throws Exception {
+        Field field = ScanStreamMetrics.class.getDeclaredField(name);
+        field.setAccessible(true);
+        return (T) field.get(null);
+    }
+
+    private static ScanIterator iterator(List<RocksDBSession.BackendColumn> columns) {
+        Iterator<RocksDBSession.BackendColumn> iter = columns.iterator();
+        return new ScanIterator() {
+
+            @Override
+            public boolean hasNext() {
+                return iter.hasNext();
+            }
+
+            @Override
+            public boolean isValid() {
+                return true;
+            }
+
+            @Override
+            @SuppressWarnings("unchecked")
+            public <T> T next() {
+                return (T) iter.next();
+            }
+
+            @Override
+            public byte[] position() {
+                // The partition id
+                return new byte[]{0, 0, 0, 1};
+            }
+
+            @Override
+            public void close() {
+                // pass
+            }
+        };
+    }
+}
@@ -0,0 +1,245 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.grpc.query;
+
+import static org.apache.hugegraph.store.constant.HugeServerTables.OUT_EDGE_TABLE;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertThrows;
+import static org.junit.Assert.assertTrue;
+
+import java.lang.reflect.Field;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.List;
+import java.util.Map;
+
+import org.apache.hugegraph.id.Id;
+import org.apache.hugegraph.id.IdGenerator;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.serializer.BytesBuffer;
+import org.apache.hugegraph.store.grpc.query.KHopDirection;
+import org.apache.hugegraph.store.grpc.query.KHopRequest;
+import org.apache.hugegraph.store.grpc.query.KHopResponse;
+import org.apache.hugegraph.type.HugeType;
+import org.junit.Test;
+
+import com.google.protobuf.ByteString;
+
+import io.grpc.ManagedChannel;
+import io.grpc.ManagedChannelBuilder;
+
+public class KHopExpanderTest {
+
+    private static final Id LABEL = IdGenerator.of(1L);
+    private static final Id OTHER_LABEL = IdGenerator.of(2L);
+
+    /**
+     * 1 -> 2, 3, 4; 2 -> 5; 3 -> 5, 6; 4 -> 1; 5 -> 7; 1 -> 8 with another label
+     */
+    private static Map<ByteBuffer, List<RocksDBSession.BackendColumn>> graph() {
+        Map<ByteBuffer, List<RocksDBSession.BackendColumn>> edges = new HashMap<>();
+        addEdge(edges, 1, 2, LABEL);
+        addEdge(edges, 1, 3, LABEL);
+        addEdge(edges, 1, 4, LABEL);
+        addEdge(edges, 2, 5, LABEL);
+        addEdge(edges, 3, 5, LABEL);
+        addEdge(edges, 3, 6, LABEL);
+        addEdge(edges, 4, 1, LABEL);
+        addEdge(edges, 5, 7, LABEL);
+        addEdge(edges, 1, 8, OTHER_LABEL);
+        return edges;
+    }
+
+    private static void addEdge(Map<ByteBuffer, List<RocksDBSession.BackendColumn>> edges,
+                                long owner, long other, Id label) {
+        // owner-vertex + dir + edge-label + sub-label + sort-values + other-vertex
+        byte[] key = BytesBuffer.allocate(32)
+                                .writeId(IdGenerator.of(owner))
+                                .write(HugeType.EDGE_OUT.code())
+                                .writeId(label)
+                                .writeId(label)
+                                .writeStringWithEnding("")
+                                .writeId(IdGenerator.of(other))
+                                .bytes();
+        edges.computeIfAbsent(vertex(owner), k -> new ArrayList<>())
+             .add(RocksDBSession.BackendColumn.of(key, new byte[0]));
+    }
+
+    private static ByteBuffer vertex(long id) {
+        return ByteBuffer.wrap(BytesBuffer.allocate(9).writeId(IdGenerator.of(id)).bytes());
+    }
+
+    private static ByteString source(long id) {
+        return ByteString.copyFrom(vertex(id).array());
+    }
+
+    private static KHopRequest.Builder request(int depth, long... sources) {
+        KHopRequest.Builder builder = KHopRequest.newBuilder()
+                                                 .setQueryId("q1")
+                                                 .setGraph("g")
+                                                 .setDepth(depth)
+                                                 .setDirection(KHopDirection.KHOP_OUT);
+        for (long source : sources) {
+            builder.addSources(source(source));
+        }
+        return builder;
+    }
+
+    private static List<ByteString> vertices(long... ids) {
+        List<ByteString> vertices = new ArrayList<>();
+        for (long id : ids) {
+            vertices.add(source(id));
+        }
+        return vertices;
+    }
+
+    @Test
+    public void testKout() throws Exception {
+        KHopResponse response = new TestExpander(request(2, 1).build(), true).execute();
+        assertTrue(response.getIsOk());
+        // 1 is visited and 7 is in the third hop
+        assertEquals(vertices(5, 6), response.getVerticesList());
+        assertEquals(2, response.getCount());
+    }
+
+    @Test
+    public void testKneighborWithLabel() throws Exception {
+        KHopRequest request = request(3, 1).setAllLayers(true)
+                                           .addLabels(ByteString.copyFrom(
+                                                   BytesBuffer.allocate(9).writeId(LABEL)
+                                                              .bytes()))
+                                           .build();
+        KHopResponse response = new TestExpander(request, true).execute();
+        assertEquals(vertices(2, 3, 4, 5, 6, 7), response.getVerticesList());
+        assertEquals(6, response.getCount());
+    }
+
+    @Test
+    public void testKneighborLimitPerHop() throws Exception {
+        KHopRequest request = request(3, 1).setAllLayers(true).setLimit(5).build();
+        TestExpander expander = new TestExpander(request, true);
+        KHopResponse response = expander.execute();
+        assertEquals(vertices(2, 3, 4, 8, 5), response.getVerticesList());
+        // The second hop stops once it reaches 5, 3 and 4 are never expanded
+        assertEquals(List.of(vertex(1), vertex(2)), expander.scanned);
+    }
+
+    @Test
+    public void testKoutLimitPerHop() throws Exception {
+        KHopRequest request = request(1, 1).setLimit(2).build();
+        TestExpander expander = new TestExpander(request, true);
+        KHopResponse response = expander.execute();
+        assertEquals(vertices(2, 3), response.getVerticesList());
+        assertEquals(2, response.getCount());
+        // Stop scanning the edges once the hop is full
+        assertEquals(2, expander.read);
+    }
+
+    @Test
+    public void testDegreeAndCountOnly() throws Exception {
+        KHopRequest request = request(2, 1).setDegree(1).setCountOnly(true).build();
+        KHopResponse response = new TestExpander(request, true).execute();
+        // 1 -> 2 -> 5
+        assertEquals(1, response.getCount());
+        assertEquals(0, response.getVerticesCount());
+    }
+
+    @Test
+    public void testLocalOnly() throws Exception {
+        KHopRequest request = request(1, 2, 3).setLocalOnly(true).setLimit(2).build();
+        KHopResponse response = new TestExpander(request, true).execute();
+        assertEquals(vertices(5, 6), response.getVerticesList());
+    }
+
+    @Test
+    public void testLocalOnlyOnFollower() {
+        KHopRequest request = request(1, 2, 3).setLocalOnly(true).build();
+        TestExpander expander = new TestExpander(request, false);
+        assertThrows(IllegalStateException.class, expander::execute);
+        assertTrue(expander.scanned.isEmpty());
+    }
+
+    @Test
+    @SuppressWarnings("unchecked")
+    public void testShutdownChannels() throws Exception {
+        Field field = KHopExpander.class.getDeclaredField("channels");
+        field.setAccessible(true);
+        Map<String, ManagedChannel> channels = (Map<String, ManagedChannel>) field.get(null);
+        ManagedChannel channel = ManagedChannelBuilder.forTarget("127.0.0.1:8500")
+                                                      .usePlaintext().build();
+        channels.put("127.0.0.1:8500", channel);
+
+        KHopExpander.shutdownChannels();
+        assertTrue(channel.isShutdown());
+        assertTrue(channels.isEmpty());
+    }
+
+    private static class TestExpander extends KHopExpander {
+
+        private final Map<ByteBuffer, List<RocksDBSession.BackendColumn>> edges = graph();
+        private final boolean leader;
+        private final List<ByteBuffer> scanned = new ArrayList<>();
+        private int read;
+
+        public TestExpander(KHopRequest request, boolean leader) {
+            super(request, null);
+            this.leader = leader;
+        }
+
+        @Override
+        protected boolean isLocalLeader(ByteBuffer vertex) {
+            return this.leader;
+        }
+
+        @Override
+        protected ScanIterator scanPrefix(String table, int code, byte[] ownerId) {
+            assertEquals(OUT_EDGE_TABLE, table);
+            ByteBuffer owner = ByteBuffer.wrap(ownerId);
+            this.scanned.add(owner);
+            Iterator<RocksDBSession.BackendColumn> iter =
+                    this.edges.getOrDefault(owner, List.of()).iterator();
+            return new ScanIterator() {
+
+                @Override
+                public boolean hasNext() {
+                    return iter.hasNext();
+                }
+
+                @Override
+                public boolean isValid() {
+                    return true;
+                }
+
+                @Override
+                @SuppressWarnings("unchecked")
+                public <T> T next() {
+                    TestExpander.this.read++;
+                    return (T) iter.next();
+                }
+
+                @Override
+                public void close() {
+                    // pass
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.apache.hugegraph.store.node.grpc.query;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Set;
+import java.util.stream.Collectors;
+
+import org.apache.hugegraph.id.Id;
+import org.apache.hugegraph.id.IdGenerator;
+import org.apache.hugegraph.id.IdUtil;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.store.node.grpc.query.model.PipelineResult;
+import org.apache.hugegraph.store.node.grpc.query.stages.ProjectionStage;
+import org.apache.hugegraph.struct.schema.PropertyKey;
+import org.apache.hugegraph.structure.BaseElement;
+import org.apache.hugegraph.structure.BaseVertex;
+import org.junit.Test;
+
+import com.google.protobuf.ByteString;
+
+public class ProjectionStageTest {
+
+    private static ProjectionStage stage(boolean removeAll, long... keys) {
+        List<ByteString> properties = new ArrayList<>();
+        for (long key : keys) {
+            properties.add(ByteString.copyFrom(IdUtil.asBytes(IdGenerator.of(key))));
+        }
+        ProjectionStage stage = new ProjectionStage();
+        stage.init(properties, removeAll);
+        return stage;
+    }
+
+    private static BaseVertex vertex(long id, int properties) {
+        BaseVertex vertex = new BaseVertex(IdGenerator.of(id));
+        for (long i = 1; i <= properties; i++) {
+            vertex.addProperty(new PropertyKey(null, IdGenerator.of(i), "p" + i), "v" + i);
+        }
+        return vertex;
+    }
+
+    private static Set<Id> keys(BaseElement element) {
+        return element.getProperties().keySet();
+    }
+
+    @Test
+    public void testBatchSameAsSingle() {
+        ProjectionStage stage = stage(false, 1L, 3L);
+        int size = 100;
+        PipelineResult[] batch = new PipelineResult[size];
+        BaseVertex[] expected = new BaseVertex[size];
+        for (int i = 0; i < size; i++) {
+            batch[i] = i % 10 == 0 ? null : new PipelineResult(vertex(i, i % 5));
+            expected[i] = vertex(i, i % 5);
+            stage.handle(new PipelineResult(expected[i]));
+        }
+
+        int kept = stage.handleBatch(batch, size);
+        assertEquals(size - 10, kept);
+        int j = 0;
+        for (int i = 0; i < size; i++) {
+            if (i % 10 == 0) {
+                continue;
+            }
+            BaseElement element = batch[j++].getElement();
+            assertEquals(expected[i].id(), element.id());
+            assertEquals(keys(expected[i]), keys(element));
+            // Only the projected properties the vertex has are kept
+            int count = i % 5;
+            Set<Long> projected = Set.of(1L, 3L).stream().filter(k -> k <= count)
+                                     .collect(Collectors.toSet());
+            assertEquals(projected, keys(element).stream().map(Id::asLong)
+                                                 .collect(Collectors.toSet()));
+        }
+    }
+
+    @Test
+    public void testRemoveAll() {
+        ProjectionStage stage = stage(true, 1L);
+        RocksDBSession.BackendColumn column =
+                RocksDBSession.BackendColumn.of(new byte[]{1}, new byte[]{2});
+        PipelineResult[] batch = {new PipelineResult(vertex(1, 3)),
+                                  new PipelineResult(column),
+                                  PipelineResult.EMPTY};
+
+        assertEquals(3, stage.handleBatch(batch, 3));
+        assertEquals(0, keys(batch[0].getElement()).size());
+        assertEquals(0, column.value.length);
+        assertSame(PipelineResult.EMPTY, batch[2]);
+    }
+}
@@ -17,9 +17,15 @@
 
 package org.apache.hugegraph.store.rocksdb;
 
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
 import java.lang.reflect.Constructor;
 import java.lang.reflect.InvocationTargetException;
+import java.util.HashMap;
+import java.util.Map;
 
+import org.apache.hugegraph.config.HugeConfig;
 import org.apache.hugegraph.rocksdb.access.RocksDBFactory;
 import org.apache.hugegraph.rocksdb.access.RocksDBSession;
 import org.apache.hugegraph.rocksdb.access.SessionOperator;
@@ -27,6 +33,15 @@ import org.junit.Test;
 
 public class RocksDBFactoryTest extends BaseRocksDbTest {
 
+    private static RocksDBFactory newFactory(HugeConfig config) throws Exception {
+        Constructor<RocksDBFactory> constructor =
+                RocksDBFactory.class.getDeclaredConstructor();
+        constructor.setAccessible(true);
+        RocksDBFactory factory = constructor.newInstance();
+        factory.setHugeConfig(config);
+        return factory;
+    }
+
     @Test
     public void testCreateSession() throws NoSuchMethodException, InvocationTargetException,
                                            InstantiationException, IllegalAccessException {
@@ -50,6 +65,54 @@ public class RocksDBFactoryTest extends BaseRocksDbTest {
         factory.destroyGraphDB("test1");
     }
 
+    @Test
+    public void testMemoryQuota() throws Exception {
+        long quota = 1024 * 1024;
+        Map<String, Object> configMap = new HashMap<>();
+        // Large enough not to be flushed by rocksdb itself
+        configMap.put("rocksdb.write_buffer_size", String.valueOf(64 * quota));
+        configMap.put("rocksdb.db_memory_quota", String.valueOf(quota));
+        RocksDBFactory factory = newFactory(new HugeConfig(configMap));
+
+        try (RocksDBSession dbSession = factory.createGraphDB("./tmp", "quota1")) {
+            dbSession.checkTable("tbl");
+            SessionOperator op = dbSession.sessionOp();
+            byte[] value = new byte[1024];
+            op.prepare();
+            for (int i = 0; i < 4096; i++) {
+                op.put("tbl", String.format("k%05d", i).getBytes(), value);
+            }
+            op.commit();
+            assertTrue(dbSession.getMemTableUsage() > quota);
+            assertEquals(0L, levelZeroFiles(dbSession));
+
+            factory.checkMemoryQuota();
+            // The flush is not waited
+            long deadline = System.currentTimeMillis() + 10_000;
+            while (dbSession.getMemTableUsage() > quota &&
+                   System.currentTimeMillis() < deadline) {
+                Thread.sleep(100);
+            }
+            assertTrue(dbSession.getMemTableUsage() <= quota);
+            assertTrue(levelZeroFiles(dbSession) > 0);
+        } finally {
+            factory.destroyGraphDB("quota1");
+        }
+    }
+
+    private static long levelZeroFiles(RocksDBSession dbSession) {
+        long files = 0L;
+        for (String table : dbSession.getTables().keySet()) {
+            try (RocksDBSession.CFHandleLock cf = dbSession.getCFHandleLock(table)) {
+                files += Long.parseLong(dbSession.getDB().getProperty(
+                        cf.get(), "rocksdb.num-files-at-level0"));
+            } catch (Exception e) {
+                throw new RuntimeException(e);
+            }
+        }
+        return files;
+    }
+
     @Test
     public void testTotalKeys() {
         RocksDBFactory dbFactory = RocksDBFactory.getInstance();
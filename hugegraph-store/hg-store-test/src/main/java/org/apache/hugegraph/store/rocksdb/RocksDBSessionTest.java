@@ -0,0 +1,175 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.apache.hugegraph.store.rocksdb;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+
+import java.io.File;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import org.apache.commons.io.FileUtils;
+import org.apache.hugegraph.config.HugeConfig;
+import org.apache.hugegraph.rocksdb.access.RocksDBOptions;
+import org.apache.hugegraph.rocksdb.access.RocksDBSession;
+import org.apache.hugegraph.rocksdb.access.ScanIterator;
+import org.apache.hugegraph.rocksdb.access.SessionOperator;
+import org.junit.AfterClass;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import org.rocksdb.BlockBasedTableConfig;
+import org.rocksdb.BloomFilter;
+import org.rocksdb.ReadOptions;
+import org.rocksdb.RocksIterator;
+
+public class RocksDBSessionTest extends BaseRocksDbTest {
+
+    private static final String DB_NAME = "prefix1";
+    // Keys of the table share a 4 bytes prefix
+    private static final String PREFIX_TABLE = "pt";
+    private static final String OTHER_TABLE = "ot";
+    private static final String[] PREFIXES = {"aaaa", "aaab", "bbbb"};
+
+    private static RocksDBSession session;
+
+    @BeforeClass
+    public static void initSession() throws Exception {
+        Map<String, Object> configMap = new HashMap<>();
+        configMap.put("rocksdb.prefix_extractor_tables", "[" + PREFIX_TABLE + ":4]");
+        // A prefix bloom filter, the whole keys are not in it
+        BlockBasedTableConfig tableConfig = new BlockBasedTableConfig()
+                .setFilterPolicy(new BloomFilter(10, false))
+                .setWholeKeyFiltering(false);
+        configMap.put(RocksDBOptions.TABLE_CONFIGS, Map.of(PREFIX_TABLE, tableConfig));
+
+        FileUtils.deleteDirectory(new File("./tmp", DB_NAME));
+        session = new RocksDBSession(new HugeConfig(configMap), "./tmp", DB_NAME, 0L);
+        session.checkTable(PREFIX_TABLE);
+        session.checkTable(OTHER_TABLE);
+
+        SessionOperator op = session.sessionOp();
+        op.prepare();
+        for (String prefix : PREFIXES) {
+            for (int i = 0; i < 5; i++) {
+                op.put(PREFIX_TABLE, key(prefix, i), key(prefix, i));
+            }
+        }
+        op.commit();
+        // Half of the keys in the sst files, so the bloom filter is used too
+        session.flush(true);
+        op.prepare();
+        for (String prefix : PREFIXES) {
+            for (int i = 5; i < 10; i++) {
+                op.put(PREFIX_TABLE, key(prefix, i), key(prefix, i));
+            }
+        }
+        op.commit();
+    }
+
+    @AfterClass
+    public static void closeSession() {
+        session.close();
+    }
+
+    private static byte[] key(String prefix, int i) {
+        return (prefix + i).getBytes();
+    }
+
+    private static List<String> keys(ScanIterator iterator) {
+        List<String> keys = new ArrayList<>();
+        try (iterator) {
+            while (iterator.hasNext()) {
+                RocksDBSession.BackendColumn col = iterator.next();
+                keys.add(new String(col.name));
+            }
+        }
+        return keys;
+    }
+
+    @Test
+    public void testIteratorOptions() {
+        ReadOptions prefix = session.getIteratorOptions(PREFIX_TABLE, "aaaa".getBytes());
+        assertTrue(prefix.prefixSameAsStart());
+        assertFalse(prefix.totalOrderSeek());
+        // Longer than the extracted prefix
+        assertTrue(session.getIteratorOptions(PREFIX_TABLE, "aaaa1".getBytes())
+                          .prefixSameAsStart());
+
+        // Shorter than the extracted prefix, or no prefix at all
+        ReadOptions totalOrder = session.getIteratorOptions(PREFIX_TABLE, "aa".getBytes());
+        assertTrue(totalOrder.totalOrderSeek());
+        assertFalse(totalOrder.prefixSameAsStart());
+        assertTrue(session.getIteratorOptions(PREFIX_TABLE, null).totalOrderSeek());
+
+        // The table without a prefix extractor uses the default options
+        assertNull(session.getIteratorOptions(OTHER_TABLE, "aaaa".getBytes()));
+    }
+
+    @Test
+    public void testPrefixScan() {
+        SessionOperator op = session.sessionOp();
+        List<String> keys = keys(op.scan(PREFIX_TABLE, "aaab".getBytes()));
+        assertEquals(10, keys.size());
+        for (int i = 0; i < 10; i++) {
+            assertEquals("aaab" + i, keys.get(i));
+        }
+        assertEquals(List.of("aaab3"), keys(op.scan(PREFIX_TABLE, "aaab3".getBytes())));
+        assertTrue(keys(op.scan(PREFIX_TABLE, "cccc".getBytes())).isEmpty());
+
+        // The prefix extractor bounds the raw iterator to the prefix
+        ReadOptions options = session.getIteratorOptions(PREFIX_TABLE, "aaaa".getBytes());
+        try (RocksDBSession.CFHandleLock cf = session.getCFHandleLock(PREFIX_TABLE);
+             RocksIterator iter = session.getDB().newIterator(cf.get(), options)) {
+            int count = 0;
+            for (iter.seek("aaaa".getBytes()); iter.isValid(); iter.next()) {
+                assertArrayEquals(key("aaaa", count), iter.key());
+                count++;
+            }
+            assertEquals(10, count);
+        }
+    }
+
+    @Test
+    public void testScanAcrossPrefixes() {
+        SessionOperator op = session.sessionOp();
+        // A prefix shorter than the extracted one covers two prefixes
+        List<String> keys = keys(op.scan(PREFIX_TABLE, "aaa".getBytes()));
+        assertEquals(20, keys.size());
+        assertEquals("aaaa0", keys.get(0));
+        assertEquals("aaab9", keys.get(19));
+
+        // A range from the middle of a prefix into another one
+        keys = keys(op.scan(PREFIX_TABLE, key("aaaa", 5), key("bbbb", 3),
+                            ScanIterator.Trait.SCAN_GTE_BEGIN |
+                            ScanIterator.Trait.SCAN_LT_END));
+        assertEquals(5 + 10 + 3, keys.size());
+        assertEquals("aaaa5", keys.get(0));
+        assertEquals("aaab0", keys.get(5));
+        assertEquals("bbbb2", keys.get(17));
+
+        // All the keys
+        assertEquals(30, keys(op.scan(PREFIX_TABLE)).size());
+    }
+}
@@ -24,7 +24,8 @@ import lombok.extern.slf4j.Slf4j;
 
 @RunWith(Suite.class)
 @Suite.SuiteClasses({
-        RocksDBFactoryTest.class
+        RocksDBFactoryTest.class,
+        RocksDBSessionTest.class
 })
 
 @Slf4j